@@ -0,0 +1,73 @@
+#include "CurlWrapper.h"
+#include "CurlPool.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using namespace MailTMAPI;
+
+// Callback that discards the response body
+static size_t DiscardCallback(void*, size_t size, size_t nmemb, void*) {
+    return size * nmemb;
+}
+
+// Configures a handle for one GET request against the stand-in server
+static void prepareRequest(CurlWrapper& curl, const std::string& url, bool insecure) {
+    curl.setOption(CURLOPT_URL, url.c_str());
+    curl.setOption(CURLOPT_WRITEFUNCTION, DiscardCallback);
+    curl.addHeader("Content-Type: application/json");
+    if (insecure) { // The local stand-in uses a self-signed certificate
+        curl.setOption(CURLOPT_SSL_VERIFYPEER, 0L);
+        curl.setOption(CURLOPT_SSL_VERIFYHOST, 0L);
+    }
+}
+
+// Runs the given request function and prints requests per second
+template <typename Func>
+static double runBenchmark(const std::string& label, int requests, Func func) {
+    auto start = std::chrono::steady_clock::now();
+    int failures = 0;
+    for (int i = 0; i < requests; ++i) {
+        if (func() != CURLE_OK) {
+            failures++;
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    double rate = requests / elapsed.count();
+    std::cout << label << ": " << requests << " requests in " << elapsed.count() << " s ("
+              << rate << " req/s, " << failures << " failures)" << std::endl;
+    return rate;
+}
+
+// Benchmark comparing a fresh CurlWrapper per request with pooled keep-alive handles.
+// Start bench/https_standin.py first, then run:
+//   connection_reuse_bench https://127.0.0.1:8443/messages 500 --insecure
+int main(int argc, char* argv[]) {
+    std::string url = argc > 1 ? argv[1] : "https://127.0.0.1:8443/messages";
+    int requests = argc > 2 ? std::stoi(argv[2]) : 200;
+    bool insecure = argc > 3 && std::string(argv[3]) == "--insecure";
+
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    // Before: every request builds its own handle and pays a full TCP and TLS handshake
+    double before = runBenchmark("fresh handle per request", requests, [&]() {
+        CurlWrapper curl;
+        prepareRequest(curl, url, insecure);
+        return curl.perform();
+    });
+
+    // After: handles come from the pool and keep their connection between requests
+    CurlPool pool;
+    double after = runBenchmark("pooled keep-alive handle", requests, [&]() {
+        auto curl = pool.acquire();
+        prepareRequest(*curl, url, insecure);
+        CURLcode res = curl->perform();
+        pool.release(std::move(curl));
+        return res;
+    });
+
+    std::cout << "speedup: " << after / before << "x" << std::endl;
+
+    curl_global_cleanup();
+    return 0;
+}
@@ -0,0 +1,93 @@
+#include "Extractor.h"
+#include "HtmlText.h"
+#include "JsonParser.h"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <string>
+
+using namespace MailTMAPI;
+
+// Reads a whole payload file into memory
+static std::string readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Failed to open payload: " + path);
+    }
+    std::ostringstream contents;
+    contents << in.rdbuf();
+    return contents.str();
+}
+
+// Runs the given extraction and prints messages per second
+template <typename Func>
+static double runBenchmark(const std::string& label, const Message& message, int iterations, Func func) {
+    size_t checksum = 0; // Keeps the compiler from discarding the work
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        checksum += func(message);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    double rate = iterations / elapsed.count();
+    std::cout << "  " << label << ": " << rate << " messages/s, " << 1e6 / rate << " us per message (" << checksum / iterations
+              << " matches)" << std::endl;
+    return rate;
+}
+
+// The scraping approach this replaces: one regular expression per pattern over the text
+static size_t regexExtract(const Message& message) {
+    static const std::regex code("(?:code|otp|pin|passcode|verification|one-time|2fa)[^0-9]{0,80}?([0-9]{4,8})",
+                                 std::regex::icase);
+    static const std::regex url("https?://[^\\s\"'<>]+");
+    static const std::regex linkKeyword("verify|verification|confirm|activate|activation|reset|magic|login|signin|"
+                                        "sign-in|token|auth", std::regex::icase);
+    std::string text = message.subject + "\n" + (message.text.empty() ? HtmlText::convert(message.html).text : message.text);
+    size_t matches = 0;
+    std::smatch match;
+    if (std::regex_search(text, match, code)) {
+        matches++;
+    }
+    for (auto it = std::sregex_iterator(text.begin(), text.end(), url); it != std::sregex_iterator(); ++it) {
+        if (std::regex_search(it->str(), linkKeyword)) {
+            matches++;
+        }
+    }
+    return matches;
+}
+
+// Benchmark comparing regular expressions with the compiled Extractor on a verification mail and a large
+// marketing mail. Run from the repository root, or pass the payload directory:
+//   extractor_bench bench/payloads 2000
+int main(int argc, char* argv[]) {
+    std::string directory = argc > 1 ? argv[1] : "bench/payloads";
+    int iterations = argc > 2 ? std::stoi(argv[2]) : 2000;
+
+    try {
+        Json::Value json;
+        if (!JsonParser::local().parse(readFile(directory + "/message.json"), json)) {
+            throw std::runtime_error("Failed to parse message.json");
+        }
+        Message verification = Message::fromJson(json);
+        Message marketing;
+        marketing.id = "marketing";
+        marketing.subject = "This week's deals";
+        marketing.html = readFile(directory + "/marketing.html");
+
+        Extractor extractor;
+        for (const auto& [label, message, scale] : {std::make_tuple("verification mail", &verification, 1),
+                                                     std::make_tuple("marketing mail", &marketing, 20)}) {
+            std::cout << label << " (" << message->text.size() + message->html.size() << " bytes)" << std::endl;
+            double before = runBenchmark("std::regex", *message, iterations / scale, regexExtract);
+            double after = runBenchmark("Extractor", *message, iterations / scale, [&](const Message& m) {
+                return extractor.extract(m).size();
+            });
+            std::cout << "  speedup: " << after / before << "x" << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include "HtmlText.h"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace MailTMAPI;
+
+// Reads a whole payload file into memory
+static std::string readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Failed to open payload: " + path);
+    }
+    std::ostringstream contents;
+    contents << in.rdbuf();
+    return contents.str();
+}
+
+// Runs the given conversion and prints documents and megabytes per second
+template <typename Func>
+static double runBenchmark(const std::string& label, const std::string& payload, int iterations, Func func) {
+    size_t checksum = 0; // Keeps the compiler from discarding the conversions
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        checksum += func(payload);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    double rate = iterations / elapsed.count();
+    std::cout << "  " << label << ": " << rate << " docs/s, "
+              << rate * payload.size() / (1024.0 * 1024.0) << " MB/s (checksum " << checksum << ")" << std::endl;
+    return rate;
+}
+
+// The converter the GUI used before, kept verbatim as the baseline
+static size_t stripHtmlExceptLinks(const std::string& html) {
+    std::string result;
+    bool inTag = false;
+    bool inLink = false;
+    std::string currentLink;
+
+    for (size_t i = 0; i < html.length(); ++i) {
+        if (html[i] == '<') {
+            inTag = true;
+            // Check if it's a link
+            if (i + 9 < html.length() && html.substr(i, 9) == "<a href=\"") {
+                inLink = true;
+                i += 8; // Skip to the href value
+                continue;
+            }
+        } else if (html[i] == '>') {
+            inTag = false;
+            if (inLink) {
+                // Add the complete link to result
+                if (!currentLink.empty()) {
+                    result += currentLink + " ";
+                    currentLink.clear();
+                }
+                inLink = false;
+            }
+            continue;
+        }
+
+        if (!inTag) {
+            if (i + 6 <= html.length() && html.substr(i, 6) == "&nbsp;") {
+                result += " ";
+                i += 5;
+            } else if (i + 4 <= html.length() && html.substr(i, 4) == "&lt;") {
+                result += "<";
+                i += 3;
+            } else if (i + 4 <= html.length() && html.substr(i, 4) == "&gt;") {
+                result += ">";
+                i += 3;
+            } else if (i + 5 <= html.length() && html.substr(i, 5) == "&amp;") {
+                result += "&";
+                i += 4;
+            } else {
+                result += html[i];
+            }
+        } else if (inLink && html[i] != '"') {
+            currentLink += html[i];
+        }
+    }
+
+    return result.size();
+}
+
+// Benchmark comparing HTML to text conversion on a large marketing email.
+// Run from the repository root, or pass the payload directory:
+//   html_text_bench bench/payloads 500
+int main(int argc, char* argv[]) {
+    std::string directory = argc > 1 ? argv[1] : "bench/payloads";
+    int iterations = argc > 2 ? std::stoi(argv[2]) : 500;
+
+    try {
+        std::string payload = readFile(directory + "/marketing.html");
+        std::cout << "marketing.html (" << payload.size() << " bytes)" << std::endl;
+        double before = runBenchmark("stripHtmlExceptLinks", payload, iterations, stripHtmlExceptLinks);
+        double after = runBenchmark("HtmlText::convert", payload, iterations, [](const std::string& html) {
+            HtmlTextResult result = HtmlText::convert(html);
+            return result.text.size() + result.links.size();
+        });
+        std::cout << "  speedup: " << after / before << "x" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
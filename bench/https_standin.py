@@ -0,0 +1,57 @@
+#!/usr/bin/env python3
+"""Local HTTPS stand-in for the connection reuse benchmark.
+
+Serves a small JSON body for every GET over HTTP/1.1 keep-alive, using a
+throwaway self-signed certificate generated with openssl.
+
+Usage: python3 https_standin.py [port]
+"""
+import http.server
+import os
+import ssl
+import subprocess
+import sys
+import tempfile
+
+BODY = b'{"hydra:member":[],"hydra:totalItems":0}'
+
+
+class Handler(http.server.BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"  # keep connections open between requests
+    disable_nagle_algorithm = True  # avoid 40 ms delayed-ACK stalls on small responses
+
+    def do_GET(self):
+        self.send_response(200)
+        self.send_header("Content-Type", "application/json")
+        self.send_header("Content-Length", str(len(BODY)))
+        self.end_headers()
+        self.wfile.write(BODY)
+
+    def log_message(self, *args):
+        pass
+
+
+class Server(http.server.ThreadingHTTPServer):
+    request_queue_size = 256  # the default backlog of 5 drops bursts of concurrent connects
+    daemon_threads = True
+
+
+def main():
+    port = int(sys.argv[1]) if len(sys.argv) > 1 else 8443
+    workdir = tempfile.mkdtemp()
+    cert = os.path.join(workdir, "cert.pem")
+    key = os.path.join(workdir, "key.pem")
+    subprocess.run(["openssl", "req", "-x509", "-newkey", "rsa:2048", "-nodes",
+                    "-keyout", key, "-out", cert, "-days", "1", "-subj", "/CN=localhost"],
+                   check=True, capture_output=True)
+
+    server = Server(("127.0.0.1", port), Handler)
+    context = ssl.SSLContext(ssl.PROTOCOL_TLS_SERVER)
+    context.load_cert_chain(cert, key)
+    server.socket = context.wrap_socket(server.socket, server_side=True)
+    print(f"Serving https://127.0.0.1:{port}/messages")
+    server.serve_forever()
+
+
+if __name__ == "__main__":
+    main()
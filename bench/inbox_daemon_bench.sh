@@ -0,0 +1,29 @@
+#!/bin/bash
+# Measures inbox_daemon throughput and peak RSS against the local mock API.
+# Usage: bench/inbox_daemon_bench.sh <path-to-inbox_daemon> [accounts] [seconds] [workers]
+# The mock_mail_server benchmark is expected next to inbox_daemon.
+set -e
+
+DAEMON=${1:?path to inbox_daemon}
+MOCK="$(dirname "$DAEMON")/mock_mail_server"
+ACCOUNTS=${2:-5000}
+SECONDS_TO_RUN=${3:-60}
+WORKERS=${4:-4}
+PORT=18080
+WORKDIR=$(mktemp -d)
+
+# Start the mock API with 50 new messages per second spread over all accounts
+"$MOCK" $PORT 50 > "$WORKDIR/mock.log" 2>&1 &
+MOCK_PID=$!
+trap 'kill $MOCK_PID 2>/dev/null; rm -rf "$WORKDIR"' EXIT
+sleep 1
+
+# Generate the credential list
+for i in $(seq 1 "$ACCOUNTS"); do
+    echo "bench$i@example.com password$i"
+done > "$WORKDIR/credentials.txt"
+
+"$DAEMON" "$WORKDIR/credentials.txt" --base-url "http://127.0.0.1:$PORT" --workers "$WORKERS" \
+    --duration "$SECONDS_TO_RUN" --output "$WORKDIR/messages.ndjson"
+
+echo "emitted_lines=$(wc -l < "$WORKDIR/messages.ndjson")"
@@ -0,0 +1,84 @@
+#include "JsonParser.h"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace MailTMAPI;
+
+// Reads a whole payload file into memory
+static std::string readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Failed to open payload: " + path);
+    }
+    std::ostringstream contents;
+    contents << in.rdbuf();
+    return contents.str();
+}
+
+// Runs the given parse function and prints documents and megabytes per second
+template <typename Func>
+static double runBenchmark(const std::string& label, const std::string& payload, int iterations, Func func) {
+    size_t checksum = 0; // Keeps the compiler from discarding the parses
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        checksum += func(payload);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    double rate = iterations / elapsed.count();
+    std::cout << "  " << label << ": " << rate << " docs/s, "
+              << rate * payload.size() / (1024.0 * 1024.0) << " MB/s (checksum " << checksum << ")" << std::endl;
+    return rate;
+}
+
+// Parse path every MailTM method used before: copy into a stream, new builder, full DOM
+static size_t parseWithStream(const std::string& payload) {
+    Json::CharReaderBuilder reader;
+    Json::Value root;
+    std::string errors;
+    std::istringstream stream(payload);
+    return Json::parseFromStream(reader, stream, &root, &errors) ? root.size() : 0;
+}
+
+// Parse path used now for endpoints that need the DOM
+static size_t parseInPlace(const std::string& payload) {
+    Json::Value root;
+    return JsonParser::local().parse(payload, root) ? root.size() : 0;
+}
+
+// Benchmark comparing JSON parse paths on mail.tm responses.
+// Run from the repository root, or pass the payload directory:
+//   json_parse_bench bench/payloads 20000
+int main(int argc, char* argv[]) {
+    std::string directory = argc > 1 ? argv[1] : "bench/payloads";
+    int iterations = argc > 2 ? std::stoi(argv[2]) : 20000;
+
+    try {
+        // Endpoints whose callers only need one field: /token and /me
+        for (const auto& [file, field] : {std::pair<const char*, const char*>{"token.json", "token"}, {"me.json", "id"}}) {
+            std::string payload = readFile(directory + "/" + file);
+            std::cout << file << " (" << payload.size() << " bytes)" << std::endl;
+            double before = runBenchmark("istringstream + parseFromStream", payload, iterations, parseWithStream);
+            runBenchmark("reused CharReader", payload, iterations, parseInPlace);
+            double after = runBenchmark("field scan", payload, iterations, [&](const std::string& text) {
+                return JsonParser::findString(text, field).value_or("").size();
+            });
+            std::cout << "  speedup: " << after / before << "x" << std::endl;
+        }
+
+        // Endpoints whose callers use the whole document: /messages and /messages/{id}
+        for (const char* file : {"messages.json", "message.json"}) {
+            std::string payload = readFile(directory + "/" + file);
+            std::cout << file << " (" << payload.size() << " bytes)" << std::endl;
+            double before = runBenchmark("istringstream + parseFromStream", payload, iterations, parseWithStream);
+            double after = runBenchmark("reused CharReader", payload, iterations, parseInPlace);
+            std::cout << "  speedup: " << after / before << "x" << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,148 @@
+#include "MailTM.h"
+#include "MockMailServer.h"
+#include "RequestMetrics.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace MailTMAPI;
+
+// Latencies of one operation, in microseconds
+struct OperationStats {
+    std::vector<double> latencies;
+    size_t failures = 0;
+
+    // Times one call; the call returns whether it succeeded
+    template <typename Func>
+    bool time(Func func) {
+        auto start = std::chrono::steady_clock::now();
+        bool succeeded = func();
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+        latencies.push_back(elapsed.count());
+        failures += succeeded ? 0 : 1;
+        return succeeded;
+    }
+
+    void merge(const OperationStats& other) {
+        latencies.insert(latencies.end(), other.latencies.begin(), other.latencies.end());
+        failures += other.failures;
+    }
+};
+
+// Prints one row of the percentile table
+static void printRow(const std::string& label, OperationStats& stats) {
+    auto& latencies = stats.latencies;
+    if (latencies.empty()) {
+        return;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) { return latencies[std::min(latencies.size() - 1, size_t(p * latencies.size()))] / 1000; };
+    std::cout << std::left << std::setw(10) << label << std::right << std::setw(9) << latencies.size() << std::setw(9)
+              << stats.failures << std::fixed << std::setprecision(2) << std::setw(9) << percentile(0.5) << std::setw(9)
+              << percentile(0.9) << std::setw(9) << percentile(0.99) << std::setw(9) << percentile(0.999) << std::setw(9)
+              << latencies.back() / 1000 << std::endl;
+}
+
+// Benchmark driving register, authenticate, poll and fetch against the in-process mock API.
+// Usage: mail_tm_bench [accounts] [threads] [latency-ms] [error-rate] [inbox-size]
+int main(int argc, char* argv[]) {
+    size_t accounts = argc > 1 ? std::stoul(argv[1]) : 500;
+    size_t threads = argc > 2 ? std::stoul(argv[2]) : 16;
+    MockServerOptions options;
+    options.latency = std::chrono::microseconds(static_cast<long>((argc > 3 ? std::stod(argv[3]) : 2.0) * 1000));
+    options.latencyJitter = options.latency / 2;
+    options.errorRate = argc > 4 ? std::stod(argv[4]) : 0.0;
+    options.inboxSize = argc > 5 ? std::stoul(argv[5]) : 30;
+    const int pollsPerAccount = 3;
+    const size_t fetchesPerAccount = 5;
+
+    MockMailServer server(options);
+    std::cout << "Mock API at " << server.url() << ": " << accounts << " accounts, " << threads << " threads, "
+              << options.latency.count() / 1000.0 << " ms latency, " << options.errorRate * 100 << "% errors, "
+              << options.inboxSize << " messages per inbox" << std::endl;
+
+    // Each thread works through its share of the accounts with its own client, like the daemon's workers
+    std::vector<OperationStats> registers(threads), logins(threads), polls(threads), fetches(threads);
+    auto metrics = std::make_shared<RequestMetrics>(); // What the clients saw on the wire, shared by all threads
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            MailTM client(server.url());
+            client.setMetrics(metrics);
+            for (size_t i = t; i < accounts; i += threads) {
+                std::string address = "bench" + std::to_string(i) + "@" + options.domain;
+                if (!registers[t].time([&]() { return client.registerEmail(address, "password").has_value(); })) {
+                    continue;
+                }
+                std::optional<std::string> token;
+                if (!logins[t].time([&]() { return (token = client.authenticate(address, "password")).has_value(); })) {
+                    continue;
+                }
+                std::vector<MessageSummary> inbox;
+                for (int poll = 0; poll < pollsPerAccount; ++poll) {
+                    polls[t].time([&]() {
+                        long status = 0;
+                        inbox = client.checkInbox(*token, status);
+                        return status == 200;
+                    });
+                }
+                for (size_t m = 0; m < inbox.size() && m < fetchesPerAccount; ++m) {
+                    fetches[t].time([&]() {
+                        auto message = client.getMessage(*token, inbox[m].id);
+                        return message.has_value() && message->id == inbox[m].id;
+                    });
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    OperationStats registerTotal, loginTotal, pollTotal, fetchTotal;
+    for (size_t t = 0; t < threads; ++t) {
+        registerTotal.merge(registers[t]);
+        loginTotal.merge(logins[t]);
+        pollTotal.merge(polls[t]);
+        fetchTotal.merge(fetches[t]);
+    }
+    std::cout << std::left << std::setw(10) << "operation" << std::right << std::setw(9) << "count" << std::setw(9)
+              << "failed" << std::setw(9) << "p50 ms" << std::setw(9) << "p90 ms" << std::setw(9) << "p99 ms"
+              << std::setw(9) << "p99.9 ms" << std::setw(9) << "max ms" << std::endl;
+    printRow("register", registerTotal);
+    printRow("login", loginTotal);
+    printRow("poll", pollTotal);
+    printRow("fetch", fetchTotal);
+
+    // The same requests as seen by RequestMetrics: time on the wire versus time spent parsing
+    std::cout << std::endl << std::left << std::setw(10) << "endpoint" << std::right << std::setw(9) << "count"
+              << std::setw(11) << "ttfb p50" << std::setw(11) << "total p50" << std::setw(11) << "total p95"
+              << std::setw(11) << "total p99" << std::setw(11) << "parse p50" << "  (ms)" << std::endl;
+    for (const auto& endpoint : metrics->snapshot()) {
+        std::cout << std::left << std::setw(10) << endpoint.endpoint << std::right << std::setw(9) << endpoint.requests
+                  << std::setw(11) << endpoint.firstByte.percentile(0.5) / 1000.0 << std::setw(11)
+                  << endpoint.total.percentile(0.5) / 1000.0 << std::setw(11) << endpoint.total.percentile(0.95) / 1000.0
+                  << std::setw(11) << endpoint.total.percentile(0.99) / 1000.0 << std::setw(11)
+                  << endpoint.processing.percentile(0.5) / 1000.0 << std::endl;
+    }
+
+    // Cost of the instrumentation itself
+    LatencyHistogram histogram;
+    const size_t records = 10000000;
+    auto recordStart = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < records; ++i) {
+        histogram.record(i & 0xFFFFF);
+    }
+    std::chrono::duration<double, std::nano> recordTime = std::chrono::steady_clock::now() - recordStart;
+    std::cout << "LatencyHistogram::record: " << recordTime.count() / records << " ns per value" << std::endl << std::endl;
+
+    std::cout << server.requestCount() << " requests in " << elapsed.count() << " s ("
+              << server.requestCount() / elapsed.count() << " requests/s)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include "JsonParser.h"
+#include "MessageStore.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace MailTMAPI;
+
+// Builds a message shaped like a typical mail.tm notification
+static Message makeMessage(size_t i) {
+    Message message;
+    message.id = "664f" + std::to_string(1000000 + i);
+    message.createdAt = "2024-05-20T10:" + std::to_string(10 + i / 60000 % 50) + ":00+00:00";
+    message.subject = "Your verification code " + std::to_string(i);
+    message.intro = "Use the code below to finish signing in";
+    message.from.address = InternedString("noreply@example.com");
+    message.to.push_back(Address{InternedString("me@example.com"), InternedString("")});
+    message.text = std::string(600, 'x') + " " + std::to_string(i);
+    message.html = "<p>" + message.text + "</p>";
+    return message;
+}
+
+// Loads every message the way a store without an index would: read and parse the whole log
+static size_t scanLog(const std::filesystem::path& path, std::vector<Message>& messages) {
+    std::ifstream in(path, std::ios::binary);
+    std::string payload;
+    uint32_t header[3];
+    Json::Value json;
+    while (in.read(reinterpret_cast<char*>(header), sizeof(header))) {
+        payload.resize(header[1]);
+        in.read(payload.data(), payload.size());
+        if (!JsonParser::local().parse(payload, json)) {
+            break;
+        }
+        messages.push_back(Message::fromJson(json));
+    }
+    return messages.size();
+}
+
+// Prints the milliseconds a step took
+template <typename Func>
+static double timed(const std::string& label, Func func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "  " << label << ": " << elapsed.count() << " ms" << std::endl;
+    return elapsed.count();
+}
+
+int main(int argc, char* argv[]) {
+    size_t total = argc > 1 ? std::stoul(argv[1]) : 100000;
+    std::filesystem::path root = std::filesystem::temp_directory_path() / "message_store_bench";
+    const std::string address = "bench@example.com";
+    std::filesystem::remove_all(root);
+
+    std::cout << "Writing " << total << " messages in batches of 100" << std::endl;
+    timed("append", [&]() {
+        MessageStore store;
+        if (!store.open(root.string(), address)) {
+            std::exit(1);
+        }
+        std::vector<Message> batch;
+        for (size_t i = 0; i < total; ++i) {
+            batch.push_back(makeMessage(i));
+            if (batch.size() == 100 || i + 1 == total) {
+                store.append(batch);
+                batch.clear();
+            }
+        }
+    });
+    std::cout << "  log size: " << std::filesystem::file_size(root / address / "messages.log") / (1024 * 1024)
+              << " MB" << std::endl;
+
+    std::cout << "Cold start: watermark and the 20 newest messages" << std::endl;
+    double indexed = timed("mapped index", [&]() {
+        MessageStore store;
+        store.open(root.string(), address);
+        InboxCursor cursor = store.cursor();
+        auto latest = store.latest(20);
+        std::cout << "    " << store.size() << " messages, newest " << cursor.createdAt << ", read " << latest.size()
+                  << std::endl;
+    });
+    double scanned = timed("full log scan", [&]() {
+        std::vector<Message> messages;
+        scanLog(root / address / "messages.log", messages);
+        std::string newest;
+        for (const auto& message : messages) {
+            newest = std::max(newest, message.createdAt);
+        }
+        std::cout << "    " << messages.size() << " messages, newest " << newest << std::endl;
+    });
+    std::cout << "Speedup: " << scanned / indexed << "x" << std::endl;
+
+    std::filesystem::remove_all(root);
+    return 0;
+}
@@ -0,0 +1,51 @@
+#include "MockMailServer.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace MailTMAPI;
+
+static std::atomic<bool> stopRequested(false); // Set by SIGINT/SIGTERM
+
+// Signal handler that asks the delivery loop to exit
+static void handleSignal(int) {
+    stopRequested = true;
+}
+
+// Stand-alone MockMailServer for load tests of separate processes such as inbox_daemon.
+// Any address at example.com logs in with any password; new mail arrives at random accounts every second.
+// Usage: mock_mail_server [port] [messages-per-second]
+int main(int argc, char* argv[]) {
+    MockServerOptions options;
+    options.port = static_cast<uint16_t>(argc > 1 ? std::stoul(argv[1]) : 8080);
+    options.openLogin = true;
+    size_t arrivalRate = argc > 2 ? std::stoul(argv[2]) : 10;
+
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+
+    MockMailServer server(options);
+    std::cout << "Serving mock mail.tm API on " << server.url() << std::endl;
+
+    std::mt19937 rng(options.seed);
+    uint64_t delivered = 0;
+    while (!stopRequested) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        std::vector<std::string> addresses = server.addresses();
+        std::shuffle(addresses.begin(), addresses.end(), rng);
+        addresses.resize(std::min(addresses.size(), arrivalRate));
+        for (const auto& address : addresses) {
+            ++delivered;
+            server.deliver(address, "Message " + std::to_string(delivered),
+                           "Your verification code is 123456. Visit https://example.com/confirm");
+        }
+    }
+    std::cout << "Delivered " << delivered << " messages, answered " << server.requestCount() << " requests" << std::endl;
+    return 0;
+}
@@ -0,0 +1,118 @@
+#include "SearchIndex.h"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace MailTMAPI;
+
+// Builds a vocabulary of made-up words
+static std::vector<std::string> makeVocabulary(size_t size, std::mt19937& rng) {
+    std::vector<std::string> words;
+    for (size_t i = 0; i < size; ++i) {
+        std::string word;
+        size_t length = 3 + rng() % 8;
+        for (size_t j = 0; j < length; ++j) {
+            word += static_cast<char>('a' + rng() % 26);
+        }
+        words.push_back(word);
+    }
+    return words;
+}
+
+// Picks a word, common words far more often than rare ones
+static const std::string& pickWord(const std::vector<std::string>& vocabulary, std::mt19937& rng) {
+    double x = std::uniform_real_distribution<double>(0, 1)(rng);
+    return vocabulary[static_cast<size_t>(x * x * x * (vocabulary.size() - 1))];
+}
+
+// Runs queries and prints the mean and worst latency in microseconds
+static void runQueries(const std::string& label, const SearchIndex& index, const std::vector<SearchQuery>& queries) {
+    std::vector<double> latencies;
+    size_t hits = 0;
+    for (const auto& query : queries) {
+        auto start = std::chrono::steady_clock::now();
+        hits += index.search(query).size();
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+        latencies.push_back(elapsed.count());
+    }
+    std::sort(latencies.begin(), latencies.end());
+    double total = 0;
+    for (double latency : latencies) {
+        total += latency;
+    }
+    std::cout << "  " << label << ": mean " << total / latencies.size() << " us, p99 "
+              << latencies[latencies.size() * 99 / 100] << " us, max " << latencies.back() << " us ("
+              << hits / queries.size() << " hits per query)" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t total = argc > 1 ? std::stoul(argv[1]) : 1000000;
+    size_t queryCount = 1000;
+    std::mt19937 rng(42);
+    std::vector<std::string> vocabulary = makeVocabulary(50000, rng);
+    std::vector<std::string> codes;
+
+    SearchIndex index;
+    std::chrono::duration<double> elapsed{0}; // Time spent in add(), not in making up messages
+    for (size_t i = 0; i < total; ++i) {
+        Message message;
+        message.id = "664f" + std::to_string(1000000 + i);
+        message.from.address = InternedString("user" + std::to_string(rng() % 2000) + "@domain" +
+                                              std::to_string(rng() % 200) + ".com");
+        for (int w = 0; w < 5; ++w) {
+            message.subject += pickWord(vocabulary, rng) + " ";
+        }
+        std::string code = std::to_string(100000 + rng() % 900000);
+        message.text = "Your code is " + code + ".";
+        for (int w = 0; w < 30; ++w) {
+            message.text += " " + pickWord(vocabulary, rng);
+        }
+        if (i % 10 == 0) { // Some senders only send HTML
+            message.html = "<p>Click <a href=\"https://example.com/verify?token=" + code + "\">here</a></p>";
+        }
+        if (i % (total / queryCount + 1) == 0) {
+            codes.push_back(code);
+        }
+        auto start = std::chrono::steady_clock::now();
+        index.add(message);
+        elapsed += std::chrono::steady_clock::now() - start;
+    }
+    std::cout << "Indexed " << index.size() << " messages in " << elapsed.count() << " s ("
+              << index.size() / elapsed.count() << " messages/s)" << std::endl;
+
+    std::cout << "Queries, 100 results at most:" << std::endl;
+    std::vector<SearchQuery> queries;
+    for (const auto& code : codes) {
+        queries.push_back(SearchQuery::parse(code));
+    }
+    runQueries("verification code", index, queries);
+
+    queries.clear();
+    for (size_t i = 0; i < queryCount; ++i) {
+        queries.push_back(SearchQuery::parse(pickWord(vocabulary, rng)));
+    }
+    runQueries("one word", index, queries);
+
+    queries.clear();
+    for (size_t i = 0; i < queryCount; ++i) {
+        queries.push_back(SearchQuery::parse(pickWord(vocabulary, rng) + " " + pickWord(vocabulary, rng)));
+    }
+    runQueries("two words", index, queries);
+
+    queries.clear();
+    for (size_t i = 0; i < queryCount; ++i) {
+        queries.push_back(SearchQuery::parse(vocabulary[rng() % vocabulary.size()].substr(0, 5) + "*"));
+    }
+    runQueries("five-letter prefix", index, queries);
+
+    queries.clear();
+    for (size_t i = 0; i < queryCount; ++i) {
+        queries.push_back(SearchQuery::parse("code from:@domain" + std::to_string(rng() % 200) + ".com"));
+    }
+    runQueries("word and sender domain", index, queries);
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include "TextLayout.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace MailTMAPI;
+
+// Builds a message body of the given number of words with a link every 40 words
+static std::string makeBody(int words) {
+    static const std::vector<std::string> vocabulary = {"your", "verification", "code", "is", "482913", "please",
+                                                        "enter", "it", "within", "ten", "minutes", "to", "continue"};
+    std::string body;
+    for (int i = 0; i < words; ++i) {
+        body += i % 40 == 39 ? "https://example.com/confirm?token=abc" : vocabulary[i % vocabulary.size()];
+        body += ' ';
+    }
+    return body;
+}
+
+// Wrapping as drawMessages did it before: every word re-measures the whole line built so far
+static size_t wrapEveryFrame(const std::string& body, const GlyphAdvances& advances, float maxWidth) {
+    size_t lines = 1;
+    std::string currentLine;
+    for (const auto& word : TextLayout::splitWords(body)) {
+        if (advances.measure(currentLine + " " + word) > maxWidth && !currentLine.empty()) {
+            lines++;
+            currentLine = word;
+        } else {
+            if (!currentLine.empty()) currentLine += " ";
+            currentLine += word;
+        }
+    }
+    return lines;
+}
+
+// Runs one frame function repeatedly and returns the average time per frame in microseconds
+template <typename Func>
+static double timePerFrame(int frames, Func func) {
+    size_t checksum = 0; // Keeps the compiler from discarding the work
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; ++i) {
+        checksum += func();
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    if (checksum == 0) {
+        std::cerr << "unexpected empty layout" << std::endl;
+    }
+    return elapsed.count() / frames;
+}
+
+// Benchmark of the per-frame text work of drawMessages for growing message lengths.
+// Glyph advances come from a fixed table so the benchmark runs without a display or font:
+//   text_layout_bench 200
+int main(int argc, char* argv[]) {
+    int frames = argc > 1 ? std::stoi(argv[1]) : 200;
+    GlyphAdvances advances([](char32_t codePoint) { return codePoint == ' ' ? 4.0f : 8.0f; });
+    LayoutOptions options;
+    options.maxWidth = 720;
+    options.lineHeight = 20;
+
+    std::cout << "words, relayout per frame (us), cached layout per frame (us)" << std::endl;
+    for (int words : {50, 500, 2000, 8000}) {
+        std::string body = makeBody(words);
+
+        // Before: the body is wrapped again on every frame
+        double before = timePerFrame(frames, [&]() { return wrapEveryFrame(body, advances, options.maxWidth); });
+
+        // After: laid out once, each frame only walks the cached runs to position them
+        LayoutResult cached = TextLayout::layout(body, advances, options);
+        double after = timePerFrame(frames, [&]() {
+            size_t positioned = 0;
+            for (const auto& run : cached.runs) {
+                positioned += run.y >= 0;
+            }
+            return positioned;
+        });
+        std::cout << words << ", " << before << ", " << after << std::endl;
+    }
+    return 0;
+}
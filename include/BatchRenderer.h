@@ -0,0 +1,123 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <initializer_list>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @class BatchRenderer
+ * @brief Collects the rectangles and glyphs of a frame and submits them in a few draw calls.
+ *
+ * Text is built from the font's glyph atlas, one texture per character
+ * size, instead of one sf::Text per string. Everything added to a layer
+ * goes into one vertex array for rectangles and one per character size
+ * for glyphs, so a layer costs one draw call per array however many
+ * strings and boxes it holds. Within a layer, rectangles are drawn below
+ * text; layers are drawn in the order they were started.
+ */
+class BatchRenderer {
+private:
+    /**
+     * @struct Layer
+     * @brief The geometry of one layer.
+     */
+    struct Layer {
+        std::vector<sf::Vertex> shapes; /**< Untextured triangles of rectangles. */
+        std::map<unsigned int, std::vector<sf::Vertex>> glyphs; /**< Textured triangles per character size. */
+    };
+
+    const sf::Font& font; /**< The font whose atlas the glyphs come from. */
+    std::vector<Layer> layers; /**< Layers of the current frame; kept between frames to reuse their memory. */
+    size_t activeLayers; /**< How many of the layers are in use this frame. */
+    size_t drawCalls; /**< Draw calls issued by the last flush. */
+
+public:
+    /**
+     * @brief Constructs a renderer with one empty layer.
+     * @param font The font to draw text with; must outlive the renderer.
+     */
+    explicit BatchRenderer(const sf::Font& font);
+
+    /**
+     * @brief Loads the printable ASCII glyphs of the given sizes into the atlas.
+     *
+     * Call after the font is loaded so the atlas does not grow mid-frame.
+     * @param sizes The character sizes the interface uses.
+     */
+    void preload(std::initializer_list<unsigned int> sizes);
+
+    /**
+     * @brief Starts a new layer drawn above everything added before.
+     */
+    void beginLayer();
+
+    /**
+     * @brief Adds a filled rectangle to the current layer.
+     * @param x The left edge.
+     * @param y The top edge.
+     * @param width The width.
+     * @param height The height.
+     * @param fill The fill color.
+     * @param outlineThickness Width of an outline drawn outside the rectangle, 0 for none.
+     * @param outlineColor The outline color.
+     */
+    void addRect(float x, float y, float width, float height, const sf::Color& fill, float outlineThickness = 0,
+                 const sf::Color& outlineColor = sf::Color::Transparent);
+
+    /**
+     * @brief Adds a line of text to the current layer.
+     * @param text The UTF-8 text.
+     * @param fontSize The character size.
+     * @param x The left edge.
+     * @param y The top edge, as with sf::Text.
+     * @param color The text color.
+     * @return The advance width of the text.
+     */
+    float addText(const std::string& text, unsigned int fontSize, float x, float y, const sf::Color& color);
+
+    /**
+     * @brief Adds prebuilt glyph vertices, e.g. from buildText, to the current layer.
+     * @param vertices Vertices relative to the top-left corner of the text.
+     * @param fontSize The character size they were built with.
+     * @param x The left edge to draw them at.
+     * @param y The top edge to draw them at.
+     */
+    void addVertices(const std::vector<sf::Vertex>& vertices, unsigned int fontSize, float x, float y);
+
+    /**
+     * @brief Draws every layer of the frame and empties them.
+     * @param target The render target.
+     */
+    void flush(sf::RenderTarget& target);
+
+    /**
+     * @brief Gets the number of draw calls the last flush issued.
+     * @return The number of draw calls.
+     */
+    size_t getDrawCalls() const;
+
+    /**
+     * @brief Measures a line of text from the atlas.
+     * @param font The font.
+     * @param text The UTF-8 text.
+     * @param fontSize The character size.
+     * @return The advance width of the text.
+     */
+    static float measureText(const sf::Font& font, const std::string& text, unsigned int fontSize);
+
+    /**
+     * @brief Builds the glyph quads of a line of text, the way sf::Text lays it out.
+     * @param font The font.
+     * @param text The UTF-8 text.
+     * @param fontSize The character size.
+     * @param color The text color.
+     * @param underlined True to add an underline.
+     * @param x The left edge.
+     * @param y The top edge.
+     * @param out Receives two triangles per glyph.
+     * @return The advance width of the text.
+     */
+    static float buildText(const sf::Font& font, const std::string& text, unsigned int fontSize, const sf::Color& color,
+                           bool underlined, float x, float y, std::vector<sf::Vertex>& out);
+};
@@ -0,0 +1,111 @@
+#pragma once
+#include "CurlWrapper.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file CurlMulti.h
+ * @brief Provides an event loop that runs many CURL transfers concurrently.
+ */
+
+namespace MailTMAPI {
+
+/**
+ * @class CurlMulti
+ * @brief A single-threaded event loop on top of curl_multi.
+ *
+ * Prepared CurlWrapper handles are submitted from any thread and driven
+ * together by one background thread. When a transfer finishes, its
+ * completion callback runs on the event loop thread and receives the handle
+ * back, so it can read the response code and return the handle to a pool.
+ */
+class CurlMulti {
+public:
+    /**
+     * @brief Callback invoked on the event loop thread when a transfer completes.
+     *
+     * The second argument is CURLE_OK on success, or the transfer error.
+     * Transfers still pending when the loop shuts down complete with
+     * CURLE_ABORTED_BY_CALLBACK.
+     */
+    using CompletionCallback = std::function<void(std::unique_ptr<CurlWrapper>, CURLcode)>;
+
+private:
+    /**
+     * @struct Transfer
+     * @brief A submitted handle and the callback to run when it completes.
+     */
+    struct Transfer {
+        std::unique_ptr<CurlWrapper> handle;
+        CompletionCallback onDone;
+    };
+
+    CURLM* multi; /**< The CURL multi handle driving all transfers. */
+    std::thread loop; /**< The event loop thread. */
+    std::atomic<bool> running; /**< Set to false to stop the event loop. */
+
+    std::mutex pendingMutex; /**< Protects the pending list. */
+    std::vector<Transfer> pending; /**< Submitted transfers not yet added to the multi handle. */
+    std::unordered_map<CURL*, Transfer> active; /**< Transfers owned by the event loop thread. */
+    std::atomic<size_t> inFlight; /**< Number of submitted transfers not yet completed. */
+
+    /**
+     * @brief Event loop body: adds pending transfers, drives I/O and dispatches completions.
+     */
+    void run();
+
+    /**
+     * @brief Moves pending transfers into the multi handle.
+     */
+    void addPending();
+
+    /**
+     * @brief Removes a transfer from the multi handle and invokes its callback.
+     * @param easy The finished easy handle.
+     * @param result The transfer result.
+     */
+    void complete(CURL* easy, CURLcode result);
+
+public:
+    /**
+     * @brief Creates the multi handle and starts the event loop thread.
+     * @param maxConnections Upper bound on open connections (0 means no limit).
+     * @throws std::runtime_error if the multi handle cannot be created.
+     */
+    explicit CurlMulti(long maxConnections = 0);
+
+    /**
+     * @brief Stops the event loop and aborts any transfers still in flight.
+     */
+    ~CurlMulti();
+
+    /**
+     * @brief Submits a prepared handle for asynchronous execution.
+     * @param handle The configured handle; ownership passes to the event loop.
+     * @param onDone Callback invoked on the event loop thread on completion.
+     */
+    void submit(std::unique_ptr<CurlWrapper> handle, CompletionCallback onDone);
+
+    /**
+     * @brief Gets the number of transfers submitted but not yet completed.
+     * @return The in-flight transfer count.
+     */
+    size_t getInFlight() const;
+
+    /**
+     * @brief Checks whether the caller is the event loop thread, i.e. runs inside a completion callback.
+     * @return True on the event loop thread.
+     */
+    bool isLoopThread() const;
+
+    // Disable copy semantics
+    CurlMulti(const CurlMulti&) = delete;
+    CurlMulti& operator=(const CurlMulti&) = delete;
+};
+
+} // namespace MailTMAPI
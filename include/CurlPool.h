@@ -0,0 +1,64 @@
+#pragma once
+#include "CurlWrapper.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @file CurlPool.h
+ * @brief Provides a pool of reusable CURL handles that share their caches.
+ */
+
+namespace MailTMAPI {
+
+/**
+ * @class CurlPool
+ * @brief A small pool of keep-alive CurlWrapper handles.
+ *
+ * Every handle handed out by the pool is attached to one CURL share handle,
+ * so open connections, resolved hosts and TLS sessions are reused across
+ * requests and across threads instead of paying a new handshake per call.
+ */
+class CurlPool {
+private:
+    CURLSH* share; /**< Share handle holding the DNS, TLS session and connection caches. */
+    std::mutex shareLocks[CURL_LOCK_DATA_LAST]; /**< One lock per shared data kind. */
+
+    std::mutex poolMutex; /**< Protects the idle handle list. */
+    std::vector<std::unique_ptr<CurlWrapper>> idle; /**< Handles ready to be reused. */
+    size_t maxIdle; /**< Maximum number of idle handles kept around. */
+
+    static void lockShare(CURL* handle, curl_lock_data data, curl_lock_access access, void* userp);
+    static void unlockShare(CURL* handle, curl_lock_data data, void* userp);
+
+public:
+    /**
+     * @brief Constructs a pool and its share handle.
+     * @param maxIdle Maximum number of idle handles kept for reuse.
+     * @throws std::runtime_error if the share handle cannot be created.
+     */
+    explicit CurlPool(size_t maxIdle = 8);
+
+    /**
+     * @brief Destroys the idle handles and the share handle.
+     */
+    ~CurlPool();
+
+    /**
+     * @brief Takes a handle from the pool, creating one if none is idle.
+     * @return A reset handle attached to the pool's share handle.
+     */
+    std::unique_ptr<CurlWrapper> acquire();
+
+    /**
+     * @brief Returns a handle to the pool so its connection can be reused.
+     * @param handle The handle previously obtained from acquire().
+     */
+    void release(std::unique_ptr<CurlWrapper> handle);
+
+    // Disable copy semantics
+    CurlPool(const CurlPool&) = delete;
+    CurlPool& operator=(const CurlPool&) = delete;
+};
+
+} // namespace MailTMAPI
@@ -1,5 +1,6 @@
 #pragma once
 #include <curl/curl.h>
+#include <cstdint>
 #include <string>
 #include <stdexcept>
 
@@ -10,6 +11,24 @@
 
 namespace MailTMAPI {
 
+/**
+ * @struct RequestTiming
+ * @brief Where the time of a finished request went, as reported by CURL.
+ *
+ * Phases are durations, not the cumulative times CURL reports, so they add
+ * up to firstByte plus the time spent sending the request and waiting.
+ */
+struct RequestTiming {
+    uint64_t dnsMicros = 0; /**< Name resolution. */
+    uint64_t connectMicros = 0; /**< TCP connect after resolution; 0 on a reused connection. */
+    uint64_t tlsMicros = 0; /**< TLS handshake after connecting; 0 for plain HTTP or a reused connection. */
+    uint64_t firstByteMicros = 0; /**< From the start until the first response byte. */
+    uint64_t totalMicros = 0; /**< The whole transfer. */
+    uint64_t bytesSent = 0; /**< Request headers and body. */
+    uint64_t bytesReceived = 0; /**< Response headers and body. */
+    long status = 0; /**< HTTP status, 0 if no response arrived. */
+};
+
 /**
  * @class CurlWrapper
  * @brief A wrapper for CURL to simplify HTTP requests.
@@ -21,6 +40,12 @@ class CurlWrapper {
 private:
     CURL* curl; /**< Pointer to the CURL instance. */
     struct curl_slist* headers; /**< Linked list of custom headers. */
+    CURLSH* share; /**< Optional share handle for DNS, TLS session and connection caches. */
+
+    /**
+     * @brief Applies the options every request starts from (share handle, keep-alive, DNS cache).
+     */
+    void applyDefaults();
 
 public:
     /**
@@ -29,6 +54,13 @@ public:
      */
     CurlWrapper();
 
+    /**
+     * @brief Constructs a CurlWrapper attached to a CURL share handle.
+     * @param share The share handle whose caches this handle should use (may be nullptr).
+     * @throws std::runtime_error if CURL initialization fails.
+     */
+    explicit CurlWrapper(CURLSH* share);
+
     /**
      * @brief Destructor to clean up CURL resources.
      */
@@ -50,6 +82,22 @@ public:
      */
     void setOption(CURLoption option, size_t (*value)(void*, size_t, size_t, void*));
 
+    /**
+     * @brief Sets a CURL option for transfer progress callbacks.
+     * @param option The CURL option to set (CURLOPT_XFERINFOFUNCTION).
+     * @param value The progress function; returning non-zero aborts the transfer.
+     * @throws std::runtime_error if the option cannot be set.
+     */
+    void setOption(CURLoption option, int (*value)(void*, curl_off_t, curl_off_t, curl_off_t, curl_off_t));
+
+    /**
+     * @brief Sets a CURL option that takes a long value.
+     * @param option The CURL option to set.
+     * @param value The value for the option.
+     * @throws std::runtime_error if the option cannot be set.
+     */
+    void setOption(CURLoption option, long value);
+
     /**
      * @brief Adds a custom header to the HTTP request.
      * @param header The header string (e.g., "Content-Type: application/json").
@@ -62,18 +110,45 @@ public:
      */
     void clearHeaders();
 
+    /**
+     * @brief Resets the handle so it can be reused for a new request.
+     *
+     * Clears headers, method and per-request options while keeping the live
+     * connections, DNS cache and TLS session cache of the underlying handle.
+     */
+    void reset();
+
+    /**
+     * @brief Applies pending headers without performing the request.
+     *
+     * Used when the handle is driven by a CurlMulti event loop instead of perform().
+     */
+    void prepare();
+
     /**
      * @brief Executes the HTTP request.
      * @return CURLcode indicating the result of the request.
      */
     CURLcode perform();
 
+    /**
+     * @brief Gets the underlying CURL easy handle.
+     * @return The raw CURL handle.
+     */
+    CURL* getHandle() const;
+
     /**
      * @brief Gets the HTTP response code.
      * @return The HTTP response code.
      */
     long getResponseCode();
 
+    /**
+     * @brief Gets the timing breakdown, sizes and status of the last request.
+     * @return The timing; all zero before the first request.
+     */
+    RequestTiming getTiming() const;
+
     /**
      * @brief Gets the effective URL from the response.
      * @return The effective URL as a string.
@@ -1,16 +1,31 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include "MailTM.h"
+#include "PollScheduler.h"
+#include "BatchRenderer.h"
+#include "FrameProfiler.h"
+#include "LayoutCache.h"
+#include "MpscQueue.h"
+#include "RenderModel.h"
+#include "SearchIndex.h"
+#include "VirtualList.h"
 #include <queue>
 #include <mutex>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <unordered_map>
 
 class EmailClientGUI {
 private:
     sf::RenderWindow window;
+    MailTMAPI::SearchIndex searchIndex; // Filled by mailTm as messages are fetched, so it must outlive it
     MailTMAPI::MailTM mailTm;
 
     // Resources
     sf::Font font;
+    LayoutCache layoutCache; // Laid-out message text, reused across frames
+    BatchRenderer batch; // Collects the frame's shapes and glyphs into a few draw calls
 
     // Email data
     std::string email;
@@ -19,23 +34,59 @@ private:
     bool isEmailGenerated;
 
     // Message handling
-    std::vector<Json::Value> messages;
-    std::mutex messagesMutex;
+    static constexpr float messageHeight = 120; // Height of a message box in the list
+    static constexpr float messageSpacing = 10; // Gap between message boxes
+    struct MessageBatch {
+        std::string inbox; // Address the messages were fetched for
+        std::vector<MailTMAPI::RenderModel> messages; // Prepared on the fetch thread
+    };
+    std::vector<MailTMAPI::RenderModel> messages; // Only touched by the render loop
+    MailTMAPI::VirtualList messageRows; // Row geometry of the shown messages
+    std::vector<size_t> shownMessages; // Index in messages of each row: all of them, or the search results
+    std::unordered_map<std::string, size_t> messageIndexById; // Maps search results back to messages
+    MailTMAPI::MpscQueue<MessageBatch> incomingMessages; // Finished batches from the inbox thread, never blocks either side
     float scrollOffset;
+    MailTMAPI::PollScheduler pollScheduler; // Decides when the inbox is polled
+    static constexpr int maxFetchAttempts = 5; // Polls a failing message fetch is retried on before it is dropped
+    std::atomic<bool> inboxActive; // Cleared to stop the push stream of the current inbox
+    std::mutex inboxMutex; // Orders adding the polled inbox against deleting it
+    uint64_t inboxGeneration = 0; // Bumped for every new or deleted account; guarded by inboxMutex
+
+    // Redraw handling
+    static constexpr std::chrono::milliseconds idleEventInterval{16}; // How often an idle window looks for input
+    std::atomic<bool> needsRedraw; // Set when something visible changed since the last frame
+    std::mutex redrawMutex;
+    std::condition_variable redrawCondition; // Wakes the idle loop when another thread invalidates the view
+
+    // Profiling
+    MailTMAPI::FrameProfiler profiler; // Times the phases of each frame
+    bool showProfiler; // F3 toggles the timing overlay; F4 starts and stops a trace
 
     // GUI elements
     sf::Text inputPrompt;
     std::string inputBuffer;
     bool isGenerating;
 
+    // Search
+    static constexpr size_t maxSearchResults = 1000; // Rows shown for a search, newest matches first
+    std::string searchText;
+    bool isSearchActive; // True while the search box has keyboard focus
+
     // Private methods
     void drawMainInterface();
     void drawMessages();
-    void checkInboxThread();
+    void checkInboxThread(std::string address, std::string accountPassword, std::string streamAccountId,
+                          uint64_t generation);
     void generateEmail();
     void handleMouseClick(int x, int y);
     void handleScroll(float delta);
     void deleteAccount();
+    void invalidate();
+    bool takeIncomingMessages();
+    void applySearch();
+    void handleEvent(const sf::Event& event);
+    void drawProfilerOverlay();
+    void toggleTrace();
 
     // Add these member variables to the private section:
     bool isCustomUsername;
@@ -55,8 +106,6 @@ private:
     std::vector<ClickableLink> activeLinks;
 
     // Add these helper function declarations
-    std::string stripHtmlExceptLinks(const std::string& html);
-    std::vector<std::string> splitIntoWords(const std::string& text);
     void openUrl(const std::string& url);
 
     // Add to private section:
@@ -68,8 +117,9 @@ private:
     void closePopup();
 
     // Add to private section:
-    void drawWrappedText(const std::string& text, float x, float y, float maxWidth, unsigned int fontSize, const sf::Color& color);
-    float calculateTextHeight(const std::string& text, float maxWidth, unsigned int fontSize);
+    void drawWrappedText(const std::string& key, const std::vector<MailTMAPI::LayoutWord>& words, float x, float y, float maxWidth, unsigned int fontSize, const sf::Color& color);
+    float calculateTextHeight(const std::string& key, const std::vector<MailTMAPI::LayoutWord>& words, float maxWidth, unsigned int fontSize);
+    void drawTextBlock(LayoutCache::Block& block, float x, float y, float lineHeight);
 
 public:
     EmailClientGUI();
@@ -0,0 +1,118 @@
+#pragma once
+#include "Message.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @file Extractor.h
+ * @brief Provides extraction of verification codes and links from messages.
+ */
+
+namespace MailTMAPI {
+
+/**
+ * @struct ExtractionPattern
+ * @brief What to pull out of a message and the words that point at it.
+ */
+struct ExtractionPattern {
+    /**
+     * @enum Kind
+     * @brief The kind of value a pattern extracts.
+     */
+    enum class Kind {
+        Code, /**< A code written near one of the keywords, e.g. "Your code is 482 913". */
+        Link /**< An http(s) URL containing one of the keywords, or any URL without keywords. */
+    };
+
+    std::string name; /**< Reported with every match, e.g. "code". */
+    Kind kind = Kind::Code; /**< The kind of value. */
+    std::vector<std::string> keywords; /**< Case-insensitive literals; codes must follow or precede one as a whole word. */
+    size_t minLength = 4; /**< Shortest code, separators not counted. */
+    size_t maxLength = 8; /**< Longest code, separators not counted. */
+    bool digitsOnly = true; /**< False to also accept letters in codes; they still need a digit. */
+    size_t window = 80; /**< Bytes around a keyword searched for a code. */
+};
+
+/**
+ * @struct Extraction
+ * @brief A value found in a message.
+ */
+struct Extraction {
+    std::string pattern; /**< Name of the pattern that matched. */
+    std::string value; /**< The code without separators, or the URL. */
+    std::string messageId; /**< The message it was found in. */
+};
+
+/**
+ * @class Extractor
+ * @brief Finds codes and links in messages with patterns compiled once.
+ *
+ * The keywords of every pattern, plus "http://" and "https://", are
+ * compiled into one Aho-Corasick automaton stored as a DFA over a
+ * compressed alphabet. A message is scanned once whatever the number of
+ * patterns; each keyword hit then looks for a code in the bytes around it,
+ * and each URL is scanned again to see which link patterns it matches.
+ * An Extractor is immutable after construction and can be shared between
+ * threads.
+ */
+class Extractor {
+private:
+    /**
+     * @struct Keyword
+     * @brief A compiled keyword.
+     */
+    struct Keyword {
+        uint32_t pattern; /**< Index in patterns, or urlStart for "http://" and "https://". */
+        uint32_t length; /**< Length in bytes. */
+    };
+
+    static constexpr uint32_t urlStart = UINT32_MAX; /**< Keyword owner that marks the start of a URL. */
+
+    std::vector<ExtractionPattern> patterns; /**< The patterns in the order given. */
+    std::vector<Keyword> keywords; /**< Every compiled keyword. */
+    std::array<uint8_t, 256> byteClass{}; /**< Alphabet class of each byte; 0 for bytes in no keyword. */
+    size_t classCount = 1; /**< Number of alphabet classes. */
+    std::vector<uint32_t> transitions; /**< Next state by state and class. */
+    std::vector<std::vector<uint32_t>> outputs; /**< Keywords ending in each state, including via suffix links. */
+
+    void compile();
+    template <typename OnHit>
+    void scan(std::string_view text, OnHit onHit) const;
+    void extractCodes(std::string_view text, const std::string& messageId, std::vector<Extraction>& results) const;
+    void extractLink(std::string_view url, const std::string& messageId, std::vector<Extraction>& results) const;
+
+public:
+    /**
+     * @brief Compiles patterns.
+     * @param patterns The patterns; names should be unique.
+     */
+    explicit Extractor(std::vector<ExtractionPattern> patterns = defaultPatterns());
+
+    /**
+     * @brief Finds every match in a message.
+     *
+     * Codes are looked for in the subject and the text, or the text of the
+     * HTML when there is no plain text. Links come from the text and the
+     * anchors of the HTML.
+     * @param message The message.
+     * @return The matches in the order found, each value once per pattern.
+     */
+    std::vector<Extraction> extract(const Message& message) const;
+
+    /**
+     * @brief Gets the compiled patterns.
+     * @return The patterns.
+     */
+    const std::vector<ExtractionPattern>& getPatterns() const;
+
+    /**
+     * @brief Patterns for the usual sign-up mail: a "code" and a "link" pattern.
+     * @return The patterns.
+     */
+    static std::vector<ExtractionPattern> defaultPatterns();
+};
+
+} // namespace MailTMAPI
@@ -0,0 +1,213 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @file FrameProfiler.h
+ * @brief Provides scoped timers for the phases of a render loop and a Chrome trace dump.
+ */
+
+namespace MailTMAPI {
+
+/**
+ * @struct PhaseTiming
+ * @brief How long one phase of the frame took.
+ */
+struct PhaseTiming {
+    std::string name; /**< The phase, e.g. "drawMessages". */
+    double lastMs = 0; /**< Time in the last finished frame. */
+    double averageMs = 0; /**< Mean over the recent frames. */
+    double maxMs = 0; /**< Worst of the recent frames. */
+};
+
+/**
+ * @struct FrameStats
+ * @brief What the overlay shows: the recent frames at a glance.
+ */
+struct FrameStats {
+    std::vector<PhaseTiming> phases; /**< Every phase seen so far, in the order first seen. */
+    PhaseTiming frame; /**< The whole frame, from beginFrame() to endFrame(). */
+    PhaseTiming lockWait; /**< Time spent waiting for locks during the frame. */
+    size_t drawCalls = 0; /**< Draw calls of the last finished frame. */
+    uint64_t frames = 0; /**< Frames finished so far. */
+};
+
+/**
+ * @class FrameProfiler
+ * @brief Times the phases of each frame for an on-screen overlay and, on request, a trace file.
+ *
+ * Wrap each phase of the render loop in a PROFILE_SCOPE between beginFrame()
+ * and endFrame(). Averages and maxima cover the last historyFrames frames.
+ * While a trace is recording, every frame, phase and lock wait is also kept
+ * as a Chrome trace event and written out by stopTrace(); the file opens in
+ * chrome://tracing or Perfetto.
+ *
+ * A profiler belongs to the thread that runs the frames. Code that may take
+ * a contended lock on that thread marks the wait with a LockWait, or reports
+ * it to recordLockWait(); the wait is charged to the frame in progress and
+ * costs nothing on other threads.
+ */
+class FrameProfiler {
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr size_t historyFrames = 120; /**< Frames the averages and maxima cover, 2 s at 60 fps. */
+    static constexpr size_t maxTraceEvents = 1000000; /**< Events kept per trace, about 50 MB of JSON. */
+
+    /**
+     * @class Scope
+     * @brief Times one phase from construction to destruction.
+     */
+    class Scope {
+    private:
+        FrameProfiler& profiler; /**< The profiler being charged. */
+        size_t phase; /**< Index of the phase. */
+        Clock::time_point start; /**< When the phase began. */
+
+    public:
+        /**
+         * @brief Starts timing a phase.
+         * @param profiler The profiler.
+         * @param name The phase name; must be a string literal or otherwise outlive the profiler.
+         */
+        Scope(FrameProfiler& profiler, const char* name);
+
+        /**
+         * @brief Adds the elapsed time to the phase.
+         */
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    /**
+     * @class LockWait
+     * @brief Times a wait for a lock and charges it to the frame running on this thread, if any.
+     */
+    class LockWait {
+    private:
+        Clock::time_point start; /**< When the wait began. */
+
+    public:
+        LockWait();
+        ~LockWait();
+
+        LockWait(const LockWait&) = delete;
+        LockWait& operator=(const LockWait&) = delete;
+    };
+
+private:
+    /**
+     * @struct Phase
+     * @brief The recent times of one phase.
+     */
+    struct Phase {
+        const char* name; /**< The phase name. */
+        double currentMs = 0; /**< Time so far in the frame in progress. */
+        std::array<double, historyFrames> history{}; /**< Times of the recent frames, a ring indexed by frame number. */
+    };
+
+    /**
+     * @struct TraceEvent
+     * @brief A complete event or a counter in the trace.
+     */
+    struct TraceEvent {
+        const char* name; /**< Event name. */
+        char phase; /**< 'X' for a timed span, 'C' for a counter. */
+        int64_t startMicros; /**< Start relative to the beginning of the trace. */
+        int64_t value; /**< Duration in microseconds for a span, the value for a counter. */
+    };
+
+    std::vector<Phase> phases; /**< Phases in the order first seen. */
+    Phase frame{"frame"}; /**< The whole frame. */
+    Phase lockWait{"lockWait"}; /**< Lock waits during the frame. */
+    std::array<size_t, historyFrames> drawCalls{}; /**< Draw calls of the recent frames. */
+    Clock::time_point frameStart; /**< When the frame in progress began. */
+    bool inFrame = false; /**< True between beginFrame() and endFrame(). */
+    uint64_t frames = 0; /**< Frames finished so far. */
+
+    bool tracing = false; /**< True while a trace is recording. */
+    std::string tracePath; /**< Where stopTrace() writes the trace. */
+    Clock::time_point traceStart; /**< Time zero of the trace. */
+    std::vector<TraceEvent> traceEvents; /**< Events recorded so far. */
+    uint64_t droppedTraceEvents = 0; /**< Events past maxTraceEvents. */
+
+    size_t phaseIndex(const char* name);
+    void addSpan(const char* name, Clock::time_point start, Clock::time_point end);
+    void addCounter(const char* name, Clock::time_point time, int64_t value);
+    static PhaseTiming summarize(const Phase& phase, uint64_t frames);
+
+public:
+    FrameProfiler() = default;
+
+    /**
+     * @brief Writes a trace still recording and detaches from the thread.
+     */
+    ~FrameProfiler();
+
+    /**
+     * @brief Charges a lock wait to the frame running on the calling thread, if any.
+     *
+     * Fits SearchIndex::setLockWaitSink, so the index needs no profiler of its own.
+     * @param start When the wait began.
+     * @param end When the lock was acquired.
+     */
+    static void recordLockWait(Clock::time_point start, Clock::time_point end);
+
+    /**
+     * @brief Starts a frame on the calling thread.
+     */
+    void beginFrame();
+
+    /**
+     * @brief Finishes the frame and adds it to the recent frames.
+     * @param frameDrawCalls Draw calls the frame issued.
+     */
+    void endFrame(size_t frameDrawCalls);
+
+    /**
+     * @brief Drops the frame in progress, e.g. when nothing was drawn after all.
+     *
+     * Spans already recorded for the trace are kept.
+     */
+    void cancelFrame();
+
+    /**
+     * @brief Gets the timings of the recent frames.
+     * @return The stats; all zero before the first frame.
+     */
+    FrameStats getStats() const;
+
+    /**
+     * @brief Starts recording a trace.
+     * @param path The file stopTrace() writes.
+     * @return False if a trace is already recording.
+     */
+    bool startTrace(const std::string& path);
+
+    /**
+     * @brief Stops recording and writes the trace as Chrome trace event JSON.
+     * @return True if the file was written.
+     */
+    bool stopTrace();
+
+    /**
+     * @brief Checks whether a trace is recording.
+     * @return True while recording.
+     */
+    bool isTracing() const;
+
+    // Disable copy semantics
+    FrameProfiler(const FrameProfiler&) = delete;
+    FrameProfiler& operator=(const FrameProfiler&) = delete;
+};
+
+} // namespace MailTMAPI
+
+#define PROFILE_SCOPE_NAME(line) profileScope##line
+#define PROFILE_SCOPE_AT(profiler, name, line) ::MailTMAPI::FrameProfiler::Scope PROFILE_SCOPE_NAME(line)(profiler, name)
+// Times the rest of the enclosing block as the named phase of the frame in progress
+#define PROFILE_SCOPE(profiler, name) PROFILE_SCOPE_AT(profiler, name, __LINE__)
@@ -0,0 +1,28 @@
+#pragma once
+#include <string_view>
+
+/**
+ * @file HtmlEntities.h
+ * @brief Provides the named character references of HTML.
+ */
+
+namespace MailTMAPI {
+
+/**
+ * @struct HtmlEntity
+ * @brief One named character reference, e.g. "amp" for "&".
+ */
+struct HtmlEntity {
+    std::string_view name; /**< The name without '&' and ';'. */
+    std::string_view value; /**< The UTF-8 text it stands for. */
+    bool legacy; /**< True if it is also recognized without the trailing ';', as in "&nbsp". */
+};
+
+/**
+ * @brief Looks up a named character reference.
+ * @param name The name without '&' and ';', case-sensitive.
+ * @return The entity, or nullptr if there is none by that name.
+ */
+const HtmlEntity* findHtmlEntity(std::string_view name);
+
+} // namespace MailTMAPI
@@ -0,0 +1,62 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @file HtmlText.h
+ * @brief Provides conversion of HTML message bodies to plain text.
+ */
+
+namespace MailTMAPI {
+
+/**
+ * @struct HtmlLink
+ * @brief A link found in an HTML body.
+ */
+struct HtmlLink {
+    std::string url; /**< The href with its character references decoded. */
+    std::string text; /**< The anchor text with whitespace collapsed. */
+};
+
+/**
+ * @struct HtmlTextResult
+ * @brief The plain text of an HTML body and its links.
+ */
+struct HtmlTextResult {
+    std::string text; /**< The visible text; block elements start a new line. */
+    std::vector<HtmlLink> links; /**< Links in document order. */
+};
+
+/**
+ * @class HtmlText
+ * @brief Single-pass HTML to text converter.
+ *
+ * Text between tags is found with a vectorized scan for '<' and '&' and
+ * copied in whole runs. Named (the full HTML set) and numeric character
+ * references are decoded; comments, <title>, <style> and <script> are
+ * dropped. Malformed markup never fails, it is passed through as text
+ * the way a browser would show it.
+ */
+class HtmlText {
+public:
+    /**
+     * @brief Converts an HTML body.
+     * @param html The HTML.
+     * @param inlineLinks True to write each http(s) URL after its anchor text,
+     *        so the text alone is enough to find and open the links.
+     * @return The text and the links.
+     */
+    static HtmlTextResult convert(std::string_view html, bool inlineLinks = true);
+
+    /**
+     * @brief Decodes the character references in text or an attribute value.
+     * @param text The encoded text.
+     * @param out Receives the decoded text.
+     * @param inAttribute True for attribute values, where a legacy name such as
+     *        "&copy" followed by a letter, digit or '=' is left alone as in URLs.
+     */
+    static void decodeEntities(std::string_view text, std::string& out, bool inAttribute = false);
+};
+
+} // namespace MailTMAPI
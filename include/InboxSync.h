@@ -0,0 +1,108 @@
+#pragma once
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "Message.h"
+
+/**
+ * @file InboxSync.h
+ * @brief Provides incremental inbox synchronisation against a high-water mark.
+ */
+
+namespace MailTMAPI {
+
+/**
+ * @struct InboxCursor
+ * @brief High-water mark of the messages a caller has already seen.
+ *
+ * mail.tm lists messages newest first, so everything at or below the mark
+ * is known. Several messages can share a createdAt timestamp; the IDs seen
+ * at exactly that timestamp are kept to tell them apart.
+ *
+ * When a sync hits its page limit before reaching the mark, the mark stays
+ * where it was and the cursor remembers where to continue and what was
+ * already returned, so older unseen mail is picked up by the next syncs.
+ */
+struct InboxCursor {
+    std::string createdAt; /**< createdAt of the newest seen message, empty before the first sync. */
+    std::vector<std::string> ids; /**< Sorted IDs of the seen messages created exactly at createdAt. */
+    std::string resumeLink; /**< hydra:next where a sync that hit the page limit stopped; the next sync continues there. */
+    std::vector<std::string> returnedIds; /**< Sorted IDs above createdAt already returned by syncs that stopped early. */
+    std::string pendingCreatedAt; /**< Newest createdAt returned so far; becomes createdAt once the sync reaches it. */
+    std::vector<std::string> pendingIds; /**< Sorted IDs of the returned messages created exactly at pendingCreatedAt. */
+
+    /**
+     * @brief Checks whether the cursor has been advanced by a sync yet.
+     * @return True if no message has been seen.
+     */
+    bool empty() const { return createdAt.empty(); }
+};
+
+/**
+ * @class InboxSync
+ * @brief Collects the messages newer than a cursor from /messages pages.
+ *
+ * Feed the pages in order; addPage returns the path of the next page until
+ * the cursor's watermark is reached, so the work per sync is proportional
+ * to the new mail rather than to the inbox size. A sync from an empty
+ * cursor reads only the first page.
+ */
+class InboxSync {
+private:
+    InboxCursor cursor; /**< The watermark this sync stops at. */
+    std::vector<MessageSummary> messages; /**< New message summaries, newest first. */
+    std::unordered_set<std::string> collectedIds; /**< Guards against messages shifting across page boundaries. */
+    std::string newestCreatedAt; /**< Highest createdAt among the collected messages. */
+    std::vector<std::string> newestIds; /**< IDs of the collected messages created at newestCreatedAt. */
+    bool reachedWatermark; /**< True once a known message was found. */
+    bool failed; /**< True if a page could not be parsed or the sync was aborted. */
+    std::string stoppedAt; /**< The next page when the sync stopped at its page limit, empty otherwise. */
+
+    bool isKnown(const std::string& createdAt, const std::string& id) const;
+
+public:
+    /**
+     * @brief Starts a sync from the given cursor.
+     * @param cursor The watermark of the previous sync.
+     */
+    explicit InboxSync(InboxCursor cursor);
+
+    /**
+     * @brief Adds one /messages response.
+     * @param response The response body.
+     * @return The path of the next page to request, or an empty string when the sync is complete.
+     */
+    std::string addPage(const std::string& response);
+
+    /**
+     * @brief Marks the sync as failed, e.g. after a page request returned an error.
+     */
+    void abort();
+
+    /**
+     * @brief Ends the sync before the watermark, e.g. at the caller's page limit.
+     * @param next The page addPage asked for; the next sync continues from it.
+     */
+    void stop(const std::string& next);
+
+    /**
+     * @brief Checks whether a page failed to parse or the sync was aborted.
+     * @return True if the sync failed.
+     */
+    bool hasFailed() const;
+
+    /**
+     * @brief Takes the messages newer than the starting cursor.
+     * @return The new message summaries, newest first.
+     */
+    std::vector<MessageSummary> takeMessages();
+
+    /**
+     * @brief Gets the cursor to pass to the next sync.
+     * @return The advanced cursor; the starting cursor if nothing new arrived or the sync failed; the
+     *         starting watermark plus what to resume if the sync was stopped.
+     */
+    InboxCursor getCursor() const;
+};
+
+} // namespace MailTMAPI
@@ -0,0 +1,71 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <string_view>
+
+/**
+ * @file InternedString.h
+ * @brief Provides shared storage for strings that repeat across many messages.
+ */
+
+namespace MailTMAPI {
+
+/**
+ * @class InternedString
+ * @brief An immutable string stored once per distinct value.
+ *
+ * Sender addresses and names repeat across most of an inbox. Interning
+ * them keeps a single copy per distinct value, shared by every message,
+ * and makes copying a message's sender a reference count increment.
+ * Values are released once no message refers to them any more.
+ */
+class InternedString {
+private:
+    std::shared_ptr<const std::string> value; /**< The pooled string, or null for the empty string. */
+
+public:
+    /**
+     * @brief Constructs an empty string.
+     */
+    InternedString() = default;
+
+    /**
+     * @brief Looks up or adds a value in the process-wide pool.
+     * @param text The value to intern.
+     */
+    explicit InternedString(std::string_view text);
+
+    /**
+     * @brief Gets the value.
+     * @return The interned string; an empty string if none was set.
+     */
+    const std::string& str() const;
+
+    /**
+     * @brief Checks whether the value is empty.
+     * @return True if the string is empty.
+     */
+    bool empty() const { return !value || value->empty(); }
+
+    /**
+     * @brief Compares two values; equal interned values share storage.
+     * @param other The value to compare with.
+     * @return True if both hold the same text.
+     */
+    bool operator==(const InternedString& other) const { return value == other.value || str() == other.str(); }
+
+    /**
+     * @brief Compares two values.
+     * @param other The value to compare with.
+     * @return True if the texts differ.
+     */
+    bool operator!=(const InternedString& other) const { return !(*this == other); }
+
+    /**
+     * @brief Gets the number of distinct values currently held by the pool.
+     * @return The pool size, including values awaiting cleanup.
+     */
+    static size_t poolSize();
+};
+
+} // namespace MailTMAPI
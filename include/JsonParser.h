@@ -0,0 +1,63 @@
+#pragma once
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <json/json.h>
+
+/**
+ * @file JsonParser.h
+ * @brief Provides the JSON parsing used for API responses.
+ */
+
+namespace MailTMAPI {
+
+/**
+ * @class JsonParser
+ * @brief Parses JSON straight from a response buffer with a reused reader.
+ *
+ * Building a Json::CharReaderBuilder and copying the body into a
+ * std::istringstream for every response costs several allocations per
+ * request. A JsonParser creates its CharReader once and parses the buffer
+ * in place. Endpoints that only need one top-level string, such as the
+ * token or an ID, can skip the DOM entirely with findString.
+ */
+class JsonParser {
+private:
+    std::unique_ptr<Json::CharReader> reader; /**< Reused for every parse; not thread-safe. */
+
+public:
+    /**
+     * @brief Constructs a parser with the default jsoncpp settings.
+     */
+    JsonParser();
+
+    /**
+     * @brief Parses a JSON document.
+     * @param text The JSON text.
+     * @param root Receives the parsed value.
+     * @param errors Receives the error message on failure (optional).
+     * @return True if the text was parsed successfully.
+     */
+    bool parse(std::string_view text, Json::Value& root, std::string* errors = nullptr);
+
+    /**
+     * @brief Gets the parser of the calling thread.
+     * @return A parser owned by the current thread.
+     */
+    static JsonParser& local();
+
+    /**
+     * @brief Looks up a top-level string field without building a DOM.
+     *
+     * Scans the object once, skipping nested values, and decodes only the
+     * requested string. Other values are not validated.
+     * @param text The JSON text, expected to hold an object.
+     * @param key The field name.
+     * @param malformed Set to true if the text is not a JSON object (optional).
+     * @return The decoded string, or std::nullopt if the field is missing or not a string.
+     */
+    static std::optional<std::string> findString(std::string_view text, std::string_view key, bool* malformed = nullptr);
+};
+
+} // namespace MailTMAPI
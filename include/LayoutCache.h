@@ -0,0 +1,83 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "BatchRenderer.h"
+#include "TextLayout.h"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class LayoutCache
+ * @brief Keeps laid-out text blocks and their drawable runs between frames.
+ *
+ * A block is laid out once per key, width, font size and line limit, and
+ * its runs are turned into glyph quads from the font atlas. Drawing a
+ * cached block only copies those quads into the frame's batch at the
+ * block's position, so frame time does not depend on how long the
+ * message is.
+ */
+class LayoutCache {
+public:
+    /**
+     * @struct Block
+     * @brief A cached block of text.
+     */
+    struct Block {
+        MailTMAPI::LayoutResult layout; /**< Line breaks and run positions. */
+        std::vector<sf::Vertex> vertices; /**< Glyph quads of every run, relative to the top-left corner. */
+        unsigned int fontSize = 14; /**< The character size the quads were built with. */
+    };
+
+    /**
+     * @struct Style
+     * @brief How a block is laid out and drawn.
+     */
+    struct Style {
+        unsigned int fontSize = 14; /**< Character size. */
+        MailTMAPI::LayoutOptions options; /**< Wrapping constraints. */
+        sf::Color color = sf::Color::White; /**< Color of plain text. */
+        sf::Color linkColor = sf::Color(100, 149, 237); /**< Color of URLs, which are also underlined. */
+    };
+
+private:
+    const sf::Font& font; /**< The font every block is drawn with. */
+    std::unordered_map<unsigned int, std::unique_ptr<MailTMAPI::GlyphAdvances>> advances; /**< Advance tables per font size. */
+    std::unordered_map<std::string, Block> blocks; /**< Cached blocks by key and style. */
+
+    static constexpr size_t maxBlocks = 1024; /**< The cache is emptied when it grows past this. */
+
+    const MailTMAPI::GlyphAdvances& getAdvances(unsigned int fontSize);
+
+public:
+    /**
+     * @brief Constructs an empty cache.
+     * @param font The font to lay out and draw with; must outlive the cache.
+     */
+    explicit LayoutCache(const sf::Font& font);
+
+    /**
+     * @brief Gets a block, laying it out on first use.
+     *
+     * The returned reference stays valid until the next call to get or clear.
+     * @param key Identifies the text, e.g. a message ID and which part of it is shown.
+     * @param style The layout and colors; part of the cache key.
+     * @param words The prepared words; only read when the block is not cached yet.
+     * @return The cached block.
+     */
+    Block& get(const std::string& key, const Style& style, const std::vector<MailTMAPI::LayoutWord>& words);
+
+    /**
+     * @brief Adds a block to a batch with its top-left corner at the given position.
+     * @param batch The batch of the current frame.
+     * @param block A block returned by get.
+     * @param x The left edge.
+     * @param y The top edge.
+     */
+    static void draw(BatchRenderer& batch, const Block& block, float x, float y);
+
+    /**
+     * @brief Drops every cached block, e.g. when the inbox is cleared.
+     */
+    void clear();
+};
@@ -0,0 +1,200 @@
+#pragma once
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+/**
+ * @file Logger.h
+ * @brief Provides a leveled logger that hands lines to a background writer thread.
+ *
+ * Log through the LOG_DEBUG, LOG_INFO, LOG_WARN and LOG_ERROR macros, which
+ * take the pieces of the line as separate arguments:
+ *
+ *     LOG_INFO("New messages: ", count);
+ *
+ * Levels below LAMBDAMAIL_LOG_LEVEL are removed at compile time, arguments
+ * included, so debug lines in the render loop cost nothing in a normal build.
+ */
+
+/**
+ * @brief The lowest level compiled in: 0 debug, 1 info, 2 warn, 3 error, 4 nothing.
+ */
+#ifndef LAMBDAMAIL_LOG_LEVEL
+#define LAMBDAMAIL_LOG_LEVEL 1
+#endif
+
+namespace MailTMAPI {
+
+/**
+ * @enum LogLevel
+ * @brief The severity of a log line.
+ */
+enum class LogLevel {
+    Debug, /**< Tracing for development, compiled out by default. */
+    Info, /**< Progress worth seeing in a normal run. */
+    Warn, /**< Something went wrong but was handled. */
+    Error /**< An operation failed. */
+};
+
+/**
+ * @class Logger
+ * @brief Formats log lines on the calling thread and writes them on a background thread.
+ *
+ * Lines go into a fixed ring of slots that producers claim with a single
+ * compare-and-swap, so logging never allocates and never waits for the
+ * terminal. The writer sleeps while the ring is empty; only a line logged
+ * while it sleeps takes a lock, briefly, to wake it. When the ring is full
+ * the line is dropped and counted; the writer reports the count with the
+ * next line it writes. Lines longer than lineCapacity are cut short.
+ */
+class Logger {
+public:
+    static constexpr size_t lineCapacity = 480; /**< Longest line kept, in bytes. */
+    using Sink = std::function<void(LogLevel, std::string_view)>; /**< Receives each formatted line on the writer thread. */
+
+private:
+    /**
+     * @struct Slot
+     * @brief One line in the ring.
+     */
+    struct Slot {
+        std::atomic<size_t> sequence{0}; /**< Which producer or consumer turn the slot is on. */
+        LogLevel level = LogLevel::Info; /**< The line's level. */
+        std::chrono::system_clock::time_point time; /**< When the line was logged. */
+        size_t length = 0; /**< Bytes used in text. */
+        char text[lineCapacity]; /**< The message, not null-terminated. */
+    };
+
+    /**
+     * @struct LineWriter
+     * @brief Appends formatted arguments to a slot, cutting off at lineCapacity.
+     */
+    struct LineWriter {
+        Slot& slot; /**< The claimed slot. */
+
+        void append(std::string_view text);
+        void append(const char* text) { append(std::string_view(text ? text : "(null)")); }
+        void append(char c) { append(std::string_view(&c, 1)); }
+        void append(double value);
+        void append(bool value) { append(std::string_view(value ? "true" : "false")); }
+
+        template <typename T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, int>::type = 0>
+        void append(T value) {
+            char buffer[24];
+            auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+            append(std::string_view(buffer, result.ptr - buffer));
+        }
+
+        template <typename T, typename std::enable_if<std::is_convertible<const T&, std::string_view>::value &&
+                                                          !std::is_pointer<T>::value, int>::type = 0>
+        void append(const T& text) {
+            append(std::string_view(text));
+        }
+    };
+
+    size_t capacity; /**< Number of slots, a power of two. */
+    std::unique_ptr<Slot[]> slots; /**< The ring. */
+    alignas(64) std::atomic<size_t> enqueuePos{0}; /**< Next position a producer claims. */
+    alignas(64) std::atomic<size_t> written{0}; /**< Lines handed to the sink so far. */
+    std::atomic<uint64_t> dropped{0}; /**< Lines lost to a full ring, not reported yet. */
+    size_t dequeuePos = 0; /**< Next position the writer reads; writer thread only. */
+    Sink sink; /**< Where lines end up. */
+    std::atomic<bool> running{true}; /**< Cleared to stop the writer. */
+    std::atomic<bool> sleeping{false}; /**< Set while the writer may be waiting on wake. */
+    std::mutex wakeMutex; /**< Only used to sleep and wake the writer. */
+    std::condition_variable wake; /**< Wakes the writer for new lines, flush() and shutdown. */
+    std::thread writer; /**< Drains the ring into the sink. */
+
+    Slot* claim();
+    void publish(Slot& slot);
+    bool drain();
+    bool hasPending() const;
+    void run();
+
+public:
+    /**
+     * @brief Starts a logger writing Debug and Info to stdout and the rest to stderr.
+     * @param capacity Number of lines the ring holds, rounded up to a power of two.
+     */
+    explicit Logger(size_t capacity = 1024);
+
+    /**
+     * @brief Starts a logger with its own sink.
+     * @param sink Called on the writer thread for every line, prefix included.
+     * @param capacity Number of lines the ring holds, rounded up to a power of two.
+     */
+    Logger(Sink sink, size_t capacity);
+
+    /**
+     * @brief Writes every pending line and stops the writer thread.
+     */
+    ~Logger();
+
+    /**
+     * @brief Gets the process-wide logger used by the LOG_ macros.
+     *
+     * It is never destroyed, so threads still running at exit can log
+     * safely; pending lines are flushed when the process exits normally.
+     * @return The logger.
+     */
+    static Logger& instance();
+
+    /**
+     * @brief Formats a line and queues it for the writer.
+     * @param level The line's level.
+     * @param args The pieces of the line: strings, characters and numbers.
+     */
+    template <typename... Args>
+    void write(LogLevel level, const Args&... args) {
+        Slot* slot = claim();
+        if (!slot) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        slot->level = level;
+        slot->time = std::chrono::system_clock::now();
+        slot->length = 0;
+        LineWriter line{*slot};
+        (line.append(args), ...);
+        publish(*slot);
+    }
+
+    /**
+     * @brief Waits until every line logged before the call has reached the sink.
+     */
+    void flush();
+
+    /**
+     * @brief Gets the number of lines dropped because the ring was full.
+     * @return The count since the last time the writer reported it.
+     */
+    uint64_t getDropped() const;
+
+    // Disable copy semantics
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+};
+
+} // namespace MailTMAPI
+
+// Queue a line when the level is compiled in; otherwise the arguments are never evaluated
+#define LAMBDAMAIL_LOG(level, levelNumber, ...)                                                                   \
+    do {                                                                                                          \
+        if constexpr ((levelNumber) >= LAMBDAMAIL_LOG_LEVEL) {                                                    \
+            ::MailTMAPI::Logger::instance().write(level, __VA_ARGS__);                                            \
+        }                                                                                                         \
+    } while (0)
+
+#define LOG_DEBUG(...) LAMBDAMAIL_LOG(::MailTMAPI::LogLevel::Debug, 0, __VA_ARGS__)
+#define LOG_INFO(...) LAMBDAMAIL_LOG(::MailTMAPI::LogLevel::Info, 1, __VA_ARGS__)
+#define LOG_WARN(...) LAMBDAMAIL_LOG(::MailTMAPI::LogLevel::Warn, 2, __VA_ARGS__)
+#define LOG_ERROR(...) LAMBDAMAIL_LOG(::MailTMAPI::LogLevel::Error, 3, __VA_ARGS__)
@@ -2,7 +2,18 @@
 #include <string>
 #include <vector>
 #include <optional>
+#include <memory>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <json/json.h>
+#include "Extractor.h"
+#include "InboxSync.h"
+#include "Message.h"
 
 /**
  * @file MailTM.h
@@ -11,6 +22,13 @@
 
 namespace MailTMAPI {
 
+class CurlPool;
+class CurlMulti;
+class CurlWrapper;
+class TokenCache;
+class SearchIndex;
+class RequestMetrics;
+
 /**
  * @class MailTM
  * @brief A class to interact with the Mail.tm API.
@@ -30,29 +48,178 @@ private:
      */
     static size_t WriteCallback(void* contents, size_t size, size_t nmemb, void* userp);
 
+    /**
+     * @brief Configures a handle for a request to the Mail.tm API.
+     * @param curl The handle to configure.
+     * @param url The endpoint URL.
+     * @param method The HTTP method (e.g., "GET", "POST").
+     * @param payload The request payload (copied into the handle).
+     * @param authToken The authentication token (optional).
+     * @param response The buffer the response body is written into.
+     */
+    static void prepareRequest(CurlWrapper& curl, const std::string& url, const std::string& method,
+                               const std::string& payload, const std::string& authToken, std::string* response);
+
     /**
      * @brief Sends an HTTP request to the Mail.tm API.
      * @param url The endpoint URL.
      * @param method The HTTP method (e.g., "GET", "POST").
      * @param payload The request payload (optional).
      * @param authToken The authentication token (optional).
+     * @param statusCode Receives the HTTP response code, or 0 on a transport error (optional).
      * @return The response body as a string.
      */
     std::string sendRequest(const std::string& url, const std::string& method,
-                            const std::string& payload = "", const std::string& authToken = "");
+                            const std::string& payload = "", const std::string& authToken = "",
+                            long* statusCode = nullptr);
 
-    const std::string baseUrl = "https://api.mail.tm"; /**< Base URL for the Mail.tm API. */
+    /**
+     * @brief Sends an HTTP request without blocking.
+     * @param url The endpoint URL.
+     * @param method The HTTP method (e.g., "GET", "POST").
+     * @param payload The request payload (may be empty).
+     * @param authToken The authentication token (may be empty).
+     * @param onDone Called on the event loop thread with the response body (empty on error)
+     *               and the HTTP status (0 on a transport error).
+     */
+    void sendRequestAsync(const std::string& url, const std::string& method, const std::string& payload,
+                          const std::string& authToken, std::function<void(std::string, long)> onDone);
+
+    /**
+     * @brief Gets the event loop used by the async API, starting it on first use.
+     * @return The shared CurlMulti instance.
+     */
+    CurlMulti& getMulti();
+
+    /**
+     * @brief Requests a new token from /token, bypassing the cache.
+     * @param email The email address.
+     * @param password The email password.
+     * @return The token if successful, or std::nullopt otherwise.
+     */
+    std::optional<std::string> requestToken(const std::string& email, const std::string& password);
+
+    /**
+     * @brief Builds the JSON body for a /token request.
+     * @param email The email address.
+     * @param password The email password.
+     * @return The serialized payload.
+     */
+    static std::string tokenPayload(const std::string& email, const std::string& password);
+
+    /**
+     * @brief Extracts the token from a /token response.
+     * @param response The response body.
+     * @return The token if present, or std::nullopt otherwise.
+     */
+    static std::optional<std::string> parseToken(const std::string& response);
+
+    /**
+     * @brief Extracts the account ID from a /me response.
+     * @param response The response body.
+     * @return The account ID if present, or std::nullopt otherwise.
+     */
+    static std::optional<std::string> parseAccountId(const std::string& response);
+
+    /**
+     * @brief Extracts the message list from a /messages response.
+     * @param response The response body.
+     * @return The messages in the first page of the inbox.
+     */
+    std::vector<MessageSummary> parseInbox(const std::string& response);
+
+    /**
+     * @brief Parses a /messages/{id} response.
+     * @param response The response body.
+     * @return The full message, or std::nullopt on error.
+     */
+    std::optional<Message> parseMessage(const std::string& response);
+
+    /**
+     * @brief Requests the next /messages page of an incremental sync without blocking.
+     * @param token The authentication token.
+     * @param url The page URL.
+     * @param sync The sync collecting the pages.
+     * @param pagesLeft The number of pages still allowed after this one.
+     * @param onDone Receives the new messages, the advanced cursor and the HTTP status.
+     */
+    void syncPageAsync(const std::string& token, const std::string& url, std::shared_ptr<InboxSync> sync,
+                       int pagesLeft, std::function<void(std::vector<MessageSummary>, InboxCursor, long)> onDone);
+
+    /**
+     * @brief Gets the first page a sync reads.
+     * @param cursor The cursor the sync starts from.
+     * @return The inbox URL, or the page where a sync that hit the page limit stopped.
+     */
+    std::string syncStartUrl(const InboxCursor& cursor) const;
+
+    /**
+     * @brief Resolves a hydra:next link against the base URL.
+     * @param next The link, usually a path such as "/messages?page=2".
+     * @return The absolute URL.
+     */
+    std::string resolveLink(const std::string& next) const;
+
+    /**
+     * @brief Streams push updates, asking tokenFor for the token before every connection.
+     * @param tokenFor Gets the token; its argument is true after the hub rejected the last one. Returns std::nullopt to give up.
+     * @param accountId The account whose updates to receive.
+     * @param onUpdate Called with the JSON payload of every pushed update.
+     * @param running Set to false from another thread to stop streaming.
+     * @return True if stopped through running, false otherwise.
+     */
+    bool streamUpdates(const std::function<std::optional<std::string>(bool)>& tokenFor, const std::string& accountId,
+                       const std::function<void(const Json::Value&)>& onUpdate, const std::atomic<bool>& running);
+
+    const std::string baseUrl; /**< Base URL for the Mail.tm API. */
+    std::string mercureUrl = "https://mercure.mail.tm/.well-known/mercure"; /**< Mercure hub for push updates. */
+
+    static constexpr int maxSyncPages = 20; /**< Upper bound on the pages one incremental sync reads. */
+    static constexpr long maxAsyncConnections = 32; /**< Connection cap for the async event loop; extra requests queue. */
+
+    std::shared_ptr<RequestMetrics> metrics; /**< Timing of every request; declared before the loops that record into it. */
+    std::unique_ptr<CurlPool> curlPool; /**< Keep-alive handles reused across requests. */
+    std::unique_ptr<CurlMulti> curlMulti; /**< Event loop for async requests, created on first use. */
+    mutable std::mutex multiMutex; /**< Guards lazy creation of curlMulti. */
+    std::unique_ptr<TokenCache> tokenCache; /**< Tokens per address, refreshed before they expire. */
+    std::atomic<SearchIndex*> searchIndex{nullptr}; /**< Receives every fetched message; not owned. */
+    std::atomic<bool> requestsStarted{false}; /**< Set by the first request; metrics is fixed from then on. */
+
+    /**
+     * @struct PendingMatch
+     * @brief An extraction waiting for waitForMatch.
+     */
+    struct PendingMatch {
+        Extraction extraction; /**< The match. */
+        std::vector<std::string> recipients; /**< Lowercased recipients of the message. */
+    };
+
+    static constexpr size_t maxPendingMatches = 1024; /**< Older matches are dropped once this many wait. */
+
+    std::shared_ptr<const Extractor> extractor; /**< Runs on every fetched message; null when disabled. */
+    std::deque<PendingMatch> pendingMatches; /**< Matches not taken by waitForMatch yet, oldest first. */
+    std::mutex matchMutex; /**< Guards extractor and pendingMatches. */
+    std::condition_variable matchArrived; /**< Wakes waitForMatch when matches are added. */
+
+    /**
+     * @brief Runs the extractor on a fetched message and wakes the waiters.
+     * @param message The message.
+     */
+    void extractMatches(const Message& message);
 
 public:
     /**
-     * @brief Default constructor.
+     * @brief Constructs the client and its connection pool.
+     * @param baseUrl Base URL of the API, e.g. a local mock server for benchmarks.
      */
-    MailTM() = default;
+    explicit MailTM(const std::string& baseUrl = "https://api.mail.tm");
 
     /**
-     * @brief Default destructor.
+     * @brief Destructor that stops the async event loop, then releases the connection pool.
+     *
+     * Requests still in flight complete with an error before any other member goes away.
      */
-    ~MailTM() = default;
+    ~MailTM();
 
     /**
      * @brief Fetches an available email domain.
@@ -70,18 +237,110 @@ public:
 
     /**
      * @brief Authenticates an email account.
+     *
+     * Returns a cached token when one is still valid; otherwise requests a
+     * new one and caches it. Cached tokens are refreshed in the background
+     * shortly before their JWT expiry.
      * @param email The email address.
      * @param password The email password.
      * @return The authentication token if successful, or std::nullopt otherwise.
      */
     std::optional<std::string> authenticate(const std::string& email, const std::string& password);
 
+    /**
+     * @brief Drops the cached token of an address, e.g. after the server answered 401.
+     * @param email The email address.
+     */
+    void invalidateToken(const std::string& email);
+
+    /**
+     * @brief Persists cached tokens to a file so restarts can skip the /token round trip.
+     * @param path The token store file.
+     */
+    void setTokenStorePath(const std::string& path);
+
+    /**
+     * @brief Adds every message fetched from now on to a search index.
+     * @param index The index, which must outlive the client; nullptr to stop indexing.
+     */
+    void setSearchIndex(SearchIndex* index);
+
+    /**
+     * @brief Records request statistics into the given collector instead of this client's own.
+     *
+     * Lets several clients, such as the workers of the inbox daemon, report
+     * into one collector. Must be called before the first request: request
+     * threads read the collector without a lock.
+     * @param metrics The collector.
+     * @throws std::logic_error if a request was already made.
+     */
+    void setMetrics(std::shared_ptr<RequestMetrics> metrics);
+
+    /**
+     * @brief Gets the collector of request timing, sizes and status codes.
+     * @return The collector; call snapshot() on it for percentiles per endpoint.
+     */
+    std::shared_ptr<RequestMetrics> getMetrics() const;
+
+    /**
+     * @brief Gets the number of async requests submitted but not finished.
+     * @return The count, including requests waiting for a free connection.
+     */
+    size_t getRequestsInFlight() const;
+
+    /**
+     * @brief Extracts codes and links from every message fetched from now on.
+     * @param patterns The patterns, compiled once here.
+     */
+    void enableExtraction(std::vector<ExtractionPattern> patterns = Extractor::defaultPatterns());
+
+    /**
+     * @brief Waits for a code or link to arrive for an account.
+     *
+     * Matches come from every message this client fetches, whichever thread
+     * or poller fetched it, and are handed out once, oldest first. A match
+     * that arrived before the call is returned at once, so there is no race
+     * between triggering the mail and starting to wait. The call returns as
+     * soon as the message is parsed, before the fetching caller sees it.
+     * @param account The recipient address, or empty for any account.
+     * @param pattern The pattern name, e.g. "code".
+     * @param timeout How long to wait.
+     * @return The match, or std::nullopt on timeout or when extraction is not enabled.
+     */
+    std::optional<Extraction> waitForMatch(const std::string& account, const std::string& pattern,
+                                           std::chrono::milliseconds timeout);
+
     /**
      * @brief Retrieves the list of messages in the inbox.
      * @param token The authentication token.
-     * @return A vector of JSON objects representing the messages.
+     * @return The messages in the first page of the inbox.
+     */
+    std::vector<MessageSummary> checkInbox(const std::string& token);
+
+    /**
+     * @brief Retrieves the list of messages in the inbox and reports the HTTP status.
+     * @param token The authentication token.
+     * @param statusCode Receives the HTTP response code, or 0 on a transport error.
+     * @return The messages in the first page of the inbox.
+     */
+    std::vector<MessageSummary> checkInbox(const std::string& token, long& statusCode);
+
+    /**
+     * @brief Retrieves only the messages that arrived since the previous sync.
+     *
+     * Pages through /messages newest first and stops at the cursor's
+     * watermark, so the cost is proportional to the new mail. The first sync
+     * from an empty cursor returns the first page. A sync that hits
+     * maxSyncPages first returns what it read and leaves the watermark in
+     * place; the next sync continues from the page where it stopped. On
+     * failure nothing is returned and the cursor is left unchanged, so the
+     * next sync retries.
+     * @param token The authentication token.
+     * @param cursor The watermark of the previous sync; advanced on success.
+     * @param statusCode Receives the HTTP response code, or 0 on a transport error.
+     * @return The new message summaries, newest first.
      */
-    std::vector<Json::Value> checkInbox(const std::string& token);
+    std::vector<MessageSummary> syncInbox(const std::string& token, InboxCursor& cursor, long& statusCode);
 
     /**
      * @brief Gets the account ID of the authenticated user.
@@ -102,9 +361,139 @@ public:
      * @brief Retrieves a specific message by its ID.
      * @param token The authentication token.
      * @param messageId The ID of the message to retrieve.
-     * @return A JSON object representing the message.
+     * @return The message, or std::nullopt on error.
+     */
+    std::optional<Message> getMessage(const std::string& token, const std::string& messageId);
+
+    /**
+     * @brief Authenticates an email account without blocking.
+     * @param email The email address.
+     * @param password The email password.
+     * @return A future holding the token, or std::nullopt on failure.
+     */
+    std::future<std::optional<std::string>> authenticateAsync(const std::string& email, const std::string& password);
+
+    /**
+     * @brief Authenticates an email account without blocking.
+     *
+     * The callback runs on the event loop thread and must not block.
+     * @param email The email address.
+     * @param password The email password.
+     * @param onDone Receives the token, or std::nullopt on failure.
+     */
+    void authenticateAsync(const std::string& email, const std::string& password,
+                           std::function<void(std::optional<std::string>)> onDone);
+
+    /**
+     * @brief Retrieves the list of messages in the inbox without blocking.
+     * @param token The authentication token.
+     * @return A future holding the messages.
+     */
+    std::future<std::vector<MessageSummary>> checkInboxAsync(const std::string& token);
+
+    /**
+     * @brief Retrieves the list of messages in the inbox without blocking.
+     *
+     * The callback runs on the event loop thread and must not block.
+     * @param token The authentication token.
+     * @param onDone Receives the messages and the HTTP status (0 on a transport error).
+     */
+    void checkInboxAsync(const std::string& token, std::function<void(std::vector<MessageSummary>, long)> onDone);
+
+    /**
+     * @brief Retrieves only the messages that arrived since the previous sync without blocking.
+     *
+     * The callback runs on the event loop thread and must not block.
+     * @param token The authentication token.
+     * @param cursor The watermark of the previous sync.
+     * @param onDone Receives the new messages (newest first), the cursor for the next sync
+     *               (unchanged on failure) and the HTTP status (0 on a transport error).
+     */
+    void syncInboxAsync(const std::string& token, const InboxCursor& cursor,
+                        std::function<void(std::vector<MessageSummary>, InboxCursor, long)> onDone);
+
+    /**
+     * @brief Gets the account ID of the authenticated user without blocking.
+     * @param token The authentication token.
+     * @return A future holding the account ID, or std::nullopt on failure.
+     */
+    std::future<std::optional<std::string>> getAccountIdAsync(const std::string& token);
+
+    /**
+     * @brief Retrieves a specific message by its ID without blocking.
+     *
+     * All async calls share one event loop thread, so hundreds of requests
+     * can be in flight at once.
+     * @param token The authentication token.
+     * @param messageId The ID of the message to retrieve.
+     * @return A future holding the message, or std::nullopt on error.
+     */
+    std::future<std::optional<Message>> getMessageAsync(const std::string& token, const std::string& messageId);
+
+    /**
+     * @brief Retrieves a specific message without blocking.
+     *
+     * The callback runs on the event loop thread and must not block.
+     * @param token The authentication token.
+     * @param messageId The ID of the message to retrieve.
+     * @param onDone Receives the message, or std::nullopt on error.
+     */
+    void getMessageAsync(const std::string& token, const std::string& messageId,
+                         std::function<void(std::optional<Message>)> onDone);
+
+    /**
+     * @brief Retrieves several messages concurrently.
+     *
+     * At most maxConcurrency requests are in flight at any time. Blocks until
+     * every message has been fetched. The fetches complete on the event loop
+     * thread, so this must not be called from an async callback; use
+     * getMessageAsync there.
+     * @param token The authentication token.
+     * @param messageIds The IDs of the messages to retrieve.
+     * @param maxConcurrency The maximum number of requests in flight.
+     * @return The messages in the same order as messageIds; failed fetches are std::nullopt.
+     * @throws std::logic_error if called on the event loop thread.
+     */
+    std::vector<std::optional<Message>> getMessages(const std::string& token, const std::vector<std::string>& messageIds,
+                                                    size_t maxConcurrency = 8);
+
+    /**
+     * @brief Sets the Mercure hub URL used by streamInbox.
+     * @param url The hub URL, e.g. a local stand-in server in tests.
+     */
+    void setMercureUrl(const std::string& url);
+
+    /**
+     * @brief Subscribes to push updates for an account over server-sent events.
+     *
+     * Keeps one long-lived connection to the Mercure hub and reconnects with
+     * Last-Event-ID when it drops. Blocks until running becomes false or the
+     * hub rejects the subscription; callers should keep polling as a fallback.
+     * @param token The authentication token.
+     * @param accountId The account whose updates to receive.
+     * @param onUpdate Called with the JSON payload of every pushed update.
+     * @param running Set to false from another thread to stop streaming.
+     * @return True if stopped through running, false if the hub rejected the subscription.
+     */
+    bool streamInbox(const std::string& token, const std::string& accountId,
+                     const std::function<void(const Json::Value&)>& onUpdate, const std::atomic<bool>& running);
+
+    /**
+     * @brief Subscribes to push updates for an account, logging in before every connection.
+     *
+     * Each reconnection uses the current cached token, so a stream that
+     * outlives its token picks up the refreshed one. When the hub rejects the
+     * token, it is dropped from the cache and the subscription is retried
+     * once with a new login.
+     * @param email The email address.
+     * @param password The email password.
+     * @param accountId The account whose updates to receive.
+     * @param onUpdate Called with the JSON payload of every pushed update.
+     * @param running Set to false from another thread to stop streaming.
+     * @return True if stopped through running, false if login failed or the hub rejected a new token too.
      */
-    Json::Value getMessage(const std::string& token, const std::string& messageId);
+    bool streamInbox(const std::string& email, const std::string& password, const std::string& accountId,
+                     const std::function<void(const Json::Value&)>& onUpdate, const std::atomic<bool>& running);
 };
 
 } // namespace MailTMAPI
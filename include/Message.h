@@ -0,0 +1,114 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <json/json.h>
+#include "InternedString.h"
+
+/**
+ * @file Message.h
+ * @brief Provides typed representations of mail.tm messages.
+ */
+
+namespace MailTMAPI {
+
+/**
+ * @struct Address
+ * @brief A sender or recipient.
+ */
+struct Address {
+    InternedString address; /**< The email address. */
+    InternedString name; /**< The display name, often empty. */
+
+    /**
+     * @brief Reads an address object.
+     * @param json An object with "address" and "name" fields.
+     * @return The address.
+     */
+    static Address fromJson(const Json::Value& json);
+
+    /**
+     * @brief Writes the address in the form fromJson reads.
+     * @return The address object.
+     */
+    Json::Value toJson() const;
+};
+
+/**
+ * @struct Attachment
+ * @brief Metadata of a message attachment; the content is downloaded separately.
+ */
+struct Attachment {
+    std::string id; /**< The attachment ID. */
+    std::string filename; /**< The file name. */
+    std::string contentType; /**< The MIME type. */
+    size_t size = 0; /**< The size as reported by the API. */
+    std::string downloadUrl; /**< Path to download the content from. */
+
+    /**
+     * @brief Reads an attachment object.
+     * @param json An element of a message's "attachments" array.
+     * @return The attachment metadata.
+     */
+    static Attachment fromJson(const Json::Value& json);
+
+    /**
+     * @brief Writes the metadata in the form fromJson reads.
+     * @return The attachment object.
+     */
+    Json::Value toJson() const;
+};
+
+/**
+ * @struct MessageSummary
+ * @brief A message as listed by /messages, without its body.
+ */
+struct MessageSummary {
+    std::string id; /**< The message ID. */
+    Address from; /**< The sender. */
+    std::string subject; /**< The subject line. */
+    std::string intro; /**< The first characters of the body. */
+    std::string createdAt; /**< ISO 8601 creation time. */
+    bool seen = false; /**< True once the message was read. */
+    bool hasAttachments = false; /**< True if the message has attachments. */
+    size_t size = 0; /**< The message size in bytes. */
+
+    /**
+     * @brief Reads a message summary.
+     * @param json An element of a /messages "hydra:member" array, or a full message.
+     * @return The summary.
+     */
+    static MessageSummary fromJson(const Json::Value& json);
+
+    /**
+     * @brief Writes the summary in the form fromJson reads.
+     * @return The message object.
+     */
+    Json::Value toJson() const;
+};
+
+/**
+ * @struct Message
+ * @brief A full message as returned by /messages/{id}.
+ */
+struct Message : MessageSummary {
+    std::vector<Address> to; /**< The recipients. */
+    std::string text; /**< The plain text body, may be empty. */
+    std::string html; /**< The HTML body with all parts joined, may be empty. */
+    std::vector<Attachment> attachments; /**< The attachment metadata. */
+
+    /**
+     * @brief Reads a full message.
+     * @param json A /messages/{id} response.
+     * @return The message.
+     */
+    static Message fromJson(const Json::Value& json);
+
+    /**
+     * @brief Writes the message in the form fromJson reads, e.g. to store it.
+     * @return The message object; the HTML is a single part.
+     */
+    Json::Value toJson() const;
+};
+
+} // namespace MailTMAPI
@@ -0,0 +1,131 @@
+#pragma once
+#include "InboxSync.h"
+#include "Message.h"
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file MessageStore.h
+ * @brief Provides an on-disk store of fetched messages per account.
+ */
+
+namespace MailTMAPI {
+
+/**
+ * @class MessageStore
+ * @brief Append-only message log with a memory-mapped index, one per account.
+ *
+ * Each account directory holds two files. messages.log is a sequence of
+ * records, each a checksummed JSON message. messages.idx is an array of
+ * fixed-size entries (ID, createdAt, record offset) that is mapped into
+ * memory, so opening a store with many messages reads no message bodies.
+ *
+ * Appends write the records and sync the log before the index entries are
+ * written and synced. After a crash, open() drops index entries that point
+ * past the log, re-indexes complete records the index missed and truncates
+ * a torn record at the end of the log. Only one process can open an
+ * account's store at a time.
+ */
+class MessageStore {
+public:
+    /**
+     * @struct IndexEntry
+     * @brief One message in the index file.
+     */
+    struct IndexEntry {
+        char id[40]; /**< The message ID, NUL-padded. */
+        char createdAt[40]; /**< ISO 8601 creation time, NUL-padded. */
+        uint64_t offset; /**< Offset of the record in the log. */
+        uint32_t length; /**< Length of the record's JSON. */
+        uint32_t crc; /**< CRC-32 of the record's JSON. */
+    };
+
+private:
+    std::string directory; /**< The account directory. */
+    int logFd; /**< messages.log, locked while the store is open. */
+    int indexFd; /**< messages.idx. */
+    const IndexEntry* entries; /**< The mapped index. */
+    size_t count; /**< Number of entries in the index. */
+    uint64_t logSize; /**< Bytes of complete records in the log. */
+    std::unordered_multimap<uint64_t, size_t> positions; /**< Entry positions by hash of the ID. */
+    mutable std::mutex mutex;
+
+    bool recover();
+    bool remap();
+    void close();
+    std::optional<size_t> find(const std::string& id) const;
+    std::optional<Message> read(const IndexEntry& entry) const;
+
+public:
+    /**
+     * @brief Constructs a closed store.
+     */
+    MessageStore();
+
+    /**
+     * @brief Unmaps and closes the files.
+     */
+    ~MessageStore();
+
+    /**
+     * @brief Opens or creates the store of an account, recovering from an interrupted append.
+     * @param root The directory holding the stores of all accounts.
+     * @param address The account address.
+     * @return True on success; errors are logged.
+     */
+    bool open(const std::string& root, const std::string& address);
+
+    /**
+     * @brief Gets the number of stored messages.
+     * @return The number of messages.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Checks whether a message is stored.
+     * @param id The message ID.
+     * @return True if it is stored.
+     */
+    bool contains(const std::string& id) const;
+
+    /**
+     * @brief Reads a stored message.
+     * @param id The message ID.
+     * @return The message, or std::nullopt if it is not stored or its record is damaged.
+     */
+    std::optional<Message> get(const std::string& id) const;
+
+    /**
+     * @brief Reads the most recently stored messages.
+     * @param limit The maximum number of messages.
+     * @return The messages, newest first.
+     */
+    std::vector<Message> latest(size_t limit) const;
+
+    /**
+     * @brief Stores messages durably; they are on disk when this returns.
+     *
+     * Messages without a createdAt are stored with an empty one. If the index
+     * cannot be mapped again after the write, the store closes; the messages
+     * written still count and the next open() finds them.
+     * @param messages The messages; ones already stored, without an ID, or with fields too long for the index are skipped.
+     * @return The number of messages written.
+     */
+    size_t append(const std::vector<Message>& messages);
+
+    /**
+     * @brief Builds the sync watermark of the stored messages.
+     * @return A cursor that makes syncInbox return only messages newer than the store.
+     */
+    InboxCursor cursor() const;
+
+    // Disable copy semantics
+    MessageStore(const MessageStore&) = delete;
+    MessageStore& operator=(const MessageStore&) = delete;
+};
+
+} // namespace MailTMAPI
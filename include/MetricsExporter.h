@@ -0,0 +1,192 @@
+#pragma once
+#include "Message.h"
+#include "PollScheduler.h"
+#include "RequestMetrics.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @file MetricsExporter.h
+ * @brief Provides a localhost endpoint serving metrics in the Prometheus text format.
+ */
+
+namespace MailTMAPI {
+
+using MetricLabels = std::vector<std::pair<std::string, std::string>>; /**< Label names and values of a sample. */
+
+/**
+ * @class MetricsWriter
+ * @brief Builds a scrape response in the Prometheus text exposition format.
+ *
+ * Each metric family is announced once with family() and followed by its
+ * samples. Histograms are reported in seconds with cumulative buckets.
+ */
+class MetricsWriter {
+private:
+    std::string text; /**< The response built so far. */
+
+public:
+    /**
+     * @brief Starts a metric family.
+     * @param name The family name, e.g. "mailtm_polls_total".
+     * @param type "counter", "gauge" or "histogram".
+     * @param help One line describing the family.
+     */
+    void family(const std::string& name, const std::string& type, const std::string& help);
+
+    /**
+     * @brief Writes one counter or gauge sample.
+     * @param name The family name.
+     * @param value The value.
+     * @param labels The labels, if any.
+     */
+    void sample(const std::string& name, double value, const MetricLabels& labels = {});
+
+    /**
+     * @brief Writes the buckets, sum and count of a microsecond histogram in seconds.
+     *
+     * A LatencyHistogram bucket only counts towards an "le" bound it lies
+     * entirely under, so a bucket is never reported as faster than it was.
+     * @param name The family name.
+     * @param snapshot The histogram.
+     * @param labels The labels, if any.
+     */
+    void histogram(const std::string& name, const HistogramSnapshot& snapshot, const MetricLabels& labels = {});
+
+    /**
+     * @brief Writes the request counters and histograms of every endpoint.
+     * @param metrics The collector, e.g. from MailTM::getMetrics().
+     */
+    void requestMetrics(const RequestMetrics& metrics);
+
+    /**
+     * @brief Writes the number of watched inboxes and the depth of the poll queue.
+     * @param scheduler The scheduler.
+     */
+    void pollScheduler(const PollScheduler& scheduler);
+
+    /**
+     * @brief Gets the response built so far.
+     * @return The text.
+     */
+    const std::string& str() const;
+};
+
+/**
+ * @class WatcherMetrics
+ * @brief Counters an inbox watcher keeps for the exporter.
+ *
+ * Every member can be updated from any thread without locking.
+ */
+class WatcherMetrics {
+private:
+    std::atomic<uint64_t> pollsOk{0}; /**< Polls that read the inbox. */
+    std::atomic<uint64_t> pollsFailed{0}; /**< Polls that failed. */
+    std::atomic<uint64_t> pollsRateLimited{0}; /**< Polls answered with HTTP 429. */
+    std::atomic<uint64_t> messages{0}; /**< Messages shown or written. */
+    LatencyHistogram arrivalLag; /**< From a message's createdAt until it was shown or written. */
+
+public:
+    /**
+     * @brief Counts a poll.
+     * @param status The outcome.
+     */
+    void recordPoll(PollStatus status);
+
+    /**
+     * @brief Counts a message that was just shown or written and records how long it took to get there.
+     * @param message The message; its createdAt is the arrival time.
+     */
+    void recordMessage(const MessageSummary& message);
+
+    /**
+     * @brief Gets the number of polls so far.
+     * @return The count, whatever the outcome.
+     */
+    uint64_t getPolls() const;
+
+    /**
+     * @brief Gets the number of polls that failed or were rate limited.
+     * @return The count.
+     */
+    uint64_t getErrors() const;
+
+    /**
+     * @brief Gets the number of messages shown or written.
+     * @return The count.
+     */
+    uint64_t getMessages() const;
+
+    /**
+     * @brief Writes the poll, message and lag families.
+     * @param writer The scrape response.
+     */
+    void write(MetricsWriter& writer) const;
+};
+
+/**
+ * @class MetricsExporter
+ * @brief A tiny HTTP listener on 127.0.0.1 answering GET /metrics.
+ *
+ * Every scrape calls the registered collectors on the listener thread to
+ * build a fresh response, so the values are current without any periodic
+ * work in between. Connections are served one at a time and closed after
+ * the response; a scraper is the only expected client.
+ */
+class MetricsExporter {
+public:
+    using Collector = std::function<void(MetricsWriter&)>;
+
+private:
+    int listenFd; /**< The listening socket, -1 until started. */
+    uint16_t port; /**< The port actually bound. */
+    std::atomic<bool> running; /**< Cleared to stop the listener. */
+    std::thread listener; /**< Thread serving scrapes. */
+    std::mutex collectorMutex; /**< Protects collectors. */
+    std::vector<Collector> collectors; /**< Called in order on every scrape. */
+
+    void serve();
+    std::string render();
+
+public:
+    /**
+     * @brief Constructs an exporter; call start() to begin listening.
+     */
+    MetricsExporter();
+
+    /**
+     * @brief Stops the listener.
+     */
+    ~MetricsExporter();
+
+    /**
+     * @brief Adds a collector called on every scrape.
+     * @param collector Writes its families into the response.
+     */
+    void addCollector(Collector collector);
+
+    /**
+     * @brief Starts listening on 127.0.0.1.
+     * @param port The port, or 0 to let the OS pick one.
+     * @return True if listening, false if the port could not be bound.
+     */
+    bool start(uint16_t port);
+
+    /**
+     * @brief Gets the port the exporter listens on.
+     * @return The port, 0 before start().
+     */
+    uint16_t getPort() const;
+
+    // Disable copy semantics
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+};
+
+} // namespace MailTMAPI
@@ -0,0 +1,153 @@
+#pragma once
+#include "Message.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <list>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file MockMailServer.h
+ * @brief Provides an in-process stand-in for the mail.tm API, for hermetic tests and benchmarks.
+ */
+
+namespace MailTMAPI {
+
+/**
+ * @struct MockServerOptions
+ * @brief How the stand-in behaves.
+ */
+struct MockServerOptions {
+    std::chrono::microseconds latency{0}; /**< Delay before every response. */
+    std::chrono::microseconds latencyJitter{0}; /**< Extra random delay, up to this much. */
+    double errorRate = 0; /**< Fraction of requests answered with HTTP 500. */
+    double rateLimitRate = 0; /**< Fraction of requests answered with HTTP 429. */
+    size_t inboxSize = 0; /**< Messages every new account starts with. */
+    size_t pageSize = 30; /**< Messages per /messages page, 30 like mail.tm. */
+    std::string domain = "example.com"; /**< The only domain listed by /domains. */
+    uint32_t seed = 42; /**< Seed for the latency jitter and error injection. */
+    uint16_t port = 0; /**< Loopback port to listen on, 0 for a free one. */
+    bool openLogin = false; /**< Log in any address of the domain with any password, creating the account; for load tests. */
+};
+
+/**
+ * @class MockMailServer
+ * @brief Serves /domains, /accounts, /token, /me, /messages and /messages/{id} on a loopback port.
+ *
+ * The server speaks HTTP/1.1 with keep-alive, so MailTM's pooled
+ * connections are reused as they are against the real API. Every
+ * connection gets its own thread, which sleeps for the configured latency
+ * before answering; a benchmark with N concurrent clients therefore sees
+ * the latency once per request rather than queued behind the others.
+ * Tokens are opaque strings without an expiry claim.
+ */
+class MockMailServer {
+private:
+    /**
+     * @struct Account
+     * @brief A registered account and its inbox.
+     */
+    struct Account {
+        std::string id; /**< The account ID. */
+        std::string address; /**< The address it was registered with. */
+        std::string password; /**< The password it was registered with. */
+        std::vector<Message> messages; /**< The inbox, oldest first. */
+    };
+
+    /**
+     * @struct Request
+     * @brief A parsed HTTP request.
+     */
+    struct Request {
+        std::string method; /**< GET, POST or DELETE. */
+        std::string path; /**< The path with its query string. */
+        std::string authorization; /**< The Authorization header, if any. */
+        std::string body; /**< The request body. */
+        bool keepAlive = true; /**< False when the client asked to close the connection. */
+    };
+
+    /**
+     * @struct Connection
+     * @brief An accepted connection and the thread serving it.
+     */
+    struct Connection {
+        int fd; /**< The socket, -1 once closed. */
+        std::thread thread; /**< The thread serving it. */
+    };
+
+    MockServerOptions options; /**< How the server behaves. */
+    int listenFd; /**< The listening socket. */
+    int port; /**< The port the OS picked. */
+    std::atomic<bool> running; /**< Cleared to stop accepting. */
+    std::atomic<uint64_t> requests; /**< Requests answered so far. */
+    std::thread acceptor; /**< Thread accepting connections. */
+
+    std::mutex connectionMutex; /**< Protects connections. */
+    std::list<Connection> connections; /**< Every accepted connection. */
+
+    mutable std::mutex stateMutex; /**< Protects everything below. */
+    std::unordered_map<std::string, Account> accounts; /**< Accounts by address. */
+    std::unordered_map<std::string, std::string> addressByToken; /**< Owner of each issued token. */
+    uint64_t nextId; /**< Counter behind account, token and message IDs. */
+    std::time_t startTime; /**< Creation time of the first message. */
+    std::mt19937 rng; /**< Drives the jitter and error injection. */
+
+    void acceptLoop();
+    void serve(Connection& connection);
+    std::string respond(const Request& request);
+    std::string handle(const Request& request, int& status);
+    Message makeMessage(const Account& account, const std::string& subject, const std::string& text);
+    Account& addAccount(const std::string& address, const std::string& password);
+    const Account* authorize(const Request& request) const;
+
+public:
+    /**
+     * @brief Starts listening on a loopback port.
+     * @param options How the server behaves.
+     * @throws std::runtime_error if the socket cannot be set up.
+     */
+    explicit MockMailServer(MockServerOptions options = {});
+
+    /**
+     * @brief Closes every connection and stops the server threads.
+     */
+    ~MockMailServer();
+
+    MockMailServer(const MockMailServer&) = delete;
+    MockMailServer& operator=(const MockMailServer&) = delete;
+
+    /**
+     * @brief Gets the base URL to hand to MailTM.
+     * @return The URL, e.g. "http://127.0.0.1:40123".
+     */
+    std::string url() const;
+
+    /**
+     * @brief Delivers a new message to a registered account.
+     * @param address The recipient.
+     * @param subject The subject line.
+     * @param text The plain text body.
+     * @return The message ID, or an empty string if the account does not exist.
+     */
+    std::string deliver(const std::string& address, const std::string& subject, const std::string& text);
+
+    /**
+     * @brief Gets the addresses of the registered accounts.
+     * @return The addresses, in no particular order.
+     */
+    std::vector<std::string> addresses() const;
+
+    /**
+     * @brief Gets the number of requests answered so far.
+     * @return The count, including injected errors.
+     */
+    uint64_t requestCount() const;
+};
+
+} // namespace MailTMAPI
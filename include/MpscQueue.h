@@ -0,0 +1,88 @@
+#pragma once
+#include <atomic>
+#include <optional>
+#include <utility>
+
+/**
+ * @file MpscQueue.h
+ * @brief Provides an unbounded lock-free queue with many producers and one consumer.
+ */
+
+namespace MailTMAPI {
+
+/**
+ * @class MpscQueue
+ * @brief Lock-free queue for handing finished work to a single consumer thread.
+ *
+ * Producers link a new node in with one atomic exchange and never wait for
+ * the consumer or each other; the consumer pops without blocking. Values
+ * are handed over by move, so a producer can publish a batch it will not
+ * touch again and the consumer owns it from then on.
+ *
+ * A value pushed while another producer is midway through its own push may
+ * become visible only once that push completes.
+ */
+template <typename T>
+class MpscQueue {
+private:
+    /**
+     * @struct Node
+     * @brief A linked-list node holding one value.
+     */
+    struct Node {
+        std::optional<T> value; /**< Empty for the sentinel node. */
+        std::atomic<Node*> next{nullptr}; /**< The node pushed after this one. */
+    };
+
+    Node* head; /**< Sentinel before the oldest value; only touched by the consumer. */
+    std::atomic<Node*> tail; /**< The newest node; producers swap themselves in here. */
+
+public:
+    /**
+     * @brief Constructs an empty queue.
+     */
+    MpscQueue() : head(new Node), tail(head) {}
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /**
+     * @brief Frees every node, including values never popped.
+     */
+    ~MpscQueue() {
+        while (head) {
+            Node* next = head->next.load(std::memory_order_relaxed);
+            delete head;
+            head = next;
+        }
+    }
+
+    /**
+     * @brief Adds a value; safe to call from any number of threads.
+     * @param value The value to hand over.
+     */
+    void push(T value) {
+        Node* node = new Node;
+        node->value.emplace(std::move(value));
+        Node* previous = tail.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release); // Publishes the value to the consumer
+    }
+
+    /**
+     * @brief Takes the oldest value without blocking; call from the consumer thread only.
+     * @return The value, or std::nullopt if the queue is empty.
+     */
+    std::optional<T> pop() {
+        Node* next = head->next.load(std::memory_order_acquire);
+        if (!next) {
+            return std::nullopt;
+        }
+        std::optional<T> value = std::move(next->value);
+        next->value.reset(); // next becomes the new sentinel
+        delete head;
+        head = next;
+        return value;
+    }
+};
+
+} // namespace MailTMAPI
@@ -0,0 +1,207 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file PollScheduler.h
+ * @brief Provides a central scheduler that decides when each watched inbox is polled.
+ */
+
+namespace MailTMAPI {
+
+/**
+ * @enum PollStatus
+ * @brief Outcome of a single inbox poll.
+ */
+enum class PollStatus {
+    Ok, /**< The inbox was read successfully. */
+    Error, /**< The request failed (network error or server error). */
+    RateLimited /**< The server answered HTTP 429. */
+};
+
+/**
+ * @struct PollResult
+ * @brief What a poll task reports back to the scheduler.
+ */
+struct PollResult {
+    PollStatus status = PollStatus::Ok; /**< Whether the poll succeeded. */
+    size_t newMessages = 0; /**< Number of messages that were new in this poll. */
+
+    /**
+     * @brief Builds a result from an HTTP status code.
+     * @param httpStatus The response code (0 for a transport error).
+     * @param newMessages Number of new messages seen.
+     * @return The matching poll result.
+     */
+    static PollResult fromHttpStatus(long httpStatus, size_t newMessages);
+};
+
+/**
+ * @struct PollQueueDepth
+ * @brief How far behind the scheduler is at one moment.
+ */
+struct PollQueueDepth {
+    size_t polling = 0; /**< Inboxes whose poll is running. */
+    size_t overdue = 0; /**< Inboxes that are due but not polled yet. */
+};
+
+/**
+ * @struct PollPolicy
+ * @brief Tuning knobs for adaptive intervals and error backoff.
+ */
+struct PollPolicy {
+    std::chrono::milliseconds initialInterval{10000}; /**< Interval for a newly added inbox. */
+    std::chrono::milliseconds minInterval{2000}; /**< Fastest polling, used for busy inboxes. */
+    std::chrono::milliseconds maxInterval{60000}; /**< Slowest polling, used for idle inboxes. */
+    std::chrono::milliseconds maxBackoff{300000}; /**< Cap for the error backoff delay. */
+    double idleGrowth = 1.5; /**< Interval multiplier after a poll without new mail. */
+    double jitter = 0.1; /**< Random +/- fraction applied to every regular interval. */
+};
+
+/**
+ * @class PollScheduler
+ * @brief Owns every watched inbox and polls each one when it is due.
+ *
+ * Inboxes are kept in a priority queue ordered by their next due time. The
+ * interval of each inbox adapts to its recent arrivals: it halves after a
+ * poll that found new mail and grows while the inbox stays idle. Errors and
+ * HTTP 429 switch to exponential backoff with full jitter. First polls are
+ * spread randomly over the initial interval so thousands of inboxes added
+ * together do not all fire in the same second.
+ *
+ * Poll tasks run on the scheduler thread and report back through the done
+ * callback, which may be invoked later from any thread. An inbox is never
+ * polled again before its previous poll reported back.
+ */
+class PollScheduler {
+public:
+    using DoneCallback = std::function<void(PollResult)>;
+    using PollTask = std::function<void(DoneCallback)>;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @struct Entry
+     * @brief Scheduling state of one inbox.
+     */
+    struct Entry {
+        PollTask task;
+        std::chrono::milliseconds interval;
+        unsigned errorStreak = 0;
+        unsigned generation = 0; /**< Bumped on every reschedule; stale heap items are skipped. */
+        Clock::time_point due; /**< When the next poll is due. */
+        bool polling = false;
+        bool pollRequested = false; /**< pollNow() was called while a poll was running. */
+    };
+
+    /**
+     * @struct HeapItem
+     * @brief A due time in the priority queue.
+     */
+    struct HeapItem {
+        Clock::time_point due;
+        std::string key;
+        unsigned generation;
+        bool operator>(const HeapItem& other) const { return due > other.due; }
+    };
+
+    PollPolicy policy;
+    std::unordered_map<std::string, Entry> entries;
+    std::priority_queue<HeapItem, std::vector<HeapItem>, std::greater<HeapItem>> heap;
+    mutable std::mutex mutex;
+    std::condition_variable changed;
+    std::mt19937 rng;
+    std::thread dispatcher;
+    bool running;
+
+    void run();
+    void schedule(const std::string& key, Entry& entry, Clock::time_point due);
+    void finish(const std::string& key, unsigned generation, PollResult result);
+    std::chrono::milliseconds jittered(std::chrono::milliseconds interval);
+    std::chrono::milliseconds backoff(const Entry& entry, PollStatus status);
+
+public:
+    /**
+     * @brief Constructs a scheduler; call start() to begin polling.
+     * @param policy Interval and backoff settings.
+     */
+    explicit PollScheduler(PollPolicy policy = PollPolicy());
+
+    /**
+     * @brief Stops the scheduler thread.
+     */
+    ~PollScheduler();
+
+    /**
+     * @brief Starts the scheduler thread.
+     */
+    void start();
+
+    /**
+     * @brief Stops the scheduler thread; polls already running still report back harmlessly.
+     */
+    void stop();
+
+    /**
+     * @brief Adds an inbox; its first poll happens at a random point within the initial interval.
+     * @param key A unique name for the inbox (e.g. the address).
+     * @param task The function that polls the inbox and calls done with the result.
+     */
+    void addAccount(const std::string& key, PollTask task);
+
+    /**
+     * @brief Stops watching an inbox.
+     * @param key The inbox name passed to addAccount.
+     */
+    void removeAccount(const std::string& key);
+
+    /**
+     * @brief Polls an inbox as soon as possible, e.g. after a push notification.
+     * @param key The inbox name passed to addAccount.
+     */
+    void pollNow(const std::string& key);
+
+    /**
+     * @brief Gets the current regular polling interval of an inbox.
+     * @param key The inbox name passed to addAccount.
+     * @return The interval, or zero if the inbox is unknown.
+     */
+    std::chrono::milliseconds getInterval(const std::string& key) const;
+
+    /**
+     * @brief Gets the number of watched inboxes.
+     * @return The inbox count.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Counts the inboxes being polled and those waiting past their due time.
+     * @return The queue depth.
+     */
+    PollQueueDepth getQueueDepth() const;
+
+    /**
+     * @brief Computes the next regular interval after a successful poll.
+     * @param policy The policy to apply.
+     * @param current The current interval.
+     * @param newMessages Number of new messages found by the poll.
+     * @return The adapted interval, clamped to the policy bounds.
+     */
+    static std::chrono::milliseconds adaptInterval(const PollPolicy& policy, std::chrono::milliseconds current,
+                                                   size_t newMessages);
+
+    // Disable copy semantics
+    PollScheduler(const PollScheduler&) = delete;
+    PollScheduler& operator=(const PollScheduler&) = delete;
+};
+
+} // namespace MailTMAPI
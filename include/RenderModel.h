@@ -0,0 +1,45 @@
+#pragma once
+#include "HtmlText.h"
+#include "Message.h"
+#include "TextLayout.h"
+#include <string>
+#include <vector>
+
+/**
+ * @file RenderModel.h
+ * @brief Provides the display-ready form of a message.
+ */
+
+namespace MailTMAPI {
+
+/**
+ * @struct RenderModel
+ * @brief Everything the GUI shows of a message, prepared when it arrives.
+ *
+ * Built on the fetch thread so the render loop never chooses between body
+ * parts, converts HTML, splits words or looks for links. Only measuring
+ * the words is left, because glyph advances come from the font, which
+ * belongs to the render thread; that happens once per message and is
+ * cached by the GUI.
+ */
+struct RenderModel {
+    std::string id; /**< The message ID, used as the layout cache key. */
+    std::vector<LayoutWord> from; /**< "From: <address>", empty if the sender is unknown. */
+    std::vector<LayoutWord> subject; /**< "Subject: <subject>", empty if there is no subject. */
+    std::vector<LayoutWord> preview; /**< The start of the body for the message list. */
+    std::vector<LayoutWord> text; /**< The text part, empty if there is none. */
+    std::vector<LayoutWord> html; /**< The HTML part as text, empty if there is none. */
+    std::vector<HtmlLink> links; /**< Links of the HTML part, listed under the body in the popup. */
+    std::vector<std::vector<LayoutWord>> linkLabels; /**< What the popup shows for each link: its anchor text, or the URL. */
+
+    static constexpr size_t previewWordLimit = 256; /**< More than the three preview lines can ever hold. */
+
+    /**
+     * @brief Prepares a message for display.
+     * @param message The full message.
+     * @return The render model.
+     */
+    static RenderModel build(const Message& message);
+};
+
+} // namespace MailTMAPI
@@ -0,0 +1,190 @@
+#pragma once
+#include "CurlWrapper.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @file RequestMetrics.h
+ * @brief Provides lock-free latency histograms and per-endpoint request statistics.
+ */
+
+namespace MailTMAPI {
+
+/**
+ * @struct HistogramSnapshot
+ * @brief A copy of a LatencyHistogram taken at one point in time.
+ */
+struct HistogramSnapshot {
+    std::vector<uint64_t> buckets; /**< Count per bucket, see LatencyHistogram::upperBound. */
+    uint64_t count = 0; /**< Number of recorded values. */
+    uint64_t sumMicros = 0; /**< Sum of the recorded values. */
+
+    /**
+     * @brief Estimates a percentile.
+     * @param fraction The percentile as a fraction, e.g. 0.99.
+     * @return The upper bound of the bucket holding it in microseconds, or 0 when empty.
+     */
+    uint64_t percentile(double fraction) const;
+
+    /**
+     * @brief Gets the mean value.
+     * @return The mean in microseconds, or 0 when empty.
+     */
+    double mean() const;
+};
+
+/**
+ * @class LatencyHistogram
+ * @brief A fixed-size log-linear histogram of microsecond values that any thread can record into.
+ *
+ * Values below 8 get a bucket each; above that every power of two is split
+ * into 8 buckets, so a reported percentile is at most 12.5% above the true
+ * value. Recording is a few relaxed atomic increments with no locks or
+ * allocation, cheap enough to run on every request.
+ */
+class LatencyHistogram {
+public:
+    static constexpr size_t subBuckets = 8; /**< Buckets per power of two. */
+    static constexpr size_t bucketCount = 38 * subBuckets; /**< Covers values up to 2^40 us, about 12 days. */
+
+    /**
+     * @brief Records a value.
+     * @param micros The value in microseconds.
+     */
+    void record(uint64_t micros);
+
+    /**
+     * @brief Copies the current counts.
+     * @return The snapshot; concurrent records may be partly included.
+     */
+    HistogramSnapshot snapshot() const;
+
+    /**
+     * @brief Gets the bucket a value falls into.
+     * @param micros The value in microseconds.
+     * @return The bucket index.
+     */
+    static size_t bucketFor(uint64_t micros);
+
+    /**
+     * @brief Gets the largest value a bucket holds.
+     * @param bucket The bucket index.
+     * @return The inclusive upper bound in microseconds.
+     */
+    static uint64_t upperBound(size_t bucket);
+
+private:
+    std::array<std::atomic<uint64_t>, bucketCount> buckets{}; /**< Count per bucket. */
+    std::atomic<uint64_t> count{0}; /**< Number of recorded values. */
+    std::atomic<uint64_t> sumMicros{0}; /**< Sum of the recorded values. */
+};
+
+/**
+ * @enum Endpoint
+ * @brief The API operations requests are grouped by.
+ */
+enum class Endpoint {
+    Domains, /**< GET /domains */
+    Register, /**< POST /accounts */
+    Token, /**< POST /token */
+    Me, /**< GET /me */
+    Inbox, /**< GET /messages, any page */
+    Message, /**< GET /messages/{id} */
+    DeleteAccount, /**< DELETE /accounts/{id} */
+    Other, /**< Anything else */
+    Count /**< Number of endpoints, not an endpoint. */
+};
+
+/**
+ * @struct EndpointSnapshot
+ * @brief Statistics of one endpoint at one point in time.
+ */
+struct EndpointSnapshot {
+    std::string endpoint; /**< Endpoint name, e.g. "message". */
+    uint64_t requests = 0; /**< Requests completed, including failures. */
+    uint64_t transportErrors = 0; /**< Requests that got no HTTP response. */
+    std::array<uint64_t, 6> statusClasses{}; /**< Responses by status class; index 2 counts 2xx, and so on. */
+    uint64_t bytesSent = 0; /**< Request bytes, headers included. */
+    uint64_t bytesReceived = 0; /**< Response bytes, headers included. */
+    HistogramSnapshot dns; /**< Name resolution time. */
+    HistogramSnapshot connect; /**< TCP connect time after resolution; 0 on a reused connection. */
+    HistogramSnapshot tls; /**< TLS handshake time; 0 for plain HTTP or a reused connection. */
+    HistogramSnapshot firstByte; /**< Time from the start until the first response byte. */
+    HistogramSnapshot total; /**< Time for the whole transfer. */
+    HistogramSnapshot processing; /**< Time spent parsing and indexing a good inbox or message response. */
+};
+
+/**
+ * @class RequestMetrics
+ * @brief Collects the timing, size and status of every request, grouped by endpoint.
+ *
+ * One instance can be shared by several MailTM clients, e.g. the workers of
+ * the inbox daemon, and read from any thread while they record. Network
+ * time (dns to total) and our own processing time are kept apart so a slow
+ * inbox can be blamed on the right side.
+ */
+class RequestMetrics {
+private:
+    /**
+     * @struct EndpointStats
+     * @brief The live counters of one endpoint.
+     */
+    struct EndpointStats {
+        std::atomic<uint64_t> requests{0}; /**< Requests completed. */
+        std::atomic<uint64_t> transportErrors{0}; /**< Requests without an HTTP response. */
+        std::array<std::atomic<uint64_t>, 6> statusClasses{}; /**< Responses by status class. */
+        std::atomic<uint64_t> bytesSent{0}; /**< Request bytes. */
+        std::atomic<uint64_t> bytesReceived{0}; /**< Response bytes. */
+        LatencyHistogram dns; /**< Name resolution time. */
+        LatencyHistogram connect; /**< TCP connect time. */
+        LatencyHistogram tls; /**< TLS handshake time. */
+        LatencyHistogram firstByte; /**< Time to the first response byte. */
+        LatencyHistogram total; /**< Transfer time. */
+        LatencyHistogram processing; /**< Time to parse the response. */
+    };
+
+    std::array<EndpointStats, static_cast<size_t>(Endpoint::Count)> endpoints; /**< Counters by endpoint. */
+
+public:
+    /**
+     * @brief Records a finished request.
+     * @param endpoint The endpoint it went to.
+     * @param timing The breakdown reported by the handle.
+     * @param transportOk False if no HTTP response arrived.
+     */
+    void record(Endpoint endpoint, const RequestTiming& timing, bool transportOk);
+
+    /**
+     * @brief Records the time spent turning a response into a result.
+     * @param endpoint The endpoint the response came from.
+     * @param micros The time in microseconds.
+     */
+    void recordProcessing(Endpoint endpoint, uint64_t micros);
+
+    /**
+     * @brief Copies the statistics of every endpoint that saw traffic.
+     * @return One entry per endpoint with at least one request.
+     */
+    std::vector<EndpointSnapshot> snapshot() const;
+
+    /**
+     * @brief Finds the endpoint a request goes to.
+     * @param method The HTTP method.
+     * @param url The request URL, absolute or a path.
+     * @return The endpoint.
+     */
+    static Endpoint classify(const std::string& method, std::string_view url);
+
+    /**
+     * @brief Gets the name of an endpoint.
+     * @param endpoint The endpoint.
+     * @return The name, e.g. "message".
+     */
+    static const char* name(Endpoint endpoint);
+};
+
+} // namespace MailTMAPI
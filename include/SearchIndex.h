@@ -0,0 +1,119 @@
+#pragma once
+#include "Message.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file SearchIndex.h
+ * @brief Provides full-text search over received messages.
+ */
+
+namespace MailTMAPI {
+
+/**
+ * @struct SearchQuery
+ * @brief A parsed search: every term, prefix and the sender filter must match.
+ */
+struct SearchQuery {
+    std::vector<std::string> terms; /**< Whole words, lowercased. */
+    std::vector<std::string> prefixes; /**< Word beginnings, lowercased. */
+    std::string sender; /**< A sender address or "@domain", lowercased; empty for any sender. */
+
+    /**
+     * @brief Parses a search box string.
+     *
+     * Words are split like message text, so "example.com" needs both words.
+     * A word ending in '*' is a prefix and "from:" sets the sender filter,
+     * e.g. "verif* code from:@example.com".
+     * @param text The query text.
+     * @return The query.
+     */
+    static SearchQuery parse(std::string_view text);
+
+    /**
+     * @brief Checks whether the query has nothing to match.
+     * @return True if there are no terms, prefixes or sender filter.
+     */
+    bool empty() const;
+};
+
+/**
+ * @class SearchIndex
+ * @brief Inverted index over the subject, sender, text and HTML of messages.
+ *
+ * Every word maps to the sorted list of messages containing it, so a query
+ * walks the shortest list and looks its entries up in the others instead of
+ * scanning messages. Words are found by hash; a sorted view of them serves
+ * prefix queries. HTML is converted to text first, so tags are not indexed
+ * but link URLs are. Messages are added as they are fetched and searches
+ * may run on other threads at the same time. A thread that must not stall,
+ * such as a render loop, can learn how long its searches waited for an add
+ * through setLockWaitSink().
+ */
+class SearchIndex {
+private:
+    using Postings = std::vector<uint32_t>; /**< Message numbers in the order they were added. */
+
+    std::unordered_map<std::string, uint32_t> wordNumbers; /**< Position in postings of each word. */
+    std::vector<Postings> postings; /**< Messages containing each word. */
+    std::map<std::string_view, uint32_t> sortedWords; /**< The keys of wordNumbers in order, for prefix lookups. */
+    std::unordered_map<std::string, Postings> senders; /**< Postings by sender address and by "@domain". */
+    std::unordered_map<std::string, uint32_t> numbers; /**< Message number by ID, to skip messages added twice. */
+    std::vector<std::string> messageIds; /**< Message ID by message number. */
+    mutable std::shared_mutex mutex; /**< Shared by searches, exclusive while adding. */
+
+public:
+    static constexpr size_t maxWordLength = 64; /**< Longer words, e.g. tokens in URLs, are indexed by their start. */
+    using Clock = std::chrono::steady_clock;
+    using LockWaitSink = void (*)(Clock::time_point start, Clock::time_point end); /**< Receives one lock wait. */
+
+    /**
+     * @brief Reports the calling thread's waits for the index lock, e.g. to a frame profiler.
+     * @param sink Called on this thread after each search that had to wait for an add; nullptr to stop.
+     */
+    static void setLockWaitSink(LockWaitSink sink);
+
+    /**
+     * @brief Adds a message; a message that is already indexed is ignored.
+     * @param message The fetched message.
+     */
+    void add(const Message& message);
+
+    /**
+     * @brief Finds the messages matching a query.
+     * @param query The query.
+     * @param limit The maximum number of results.
+     * @return Message IDs, most recently added first; empty for an empty query.
+     */
+    std::vector<std::string> search(const SearchQuery& query, size_t limit = 100) const;
+
+    /**
+     * @brief Gets the number of indexed messages.
+     * @return The number of messages.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Removes every message, e.g. when the account is deleted.
+     */
+    void clear();
+
+    /**
+     * @brief Splits text into lowercased words the way messages and queries are indexed.
+     *
+     * Words are runs of ASCII letters and digits and of non-ASCII UTF-8
+     * characters, so verification codes and words in other scripts stay whole.
+     * @param text The text.
+     * @param onWord Receives each word.
+     */
+    static void tokenize(std::string_view text, const std::function<void(std::string_view)>& onWord);
+};
+
+} // namespace MailTMAPI
@@ -0,0 +1,80 @@
+#pragma once
+#include <functional>
+#include <string>
+
+/**
+ * @file SseParser.h
+ * @brief Provides an incremental parser for server-sent event streams.
+ */
+
+namespace MailTMAPI {
+
+/**
+ * @struct SseEvent
+ * @brief A single dispatched server-sent event.
+ */
+struct SseEvent {
+    std::string type; /**< The event type, "message" when the stream does not name one. */
+    std::string data; /**< The event payload; multiple data lines are joined with '\n'. */
+    std::string id; /**< The last event ID seen on the stream. */
+};
+
+/**
+ * @class SseParser
+ * @brief Parses a text/event-stream body chunk by chunk.
+ *
+ * Chunks may split lines and events at any byte; complete events are
+ * delivered to the callback as soon as their terminating blank line arrives.
+ */
+class SseParser {
+public:
+    using EventCallback = std::function<void(const SseEvent&)>;
+
+private:
+    EventCallback onEvent; /**< Receives every dispatched event. */
+    std::string line; /**< The current, not yet terminated line. */
+    std::string eventType; /**< Event type of the event being built. */
+    std::string data; /**< Data of the event being built. */
+    std::string lastEventId; /**< ID carried over between events as the spec requires. */
+    bool hasData; /**< True once a data field was seen for the current event. */
+    bool skipLineFeed; /**< True if the previous chunk ended in '\r'. */
+    long retryMs; /**< Reconnection delay requested by the server, or -1. */
+
+    void processLine();
+    void dispatch();
+
+public:
+    /**
+     * @brief Constructs a parser.
+     * @param onEvent Callback invoked for each complete event.
+     */
+    explicit SseParser(EventCallback onEvent);
+
+    /**
+     * @brief Feeds the next chunk of the stream.
+     * @param chunk Pointer to the bytes.
+     * @param size Number of bytes.
+     */
+    void feed(const char* chunk, size_t size);
+
+    /**
+     * @brief Discards a partially received line and event, keeping the last event ID.
+     *
+     * Call before feeding a new connection after the previous one dropped.
+     */
+    void reset();
+
+    /**
+     * @brief Gets the last event ID, to resume with a Last-Event-ID header.
+     * @return The last event ID, or an empty string.
+     */
+    const std::string& getLastEventId() const;
+
+    /**
+     * @brief Gets the reconnection delay sent by the server.
+     * @return The delay in milliseconds, or -1 if the server sent none.
+     */
+    long getRetryMs() const;
+};
+
+} // namespace MailTMAPI
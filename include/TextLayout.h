@@ -0,0 +1,150 @@
+#pragma once
+#include <array>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file TextLayout.h
+ * @brief Provides word wrapping with cached glyph advances, independent of the renderer.
+ */
+
+namespace MailTMAPI {
+
+/**
+ * @class GlyphAdvances
+ * @brief Horizontal advance of every glyph of one font at one size.
+ *
+ * ASCII advances are read into a table up front; other code points are
+ * looked up once and remembered. Measuring a word is then a sum over the
+ * table instead of building a text object.
+ */
+class GlyphAdvances {
+public:
+    using AdvanceFunction = std::function<float(char32_t)>;
+
+private:
+    AdvanceFunction source; /**< Queries the font for code points not in the tables. */
+    std::array<float, 128> ascii; /**< Advances of the ASCII range. */
+    mutable std::unordered_map<char32_t, float> others; /**< Advances of other code points seen so far. */
+
+public:
+    /**
+     * @brief Builds the tables from a font query.
+     * @param source Returns the advance of a code point.
+     */
+    explicit GlyphAdvances(AdvanceFunction source);
+
+    /**
+     * @brief Gets the advance of one code point.
+     * @param codePoint The code point.
+     * @return The advance in pixels.
+     */
+    float advance(char32_t codePoint) const;
+
+    /**
+     * @brief Measures a UTF-8 string.
+     * @param text The text.
+     * @return The sum of the advances.
+     */
+    float measure(std::string_view text) const;
+};
+
+/**
+ * @struct LayoutWord
+ * @brief A word ready for layout.
+ */
+struct LayoutWord {
+    std::string text; /**< The UTF-8 word, without whitespace. */
+    bool isLink = false; /**< True if the word is a URL. */
+};
+
+/**
+ * @struct LayoutOptions
+ * @brief Constraints for laying out a block of text.
+ */
+struct LayoutOptions {
+    float maxWidth = 720; /**< Width lines are wrapped at. */
+    float lineHeight = 20; /**< Distance between line tops. */
+    size_t maxLines = 0; /**< Lines after which the text is cut with "...", 0 for no limit. */
+};
+
+/**
+ * @struct LayoutRun
+ * @brief A piece of a line drawn in one style.
+ */
+struct LayoutRun {
+    std::string text; /**< The UTF-8 text of the run. */
+    float x = 0; /**< Offset from the left edge of the block. */
+    float y = 0; /**< Offset from the top of the block. */
+    float width = 0; /**< The measured width. */
+    bool isLink = false; /**< True if the run is a URL. */
+};
+
+/**
+ * @struct LayoutResult
+ * @brief A laid-out block of text.
+ */
+struct LayoutResult {
+    std::vector<LayoutRun> runs; /**< Runs in reading order. */
+    size_t lineCount = 0; /**< The number of lines. */
+    float height = 0; /**< lineCount times the line height, at least one line. */
+    bool truncated = false; /**< True if maxLines cut the text short. */
+};
+
+/**
+ * @class TextLayout
+ * @brief Wraps text into lines and finds the links in it.
+ *
+ * Each word is measured once from the advance table, so laying out a
+ * message is linear in its length. URLs become their own runs; a URL
+ * broken at a space before a piece such as "?a=1" or "/path" is joined
+ * back together.
+ */
+class TextLayout {
+public:
+    /**
+     * @brief Lays out a block of text.
+     * @param text The UTF-8 text; runs of whitespace are collapsed.
+     * @param advances The glyph advances of the font and size to use.
+     * @param options The wrapping constraints.
+     * @return The runs with their positions relative to the block.
+     */
+    static LayoutResult layout(const std::string& text, const GlyphAdvances& advances, const LayoutOptions& options);
+
+    /**
+     * @brief Lays out words prepared earlier, possibly on another thread.
+     * @param words Words from prepare.
+     * @param advances The glyph advances of the font and size to use.
+     * @param options The wrapping constraints.
+     * @return The runs with their positions relative to the block.
+     */
+    static LayoutResult layout(const std::vector<LayoutWord>& words, const GlyphAdvances& advances,
+                               const LayoutOptions& options);
+
+    /**
+     * @brief Does the font-independent part of layout: splitting words and finding links.
+     * @param text The UTF-8 text.
+     * @param maxWords Words after this many are dropped, 0 for no limit.
+     * @return The words in order.
+     */
+    static std::vector<LayoutWord> prepare(const std::string& text, size_t maxWords = 0);
+
+    /**
+     * @brief Splits text at whitespace and rejoins URLs that were split apart.
+     * @param text The text.
+     * @return The words.
+     */
+    static std::vector<std::string> splitWords(const std::string& text);
+
+    /**
+     * @brief Checks whether a word is a URL.
+     * @param word The word.
+     * @return True if it starts with http:// or https://.
+     */
+    static bool isLink(const std::string& word);
+};
+
+} // namespace MailTMAPI
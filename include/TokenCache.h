@@ -0,0 +1,123 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+/**
+ * @file TokenCache.h
+ * @brief Provides a thread-safe cache of authentication tokens keyed by address.
+ */
+
+namespace MailTMAPI {
+
+/**
+ * @class TokenCache
+ * @brief Caches JWTs per address and refreshes them shortly before they expire.
+ *
+ * The expiry of each token is read from its JWT "exp" claim. A background
+ * thread fetches a new token refreshMargin before the old one expires, so
+ * callers normally never wait for the /token round trip. Tokens can also be
+ * persisted to a file so a restarted process starts with valid tokens.
+ */
+class TokenCache {
+public:
+    using Clock = std::chrono::system_clock;
+
+    /**
+     * @brief Function that requests a fresh token for an address and password.
+     */
+    using FetchFunction = std::function<std::optional<std::string>(const std::string&, const std::string&)>;
+
+private:
+    /**
+     * @struct Entry
+     * @brief A cached token and what is needed to refresh it.
+     */
+    struct Entry {
+        std::string token;
+        std::string password; /**< Kept in memory only, empty for tokens loaded from disk. */
+        Clock::time_point expiresAt;
+    };
+
+    FetchFunction fetch;
+    std::chrono::seconds refreshMargin;
+    std::unordered_map<std::string, Entry> entries;
+    std::string storePath;
+    bool dirty; /**< The store file is behind the entries. */
+    Clock::time_point saveAt; /**< When the refresher writes the store while dirty. */
+    mutable std::mutex mutex;
+    std::condition_variable changed;
+    std::thread refresher;
+    bool running;
+
+    void refreshLoop();
+    void markDirty();
+    std::string serialize() const;
+    void writeStore(const std::string& contents);
+    void startRefresher();
+
+public:
+    /**
+     * @brief Constructs a cache.
+     * @param fetch Function used to request new tokens (called without the cache lock held).
+     * @param refreshMargin How long before expiry a token is refreshed and stops being handed out.
+     */
+    explicit TokenCache(FetchFunction fetch, std::chrono::seconds refreshMargin = std::chrono::seconds(60));
+
+    /**
+     * @brief Stops the background refresh thread.
+     */
+    ~TokenCache();
+
+    /**
+     * @brief Gets a cached token that is not about to expire.
+     *
+     * A token is only returned for the password it was obtained with; a
+     * token loaded from disk is returned as stored until put() records its
+     * password after the next successful login.
+     * @param address The account address.
+     * @param password The account password.
+     * @return The token, or std::nullopt if none is cached, the password differs or it expires within the margin.
+     */
+    std::optional<std::string> get(const std::string& address, const std::string& password);
+
+    /**
+     * @brief Stores a token and schedules its refresh.
+     * @param address The account address.
+     * @param password The account password.
+     * @param token The JWT returned by /token.
+     */
+    void put(const std::string& address, const std::string& password, const std::string& token);
+
+    /**
+     * @brief Drops a token the server rejected.
+     * @param address The account address.
+     */
+    void invalidate(const std::string& address);
+
+    /**
+     * @brief Persists tokens to a file and loads any still-valid tokens from it.
+     *
+     * Changes are written by the background thread within a second, and on destruction.
+     * @param path The file to use; it is written with owner-only permissions.
+     */
+    void setStorePath(const std::string& path);
+
+    /**
+     * @brief Reads the "exp" claim of a JWT.
+     * @param token The JWT.
+     * @return The expiry time, or std::nullopt if the token has no readable claim.
+     */
+    static std::optional<Clock::time_point> decodeExpiry(const std::string& token);
+
+    // Disable copy semantics
+    TokenCache(const TokenCache&) = delete;
+    TokenCache& operator=(const TokenCache&) = delete;
+};
+
+} // namespace MailTMAPI
@@ -0,0 +1,82 @@
+#pragma once
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+/**
+ * @file VirtualList.h
+ * @brief Provides row geometry for lists that only draw what is on screen.
+ */
+
+namespace MailTMAPI {
+
+/**
+ * @class VirtualList
+ * @brief Prefix sums of row heights for a vertically scrolling list.
+ *
+ * Rows are stacked top to bottom with a fixed spacing after each one. The
+ * top of every row is kept in a sorted array, so the first visible row and
+ * the row under the cursor are found by binary search and a frame only
+ * touches the rows that are actually on screen.
+ */
+class VirtualList {
+private:
+    std::vector<float> tops; /**< tops[i] is the top of row i; the last entry is the total height. */
+    std::vector<float> heights; /**< Height of each row, without the spacing. */
+    float spacing; /**< Gap after each row. */
+
+public:
+    /**
+     * @brief Constructs an empty list.
+     * @param spacing The gap left after each row.
+     */
+    explicit VirtualList(float spacing = 0);
+
+    /**
+     * @brief Adds a row at the bottom.
+     * @param height The height of the row, without the spacing.
+     */
+    void append(float height);
+
+    /**
+     * @brief Removes every row.
+     */
+    void clear();
+
+    /**
+     * @brief Gets the number of rows.
+     * @return The number of rows.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Gets the height of all rows including their spacing.
+     * @return The total height.
+     */
+    float totalHeight() const;
+
+    /**
+     * @brief Gets the top of a row.
+     * @param index The row, less than size().
+     * @return The offset of the row from the top of the list.
+     */
+    float rowTop(size_t index) const;
+
+    /**
+     * @brief Gets the rows whose top lies in a range.
+     * @param top The upper edge of the range.
+     * @param bottom The lower edge of the range, inclusive.
+     * @return The first row and one past the last row; equal if there are none.
+     */
+    std::pair<size_t, size_t> rowsStartingIn(float top, float bottom) const;
+
+    /**
+     * @brief Finds the row at an offset, e.g. for a mouse click.
+     * @param y The offset from the top of the list.
+     * @return The row, or std::nullopt if the offset is outside every row or in the spacing.
+     */
+    std::optional<size_t> rowAt(float y) const;
+};
+
+} // namespace MailTMAPI
@@ -0,0 +1,142 @@
+#include "BatchRenderer.h"
+#include <cmath>
+
+namespace {
+
+// Function to append a quad as two triangles
+void appendQuad(std::vector<sf::Vertex>& out, float left, float top, float right, float bottom, const sf::Color& color,
+                float u1 = 1, float v1 = 1, float u2 = 1, float v2 = 1) {
+    out.emplace_back(sf::Vector2f(left, top), color, sf::Vector2f(u1, v1));
+    out.emplace_back(sf::Vector2f(right, top), color, sf::Vector2f(u2, v1));
+    out.emplace_back(sf::Vector2f(left, bottom), color, sf::Vector2f(u1, v2));
+    out.emplace_back(sf::Vector2f(left, bottom), color, sf::Vector2f(u1, v2));
+    out.emplace_back(sf::Vector2f(right, top), color, sf::Vector2f(u2, v1));
+    out.emplace_back(sf::Vector2f(right, bottom), color, sf::Vector2f(u2, v2));
+}
+
+} // namespace
+
+// Constructor for BatchRenderer
+BatchRenderer::BatchRenderer(const sf::Font& font) : font(font), layers(1), activeLayers(1), drawCalls(0) {}
+
+// Method to rasterize the printable ASCII range into the atlas of each size
+void BatchRenderer::preload(std::initializer_list<unsigned int> sizes) {
+    for (unsigned int size : sizes) {
+        for (sf::Uint32 c = 32; c < 127; ++c) {
+            font.getGlyph(c, size, false);
+        }
+    }
+}
+
+// Method to start a new layer, reusing one from an earlier frame if there is one
+void BatchRenderer::beginLayer() {
+    if (activeLayers == layers.size()) {
+        layers.emplace_back();
+    }
+    activeLayers++;
+}
+
+// Method to add a rectangle and its outline as untextured quads
+void BatchRenderer::addRect(float x, float y, float width, float height, const sf::Color& fill, float outlineThickness,
+                            const sf::Color& outlineColor) {
+    auto& shapes = layers[activeLayers - 1].shapes;
+    appendQuad(shapes, x, y, x + width, y + height, fill);
+
+    if (outlineThickness > 0 && outlineColor.a > 0) { // Outline around the outside, as sf::Shape draws it
+        float t = outlineThickness;
+        appendQuad(shapes, x - t, y - t, x + width + t, y, outlineColor);
+        appendQuad(shapes, x - t, y + height, x + width + t, y + height + t, outlineColor);
+        appendQuad(shapes, x - t, y, x, y + height, outlineColor);
+        appendQuad(shapes, x + width, y, x + width + t, y + height, outlineColor);
+    }
+}
+
+// Method to add a line of text from the atlas
+float BatchRenderer::addText(const std::string& text, unsigned int fontSize, float x, float y, const sf::Color& color) {
+    return buildText(font, text, fontSize, color, false, x, y, layers[activeLayers - 1].glyphs[fontSize]);
+}
+
+// Method to add prebuilt glyphs, moving them into place
+void BatchRenderer::addVertices(const std::vector<sf::Vertex>& vertices, unsigned int fontSize, float x, float y) {
+    auto& glyphs = layers[activeLayers - 1].glyphs[fontSize];
+    glyphs.reserve(glyphs.size() + vertices.size());
+    for (sf::Vertex vertex : vertices) {
+        vertex.position.x += x;
+        vertex.position.y += y;
+        glyphs.push_back(vertex);
+    }
+}
+
+// Method to draw the frame with one call per non-empty array
+void BatchRenderer::flush(sf::RenderTarget& target) {
+    drawCalls = 0;
+    for (size_t i = 0; i < activeLayers; ++i) {
+        Layer& layer = layers[i];
+        if (!layer.shapes.empty()) {
+            target.draw(layer.shapes.data(), layer.shapes.size(), sf::Triangles);
+            drawCalls++;
+        }
+        for (auto& [fontSize, glyphs] : layer.glyphs) {
+            if (!glyphs.empty()) {
+                target.draw(glyphs.data(), glyphs.size(), sf::Triangles, sf::RenderStates(&font.getTexture(fontSize)));
+                drawCalls++;
+            }
+            glyphs.clear(); // Keeps the capacity for the next frame
+        }
+        layer.shapes.clear();
+    }
+    activeLayers = 1;
+}
+
+// Method to get the draw calls of the last frame
+size_t BatchRenderer::getDrawCalls() const {
+    return drawCalls;
+}
+
+// Function to measure text by summing advances and kerning
+float BatchRenderer::measureText(const sf::Font& font, const std::string& text, unsigned int fontSize) {
+    sf::String decoded = sf::String::fromUtf8(text.data(), text.data() + text.size());
+    float width = 0;
+    sf::Uint32 previous = 0;
+    for (std::size_t i = 0; i < decoded.getSize(); ++i) {
+        sf::Uint32 current = decoded[i];
+        width += font.getKerning(previous, current, fontSize) + font.getGlyph(current, fontSize, false).advance;
+        previous = current;
+    }
+    return width;
+}
+
+// Function to build glyph quads with the same metrics and baseline as sf::Text
+float BatchRenderer::buildText(const sf::Font& font, const std::string& text, unsigned int fontSize,
+                               const sf::Color& color, bool underlined, float x, float y, std::vector<sf::Vertex>& out) {
+    sf::String decoded = sf::String::fromUtf8(text.data(), text.data() + text.size());
+    const float padding = 1; // The atlas leaves a transparent pixel around each glyph
+    const float baseline = y + fontSize;
+    float penX = x;
+    sf::Uint32 previous = 0;
+
+    out.reserve(out.size() + decoded.getSize() * 6);
+    for (std::size_t i = 0; i < decoded.getSize(); ++i) {
+        sf::Uint32 current = decoded[i];
+        penX += font.getKerning(previous, current, fontSize);
+        previous = current;
+
+        const sf::Glyph& glyph = font.getGlyph(current, fontSize, false);
+        if (current != ' ' && current != '\t') { // Whitespace only advances the pen
+            const sf::FloatRect& bounds = glyph.bounds;
+            const sf::IntRect& rect = glyph.textureRect;
+            appendQuad(out, penX + bounds.left - padding, baseline + bounds.top - padding,
+                       penX + bounds.left + bounds.width + padding, baseline + bounds.top + bounds.height + padding,
+                       color, rect.left - padding, rect.top - padding, rect.left + rect.width + padding,
+                       rect.top + rect.height + padding);
+        }
+        penX += glyph.advance;
+    }
+
+    if (underlined && penX > x) { // Uses the white texel every atlas page reserves at (1, 1)
+        float thickness = font.getUnderlineThickness(fontSize);
+        float top = std::floor(baseline + font.getUnderlinePosition(fontSize) - thickness / 2 + 0.5f);
+        appendQuad(out, x - 1, top, penX, top + std::floor(thickness + 0.5f), color);
+    }
+    return penX - x;
+}
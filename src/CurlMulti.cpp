@@ -0,0 +1,117 @@
+#include "CurlMulti.h"
+
+using namespace MailTMAPI;
+
+// Constructor for CurlMulti that creates the multi handle and starts the event loop
+CurlMulti::CurlMulti(long maxConnections) : multi(curl_multi_init()), running(true), inFlight(0) {
+    if (!multi) { // Check if multi handle initialization failed
+        throw std::runtime_error("Failed to initialize CURL multi handle");
+    }
+    if (maxConnections > 0) { // Optionally cap the number of open connections
+        curl_multi_setopt(multi, CURLMOPT_MAX_TOTAL_CONNECTIONS, maxConnections);
+    }
+    curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX); // Multiplex over HTTP/2 when possible
+
+    loop = std::thread(&CurlMulti::run, this);
+}
+
+// Destructor for CurlMulti that stops the loop and aborts unfinished transfers
+CurlMulti::~CurlMulti() {
+    running = false;
+    curl_multi_wakeup(multi); // Interrupt curl_multi_poll so the loop sees the flag
+    if (loop.joinable()) {
+        loop.join();
+    }
+
+    // Complete everything that never finished so no caller waits forever
+    std::vector<CURL*> unfinished;
+    for (const auto& entry : active) {
+        unfinished.push_back(entry.first);
+    }
+    for (CURL* easy : unfinished) {
+        complete(easy, CURLE_ABORTED_BY_CALLBACK);
+    }
+    std::vector<Transfer> leftovers;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        leftovers.swap(pending);
+    }
+    for (auto& transfer : leftovers) {
+        inFlight--;
+        transfer.onDone(std::move(transfer.handle), CURLE_ABORTED_BY_CALLBACK);
+    }
+
+    curl_multi_cleanup(multi);
+}
+
+// Method to queue a handle for the event loop thread
+void CurlMulti::submit(std::unique_ptr<CurlWrapper> handle, CompletionCallback onDone) {
+    handle->prepare(); // Apply headers now, the loop thread only adds the handle
+    inFlight++;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        pending.push_back(Transfer{std::move(handle), std::move(onDone)});
+    }
+    curl_multi_wakeup(multi); // Wake the loop so the transfer starts immediately
+}
+
+// Method to report how many transfers are still running or queued
+size_t CurlMulti::getInFlight() const {
+    return inFlight;
+}
+
+// Method to check whether the caller runs on the event loop thread
+bool CurlMulti::isLoopThread() const {
+    return std::this_thread::get_id() == loop.get_id();
+}
+
+// Method to hand newly submitted transfers to the multi handle
+void CurlMulti::addPending() {
+    std::vector<Transfer> batch;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        batch.swap(pending);
+    }
+    for (auto& transfer : batch) {
+        CURL* easy = transfer.handle->getHandle();
+        CURLMcode res = curl_multi_add_handle(multi, easy);
+        active.emplace(easy, std::move(transfer));
+        if (res != CURLM_OK) { // Report a transfer that could not be started as failed
+            complete(easy, CURLE_FAILED_INIT);
+        }
+    }
+}
+
+// Method to detach a finished transfer and run its completion callback
+void CurlMulti::complete(CURL* easy, CURLcode result) {
+    auto it = active.find(easy);
+    if (it == active.end()) {
+        return;
+    }
+    curl_multi_remove_handle(multi, easy);
+    Transfer transfer = std::move(it->second);
+    active.erase(it);
+    inFlight--;
+    transfer.onDone(std::move(transfer.handle), result);
+}
+
+// Event loop that drives every transfer on a single thread
+void CurlMulti::run() {
+    while (running) {
+        addPending();
+
+        int stillRunning = 0;
+        curl_multi_perform(multi, &stillRunning);
+
+        // Dispatch every transfer that finished during this round
+        int queued = 0;
+        while (CURLMsg* msg = curl_multi_info_read(multi, &queued)) {
+            if (msg->msg == CURLMSG_DONE) {
+                complete(msg->easy_handle, msg->data.result);
+            }
+        }
+
+        // Sleep until there is socket activity, a new submission or the timeout
+        curl_multi_poll(multi, nullptr, 0, 1000, nullptr);
+    }
+}
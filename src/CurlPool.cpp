@@ -0,0 +1,61 @@
+#include "CurlPool.h"
+
+using namespace MailTMAPI;
+
+// Constructor for CurlPool that creates the share handle used by every pooled handle
+CurlPool::CurlPool(size_t maxIdle) : share(curl_share_init()), maxIdle(maxIdle) {
+    if (!share) { // Check if share handle initialization failed
+        throw std::runtime_error("Failed to initialize CURL share handle");
+    }
+
+    curl_share_setopt(share, CURLSHOPT_LOCKFUNC, lockShare);
+    curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, unlockShare);
+    curl_share_setopt(share, CURLSHOPT_USERDATA, this);
+
+    // Share resolved hosts, TLS sessions and open connections between handles
+    curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+}
+
+// Destructor for CurlPool that cleans up the handles before the share handle
+CurlPool::~CurlPool() {
+    idle.clear(); // Easy handles must be gone before the share handle is cleaned up
+    curl_share_cleanup(share);
+}
+
+// Lock callback used by CURL to protect shared data between threads
+void CurlPool::lockShare(CURL*, curl_lock_data data, curl_lock_access, void* userp) {
+    static_cast<CurlPool*>(userp)->shareLocks[data].lock();
+}
+
+// Unlock callback used by CURL to release shared data
+void CurlPool::unlockShare(CURL*, curl_lock_data data, void* userp) {
+    static_cast<CurlPool*>(userp)->shareLocks[data].unlock();
+}
+
+// Method to take an idle handle from the pool or create a new one
+std::unique_ptr<CurlWrapper> CurlPool::acquire() {
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        if (!idle.empty()) { // Reuse the most recently released handle
+            std::unique_ptr<CurlWrapper> handle = std::move(idle.back());
+            idle.pop_back();
+            return handle;
+        }
+    }
+    return std::make_unique<CurlWrapper>(share); // No idle handle, create a new one
+}
+
+// Method to return a handle to the pool after a request
+void CurlPool::release(std::unique_ptr<CurlWrapper> handle) {
+    if (!handle) {
+        return;
+    }
+    handle->reset(); // Clear headers and method state before the next request
+
+    std::lock_guard<std::mutex> lock(poolMutex);
+    if (idle.size() < maxIdle) { // Keep the handle unless the pool is already full
+        idle.push_back(std::move(handle));
+    }
+}
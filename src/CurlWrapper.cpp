@@ -3,10 +3,24 @@
 using namespace MailTMAPI;
 
 // Constructor for CurlWrapper that initializes a CURL handle
-CurlWrapper::CurlWrapper() : curl(curl_easy_init()), headers(nullptr) {
+CurlWrapper::CurlWrapper() : CurlWrapper(nullptr) {}
+
+// Constructor for CurlWrapper that attaches the handle to a share handle
+CurlWrapper::CurlWrapper(CURLSH* share) : curl(curl_easy_init()), headers(nullptr), share(share) {
     if (!curl) { // Check if CURL initialization failed
         throw std::runtime_error("Failed to initialize CURL");
     }
+    applyDefaults();
+}
+
+// Method to apply the options shared by every request made with this handle
+void CurlWrapper::applyDefaults() {
+    if (share) { // Use the shared DNS, TLS session and connection caches
+        setOption(CURLOPT_SHARE, static_cast<const void*>(share));
+    }
+    setOption(CURLOPT_NOSIGNAL, 1L); // Handles are used from worker threads
+    setOption(CURLOPT_TCP_KEEPALIVE, 1L); // Keep idle connections alive between polls
+    setOption(CURLOPT_DNS_CACHE_TIMEOUT, 300L); // Cache resolved hosts for five minutes
 }
 
 // Destructor for CurlWrapper that cleans up allocated resources
@@ -33,6 +47,20 @@ void CurlWrapper::setOption(CURLoption option, size_t (*value)(void*, size_t, si
     }
 }
 
+// Method to set a CURL progress callback option
+void CurlWrapper::setOption(CURLoption option, int (*value)(void*, curl_off_t, curl_off_t, curl_off_t, curl_off_t)) {
+    if (curl_easy_setopt(curl, option, value) != CURLE_OK) { // Check if setting the function option fails
+        throw std::runtime_error("Failed to set CURL function option");
+    }
+}
+
+// Method to set a CURL option that takes a long value
+void CurlWrapper::setOption(CURLoption option, long value) {
+    if (curl_easy_setopt(curl, option, value) != CURLE_OK) { // Check if setting the option fails
+        throw std::runtime_error("Failed to set CURL option");
+    }
+}
+
 // Method to add a header to the CURL request
 void CurlWrapper::addHeader(const std::string& header) {
     headers = curl_slist_append(headers, header.c_str()); // Append the header to the list
@@ -49,14 +77,31 @@ void CurlWrapper::clearHeaders() {
     }
 }
 
-// Method to perform the CURL request
-CURLcode CurlWrapper::perform() {
+// Method to reset the handle for reuse while keeping its connection and caches
+void CurlWrapper::reset() {
+    curl_easy_reset(curl); // Drop per-request options such as the URL, method and body
+    clearHeaders();
+    applyDefaults(); // curl_easy_reset also drops the share handle, so reattach it
+}
+
+// Method to apply the pending headers to the CURL handle
+void CurlWrapper::prepare() {
     if (headers) { // Set the headers for the CURL request if they exist
         curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
     }
+}
+
+// Method to perform the CURL request
+CURLcode CurlWrapper::perform() {
+    prepare();
     return curl_easy_perform(curl); // Perform the CURL request
 }
 
+// Method to expose the raw handle for use with a CURL multi handle
+CURL* CurlWrapper::getHandle() const {
+    return curl;
+}
+
 // Method to retrieve the HTTP response code from the CURL request
 long CurlWrapper::getResponseCode() {
     long responseCode = 0;
@@ -64,6 +109,34 @@ long CurlWrapper::getResponseCode() {
     return responseCode; // Return the response code
 }
 
+// Method to read the timing breakdown, sizes and status of the last request
+RequestTiming CurlWrapper::getTiming() const {
+    curl_off_t nameLookup = 0, connect = 0, appConnect = 0, startTransfer = 0, total = 0;
+    curl_off_t uploaded = 0, downloaded = 0;
+    long requestSize = 0, headerSize = 0;
+    RequestTiming timing;
+    // CURL reports times cumulatively from the start of the request, in microseconds
+    curl_easy_getinfo(curl, CURLINFO_NAMELOOKUP_TIME_T, &nameLookup);
+    curl_easy_getinfo(curl, CURLINFO_CONNECT_TIME_T, &connect);
+    curl_easy_getinfo(curl, CURLINFO_APPCONNECT_TIME_T, &appConnect);
+    curl_easy_getinfo(curl, CURLINFO_STARTTRANSFER_TIME_T, &startTransfer);
+    curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME_T, &total);
+    curl_easy_getinfo(curl, CURLINFO_SIZE_UPLOAD_T, &uploaded);
+    curl_easy_getinfo(curl, CURLINFO_SIZE_DOWNLOAD_T, &downloaded);
+    curl_easy_getinfo(curl, CURLINFO_REQUEST_SIZE, &requestSize);
+    curl_easy_getinfo(curl, CURLINFO_HEADER_SIZE, &headerSize);
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &timing.status);
+
+    timing.dnsMicros = nameLookup;
+    timing.connectMicros = connect > nameLookup ? connect - nameLookup : 0; // Reused connections report 0
+    timing.tlsMicros = appConnect > connect ? appConnect - connect : 0; // 0 when there was no handshake
+    timing.firstByteMicros = startTransfer;
+    timing.totalMicros = total;
+    timing.bytesSent = static_cast<uint64_t>(requestSize) + static_cast<uint64_t>(uploaded);
+    timing.bytesReceived = static_cast<uint64_t>(headerSize) + static_cast<uint64_t>(downloaded);
+    return timing;
+}
+
 // Method to retrieve the response as a string
 std::string CurlWrapper::getResponse() {
     char* response;
@@ -72,9 +145,11 @@ std::string CurlWrapper::getResponse() {
 }
 
 // Move constructor for CurlWrapper
-CurlWrapper::CurlWrapper(CurlWrapper&& other) noexcept : curl(other.curl), headers(other.headers) {
+CurlWrapper::CurlWrapper(CurlWrapper&& other) noexcept
+    : curl(other.curl), headers(other.headers), share(other.share) {
     other.curl = nullptr; // Reset the moved object's CURL handle
     other.headers = nullptr; // Reset the moved object's headers
+    other.share = nullptr; // The share handle is not owned, just forget it
 }
 
 // Move assignment operator for CurlWrapper
@@ -88,8 +163,10 @@ CurlWrapper& CurlWrapper::operator=(CurlWrapper&& other) noexcept {
         }
         curl = other.curl; // Transfer the CURL handle from the other object
         headers = other.headers; // Transfer the headers from the other object
+        share = other.share; // Transfer the (non-owned) share handle
         other.curl = nullptr; // Reset the moved object's CURL handle
         other.headers = nullptr; // Reset the moved object's headers
+        other.share = nullptr; // Reset the moved object's share handle
     }
     return *this; // Return the current object
 }
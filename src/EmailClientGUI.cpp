@@ -1,14 +1,24 @@
 #include "EmailClientGUI.h"
+#include "Logger.h"
 #include <thread>
 #include <random>
-#include <iostream>
-#include <unordered_map>
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <map>
 
 EmailClientGUI::EmailClientGUI()
     : window(sf::VideoMode(800, 600), "Temporary Email Client")
+    , layoutCache(font)
+    , batch(font)
     , isEmailGenerated(false)
+    , messageRows(messageSpacing)
     , scrollOffset(0)
+    , inboxActive(false)
+    , needsRedraw(true)
+    , showProfiler(false)
     , isGenerating(false)
+    , isSearchActive(false)
     , isCustomUsername(false)
     , isInputActive(false)
     , isPopupOpen(false)
@@ -32,7 +42,7 @@ EmailClientGUI::EmailClientGUI()
     for (const auto& path : fontPaths) {
         if (font.loadFromFile(path)) {
             fontLoaded = true;
-            std::cout << "Loaded font from: " << path << std::endl;
+            LOG_INFO("Loaded font from: ", path);
             break;
         }
     }
@@ -40,10 +50,14 @@ EmailClientGUI::EmailClientGUI()
     if (!fontLoaded) {
         throw std::runtime_error("Failed to load font");
     }
+    batch.preload({12, 14, 16, 18, 20, 24}); // Every size the interface uses, so the atlas is ready before the first frame
 
     inputPrompt.setFont(font);
     inputPrompt.setCharacterSize(20);
     inputPrompt.setFillColor(sf::Color::White);
+
+    mailTm.setSearchIndex(&searchIndex); // Every fetched message becomes searchable
+    pollScheduler.start();
 }
 
 bool EmailClientGUI::isValidUsername(const std::string& username) {
@@ -63,24 +77,23 @@ bool EmailClientGUI::isValidUsername(const std::string& username) {
 }
 
 void EmailClientGUI::generateEmail() {
-    std::cout << "Starting email generation..." << std::endl;
+    LOG_INFO("Starting email generation...");
 
     std::string domain = mailTm.getAvailableDomain();
     if (domain.empty()) {
-        std::cerr << "Failed to get domain" << std::endl;
+        LOG_ERROR("Failed to get domain");
         return;
     }
-    std::cout << "Got domain: " << domain << std::endl;
+    LOG_INFO("Got domain: ", domain);
 
     std::string username;
     if (isCustomUsername) {
         // Validate custom username
         if (!isValidUsername(customUsername)) {
-            std::cerr << "Invalid username. Username must:\n"
-                     << "• Start with a letter\n"
-                     << "• Be at least 3 characters long\n"
-                     << "• Contain only letters, numbers, dots, underscores, or hyphens"
-                     << std::endl;
+            LOG_WARN("Invalid username. Username must:\n",
+                     "• Start with a letter\n",
+                     "• Be at least 3 characters long\n",
+                     "• Contain only letters, numbers, dots, underscores, or hyphens");
             return;
         }
         username = customUsername;
@@ -95,111 +108,138 @@ void EmailClientGUI::generateEmail() {
     password = "pass" + std::to_string(std::random_device{}());
     email = username + "@" + domain;
 
-    std::cout << "Attempting to register: " << email << std::endl;
+    LOG_INFO("Attempting to register: ", email);
 
     auto result = mailTm.registerEmail(email, password);
     if (result) {
         accountId = *result;
         isEmailGenerated = true;
-        std::cout << "Email registered successfully!" << std::endl;
+        inboxActive = true;
+        LOG_INFO("Email registered successfully!");
 
-        std::thread([this]() {
-            std::cout << "Starting inbox check thread..." << std::endl;
-            checkInboxThread();
+        uint64_t generation;
+        {
+            std::lock_guard<std::mutex> lock(inboxMutex);
+            generation = ++inboxGeneration;
+        }
+        // The thread gets its own copies, deleteAccount clears the members while it may still be logging in
+        std::thread([this, address = email, accountPassword = password, streamAccountId = accountId, generation]() {
+            LOG_DEBUG("Starting inbox check thread...");
+            checkInboxThread(address, accountPassword, streamAccountId, generation);
         }).detach();
     } else {
-        std::cerr << "Failed to register email. Please try a different username." << std::endl;
+        LOG_ERROR("Failed to register email. Please try a different username.");
         if (isCustomUsername) {
             customUsername.clear(); // Clear the invalid username
         }
     }
 }
 
-void EmailClientGUI::checkInboxThread() {
-    std::cout << "Authenticating with email: " << email << std::endl;
+void EmailClientGUI::checkInboxThread(std::string address, std::string accountPassword, std::string streamAccountId,
+                                      uint64_t generation) {
+    LOG_INFO("Authenticating with email: ", address);
 
-    auto tokenOpt = mailTm.authenticate(email, password);
+    auto tokenOpt = mailTm.authenticate(address, accountPassword);
     if (!tokenOpt) {
-        std::cerr << "Authentication failed" << std::endl;
+        LOG_ERROR("Authentication failed");
         return;
     }
 
-    std::string token = *tokenOpt;
-    std::cout << "Authentication successful" << std::endl;
+    LOG_INFO("Authentication successful");
 
-    std::unordered_map<std::string, bool> seenMessageIds;
+    std::string inboxKey = address;
+    auto cursor = std::make_shared<MailTMAPI::InboxCursor>(); // Watermark of the messages already shown
+    auto retries = std::make_shared<std::map<std::string, int>>(); // Messages whose fetch failed, with the attempts so far
 
-    while (isEmailGenerated) {
-        std::cout << "Checking for new messages..." << std::endl;
-        auto newMessages = mailTm.checkInbox(token);
+    // The scheduler polls this inbox from now on, adapting the interval to incoming mail
+    std::unique_lock<std::mutex> inboxLock(inboxMutex);
+    if (generation != inboxGeneration) { // Deleted while we were logging in; its poll task must not outlive it
+        LOG_INFO("Account was deleted before its inbox was watched");
+        return;
+    }
+    pollScheduler.addAccount(inboxKey, [this, address, accountPassword, cursor, retries, inboxKey](MailTMAPI::PollScheduler::DoneCallback done) {
+        LOG_DEBUG("Checking for new messages...");
+        auto token = mailTm.authenticate(address, accountPassword); // A cache hit, refreshed before the token expires
+        if (!token) {
+            done(MailTMAPI::PollResult::fromHttpStatus(0, 0));
+            return;
+        }
+        long status = 0;
+        auto newMessages = mailTm.syncInbox(*token, *cursor, status); // Only what arrived since the last poll
+        if (status == 401) { // Token expired or revoked, the next poll logs in again
+            mailTm.invalidateToken(address);
+            done(MailTMAPI::PollResult::fromHttpStatus(status, 0));
+            return;
+        }
 
-        {
-            std::lock_guard<std::mutex> lock(messagesMutex);
-            for (const auto& message : newMessages) {
-                std::string messageId = message["id"].asString();
-                if (seenMessageIds.find(messageId) == seenMessageIds.end()) {
-                    // Get full message content
-                    Json::Value fullMessage = mailTm.getMessage(token, messageId);
-                    messages.push_back(fullMessage);  // Store full message instead
-                    seenMessageIds[messageId] = true;
-                }
+        std::vector<std::string> unseenIds;
+        for (const auto& message : newMessages) {
+            unseenIds.push_back(message.id);
+        }
+        for (const auto& retry : *retries) { // The cursor is past these already, fetch them again
+            if (std::find(unseenIds.begin(), unseenIds.end(), retry.first) == unseenIds.end()) {
+                unseenIds.push_back(retry.first);
             }
         }
 
-        std::cout << "Total messages: " << messages.size() << std::endl;
-        std::this_thread::sleep_for(std::chrono::seconds(10));
+        // Fetch the full messages concurrently
+        std::vector<std::optional<MailTMAPI::Message>> fullMessages = mailTm.getMessages(*token, unseenIds);
+
+        // Hand the finished batch to the render loop; it picks it up on its next iteration
+        MessageBatch published{inboxKey, {}};
+        for (size_t i = 0; i < fullMessages.size(); ++i) {
+            if (fullMessages[i]) {
+                published.messages.push_back(MailTMAPI::RenderModel::build(*fullMessages[i])); // All text work happens here
+                retries->erase(unseenIds[i]);
+            } else if (++(*retries)[unseenIds[i]] >= maxFetchAttempts) { // Most likely deleted, stop asking
+                LOG_WARN("Giving up on message ", unseenIds[i]);
+                retries->erase(unseenIds[i]);
+            }
+        }
+        if (!published.messages.empty()) {
+            LOG_INFO("New messages: ", published.messages.size());
+            incomingMessages.push(std::move(published));
+            invalidate(); // Show the new messages
+        }
+
+        done(MailTMAPI::PollResult::fromHttpStatus(status, unseenIds.size()));
+    });
+    inboxLock.unlock();
+    pollScheduler.pollNow(inboxKey); // Check right away instead of waiting for the spread-out first poll
+
+    // Stream push updates on this thread so new mail is polled without waiting for the next interval;
+    // every reconnection uses the current token
+    bool streamed = mailTm.streamInbox(address, accountPassword, streamAccountId, [this, &inboxKey](const Json::Value&) {
+        pollScheduler.pollNow(inboxKey);
+    }, inboxActive);
+    if (!streamed) {
+        LOG_WARN("Push updates unavailable, relying on polling");
     }
 }
 
 void EmailClientGUI::drawMainInterface() {
     // Draw header with gradient effect
-    sf::RectangleShape header(sf::Vector2f(800, 100));
-    sf::RectangleShape headerGradient(sf::Vector2f(800, 5));
-    header.setFillColor(sf::Color(40, 44, 52));  // Darker, more professional blue
-    headerGradient.setFillColor(sf::Color(65, 105, 225));  // Royal Blue
-    headerGradient.setPosition(0, 100);
-    window.draw(header);
-    window.draw(headerGradient);
+    batch.addRect(0, 0, 800, 100, sf::Color(40, 44, 52));  // Darker, more professional blue
+    batch.addRect(0, 100, 800, 5, sf::Color(65, 105, 225));  // Royal Blue
 
     if (!isEmailGenerated) {
         // Center container for controls
-        sf::RectangleShape controlContainer(sf::Vector2f(600, 180));
-        controlContainer.setPosition(100, 120);
-        controlContainer.setFillColor(sf::Color(50, 54, 62));
-        window.draw(controlContainer);
+        batch.addRect(100, 120, 600, 180, sf::Color(50, 54, 62));
 
         // Title
-        sf::Text title("Temporary Email Generator", font, 24);
-        title.setPosition(270, 130);
-        title.setFillColor(sf::Color::White);
-        window.draw(title);
+        batch.addText("Temporary Email Generator", 24, 270, 130, sf::Color::White);
 
         // Toggle button with better styling
-        sf::RectangleShape toggleButton(sf::Vector2f(200, 40));
-        toggleButton.setPosition(150, 180);
-        toggleButton.setFillColor(sf::Color(65, 105, 225));
-
-        sf::Text toggleText(isCustomUsername ? "Use Random Username" : "Use Custom Username", font, 16);
-        toggleText.setPosition(170, 190);
-        toggleText.setFillColor(sf::Color::White);
-
-        window.draw(toggleButton);
-        window.draw(toggleText);
+        batch.addRect(150, 180, 200, 40, sf::Color(65, 105, 225));
+        batch.addText(isCustomUsername ? "Use Random Username" : "Use Custom Username", 16, 170, 190, sf::Color::White);
 
         if (isCustomUsername) {
             // Username input box with better styling
-            sf::RectangleShape inputBox(sf::Vector2f(300, 40));
-            inputBox.setPosition(150, 230);
-            inputBox.setFillColor(isInputActive ? sf::Color::White : sf::Color(200, 200, 200));
-            inputBox.setOutlineThickness(2);
-            inputBox.setOutlineColor(isInputActive ? sf::Color(65, 105, 225) : sf::Color::Transparent);
-            window.draw(inputBox);
+            batch.addRect(150, 230, 300, 40, isInputActive ? sf::Color::White : sf::Color(200, 200, 200), 2,
+                          isInputActive ? sf::Color(65, 105, 225) : sf::Color::Transparent);
 
             // Show username input
-            sf::Text usernameText(customUsername + (isInputActive ? "_" : ""), font, 16);
-            usernameText.setPosition(160, 240);
-            usernameText.setFillColor(sf::Color::Black);
-            window.draw(usernameText);
+            batch.addText(customUsername + (isInputActive ? "_" : ""), 16, 160, 240, sf::Color::Black);
 
             // Helper text with better formatting
             std::vector<std::string> helperLines = {
@@ -210,210 +250,95 @@ void EmailClientGUI::drawMainInterface() {
 
             float yPos = 280;
             for (const auto& line : helperLines) {
-                sf::Text helperText(line, font, 12);
-                helperText.setPosition(150, yPos);
-                helperText.setFillColor(sf::Color(150, 150, 150));
-                window.draw(helperText);
+                batch.addText(line, 12, 150, yPos, sf::Color(150, 150, 150));
                 yPos += 15;
             }
         }
 
         // Generate button with better styling
-        sf::RectangleShape generateButton(sf::Vector2f(200, 40));
-        generateButton.setPosition(450, 230);
-        generateButton.setFillColor(sf::Color(46, 204, 113));  // Green color
-
-        sf::Text buttonText("Generate Email", font, 16);
-        float textWidth = buttonText.getLocalBounds().width;
-        buttonText.setPosition(450 + (200 - textWidth) / 2, 240);
-        buttonText.setFillColor(sf::Color::White);
+        batch.addRect(450, 230, 200, 40, sf::Color(46, 204, 113));  // Green color
 
-        window.draw(generateButton);
-        window.draw(buttonText);
+        float textWidth = BatchRenderer::measureText(font, "Generate Email", 16);
+        batch.addText("Generate Email", 16, 450 + (200 - textWidth) / 2, 240, sf::Color::White);
     } else {
         // Email info display
-        sf::Text emailText("Your temporary email: " + email, font, 18);
-        emailText.setPosition(20, 20);
-        emailText.setFillColor(sf::Color::White);
-        window.draw(emailText);
+        batch.addText("Your temporary email: " + email, 18, 20, 20, sf::Color::White);
 
         // Delete button with better styling
-        sf::RectangleShape deleteButton(sf::Vector2f(150, 30));
-        deleteButton.setPosition(620, 20);
-        deleteButton.setFillColor(sf::Color(231, 76, 60));  // Red color
+        batch.addRect(620, 20, 150, 30, sf::Color(231, 76, 60));  // Red color
 
-        sf::Text deleteText("Delete Account", font, 14);
-        float deleteTextWidth = deleteText.getLocalBounds().width;
-        deleteText.setPosition(620 + (150 - deleteTextWidth) / 2, 25);
-        deleteText.setFillColor(sf::Color::White);
+        float deleteTextWidth = BatchRenderer::measureText(font, "Delete Account", 14);
+        batch.addText("Delete Account", 14, 620 + (150 - deleteTextWidth) / 2, 25, sf::Color::White);
 
-        window.draw(deleteButton);
-        window.draw(deleteText);
+        // Search box, filtering the list as the query is typed
+        batch.addRect(20, 60, 580, 30, isSearchActive ? sf::Color::White : sf::Color(200, 200, 200), 2,
+                      isSearchActive ? sf::Color(65, 105, 225) : sf::Color::Transparent);
+        if (searchText.empty() && !isSearchActive) {
+            batch.addText("Search: words, prefix*, from:address", 14, 30, 66, sf::Color(120, 120, 120));
+        } else {
+            batch.addText(searchText + (isSearchActive ? "_" : ""), 14, 30, 66, sf::Color::Black);
+        }
+        if (!searchText.empty()) {
+            batch.addText(std::to_string(shownMessages.size()) + " of " + std::to_string(messages.size()), 14, 620, 66,
+                          sf::Color(200, 200, 200));
+        }
     }
 }
 
 void EmailClientGUI::drawMessages() {
-    std::lock_guard<std::mutex> lock(messagesMutex);
-    float yPos = 110 - scrollOffset;
     activeLinks.clear();
+    batch.beginLayer();
 
     // Message container background
-    sf::RectangleShape messagesContainer(sf::Vector2f(780, 480));
-    messagesContainer.setPosition(10, 110);
-    messagesContainer.setFillColor(sf::Color(45, 49, 57));
-    window.draw(messagesContainer);
-
-    for (const auto& message : messages) {
-        if (yPos >= 110 && yPos <= 540) {
-            // Message box with better styling
-            sf::RectangleShape messageBox(sf::Vector2f(760, 120));
-            messageBox.setPosition(20, yPos);
-            messageBox.setFillColor(sf::Color(50, 54, 62));
-            messageBox.setOutlineThickness(1);
-            messageBox.setOutlineColor(sf::Color(70, 74, 82));
-            window.draw(messageBox);
-
-            // From header
-            sf::Text fromText("From: " + message["from"]["address"].asString(), font, 16);
-            fromText.setPosition(30, yPos + 10);
-            fromText.setFillColor(sf::Color(200, 200, 200));
-            window.draw(fromText);
-
-            // Subject with better contrast
-            sf::Text subjectText("Subject: " + message["subject"].asString(), font, 16);
-            subjectText.setPosition(30, yPos + 35);
-            subjectText.setFillColor(sf::Color::White);
-            window.draw(subjectText);
-
-            // Body text processing (rest of the code remains the same)
-            std::string bodyText;
-            if (message.isMember("text")) {
-                bodyText = message["text"].asString();
-            } else if (message.isMember("html")) {
-                bodyText = stripHtmlExceptLinks(message["html"].asString());
-            } else if (message.isMember("intro")) {
-                bodyText = message["intro"].asString();
-            }
-
-            // Draw body text with improved formatting
-            float textX = 30;  // Increased margin
-            float textY = yPos + 60;
-            float maxWidth = 720;  // Adjusted for new margins
-
-            std::vector<std::string> words = splitIntoWords(bodyText);
-            std::string currentLine;
-            float lineX = textX;
-
-            for (const auto& word : words) {
-                bool isLink = word.find("http://") == 0 || word.find("https://") == 0;
-
-                sf::Text testText(currentLine + " " + word, font, 14);
-                if (testText.getLocalBounds().width > maxWidth && !currentLine.empty()) {
-                    sf::Text lineText(currentLine, font, 14);
-                    lineText.setPosition(lineX, textY);
-                    lineText.setFillColor(sf::Color(180, 180, 180));
-                    window.draw(lineText);
-
-                    textY += 20;
-                    currentLine = word;
-                    lineX = textX;
-                } else {
-                    if (!currentLine.empty()) currentLine += " ";
-                    currentLine += word;
-                }
-
-                if (isLink) {
-                    sf::Text linkText(word, font, 14);
-                    linkText.setPosition(lineX, textY);
-                    linkText.setFillColor(sf::Color(100, 149, 237));  // Softer blue for links
-                    linkText.setStyle(sf::Text::Underlined);
-
-                    ClickableLink link;
-                    link.bounds = linkText.getGlobalBounds();
-                    link.url = word;
-                    activeLinks.push_back(link);
-
-                    window.draw(linkText);
-                    lineX += linkText.getGlobalBounds().width + 5;
-                }
-            }
-        }
-        yPos += 130;
+    batch.addRect(10, 110, 780, 480, sf::Color(45, 49, 57));
+
+    // Only visit the rows whose top is inside the container, found by binary search
+    auto visibleRows = messageRows.rowsStartingIn(scrollOffset, scrollOffset + 430);
+    for (size_t index = visibleRows.first; index < visibleRows.second; ++index) {
+        const auto& message = messages[shownMessages[index]];
+        float yPos = 110 + messageRows.rowTop(index) - scrollOffset;
+
+        // Message box with better styling
+        batch.addRect(20, yPos, 760, messageHeight, sf::Color(50, 54, 62), 1, sf::Color(70, 74, 82));
+
+        // Header lines and body preview were prepared on arrival; they are measured once and replayed every frame
+        LayoutCache::Style fromStyle;
+        fromStyle.fontSize = 16;
+        fromStyle.options.maxWidth = 740;
+        fromStyle.options.maxLines = 1;
+        fromStyle.color = sf::Color(200, 200, 200);
+        auto& fromBlock = layoutCache.get(message.id + "/from", fromStyle, message.from);
+        drawTextBlock(fromBlock, 30, yPos + 10, fromStyle.options.lineHeight);
+
+        // Subject with better contrast
+        LayoutCache::Style subjectStyle = fromStyle;
+        subjectStyle.color = sf::Color::White;
+        auto& subjectBlock = layoutCache.get(message.id + "/subject", subjectStyle, message.subject);
+        drawTextBlock(subjectBlock, 30, yPos + 35, subjectStyle.options.lineHeight);
+
+        // Body preview, as many lines as fit in the message box
+        LayoutCache::Style bodyStyle;
+        bodyStyle.fontSize = 14;
+        bodyStyle.options.maxWidth = 720;  // Adjusted for new margins
+        bodyStyle.options.lineHeight = 20;
+        bodyStyle.options.maxLines = 3;
+        bodyStyle.color = sf::Color(180, 180, 180);
+        auto& bodyBlock = layoutCache.get(message.id + "/preview", bodyStyle, message.preview);
+        drawTextBlock(bodyBlock, 30, yPos + 60, bodyStyle.options.lineHeight);
     }
 
-    // Scroll indicator using UTF-8 symbol
-    if (messages.size() > 4) {
-        sf::Text scrollIndicator(L"▼", font, 20);  // Using wide string for Unicode
-        scrollIndicator.setPosition(770, 560);
-        scrollIndicator.setFillColor(sf::Color(150, 150, 150));
-        window.draw(scrollIndicator);
-    }
-}
-
-std::string EmailClientGUI::stripHtmlExceptLinks(const std::string& html) {
-    std::string result;
-    bool inTag = false;
-    bool inLink = false;
-    std::string currentLink;
-
-    for (size_t i = 0; i < html.length(); ++i) {
-        if (html[i] == '<') {
-            inTag = true;
-            // Check if it's a link
-            if (i + 9 < html.length() && html.substr(i, 9) == "<a href=\"") {
-                inLink = true;
-                i += 8; // Skip to the href value
-                continue;
-            }
-        } else if (html[i] == '>') {
-            inTag = false;
-            if (inLink) {
-                // Add the complete link to result
-                if (!currentLink.empty()) {
-                    result += currentLink + " ";
-                    currentLink.clear();
-                }
-                inLink = false;
-            }
-            continue;
-        }
-
-        if (!inTag) {
-            if (i + 6 <= html.length() && html.substr(i, 6) == "&nbsp;") {
-                result += " ";
-                i += 5;
-            } else if (i + 4 <= html.length() && html.substr(i, 4) == "&lt;") {
-                result += "<";
-                i += 3;
-            } else if (i + 4 <= html.length() && html.substr(i, 4) == "&gt;") {
-                result += ">";
-                i += 3;
-            } else if (i + 5 <= html.length() && html.substr(i, 5) == "&amp;") {
-                result += "&";
-                i += 4;
-            } else {
-                result += html[i];
-            }
-        } else if (inLink && html[i] != '"') {
-            currentLink += html[i];
-        }
+    if (shownMessages.empty() && !searchText.empty()) {
+        batch.addText("No messages match the search", 16, 30, 130, sf::Color(150, 150, 150));
     }
 
-    return result;
-}
-
-std::vector<std::string> EmailClientGUI::splitIntoWords(const std::string& text) {
-    std::vector<std::string> words;
-    std::istringstream iss(text);
-    std::string word;
-    while (iss >> word) {
-        words.push_back(word);
+    // Scroll indicator using UTF-8 symbol
+    if (shownMessages.size() > 4) {
+        batch.addText("▼", 20, 770, 560, sf::Color(150, 150, 150));
     }
-    return words;
 }
 
 void EmailClientGUI::handleMouseClick(int x, int y) {
-    std::cout << "Click detected at x: " << x << ", y: " << y << std::endl;
+    LOG_DEBUG("Click detected at x: ", x, ", y: ", y);
 
     // Check for link clicks first
     for (const auto& link : activeLinks) {
@@ -427,7 +352,7 @@ void EmailClientGUI::handleMouseClick(int x, int y) {
     if (isPopupOpen) {
         // Close button (top-right of popup)
         if (x >= 700 && x <= 730 && y >= 60 && y <= 90) {
-            std::cout << "Closing popup" << std::endl;
+            LOG_DEBUG("Closing popup");
             isPopupOpen = false;
             selectedMessageIndex = -1;
             return;
@@ -437,15 +362,12 @@ void EmailClientGUI::handleMouseClick(int x, int y) {
 
     // Check for message clicks when emails are shown
     if (isEmailGenerated) {
-        float clickY = y + scrollOffset; // Adjust for scrolling
-        if (x >= 20 && x <= 780 && clickY >= 110) {
-            int messageIndex = (clickY - 110) / 90; // 90 is the height of each message preview
-            std::cout << "Calculated message index: " << messageIndex << std::endl;
-
-            if (messageIndex >= 0 && messageIndex < messages.size()) {
-                std::cout << "Opening popup for message " << messageIndex << std::endl;
+        if (x >= 20 && x <= 780 && y >= 110) { // Inside the message container
+            auto messageIndex = messageRows.rowAt(y - 110 + scrollOffset); // Adjust for scrolling
+            if (messageIndex) {
+                LOG_DEBUG("Opening popup for message ", *messageIndex);
                 isPopupOpen = true;
-                selectedMessageIndex = messageIndex;
+                selectedMessageIndex = static_cast<int>(shownMessages[*messageIndex]);
                 popupScrollOffset = 0;
                 return;
             }
@@ -476,6 +398,8 @@ void EmailClientGUI::handleMouseClick(int x, int y) {
         if (x >= 620 && x <= 770 && y >= 20 && y <= 50) {
             deleteAccount();
         }
+        // Search box (20, 60, 600, 90)
+        isSearchActive = isEmailGenerated && x >= 20 && x <= 600 && y >= 60 && y <= 90;
     }
 }
 
@@ -483,8 +407,8 @@ void EmailClientGUI::handleScroll(float delta) {
     scrollOffset += delta * 30;
     if (scrollOffset < 0) scrollOffset = 0;
 
-    // Adjust max scroll to account for larger message boxes
-    float maxScroll = messages.size() * 130 - 430;  // Changed from 90 to 130
+    // Stop once the last message is in view
+    float maxScroll = std::max(0.0f, messageRows.totalHeight() - 430);
     if (scrollOffset > maxScroll) scrollOffset = maxScroll;
 }
 
@@ -494,63 +418,253 @@ void EmailClientGUI::deleteAccount() {
         if (tokenOpt) {
             mailTm.deleteAccount(*tokenOpt, accountId);
         }
+        {
+            std::lock_guard<std::mutex> lock(inboxMutex); // An inbox thread still logging in sees this and backs off
+            ++inboxGeneration;
+            pollScheduler.removeAccount(email);
+        }
+        inboxActive = false; // Ends the push stream
         isEmailGenerated = false;
         messages.clear();
+        messageRows.clear();
+        shownMessages.clear();
+        messageIndexById.clear();
+        searchIndex.clear();
+        searchText.clear();
+        isSearchActive = false;
+        layoutCache.clear();
         email.clear();
         password.clear();
         accountId.clear();
     }
 }
 
+void EmailClientGUI::invalidate() {
+    {
+        std::lock_guard<std::mutex> lock(redrawMutex);
+        needsRedraw = true;
+    }
+    redrawCondition.notify_one();
+}
+
+bool EmailClientGUI::takeIncomingMessages() {
+    bool changed = false;
+    while (auto incoming = incomingMessages.pop()) {
+        if (!isEmailGenerated || incoming->inbox != email) {
+            continue; // A late poll of an account that was deleted in the meantime
+        }
+        for (auto& message : incoming->messages) {
+            messageIndexById[message.id] = messages.size();
+            if (searchText.empty()) {
+                shownMessages.push_back(messages.size());
+                messageRows.append(messageHeight);
+            }
+            messages.push_back(std::move(message));
+        }
+        changed = true;
+    }
+    if (changed && !searchText.empty()) {
+        applySearch(); // The new messages were indexed when they were fetched
+    }
+    return changed;
+}
+
+void EmailClientGUI::applySearch() {
+    shownMessages.clear();
+    messageRows.clear();
+
+    auto query = MailTMAPI::SearchQuery::parse(searchText);
+    if (query.empty()) {
+        for (size_t i = 0; i < messages.size(); ++i) {
+            shownMessages.push_back(i);
+        }
+    } else {
+        for (const auto& id : searchIndex.search(query, maxSearchResults)) {
+            auto it = messageIndexById.find(id);
+            if (it != messageIndexById.end()) { // Matches still on their way to the render loop show up later
+                shownMessages.push_back(it->second);
+            }
+        }
+        std::sort(shownMessages.begin(), shownMessages.end()); // Same order as the full list
+    }
+    for (size_t i = 0; i < shownMessages.size(); ++i) {
+        messageRows.append(messageHeight);
+    }
+    handleScroll(0); // Keep the scroll position inside the shorter list
+}
+
+void EmailClientGUI::handleEvent(const sf::Event& event) {
+    if (event.type != sf::Event::MouseMoved) { // Nothing in the interface reacts to hovering
+        needsRedraw = true;
+    }
+
+    switch (event.type) {
+        case sf::Event::Closed:
+            window.close();
+            break;
+
+        case sf::Event::MouseButtonPressed:
+            if (event.mouseButton.button == sf::Mouse::Left) {
+                handleMouseClick(event.mouseButton.x, event.mouseButton.y);
+            }
+            break;
+
+        case sf::Event::MouseWheelScrolled:
+            handleScroll(event.mouseWheelScroll.delta);
+            break;
+
+        case sf::Event::KeyPressed:
+            if (event.key.code == sf::Keyboard::F3) {
+                showProfiler = !showProfiler;
+            } else if (event.key.code == sf::Keyboard::F4) {
+                toggleTrace();
+            }
+            break;
+
+        case sf::Event::TextEntered:
+            if (isSearchActive && isEmailGenerated) {
+                if (event.text.unicode == '\b') {
+                    if (!searchText.empty()) {
+                        searchText.pop_back();
+                    }
+                } else if (event.text.unicode == 27) { // Escape clears the search
+                    searchText.clear();
+                    isSearchActive = false;
+                } else if (event.text.unicode >= 32 && event.text.unicode < 128) {
+                    searchText += static_cast<char>(event.text.unicode);
+                }
+                scrollOffset = 0;
+                applySearch();
+            }
+            if (isInputActive && !isEmailGenerated) {
+                if (event.text.unicode == '\b') {
+                    if (!customUsername.empty()) {
+                        customUsername.pop_back();
+                    }
+                }
+                else if (event.text.unicode < 128 && event.text.unicode != '\r' && event.text.unicode != '\n') {
+                    customUsername += static_cast<char>(event.text.unicode);
+                }
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
 void EmailClientGUI::run() {
-    window.setFramerateLimit(60);
+    window.setFramerateLimit(60); // Caps the rate while the view keeps changing, e.g. while scrolling
+    MailTMAPI::SearchIndex::setLockWaitSink(&MailTMAPI::FrameProfiler::recordLockWait); // Searches run on this thread
 
     while (window.isOpen()) {
+        profiler.beginFrame();
         sf::Event event;
-        while (window.pollEvent(event)) {
-            switch (event.type) {
-                case sf::Event::Closed:
-                    window.close();
-                    break;
-
-                case sf::Event::MouseButtonPressed:
-                    if (event.mouseButton.button == sf::Mouse::Left) {
-                        handleMouseClick(event.mouseButton.x, event.mouseButton.y);
-                    }
-                    break;
-
-                case sf::Event::MouseWheelScrolled:
-                    handleScroll(event.mouseWheelScroll.delta);
-                    break;
-
-                case sf::Event::TextEntered:
-                    if (isInputActive && !isEmailGenerated) {
-                        if (event.text.unicode == '\b') {
-                            if (!customUsername.empty()) {
-                                customUsername.pop_back();
-                            }
-                        }
-                        else if (event.text.unicode < 128 && event.text.unicode != '\r' && event.text.unicode != '\n') {
-                            customUsername += static_cast<char>(event.text.unicode);
-                        }
-                    }
-                    break;
+        {
+            PROFILE_SCOPE(profiler, "events");
+            while (window.pollEvent(event)) {
+                handleEvent(event);
+            }
+        }
+        {
+            PROFILE_SCOPE(profiler, "takeIncomingMessages");
+            if (takeIncomingMessages()) {
+                needsRedraw = true;
+            }
+        }
 
-                default:
-                    break;
+        if (!needsRedraw.exchange(false)) {
+            profiler.cancelFrame(); // Nothing is drawn, so this is not a frame
+            // Nothing changed: block until input arrives or, once the inbox thread runs, until it invalidates the
+            // view. waitEvent cannot be woken from another thread, so input is then polled at the old frame interval.
+            if (!inboxActive) { // No inbox thread yet, so only input can change the view
+                if (window.waitEvent(event)) {
+                    handleEvent(event);
+                }
+            } else {
+                std::unique_lock<std::mutex> lock(redrawMutex);
+                redrawCondition.wait_for(lock, idleEventInterval, [this]() { return needsRedraw.load(); });
             }
+            continue;
         }
 
         window.clear(sf::Color(50, 50, 50));
-        drawMainInterface();
+        {
+            PROFILE_SCOPE(profiler, "drawMainInterface");
+            drawMainInterface();
+        }
         if (isEmailGenerated) {
-            drawMessages();
+            {
+                PROFILE_SCOPE(profiler, "drawMessages");
+                drawMessages();
+            }
             if (isPopupOpen) {
+                PROFILE_SCOPE(profiler, "drawMessagePopup");
                 drawMessagePopup();
             }
         }
-        window.display();
+        if (showProfiler) {
+            drawProfilerOverlay(); // Shows the previous frames, this one is still running
+        }
+        {
+            PROFILE_SCOPE(profiler, "flush");
+            batch.flush(window); // The whole frame in a few draw calls
+        }
+        {
+            PROFILE_SCOPE(profiler, "display");
+            window.display();
+        }
+        profiler.endFrame(batch.getDrawCalls());
     }
+    if (profiler.isTracing()) {
+        profiler.stopTrace();
+    }
+}
+
+void EmailClientGUI::drawProfilerOverlay() {
+    MailTMAPI::FrameStats stats = profiler.getStats();
+    std::vector<MailTMAPI::PhaseTiming> rows = stats.phases;
+    rows.push_back(stats.frame);
+    rows.push_back(stats.lockWait);
+
+    // Drawn in its own layer over everything else, popup included
+    const float lineHeight = 16;
+    const float left = 450;
+    const float columns[] = {left + 160, left + 220, left + 280}; // last, avg and max, in ms
+    batch.beginLayer();
+    batch.addRect(left - 10, 110, 350, (rows.size() + 2) * lineHeight + 10, sf::Color(0, 0, 0, 200));
+    const sf::Color textColor(120, 255, 120);
+    float y = 115;
+    batch.addText("ms", 12, left, y, textColor);
+    batch.addText("last", 12, columns[0], y, textColor);
+    batch.addText("avg", 12, columns[1], y, textColor);
+    batch.addText("max", 12, columns[2], y, textColor);
+    char value[32];
+    for (const auto& row : rows) {
+        y += lineHeight;
+        batch.addText(row.name, 12, left, y, textColor);
+        double values[] = {row.lastMs, row.averageMs, row.maxMs};
+        for (size_t i = 0; i < 3; ++i) {
+            std::snprintf(value, sizeof(value), "%.2f", values[i]);
+            batch.addText(value, 12, columns[i], y, textColor);
+        }
+    }
+    y += lineHeight;
+    batch.addText("draw calls " + std::to_string(stats.drawCalls) + "   frames " + std::to_string(stats.frames) +
+                      (profiler.isTracing() ? "   tracing (F4)" : ""),
+                  12, left, y, textColor);
+}
+
+void EmailClientGUI::toggleTrace() {
+    if (profiler.isTracing()) {
+        profiler.stopTrace();
+        return;
+    }
+    std::time_t now = std::time(nullptr);
+    char path[64];
+    std::strftime(path, sizeof(path), "lambdamail-trace-%Y%m%d-%H%M%S.json", std::localtime(&now));
+    profiler.startTrace(path);
+    LOG_INFO("Recording a frame trace to ", path, ", press F4 again to stop");
 }
 
 void EmailClientGUI::openUrl(const std::string& url) {
@@ -575,7 +689,7 @@ void EmailClientGUI::openUrl(const std::string& url) {
         system(command.c_str());
     #endif
 
-    std::cout << "Opening URL: " << encodedUrl << std::endl;
+    LOG_INFO("Opening URL: ", encodedUrl);
 }
 
 void EmailClientGUI::drawMessagePopup() {
@@ -583,242 +697,114 @@ void EmailClientGUI::drawMessagePopup() {
         return;
     }
 
-    // Draw the popup UI
-    sf::RectangleShape overlay(sf::Vector2f(800, 600));
-    overlay.setFillColor(sf::Color(0, 0, 0, 180));
-    window.draw(overlay);
-
-    sf::RectangleShape popup(sf::Vector2f(600, 400));
-    popup.setPosition(100, 100);
-    popup.setFillColor(sf::Color(45, 49, 57));
-    popup.setOutlineThickness(2);
-    popup.setOutlineColor(sf::Color(70, 74, 82));
-    window.draw(popup);
+    // Draw the popup UI above the message list
+    batch.beginLayer();
+    batch.addRect(0, 0, 800, 600, sf::Color(0, 0, 0, 180));
+    batch.addRect(100, 100, 600, 400, sf::Color(45, 49, 57), 2, sf::Color(70, 74, 82));
 
     const auto& message = messages[selectedMessageIndex];
     float yPos = 120 - popupScrollOffset;
 
+    // Header lines, one line each
+    LayoutCache::Style headerStyle;
+    headerStyle.fontSize = 16;
+    headerStyle.options.maxWidth = 560;
+    headerStyle.options.maxLines = 1;
+
     // From
-    if (message.isMember("from") && message["from"].isObject() && message["from"].isMember("address")) {
-        try {
-            std::string fromAddress = message["from"]["address"].asString();
-            sf::Text fromText("From: " + fromAddress, font, 16);
-            fromText.setPosition(120, yPos);
-            fromText.setFillColor(sf::Color::White);
-            window.draw(fromText);
-            yPos += 30;
-        } catch (const std::exception& e) {
-            std::cout << "Error converting from address: " << e.what() << std::endl;
-        }
+    if (!message.from.empty()) {
+        drawTextBlock(layoutCache.get(message.id + "/popup-from", headerStyle, message.from), 120, yPos,
+                      headerStyle.options.lineHeight);
+        yPos += 30;
     }
 
     // Subject
-    if (message.isMember("subject")) {
-        try {
-            std::string subject = message["subject"].asString();
-            sf::Text subjectText("Subject: " + subject, font, 16);
-            subjectText.setPosition(120, yPos);
-            subjectText.setFillColor(sf::Color::White);
-            window.draw(subjectText);
-            yPos += 40;
-        } catch (const std::exception& e) {
-            std::cout << "Error converting subject: " << e.what() << std::endl;
-        }
+    if (!message.subject.empty()) {
+        drawTextBlock(layoutCache.get(message.id + "/popup-subject", headerStyle, message.subject), 120, yPos,
+                      headerStyle.options.lineHeight);
+        yPos += 40;
     }
 
     // Body text
-    if (message.isMember("text") && !message["text"].isNull()) {
-        try {
-            sf::Text bodyHeader("Message:", font, 14);
-            bodyHeader.setPosition(120, yPos);
-            bodyHeader.setFillColor(sf::Color(150, 150, 150));
-            window.draw(bodyHeader);
-            yPos += 25;
-
-            std::string bodyText = message["text"].asString();
-            drawWrappedText(bodyText, 120, yPos, 540, 14, sf::Color(200, 200, 200));
-            yPos += calculateTextHeight(bodyText, 540, 14) + 20;
-        } catch (const std::exception& e) {
-            std::cout << "Error converting text content: " << e.what() << std::endl;
-        }
-    }
-
-    // HTML content
-    if (message.isMember("html") && !message["html"].isNull()) {
-        try {
-            // Debug the HTML content type
-            std::cout << "HTML content type: " << message["html"].type() << std::endl;
-
-            // Handle array type HTML content
-            std::string htmlContent;
-            if (message["html"].isArray()) {
-                for (const auto& part : message["html"]) {
-                    if (part.isString()) {
-                        htmlContent += part.asString();
-                    }
-                }
-            } else if (message["html"].isString()) {
-                htmlContent = message["html"].asString();
-            } else {
-                std::cout << "Unsupported HTML content type" << std::endl;
-                return;
-            }
+    if (!message.text.empty()) {
+        batch.addText("Message:", 14, 120, yPos, sf::Color(150, 150, 150));
+        yPos += 25;
 
-            if (!htmlContent.empty()) {
-                sf::Text htmlHeader("HTML Content:", font, 14);
-                htmlHeader.setPosition(120, yPos);
-                htmlHeader.setFillColor(sf::Color(150, 150, 150));
-                window.draw(htmlHeader);
-                yPos += 25;
+        drawWrappedText(message.id + "/text", message.text, 120, yPos, 540, 14, sf::Color(200, 200, 200));
+        yPos += calculateTextHeight(message.id + "/text", message.text, 540, 14) + 20;
+    }
 
-                std::string strippedHtml = stripHtmlExceptLinks(htmlContent);
-                drawWrappedText(strippedHtml, 120, yPos, 540, 14, sf::Color(200, 200, 200));
-            }
-        } catch (const std::exception& e) {
-            std::cout << "Error converting HTML content: " << e.what() << std::endl;
-            // Print more details about the HTML content
-            if (message.isMember("html")) {
-                std::cout << "HTML content exists but couldn't be converted. Type: "
-                          << message["html"].type() << std::endl;
+    // HTML content, already joined from its parts
+    if (!message.html.empty()) {
+        batch.addText("HTML Content:", 14, 120, yPos, sf::Color(150, 150, 150));
+        yPos += 25;
+
+        drawWrappedText(message.id + "/html", message.html, 120, yPos, 540, 14, sf::Color(200, 200, 200));
+        yPos += calculateTextHeight(message.id + "/html", message.html, 540, 14) + 20;
+    }
+
+    // Links of the HTML part by their anchor text; the body above shows the text without the URLs
+    if (!message.links.empty() && yPos <= 460) {
+        batch.addText("Links:", 14, 120, yPos, sf::Color(150, 150, 150));
+        yPos += 25;
+
+        LayoutCache::Style linkStyle;
+        linkStyle.options.maxWidth = 540;
+        linkStyle.options.maxLines = 1;
+        linkStyle.color = linkStyle.linkColor;
+        for (size_t i = 0; i < message.links.size() && yPos <= 460; ++i) {
+            LayoutCache::Block& block = layoutCache.get(message.id + "/link" + std::to_string(i), linkStyle,
+                                                        message.linkLabels[i]);
+            LayoutCache::draw(batch, block, 120, yPos);
+
+            float width = 0;
+            for (const auto& run : block.layout.runs) {
+                width = std::max(width, run.x + run.width);
             }
+            activeLinks.push_back(ClickableLink{sf::FloatRect(120, yPos, width, linkStyle.options.lineHeight),
+                                                message.links[i].url});
+            yPos += linkStyle.options.lineHeight;
         }
     }
 
     // Close button
-    sf::RectangleShape closeButton(sf::Vector2f(30, 30));
-    closeButton.setPosition(700, 60);
-    closeButton.setFillColor(sf::Color(231, 76, 60));
-    window.draw(closeButton);
-
-    sf::Text closeText(L"×", font, 20);
-    closeText.setPosition(710, 65);
-    closeText.setFillColor(sf::Color::White);
-    window.draw(closeText);
+    batch.addRect(700, 60, 30, 30, sf::Color(231, 76, 60));
+    batch.addText("×", 20, 710, 65, sf::Color::White);
 }
 
-void EmailClientGUI::drawWrappedText(const std::string& text, float x, float y, float maxWidth, unsigned int fontSize, const sf::Color& color) {
-    std::vector<std::string> words = splitIntoWords(text);
-    std::string currentLine;
-    float lineX = x;
-    float currentY = y;
+void EmailClientGUI::drawWrappedText(const std::string& key, const std::vector<MailTMAPI::LayoutWord>& words, float x, float y, float maxWidth, unsigned int fontSize, const sf::Color& color) {
     float maxY = 460;
+    if (y > maxY) {
+        return;
+    }
 
-    for (size_t i = 0; i < words.size(); ++i) {
-        if (currentY > maxY) {
-            sf::Text ellipsis("...", font, fontSize);
-            ellipsis.setPosition(lineX, currentY - fontSize - 6);
-            ellipsis.setFillColor(color);
-            window.draw(ellipsis);
-            break;
-        }
-
-        const std::string& word = words[i];
-        bool isLink = (word.find("http://") == 0 || word.find("https://") == 0);
-
-        // Simplified URL reconstruction
-        std::string fullWord = word;
-        if (isLink) {
-            while (i + 1 < words.size()) {
-                const std::string& next = words[i + 1];
-                if (next.empty()) break;
-
-                char firstChar = next[0];
-                if (firstChar == '?' || firstChar == '&' || firstChar == '=' ||
-                    firstChar == '/' || firstChar == '|' || firstChar == '-' ||
-                    firstChar == '_' || firstChar == '.') {
-                    fullWord += next;
-                    i++;
-                } else {
-                    bool isUrlPart = true;
-                    for (char c : next) {
-                        if (!isalnum(c) && c != '=' && c != '&' && c != '%' &&
-                            c != '+' && c != '|' && c != '-' && c != '_' && c != '.') {
-                            isUrlPart = false;
-                            break;
-                        }
-                    }
-                    if (!isUrlPart) break;
-                    fullWord += next;
-                    i++;
-                }
-            }
-        }
-
-        // Handle long words
-        if (fullWord.length() > 50) {
-            sf::Text testWord(fullWord, font, fontSize);
-            if (testWord.getLocalBounds().width > maxWidth) {
-                if (isLink) {
-                    ClickableLink link;
-                    link.url = fullWord;
-                    sf::Text linkText(fullWord, font, fontSize);
-                    linkText.setPosition(lineX, currentY);
-                    linkText.setFillColor(sf::Color(100, 149, 237));
-                    linkText.setStyle(sf::Text::Underlined);
-                    link.bounds = linkText.getGlobalBounds();
-                    activeLinks.push_back(link);
-                    window.draw(linkText);
-                    currentY += fontSize + 6;
-                    lineX = x;
-                    continue;
-                }
-            }
-        }
+    LayoutCache::Style style;
+    style.fontSize = fontSize;
+    style.options.maxWidth = maxWidth;
+    style.options.lineHeight = fontSize + 6;  // Include line spacing
+    style.options.maxLines = static_cast<size_t>((maxY - y) / style.options.lineHeight) + 1;  // Lines starting above maxY
+    style.color = color;
+    drawTextBlock(layoutCache.get(key, style, words), x, y, style.options.lineHeight);
+}
 
-        // Normal word wrapping
-        sf::Text testText(currentLine + (currentLine.empty() ? "" : " ") + fullWord, font, fontSize);
-        if (testText.getLocalBounds().width > maxWidth && !currentLine.empty()) {
-            sf::Text lineText(currentLine, font, fontSize);
-            lineText.setPosition(lineX, currentY);
-            lineText.setFillColor(color);
-            window.draw(lineText);
-            currentY += fontSize + 6;
-            currentLine = fullWord;
-            lineX = x;
-        } else {
-            if (!currentLine.empty()) currentLine += " ";
-            currentLine += fullWord;
-        }
+float EmailClientGUI::calculateTextHeight(const std::string& key, const std::vector<MailTMAPI::LayoutWord>& words, float maxWidth, unsigned int fontSize) {
+    LayoutCache::Style style;
+    style.fontSize = fontSize;
+    style.options.maxWidth = maxWidth;
+    style.options.lineHeight = fontSize + 6;  // Include line spacing
+    return layoutCache.get(key, style, words).layout.height;
+}
 
-        if (isLink) {
-            sf::Text linkText(fullWord, font, fontSize);
-            linkText.setPosition(lineX, currentY);
-            linkText.setFillColor(sf::Color(100, 149, 237));
-            linkText.setStyle(sf::Text::Underlined);
+void EmailClientGUI::drawTextBlock(LayoutCache::Block& block, float x, float y, float lineHeight) {
+    LayoutCache::draw(batch, block, x, y);
 
+    // Links are clickable where they were laid out
+    for (const auto& run : block.layout.runs) {
+        if (run.isLink) {
             ClickableLink link;
-            link.bounds = linkText.getGlobalBounds();
-            link.url = fullWord;
+            link.bounds = sf::FloatRect(x + run.x, y + run.y, run.width, lineHeight);
+            link.url = run.text;
             activeLinks.push_back(link);
-
-            window.draw(linkText);
-            lineX += linkText.getGlobalBounds().width + 5;
-        }
-    }
-
-    if (!currentLine.empty() && currentY <= maxY) {
-        sf::Text lineText(currentLine, font, fontSize);
-        lineText.setPosition(lineX, currentY);
-        lineText.setFillColor(color);
-        window.draw(lineText);
-    }
-}
-
-float EmailClientGUI::calculateTextHeight(const std::string& text, float maxWidth, unsigned int fontSize) {
-    std::vector<std::string> words = splitIntoWords(text);
-    std::string currentLine;
-    int numLines = 1;
-
-    for (const auto& word : words) {
-        sf::Text testText(currentLine + " " + word, font, fontSize);
-        if (testText.getLocalBounds().width > maxWidth && !currentLine.empty()) {
-            numLines++;
-            currentLine = word;
-        } else {
-            if (!currentLine.empty()) currentLine += " ";
-            currentLine += word;
         }
     }
-
-    return numLines * (fontSize + 6);  // Include line spacing
 }
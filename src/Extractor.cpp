@@ -0,0 +1,287 @@
+#include "Extractor.h"
+#include "HtmlText.h"
+#include <algorithm>
+#include <cctype>
+#include <deque>
+#include <iterator>
+
+using namespace MailTMAPI;
+
+namespace {
+
+const uint32_t noState = UINT32_MAX; // Missing trie edge while the automaton is built
+
+// Function to check for an ASCII letter or digit
+bool isAlnum(char c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+// Function to check for an ASCII digit
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// Function to lowercase an ASCII letter
+char toLower(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+// Function to check whether a URL starts at pos
+bool startsUrl(std::string_view text, size_t pos) {
+    std::string scheme;
+    for (size_t i = pos; i < text.size() && i < pos + 8; ++i) {
+        scheme += toLower(text[i]);
+    }
+    return scheme.compare(0, 7, "http://") == 0 || scheme.compare(0, 8, "https://") == 0;
+}
+
+// Function to read the code candidate starting at start; digit groups such as "482 913" or "482-913" are joined
+size_t readCandidate(std::string_view text, size_t start, std::string& value) {
+    value.clear();
+    size_t end = start;
+    while (true) {
+        while (end < text.size() && isAlnum(text[end])) {
+            value += text[end++];
+        }
+        bool joinsGroup = end + 1 < text.size() && (text[end] == ' ' || text[end] == '-') && isDigit(text[end - 1]) &&
+                          isDigit(text[end + 1]);
+        if (!joinsGroup) {
+            return end;
+        }
+        end++; // Skip the separator
+    }
+}
+
+// Function to check a candidate against the length and character rules of a pattern
+bool isCode(const std::string& value, const ExtractionPattern& pattern) {
+    if (value.size() < pattern.minLength || value.size() > pattern.maxLength) {
+        return false;
+    }
+    bool hasDigit = std::any_of(value.begin(), value.end(), isDigit);
+    return pattern.digitsOnly ? std::all_of(value.begin(), value.end(), isDigit) : hasDigit;
+}
+
+// Function to add a match unless the pattern already produced the same value
+void addMatch(std::vector<Extraction>& results, const std::string& pattern, std::string value, const std::string& messageId) {
+    for (const auto& existing : results) {
+        if (existing.pattern == pattern && existing.value == value) {
+            return;
+        }
+    }
+    results.push_back(Extraction{pattern, std::move(value), messageId});
+}
+
+} // namespace
+
+// Constructor that compiles the patterns
+Extractor::Extractor(std::vector<ExtractionPattern> patterns) : patterns(std::move(patterns)) {
+    compile();
+}
+
+// Method to build the Aho-Corasick automaton over every keyword
+void Extractor::compile() {
+    std::vector<std::string> texts;
+    for (size_t p = 0; p < patterns.size(); ++p) {
+        for (const auto& keyword : patterns[p].keywords) {
+            if (keyword.empty()) {
+                continue;
+            }
+            std::string lowered;
+            std::transform(keyword.begin(), keyword.end(), std::back_inserter(lowered), toLower);
+            keywords.push_back(Keyword{static_cast<uint32_t>(p), static_cast<uint32_t>(lowered.size())});
+            texts.push_back(std::move(lowered));
+        }
+    }
+    for (const char* scheme : {"http://", "https://"}) {
+        keywords.push_back(Keyword{urlStart, static_cast<uint32_t>(std::string_view(scheme).size())});
+        texts.push_back(scheme);
+    }
+
+    // Bytes that occur in no keyword share class 0; letters map to the class of their lowercase form
+    for (const auto& text : texts) {
+        for (char c : text) {
+            uint8_t byte = static_cast<uint8_t>(c);
+            if (byteClass[byte] == 0) {
+                byteClass[byte] = static_cast<uint8_t>(classCount++);
+                if (c >= 'a' && c <= 'z') {
+                    byteClass[static_cast<uint8_t>(c - 'a' + 'A')] = byteClass[byte];
+                }
+            }
+        }
+    }
+
+    // Build the trie
+    transitions.assign(classCount, noState);
+    outputs.assign(1, {});
+    for (size_t k = 0; k < texts.size(); ++k) {
+        uint32_t state = 0;
+        for (char c : texts[k]) {
+            uint32_t& next = transitions[state * classCount + byteClass[static_cast<uint8_t>(c)]];
+            if (next == noState) {
+                next = static_cast<uint32_t>(outputs.size());
+                outputs.emplace_back();
+                transitions.resize(transitions.size() + classCount, noState); // Invalidates next, so it is not reused
+            }
+            state = transitions[state * classCount + byteClass[static_cast<uint8_t>(c)]];
+        }
+        outputs[state].push_back(static_cast<uint32_t>(k));
+    }
+
+    // Turn it into a DFA breadth first: missing edges follow the failure link, outputs include the suffixes'
+    std::vector<uint32_t> fail(outputs.size(), 0);
+    std::deque<uint32_t> queue;
+    for (size_t c = 0; c < classCount; ++c) {
+        uint32_t& next = transitions[c];
+        if (next == noState) {
+            next = 0;
+        } else {
+            queue.push_back(next);
+        }
+    }
+    while (!queue.empty()) {
+        uint32_t state = queue.front();
+        queue.pop_front();
+        for (size_t c = 0; c < classCount; ++c) {
+            uint32_t fallback = transitions[fail[state] * classCount + c];
+            uint32_t& next = transitions[state * classCount + c];
+            if (next == noState) {
+                next = fallback;
+            } else {
+                fail[next] = fallback;
+                outputs[next].insert(outputs[next].end(), outputs[fallback].begin(), outputs[fallback].end());
+                queue.push_back(next);
+            }
+        }
+    }
+}
+
+// Method to run the automaton over text, reporting each keyword and where it ends
+template <typename OnHit>
+void Extractor::scan(std::string_view text, OnHit onHit) const {
+    uint32_t state = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        state = transitions[state * classCount + byteClass[static_cast<uint8_t>(text[i])]];
+        for (uint32_t keyword : outputs[state]) {
+            onHit(keywords[keyword], i + 1);
+        }
+    }
+}
+
+// Method to find codes near keywords and the URLs in plain text
+void Extractor::extractCodes(std::string_view text, const std::string& messageId, std::vector<Extraction>& results) const {
+    size_t urlEnd = 0; // Keywords inside a URL belong to the link, not to a code
+    std::string candidate;
+    scan(text, [&](const Keyword& keyword, size_t end) {
+        size_t start = end - keyword.length;
+        if (keyword.pattern == urlStart) {
+            if (start < urlEnd) {
+                return;
+            }
+            size_t stop = end;
+            while (stop < text.size() && !std::isspace(static_cast<unsigned char>(text[stop])) &&
+                   text[stop] != '<' && text[stop] != '>' && text[stop] != '"' && text[stop] != '\'') {
+                stop++;
+            }
+            while (stop > end && std::string_view(".,;:!?)]}").find(text[stop - 1]) != std::string_view::npos) {
+                stop--; // Punctuation ending the sentence
+            }
+            urlEnd = stop;
+            if (stop > end) {
+                extractLink(text.substr(start, stop - start), messageId, results);
+            }
+            return;
+        }
+
+        const ExtractionPattern& pattern = patterns[keyword.pattern];
+        if (pattern.kind != ExtractionPattern::Kind::Code || start < urlEnd || (start > 0 && isAlnum(text[start - 1])) ||
+            (end < text.size() && isAlnum(text[end]))) {
+            return; // Link keywords only count in URLs, and neither "barcode" nor "Pinterest" is a keyword
+        }
+
+        // The nearest code after the keyword, else the nearest one before it as in "482913 is your code"
+        size_t limit = std::min(text.size(), end + pattern.window);
+        for (size_t pos = end; pos < limit;) {
+            if (!isAlnum(text[pos])) {
+                pos++;
+                continue;
+            }
+            if (startsUrl(text, pos)) { // Numbers in a URL are not codes
+                while (pos < text.size() && !std::isspace(static_cast<unsigned char>(text[pos]))) {
+                    pos++;
+                }
+                continue;
+            }
+            pos = readCandidate(text, pos, candidate);
+            if (isCode(candidate, pattern)) {
+                addMatch(results, pattern.name, candidate, messageId);
+                return;
+            }
+        }
+        std::string nearest;
+        for (size_t pos = start > pattern.window ? start - pattern.window : 0; pos < start;) {
+            if (!isAlnum(text[pos]) || (pos > 0 && isAlnum(text[pos - 1]))) { // Only whole candidates
+                pos++;
+                continue;
+            }
+            pos = readCandidate(text, pos, candidate);
+            if (pos <= start && isCode(candidate, pattern)) {
+                nearest = candidate;
+            }
+        }
+        if (!nearest.empty()) {
+            addMatch(results, pattern.name, nearest, messageId);
+        }
+    });
+}
+
+// Method to report a URL for every link pattern it matches
+void Extractor::extractLink(std::string_view url, const std::string& messageId, std::vector<Extraction>& results) const {
+    std::vector<bool> matched(patterns.size(), false);
+    scan(url, [&](const Keyword& keyword, size_t) {
+        if (keyword.pattern != urlStart) {
+            matched[keyword.pattern] = true;
+        }
+    });
+    for (size_t p = 0; p < patterns.size(); ++p) {
+        if (patterns[p].kind == ExtractionPattern::Kind::Link && (matched[p] || patterns[p].keywords.empty())) {
+            addMatch(results, patterns[p].name, std::string(url), messageId);
+        }
+    }
+}
+
+// Method to find every match in a message
+std::vector<Extraction> Extractor::extract(const Message& message) const {
+    std::vector<Extraction> results;
+    HtmlTextResult html;
+    if (!message.html.empty()) {
+        html = HtmlText::convert(message.html, false);
+    }
+
+    std::string text = message.subject + "\n" + (message.text.empty() ? html.text : message.text);
+    extractCodes(text, message.id, results);
+    for (const auto& link : html.links) {
+        if (link.url.compare(0, 7, "http://") == 0 || link.url.compare(0, 8, "https://") == 0) {
+            extractLink(link.url, message.id, results);
+        }
+    }
+    return results;
+}
+
+// Method to get the compiled patterns
+const std::vector<ExtractionPattern>& Extractor::getPatterns() const {
+    return patterns;
+}
+
+// Method to build the patterns for the usual sign-up mail
+std::vector<ExtractionPattern> Extractor::defaultPatterns() {
+    ExtractionPattern code;
+    code.name = "code";
+    code.keywords = {"code", "otp", "pin", "passcode", "verification", "one-time", "2fa"};
+
+    ExtractionPattern link;
+    link.name = "link";
+    link.kind = ExtractionPattern::Kind::Link;
+    link.keywords = {"verify", "verification", "confirm", "activate", "activation", "reset", "magic", "login",
+                     "signin", "sign-in", "token", "auth"};
+    return {code, link};
+}
@@ -0,0 +1,220 @@
+#include "FrameProfiler.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+using namespace MailTMAPI;
+
+namespace {
+
+thread_local FrameProfiler* activeProfiler = nullptr; // The profiler whose frames run on this thread
+
+// Function to convert a duration to fractional milliseconds
+double toMillis(FrameProfiler::Clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+} // namespace
+
+// Constructor starting a phase timer
+FrameProfiler::Scope::Scope(FrameProfiler& profiler, const char* name)
+    : profiler(profiler), phase(profiler.phaseIndex(name)), start(Clock::now()) {}
+
+// Destructor charging the elapsed time to the phase
+FrameProfiler::Scope::~Scope() {
+    Clock::time_point end = Clock::now();
+    Phase& timed = profiler.phases[phase];
+    if (profiler.inFrame) {
+        timed.currentMs += toMillis(end - start);
+    }
+    profiler.addSpan(timed.name, start, end);
+}
+
+// Constructor starting a lock wait timer
+FrameProfiler::LockWait::LockWait() : start(activeProfiler ? Clock::now() : Clock::time_point()) {}
+
+// Destructor charging the wait to the frame running on this thread
+FrameProfiler::LockWait::~LockWait() {
+    if (activeProfiler) {
+        recordLockWait(start, Clock::now());
+    }
+}
+
+// Function to charge a lock wait to the frame running on this thread
+void FrameProfiler::recordLockWait(Clock::time_point start, Clock::time_point end) {
+    FrameProfiler* profiler = activeProfiler;
+    if (!profiler || !profiler->inFrame) {
+        return;
+    }
+    profiler->lockWait.currentMs += toMillis(end - start);
+    profiler->addSpan(profiler->lockWait.name, start, end);
+}
+
+// Destructor writing a trace that is still recording
+FrameProfiler::~FrameProfiler() {
+    if (tracing) {
+        stopTrace();
+    }
+    if (activeProfiler == this) {
+        activeProfiler = nullptr;
+    }
+}
+
+// Method to find a phase by name, adding it on first use
+size_t FrameProfiler::phaseIndex(const char* name) {
+    for (size_t i = 0; i < phases.size(); ++i) {
+        if (phases[i].name == name || std::strcmp(phases[i].name, name) == 0) { // Literals usually match by address
+            return i;
+        }
+    }
+    phases.push_back(Phase{name});
+    return phases.size() - 1;
+}
+
+// Method to record a timed span in the trace
+void FrameProfiler::addSpan(const char* name, Clock::time_point start, Clock::time_point end) {
+    if (!tracing) {
+        return;
+    }
+    if (traceEvents.size() >= maxTraceEvents) {
+        ++droppedTraceEvents;
+        return;
+    }
+    auto startMicros = std::chrono::duration_cast<std::chrono::microseconds>(start - traceStart).count();
+    auto durationMicros = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    traceEvents.push_back(TraceEvent{name, 'X', startMicros, durationMicros});
+}
+
+// Method to record a counter value in the trace
+void FrameProfiler::addCounter(const char* name, Clock::time_point time, int64_t value) {
+    if (!tracing) {
+        return;
+    }
+    if (traceEvents.size() >= maxTraceEvents) {
+        ++droppedTraceEvents;
+        return;
+    }
+    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(time - traceStart).count();
+    traceEvents.push_back(TraceEvent{name, 'C', micros, value});
+}
+
+// Method to start a frame on the calling thread
+void FrameProfiler::beginFrame() {
+    activeProfiler = this;
+    inFrame = true;
+    for (auto& phase : phases) {
+        phase.currentMs = 0;
+    }
+    lockWait.currentMs = 0;
+    frameStart = Clock::now();
+}
+
+// Method to finish the frame and store its times
+void FrameProfiler::endFrame(size_t frameDrawCalls) {
+    if (!inFrame) {
+        return;
+    }
+    Clock::time_point end = Clock::now();
+    inFrame = false;
+    size_t slot = frames % historyFrames;
+    for (auto& phase : phases) {
+        phase.history[slot] = phase.currentMs;
+    }
+    frame.history[slot] = toMillis(end - frameStart);
+    lockWait.history[slot] = lockWait.currentMs;
+    drawCalls[slot] = frameDrawCalls;
+    ++frames;
+
+    addSpan(frame.name, frameStart, end);
+    addCounter("drawCalls", end, static_cast<int64_t>(frameDrawCalls));
+}
+
+// Method to drop the frame in progress
+void FrameProfiler::cancelFrame() {
+    inFrame = false;
+}
+
+// Function to compute the last, mean and worst time of a phase over the recent frames
+PhaseTiming FrameProfiler::summarize(const Phase& phase, uint64_t frames) {
+    PhaseTiming timing;
+    timing.name = phase.name;
+    if (frames == 0) {
+        return timing;
+    }
+    size_t count = static_cast<size_t>(std::min<uint64_t>(frames, historyFrames));
+    double total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        total += phase.history[i];
+        timing.maxMs = std::max(timing.maxMs, phase.history[i]);
+    }
+    timing.lastMs = phase.history[(frames - 1) % historyFrames];
+    timing.averageMs = total / count;
+    return timing;
+}
+
+// Method to get the timings of the recent frames
+FrameStats FrameProfiler::getStats() const {
+    FrameStats stats;
+    for (const auto& phase : phases) {
+        stats.phases.push_back(summarize(phase, frames));
+    }
+    stats.frame = summarize(frame, frames);
+    stats.lockWait = summarize(lockWait, frames);
+    stats.drawCalls = frames == 0 ? 0 : drawCalls[(frames - 1) % historyFrames];
+    stats.frames = frames;
+    return stats;
+}
+
+// Method to start recording a trace
+bool FrameProfiler::startTrace(const std::string& path) {
+    if (tracing) {
+        return false;
+    }
+    tracing = true;
+    tracePath = path;
+    traceStart = Clock::now();
+    traceEvents.clear();
+    droppedTraceEvents = 0;
+    return true;
+}
+
+// Method to stop recording and write the trace in the Chrome trace event format
+bool FrameProfiler::stopTrace() {
+    if (!tracing) {
+        return false;
+    }
+    tracing = false;
+    std::ofstream out(tracePath);
+    if (!out) {
+        LOG_ERROR("Failed to write trace to ", tracePath);
+        return false;
+    }
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"render loop\"}}";
+    for (const auto& event : traceEvents) { // Names are phase literals, so they need no escaping
+        out << ",\n{\"name\":\"" << event.name << "\",\"ph\":\"" << event.phase << "\",\"ts\":" << event.startMicros
+            << ",\"pid\":1,\"tid\":1,";
+        if (event.phase == 'X') {
+            out << "\"dur\":" << event.value << "}";
+        } else {
+            out << "\"args\":{\"" << event.name << "\":" << event.value << "}}";
+        }
+    }
+    out << "\n]}\n";
+    out.close();
+    if (!out) {
+        LOG_ERROR("Failed to write trace to ", tracePath);
+        return false;
+    }
+    LOG_INFO("Wrote ", traceEvents.size(), " trace events to ", tracePath,
+             droppedTraceEvents > 0 ? " (trace buffer full, later events dropped)" : "");
+    traceEvents.clear();
+    traceEvents.shrink_to_fit();
+    return true;
+}
+
+// Method to check whether a trace is recording
+bool FrameProfiler::isTracing() const {
+    return tracing;
+}
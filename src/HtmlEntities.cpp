@@ -0,0 +1,2149 @@
+#include "HtmlEntities.h"
+#include <algorithm>
+#include <iterator>
+
+using namespace MailTMAPI;
+
+namespace {
+
+// The named character references of the WHATWG HTML standard, sorted by name.
+// Names are stored without the trailing ';'; legacy entries may also appear without it.
+const HtmlEntity entities[] = {
+    {"AElig", "\303\206", true},
+    {"AMP", "&", true},
+    {"Aacute", "\303\201", true},
+    {"Abreve", "\304\202", false},
+    {"Acirc", "\303\202", true},
+    {"Acy", "\320\220", false},
+    {"Afr", "\360\235\224\204", false},
+    {"Agrave", "\303\200", true},
+    {"Alpha", "\316\221", false},
+    {"Amacr", "\304\200", false},
+    {"And", "\342\251\223", false},
+    {"Aogon", "\304\204", false},
+    {"Aopf", "\360\235\224\270", false},
+    {"ApplyFunction", "\342\201\241", false},
+    {"Aring", "\303\205", true},
+    {"Ascr", "\360\235\222\234", false},
+    {"Assign", "\342\211\224", false},
+    {"Atilde", "\303\203", true},
+    {"Auml", "\303\204", true},
+    {"Backslash", "\342\210\226", false},
+    {"Barv", "\342\253\247", false},
+    {"Barwed", "\342\214\206", false},
+    {"Bcy", "\320\221", false},
+    {"Because", "\342\210\265", false},
+    {"Bernoullis", "\342\204\254", false},
+    {"Beta", "\316\222", false},
+    {"Bfr", "\360\235\224\205", false},
+    {"Bopf", "\360\235\224\271", false},
+    {"Breve", "\313\230", false},
+    {"Bscr", "\342\204\254", false},
+    {"Bumpeq", "\342\211\216", false},
+    {"CHcy", "\320\247", false},
+    {"COPY", "\302\251", true},
+    {"Cacute", "\304\206", false},
+    {"Cap", "\342\213\222", false},
+    {"CapitalDifferentialD", "\342\205\205", false},
+    {"Cayleys", "\342\204\255", false},
+    {"Ccaron", "\304\214", false},
+    {"Ccedil", "\303\207", true},
+    {"Ccirc", "\304\210", false},
+    {"Cconint", "\342\210\260", false},
+    {"Cdot", "\304\212", false},
+    {"Cedilla", "\302\270", false},
+    {"CenterDot", "\302\267", false},
+    {"Cfr", "\342\204\255", false},
+    {"Chi", "\316\247", false},
+    {"CircleDot", "\342\212\231", false},
+    {"CircleMinus", "\342\212\226", false},
+    {"CirclePlus", "\342\212\225", false},
+    {"CircleTimes", "\342\212\227", false},
+    {"ClockwiseContourIntegral", "\342\210\262", false},
+    {"CloseCurlyDoubleQuote", "\342\200\235", false},
+    {"CloseCurlyQuote", "\342\200\231", false},
+    {"Colon", "\342\210\267", false},
+    {"Colone", "\342\251\264", false},
+    {"Congruent", "\342\211\241", false},
+    {"Conint", "\342\210\257", false},
+    {"ContourIntegral", "\342\210\256", false},
+    {"Copf", "\342\204\202", false},
+    {"Coproduct", "\342\210\220", false},
+    {"CounterClockwiseContourIntegral", "\342\210\263", false},
+    {"Cross", "\342\250\257", false},
+    {"Cscr", "\360\235\222\236", false},
+    {"Cup", "\342\213\223", false},
+    {"CupCap", "\342\211\215", false},
+    {"DD", "\342\205\205", false},
+    {"DDotrahd", "\342\244\221", false},
+    {"DJcy", "\320\202", false},
+    {"DScy", "\320\205", false},
+    {"DZcy", "\320\217", false},
+    {"Dagger", "\342\200\241", false},
+    {"Darr", "\342\206\241", false},
+    {"Dashv", "\342\253\244", false},
+    {"Dcaron", "\304\216", false},
+    {"Dcy", "\320\224", false},
+    {"Del", "\342\210\207", false},
+    {"Delta", "\316\224", false},
+    {"Dfr", "\360\235\224\207", false},
+    {"DiacriticalAcute", "\302\264", false},
+    {"DiacriticalDot", "\313\231", false},
+    {"DiacriticalDoubleAcute", "\313\235", false},
+    {"DiacriticalGrave", "`", false},
+    {"DiacriticalTilde", "\313\234", false},
+    {"Diamond", "\342\213\204", false},
+    {"DifferentialD", "\342\205\206", false},
+    {"Dopf", "\360\235\224\273", false},
+    {"Dot", "\302\250", false},
+    {"DotDot", "\342\203\234", false},
+    {"DotEqual", "\342\211\220", false},
+    {"DoubleContourIntegral", "\342\210\257", false},
+    {"DoubleDot", "\302\250", false},
+    {"DoubleDownArrow", "\342\207\223", false},
+    {"DoubleLeftArrow", "\342\207\220", false},
+    {"DoubleLeftRightArrow", "\342\207\224", false},
+    {"DoubleLeftTee", "\342\253\244", false},
+    {"DoubleLongLeftArrow", "\342\237\270", false},
+    {"DoubleLongLeftRightArrow", "\342\237\272", false},
+    {"DoubleLongRightArrow", "\342\237\271", false},
+    {"DoubleRightArrow", "\342\207\222", false},
+    {"DoubleRightTee", "\342\212\250", false},
+    {"DoubleUpArrow", "\342\207\221", false},
+    {"DoubleUpDownArrow", "\342\207\225", false},
+    {"DoubleVerticalBar", "\342\210\245", false},
+    {"DownArrow", "\342\206\223", false},
+    {"DownArrowBar", "\342\244\223", false},
+    {"DownArrowUpArrow", "\342\207\265", false},
+    {"DownBreve", "\314\221", false},
+    {"DownLeftRightVector", "\342\245\220", false},
+    {"DownLeftTeeVector", "\342\245\236", false},
+    {"DownLeftVector", "\342\206\275", false},
+    {"DownLeftVectorBar", "\342\245\226", false},
+    {"DownRightTeeVector", "\342\245\237", false},
+    {"DownRightVector", "\342\207\201", false},
+    {"DownRightVectorBar", "\342\245\227", false},
+    {"DownTee", "\342\212\244", false},
+    {"DownTeeArrow", "\342\206\247", false},
+    {"Downarrow", "\342\207\223", false},
+    {"Dscr", "\360\235\222\237", false},
+    {"Dstrok", "\304\220", false},
+    {"ENG", "\305\212", false},
+    {"ETH", "\303\220", true},
+    {"Eacute", "\303\211", true},
+    {"Ecaron", "\304\232", false},
+    {"Ecirc", "\303\212", true},
+    {"Ecy", "\320\255", false},
+    {"Edot", "\304\226", false},
+    {"Efr", "\360\235\224\210", false},
+    {"Egrave", "\303\210", true},
+    {"Element", "\342\210\210", false},
+    {"Emacr", "\304\222", false},
+    {"EmptySmallSquare", "\342\227\273", false},
+    {"EmptyVerySmallSquare", "\342\226\253", false},
+    {"Eogon", "\304\230", false},
+    {"Eopf", "\360\235\224\274", false},
+    {"Epsilon", "\316\225", false},
+    {"Equal", "\342\251\265", false},
+    {"EqualTilde", "\342\211\202", false},
+    {"Equilibrium", "\342\207\214", false},
+    {"Escr", "\342\204\260", false},
+    {"Esim", "\342\251\263", false},
+    {"Eta", "\316\227", false},
+    {"Euml", "\303\213", true},
+    {"Exists", "\342\210\203", false},
+    {"ExponentialE", "\342\205\207", false},
+    {"Fcy", "\320\244", false},
+    {"Ffr", "\360\235\224\211", false},
+    {"FilledSmallSquare", "\342\227\274", false},
+    {"FilledVerySmallSquare", "\342\226\252", false},
+    {"Fopf", "\360\235\224\275", false},
+    {"ForAll", "\342\210\200", false},
+    {"Fouriertrf", "\342\204\261", false},
+    {"Fscr", "\342\204\261", false},
+    {"GJcy", "\320\203", false},
+    {"GT", ">", true},
+    {"Gamma", "\316\223", false},
+    {"Gammad", "\317\234", false},
+    {"Gbreve", "\304\236", false},
+    {"Gcedil", "\304\242", false},
+    {"Gcirc", "\304\234", false},
+    {"Gcy", "\320\223", false},
+    {"Gdot", "\304\240", false},
+    {"Gfr", "\360\235\224\212", false},
+    {"Gg", "\342\213\231", false},
+    {"Gopf", "\360\235\224\276", false},
+    {"GreaterEqual", "\342\211\245", false},
+    {"GreaterEqualLess", "\342\213\233", false},
+    {"GreaterFullEqual", "\342\211\247", false},
+    {"GreaterGreater", "\342\252\242", false},
+    {"GreaterLess", "\342\211\267", false},
+    {"GreaterSlantEqual", "\342\251\276", false},
+    {"GreaterTilde", "\342\211\263", false},
+    {"Gscr", "\360\235\222\242", false},
+    {"Gt", "\342\211\253", false},
+    {"HARDcy", "\320\252", false},
+    {"Hacek", "\313\207", false},
+    {"Hat", "^", false},
+    {"Hcirc", "\304\244", false},
+    {"Hfr", "\342\204\214", false},
+    {"HilbertSpace", "\342\204\213", false},
+    {"Hopf", "\342\204\215", false},
+    {"HorizontalLine", "\342\224\200", false},
+    {"Hscr", "\342\204\213", false},
+    {"Hstrok", "\304\246", false},
+    {"HumpDownHump", "\342\211\216", false},
+    {"HumpEqual", "\342\211\217", false},
+    {"IEcy", "\320\225", false},
+    {"IJlig", "\304\262", false},
+    {"IOcy", "\320\201", false},
+    {"Iacute", "\303\215", true},
+    {"Icirc", "\303\216", true},
+    {"Icy", "\320\230", false},
+    {"Idot", "\304\260", false},
+    {"Ifr", "\342\204\221", false},
+    {"Igrave", "\303\214", true},
+    {"Im", "\342\204\221", false},
+    {"Imacr", "\304\252", false},
+    {"ImaginaryI", "\342\205\210", false},
+    {"Implies", "\342\207\222", false},
+    {"Int", "\342\210\254", false},
+    {"Integral", "\342\210\253", false},
+    {"Intersection", "\342\213\202", false},
+    {"InvisibleComma", "\342\201\243", false},
+    {"InvisibleTimes", "\342\201\242", false},
+    {"Iogon", "\304\256", false},
+    {"Iopf", "\360\235\225\200", false},
+    {"Iota", "\316\231", false},
+    {"Iscr", "\342\204\220", false},
+    {"Itilde", "\304\250", false},
+    {"Iukcy", "\320\206", false},
+    {"Iuml", "\303\217", true},
+    {"Jcirc", "\304\264", false},
+    {"Jcy", "\320\231", false},
+    {"Jfr", "\360\235\224\215", false},
+    {"Jopf", "\360\235\225\201", false},
+    {"Jscr", "\360\235\222\245", false},
+    {"Jsercy", "\320\210", false},
+    {"Jukcy", "\320\204", false},
+    {"KHcy", "\320\245", false},
+    {"KJcy", "\320\214", false},
+    {"Kappa", "\316\232", false},
+    {"Kcedil", "\304\266", false},
+    {"Kcy", "\320\232", false},
+    {"Kfr", "\360\235\224\216", false},
+    {"Kopf", "\360\235\225\202", false},
+    {"Kscr", "\360\235\222\246", false},
+    {"LJcy", "\320\211", false},
+    {"LT", "<", true},
+    {"Lacute", "\304\271", false},
+    {"Lambda", "\316\233", false},
+    {"Lang", "\342\237\252", false},
+    {"Laplacetrf", "\342\204\222", false},
+    {"Larr", "\342\206\236", false},
+    {"Lcaron", "\304\275", false},
+    {"Lcedil", "\304\273", false},
+    {"Lcy", "\320\233", false},
+    {"LeftAngleBracket", "\342\237\250", false},
+    {"LeftArrow", "\342\206\220", false},
+    {"LeftArrowBar", "\342\207\244", false},
+    {"LeftArrowRightArrow", "\342\207\206", false},
+    {"LeftCeiling", "\342\214\210", false},
+    {"LeftDoubleBracket", "\342\237\246", false},
+    {"LeftDownTeeVector", "\342\245\241", false},
+    {"LeftDownVector", "\342\207\203", false},
+    {"LeftDownVectorBar", "\342\245\231", false},
+    {"LeftFloor", "\342\214\212", false},
+    {"LeftRightArrow", "\342\206\224", false},
+    {"LeftRightVector", "\342\245\216", false},
+    {"LeftTee", "\342\212\243", false},
+    {"LeftTeeArrow", "\342\206\244", false},
+    {"LeftTeeVector", "\342\245\232", false},
+    {"LeftTriangle", "\342\212\262", false},
+    {"LeftTriangleBar", "\342\247\217", false},
+    {"LeftTriangleEqual", "\342\212\264", false},
+    {"LeftUpDownVector", "\342\245\221", false},
+    {"LeftUpTeeVector", "\342\245\240", false},
+    {"LeftUpVector", "\342\206\277", false},
+    {"LeftUpVectorBar", "\342\245\230", false},
+    {"LeftVector", "\342\206\274", false},
+    {"LeftVectorBar", "\342\245\222", false},
+    {"Leftarrow", "\342\207\220", false},
+    {"Leftrightarrow", "\342\207\224", false},
+    {"LessEqualGreater", "\342\213\232", false},
+    {"LessFullEqual", "\342\211\246", false},
+    {"LessGreater", "\342\211\266", false},
+    {"LessLess", "\342\252\241", false},
+    {"LessSlantEqual", "\342\251\275", false},
+    {"LessTilde", "\342\211\262", false},
+    {"Lfr", "\360\235\224\217", false},
+    {"Ll", "\342\213\230", false},
+    {"Lleftarrow", "\342\207\232", false},
+    {"Lmidot", "\304\277", false},
+    {"LongLeftArrow", "\342\237\265", false},
+    {"LongLeftRightArrow", "\342\237\267", false},
+    {"LongRightArrow", "\342\237\266", false},
+    {"Longleftarrow", "\342\237\270", false},
+    {"Longleftrightarrow", "\342\237\272", false},
+    {"Longrightarrow", "\342\237\271", false},
+    {"Lopf", "\360\235\225\203", false},
+    {"LowerLeftArrow", "\342\206\231", false},
+    {"LowerRightArrow", "\342\206\230", false},
+    {"Lscr", "\342\204\222", false},
+    {"Lsh", "\342\206\260", false},
+    {"Lstrok", "\305\201", false},
+    {"Lt", "\342\211\252", false},
+    {"Map", "\342\244\205", false},
+    {"Mcy", "\320\234", false},
+    {"MediumSpace", "\342\201\237", false},
+    {"Mellintrf", "\342\204\263", false},
+    {"Mfr", "\360\235\224\220", false},
+    {"MinusPlus", "\342\210\223", false},
+    {"Mopf", "\360\235\225\204", false},
+    {"Mscr", "\342\204\263", false},
+    {"Mu", "\316\234", false},
+    {"NJcy", "\320\212", false},
+    {"Nacute", "\305\203", false},
+    {"Ncaron", "\305\207", false},
+    {"Ncedil", "\305\205", false},
+    {"Ncy", "\320\235", false},
+    {"NegativeMediumSpace", "\342\200\213", false},
+    {"NegativeThickSpace", "\342\200\213", false},
+    {"NegativeThinSpace", "\342\200\213", false},
+    {"NegativeVeryThinSpace", "\342\200\213", false},
+    {"NestedGreaterGreater", "\342\211\253", false},
+    {"NestedLessLess", "\342\211\252", false},
+    {"NewLine", "\012", false},
+    {"Nfr", "\360\235\224\221", false},
+    {"NoBreak", "\342\201\240", false},
+    {"NonBreakingSpace", "\302\240", false},
+    {"Nopf", "\342\204\225", false},
+    {"Not", "\342\253\254", false},
+    {"NotCongruent", "\342\211\242", false},
+    {"NotCupCap", "\342\211\255", false},
+    {"NotDoubleVerticalBar", "\342\210\246", false},
+    {"NotElement", "\342\210\211", false},
+    {"NotEqual", "\342\211\240", false},
+    {"NotEqualTilde", "\342\211\202\314\270", false},
+    {"NotExists", "\342\210\204", false},
+    {"NotGreater", "\342\211\257", false},
+    {"NotGreaterEqual", "\342\211\261", false},
+    {"NotGreaterFullEqual", "\342\211\247\314\270", false},
+    {"NotGreaterGreater", "\342\211\253\314\270", false},
+    {"NotGreaterLess", "\342\211\271", false},
+    {"NotGreaterSlantEqual", "\342\251\276\314\270", false},
+    {"NotGreaterTilde", "\342\211\265", false},
+    {"NotHumpDownHump", "\342\211\216\314\270", false},
+    {"NotHumpEqual", "\342\211\217\314\270", false},
+    {"NotLeftTriangle", "\342\213\252", false},
+    {"NotLeftTriangleBar", "\342\247\217\314\270", false},
+    {"NotLeftTriangleEqual", "\342\213\254", false},
+    {"NotLess", "\342\211\256", false},
+    {"NotLessEqual", "\342\211\260", false},
+    {"NotLessGreater", "\342\211\270", false},
+    {"NotLessLess", "\342\211\252\314\270", false},
+    {"NotLessSlantEqual", "\342\251\275\314\270", false},
+    {"NotLessTilde", "\342\211\264", false},
+    {"NotNestedGreaterGreater", "\342\252\242\314\270", false},
+    {"NotNestedLessLess", "\342\252\241\314\270", false},
+    {"NotPrecedes", "\342\212\200", false},
+    {"NotPrecedesEqual", "\342\252\257\314\270", false},
+    {"NotPrecedesSlantEqual", "\342\213\240", false},
+    {"NotReverseElement", "\342\210\214", false},
+    {"NotRightTriangle", "\342\213\253", false},
+    {"NotRightTriangleBar", "\342\247\220\314\270", false},
+    {"NotRightTriangleEqual", "\342\213\255", false},
+    {"NotSquareSubset", "\342\212\217\314\270", false},
+    {"NotSquareSubsetEqual", "\342\213\242", false},
+    {"NotSquareSuperset", "\342\212\220\314\270", false},
+    {"NotSquareSupersetEqual", "\342\213\243", false},
+    {"NotSubset", "\342\212\202\342\203\222", false},
+    {"NotSubsetEqual", "\342\212\210", false},
+    {"NotSucceeds", "\342\212\201", false},
+    {"NotSucceedsEqual", "\342\252\260\314\270", false},
+    {"NotSucceedsSlantEqual", "\342\213\241", false},
+    {"NotSucceedsTilde", "\342\211\277\314\270", false},
+    {"NotSuperset", "\342\212\203\342\203\222", false},
+    {"NotSupersetEqual", "\342\212\211", false},
+    {"NotTilde", "\342\211\201", false},
+    {"NotTildeEqual", "\342\211\204", false},
+    {"NotTildeFullEqual", "\342\211\207", false},
+    {"NotTildeTilde", "\342\211\211", false},
+    {"NotVerticalBar", "\342\210\244", false},
+    {"Nscr", "\360\235\222\251", false},
+    {"Ntilde", "\303\221", true},
+    {"Nu", "\316\235", false},
+    {"OElig", "\305\222", false},
+    {"Oacute", "\303\223", true},
+    {"Ocirc", "\303\224", true},
+    {"Ocy", "\320\236", false},
+    {"Odblac", "\305\220", false},
+    {"Ofr", "\360\235\224\222", false},
+    {"Ograve", "\303\222", true},
+    {"Omacr", "\305\214", false},
+    {"Omega", "\316\251", false},
+    {"Omicron", "\316\237", false},
+    {"Oopf", "\360\235\225\206", false},
+    {"OpenCurlyDoubleQuote", "\342\200\234", false},
+    {"OpenCurlyQuote", "\342\200\230", false},
+    {"Or", "\342\251\224", false},
+    {"Oscr", "\360\235\222\252", false},
+    {"Oslash", "\303\230", true},
+    {"Otilde", "\303\225", true},
+    {"Otimes", "\342\250\267", false},
+    {"Ouml", "\303\226", true},
+    {"OverBar", "\342\200\276", false},
+    {"OverBrace", "\342\217\236", false},
+    {"OverBracket", "\342\216\264", false},
+    {"OverParenthesis", "\342\217\234", false},
+    {"PartialD", "\342\210\202", false},
+    {"Pcy", "\320\237", false},
+    {"Pfr", "\360\235\224\223", false},
+    {"Phi", "\316\246", false},
+    {"Pi", "\316\240", false},
+    {"PlusMinus", "\302\261", false},
+    {"Poincareplane", "\342\204\214", false},
+    {"Popf", "\342\204\231", false},
+    {"Pr", "\342\252\273", false},
+    {"Precedes", "\342\211\272", false},
+    {"PrecedesEqual", "\342\252\257", false},
+    {"PrecedesSlantEqual", "\342\211\274", false},
+    {"PrecedesTilde", "\342\211\276", false},
+    {"Prime", "\342\200\263", false},
+    {"Product", "\342\210\217", false},
+    {"Proportion", "\342\210\267", false},
+    {"Proportional", "\342\210\235", false},
+    {"Pscr", "\360\235\222\253", false},
+    {"Psi", "\316\250", false},
+    {"QUOT", "\"", true},
+    {"Qfr", "\360\235\224\224", false},
+    {"Qopf", "\342\204\232", false},
+    {"Qscr", "\360\235\222\254", false},
+    {"RBarr", "\342\244\220", false},
+    {"REG", "\302\256", true},
+    {"Racute", "\305\224", false},
+    {"Rang", "\342\237\253", false},
+    {"Rarr", "\342\206\240", false},
+    {"Rarrtl", "\342\244\226", false},
+    {"Rcaron", "\305\230", false},
+    {"Rcedil", "\305\226", false},
+    {"Rcy", "\320\240", false},
+    {"Re", "\342\204\234", false},
+    {"ReverseElement", "\342\210\213", false},
+    {"ReverseEquilibrium", "\342\207\213", false},
+    {"ReverseUpEquilibrium", "\342\245\257", false},
+    {"Rfr", "\342\204\234", false},
+    {"Rho", "\316\241", false},
+    {"RightAngleBracket", "\342\237\251", false},
+    {"RightArrow", "\342\206\222", false},
+    {"RightArrowBar", "\342\207\245", false},
+    {"RightArrowLeftArrow", "\342\207\204", false},
+    {"RightCeiling", "\342\214\211", false},
+    {"RightDoubleBracket", "\342\237\247", false},
+    {"RightDownTeeVector", "\342\245\235", false},
+    {"RightDownVector", "\342\207\202", false},
+    {"RightDownVectorBar", "\342\245\225", false},
+    {"RightFloor", "\342\214\213", false},
+    {"RightTee", "\342\212\242", false},
+    {"RightTeeArrow", "\342\206\246", false},
+    {"RightTeeVector", "\342\245\233", false},
+    {"RightTriangle", "\342\212\263", false},
+    {"RightTriangleBar", "\342\247\220", false},
+    {"RightTriangleEqual", "\342\212\265", false},
+    {"RightUpDownVector", "\342\245\217", false},
+    {"RightUpTeeVector", "\342\245\234", false},
+    {"RightUpVector", "\342\206\276", false},
+    {"RightUpVectorBar", "\342\245\224", false},
+    {"RightVector", "\342\207\200", false},
+    {"RightVectorBar", "\342\245\223", false},
+    {"Rightarrow", "\342\207\222", false},
+    {"Ropf", "\342\204\235", false},
+    {"RoundImplies", "\342\245\260", false},
+    {"Rrightarrow", "\342\207\233", false},
+    {"Rscr", "\342\204\233", false},
+    {"Rsh", "\342\206\261", false},
+    {"RuleDelayed", "\342\247\264", false},
+    {"SHCHcy", "\320\251", false},
+    {"SHcy", "\320\250", false},
+    {"SOFTcy", "\320\254", false},
+    {"Sacute", "\305\232", false},
+    {"Sc", "\342\252\274", false},
+    {"Scaron", "\305\240", false},
+    {"Scedil", "\305\236", false},
+    {"Scirc", "\305\234", false},
+    {"Scy", "\320\241", false},
+    {"Sfr", "\360\235\224\226", false},
+    {"ShortDownArrow", "\342\206\223", false},
+    {"ShortLeftArrow", "\342\206\220", false},
+    {"ShortRightArrow", "\342\206\222", false},
+    {"ShortUpArrow", "\342\206\221", false},
+    {"Sigma", "\316\243", false},
+    {"SmallCircle", "\342\210\230", false},
+    {"Sopf", "\360\235\225\212", false},
+    {"Sqrt", "\342\210\232", false},
+    {"Square", "\342\226\241", false},
+    {"SquareIntersection", "\342\212\223", false},
+    {"SquareSubset", "\342\212\217", false},
+    {"SquareSubsetEqual", "\342\212\221", false},
+    {"SquareSuperset", "\342\212\220", false},
+    {"SquareSupersetEqual", "\342\212\222", false},
+    {"SquareUnion", "\342\212\224", false},
+    {"Sscr", "\360\235\222\256", false},
+    {"Star", "\342\213\206", false},
+    {"Sub", "\342\213\220", false},
+    {"Subset", "\342\213\220", false},
+    {"SubsetEqual", "\342\212\206", false},
+    {"Succeeds", "\342\211\273", false},
+    {"SucceedsEqual", "\342\252\260", false},
+    {"SucceedsSlantEqual", "\342\211\275", false},
+    {"SucceedsTilde", "\342\211\277", false},
+    {"SuchThat", "\342\210\213", false},
+    {"Sum", "\342\210\221", false},
+    {"Sup", "\342\213\221", false},
+    {"Superset", "\342\212\203", false},
+    {"SupersetEqual", "\342\212\207", false},
+    {"Supset", "\342\213\221", false},
+    {"THORN", "\303\236", true},
+    {"TRADE", "\342\204\242", false},
+    {"TSHcy", "\320\213", false},
+    {"TScy", "\320\246", false},
+    {"Tab", "\011", false},
+    {"Tau", "\316\244", false},
+    {"Tcaron", "\305\244", false},
+    {"Tcedil", "\305\242", false},
+    {"Tcy", "\320\242", false},
+    {"Tfr", "\360\235\224\227", false},
+    {"Therefore", "\342\210\264", false},
+    {"Theta", "\316\230", false},
+    {"ThickSpace", "\342\201\237\342\200\212", false},
+    {"ThinSpace", "\342\200\211", false},
+    {"Tilde", "\342\210\274", false},
+    {"TildeEqual", "\342\211\203", false},
+    {"TildeFullEqual", "\342\211\205", false},
+    {"TildeTilde", "\342\211\210", false},
+    {"Topf", "\360\235\225\213", false},
+    {"TripleDot", "\342\203\233", false},
+    {"Tscr", "\360\235\222\257", false},
+    {"Tstrok", "\305\246", false},
+    {"Uacute", "\303\232", true},
+    {"Uarr", "\342\206\237", false},
+    {"Uarrocir", "\342\245\211", false},
+    {"Ubrcy", "\320\216", false},
+    {"Ubreve", "\305\254", false},
+    {"Ucirc", "\303\233", true},
+    {"Ucy", "\320\243", false},
+    {"Udblac", "\305\260", false},
+    {"Ufr", "\360\235\224\230", false},
+    {"Ugrave", "\303\231", true},
+    {"Umacr", "\305\252", false},
+    {"UnderBar", "_", false},
+    {"UnderBrace", "\342\217\237", false},
+    {"UnderBracket", "\342\216\265", false},
+    {"UnderParenthesis", "\342\217\235", false},
+    {"Union", "\342\213\203", false},
+    {"UnionPlus", "\342\212\216", false},
+    {"Uogon", "\305\262", false},
+    {"Uopf", "\360\235\225\214", false},
+    {"UpArrow", "\342\206\221", false},
+    {"UpArrowBar", "\342\244\222", false},
+    {"UpArrowDownArrow", "\342\207\205", false},
+    {"UpDownArrow", "\342\206\225", false},
+    {"UpEquilibrium", "\342\245\256", false},
+    {"UpTee", "\342\212\245", false},
+    {"UpTeeArrow", "\342\206\245", false},
+    {"Uparrow", "\342\207\221", false},
+    {"Updownarrow", "\342\207\225", false},
+    {"UpperLeftArrow", "\342\206\226", false},
+    {"UpperRightArrow", "\342\206\227", false},
+    {"Upsi", "\317\222", false},
+    {"Upsilon", "\316\245", false},
+    {"Uring", "\305\256", false},
+    {"Uscr", "\360\235\222\260", false},
+    {"Utilde", "\305\250", false},
+    {"Uuml", "\303\234", true},
+    {"VDash", "\342\212\253", false},
+    {"Vbar", "\342\253\253", false},
+    {"Vcy", "\320\222", false},
+    {"Vdash", "\342\212\251", false},
+    {"Vdashl", "\342\253\246", false},
+    {"Vee", "\342\213\201", false},
+    {"Verbar", "\342\200\226", false},
+    {"Vert", "\342\200\226", false},
+    {"VerticalBar", "\342\210\243", false},
+    {"VerticalLine", "|", false},
+    {"VerticalSeparator", "\342\235\230", false},
+    {"VerticalTilde", "\342\211\200", false},
+    {"VeryThinSpace", "\342\200\212", false},
+    {"Vfr", "\360\235\224\231", false},
+    {"Vopf", "\360\235\225\215", false},
+    {"Vscr", "\360\235\222\261", false},
+    {"Vvdash", "\342\212\252", false},
+    {"Wcirc", "\305\264", false},
+    {"Wedge", "\342\213\200", false},
+    {"Wfr", "\360\235\224\232", false},
+    {"Wopf", "\360\235\225\216", false},
+    {"Wscr", "\360\235\222\262", false},
+    {"Xfr", "\360\235\224\233", false},
+    {"Xi", "\316\236", false},
+    {"Xopf", "\360\235\225\217", false},
+    {"Xscr", "\360\235\222\263", false},
+    {"YAcy", "\320\257", false},
+    {"YIcy", "\320\207", false},
+    {"YUcy", "\320\256", false},
+    {"Yacute", "\303\235", true},
+    {"Ycirc", "\305\266", false},
+    {"Ycy", "\320\253", false},
+    {"Yfr", "\360\235\224\234", false},
+    {"Yopf", "\360\235\225\220", false},
+    {"Yscr", "\360\235\222\264", false},
+    {"Yuml", "\305\270", false},
+    {"ZHcy", "\320\226", false},
+    {"Zacute", "\305\271", false},
+    {"Zcaron", "\305\275", false},
+    {"Zcy", "\320\227", false},
+    {"Zdot", "\305\273", false},
+    {"ZeroWidthSpace", "\342\200\213", false},
+    {"Zeta", "\316\226", false},
+    {"Zfr", "\342\204\250", false},
+    {"Zopf", "\342\204\244", false},
+    {"Zscr", "\360\235\222\265", false},
+    {"aacute", "\303\241", true},
+    {"abreve", "\304\203", false},
+    {"ac", "\342\210\276", false},
+    {"acE", "\342\210\276\314\263", false},
+    {"acd", "\342\210\277", false},
+    {"acirc", "\303\242", true},
+    {"acute", "\302\264", true},
+    {"acy", "\320\260", false},
+    {"aelig", "\303\246", true},
+    {"af", "\342\201\241", false},
+    {"afr", "\360\235\224\236", false},
+    {"agrave", "\303\240", true},
+    {"alefsym", "\342\204\265", false},
+    {"aleph", "\342\204\265", false},
+    {"alpha", "\316\261", false},
+    {"amacr", "\304\201", false},
+    {"amalg", "\342\250\277", false},
+    {"amp", "&", true},
+    {"and", "\342\210\247", false},
+    {"andand", "\342\251\225", false},
+    {"andd", "\342\251\234", false},
+    {"andslope", "\342\251\230", false},
+    {"andv", "\342\251\232", false},
+    {"ang", "\342\210\240", false},
+    {"ange", "\342\246\244", false},
+    {"angle", "\342\210\240", false},
+    {"angmsd", "\342\210\241", false},
+    {"angmsdaa", "\342\246\250", false},
+    {"angmsdab", "\342\246\251", false},
+    {"angmsdac", "\342\246\252", false},
+    {"angmsdad", "\342\246\253", false},
+    {"angmsdae", "\342\246\254", false},
+    {"angmsdaf", "\342\246\255", false},
+    {"angmsdag", "\342\246\256", false},
+    {"angmsdah", "\342\246\257", false},
+    {"angrt", "\342\210\237", false},
+    {"angrtvb", "\342\212\276", false},
+    {"angrtvbd", "\342\246\235", false},
+    {"angsph", "\342\210\242", false},
+    {"angst", "\303\205", false},
+    {"angzarr", "\342\215\274", false},
+    {"aogon", "\304\205", false},
+    {"aopf", "\360\235\225\222", false},
+    {"ap", "\342\211\210", false},
+    {"apE", "\342\251\260", false},
+    {"apacir", "\342\251\257", false},
+    {"ape", "\342\211\212", false},
+    {"apid", "\342\211\213", false},
+    {"apos", "'", false},
+    {"approx", "\342\211\210", false},
+    {"approxeq", "\342\211\212", false},
+    {"aring", "\303\245", true},
+    {"ascr", "\360\235\222\266", false},
+    {"ast", "*", false},
+    {"asymp", "\342\211\210", false},
+    {"asympeq", "\342\211\215", false},
+    {"atilde", "\303\243", true},
+    {"auml", "\303\244", true},
+    {"awconint", "\342\210\263", false},
+    {"awint", "\342\250\221", false},
+    {"bNot", "\342\253\255", false},
+    {"backcong", "\342\211\214", false},
+    {"backepsilon", "\317\266", false},
+    {"backprime", "\342\200\265", false},
+    {"backsim", "\342\210\275", false},
+    {"backsimeq", "\342\213\215", false},
+    {"barvee", "\342\212\275", false},
+    {"barwed", "\342\214\205", false},
+    {"barwedge", "\342\214\205", false},
+    {"bbrk", "\342\216\265", false},
+    {"bbrktbrk", "\342\216\266", false},
+    {"bcong", "\342\211\214", false},
+    {"bcy", "\320\261", false},
+    {"bdquo", "\342\200\236", false},
+    {"becaus", "\342\210\265", false},
+    {"because", "\342\210\265", false},
+    {"bemptyv", "\342\246\260", false},
+    {"bepsi", "\317\266", false},
+    {"bernou", "\342\204\254", false},
+    {"beta", "\316\262", false},
+    {"beth", "\342\204\266", false},
+    {"between", "\342\211\254", false},
+    {"bfr", "\360\235\224\237", false},
+    {"bigcap", "\342\213\202", false},
+    {"bigcirc", "\342\227\257", false},
+    {"bigcup", "\342\213\203", false},
+    {"bigodot", "\342\250\200", false},
+    {"bigoplus", "\342\250\201", false},
+    {"bigotimes", "\342\250\202", false},
+    {"bigsqcup", "\342\250\206", false},
+    {"bigstar", "\342\230\205", false},
+    {"bigtriangledown", "\342\226\275", false},
+    {"bigtriangleup", "\342\226\263", false},
+    {"biguplus", "\342\250\204", false},
+    {"bigvee", "\342\213\201", false},
+    {"bigwedge", "\342\213\200", false},
+    {"bkarow", "\342\244\215", false},
+    {"blacklozenge", "\342\247\253", false},
+    {"blacksquare", "\342\226\252", false},
+    {"blacktriangle", "\342\226\264", false},
+    {"blacktriangledown", "\342\226\276", false},
+    {"blacktriangleleft", "\342\227\202", false},
+    {"blacktriangleright", "\342\226\270", false},
+    {"blank", "\342\220\243", false},
+    {"blk12", "\342\226\222", false},
+    {"blk14", "\342\226\221", false},
+    {"blk34", "\342\226\223", false},
+    {"block", "\342\226\210", false},
+    {"bne", "=\342\203\245", false},
+    {"bnequiv", "\342\211\241\342\203\245", false},
+    {"bnot", "\342\214\220", false},
+    {"bopf", "\360\235\225\223", false},
+    {"bot", "\342\212\245", false},
+    {"bottom", "\342\212\245", false},
+    {"bowtie", "\342\213\210", false},
+    {"boxDL", "\342\225\227", false},
+    {"boxDR", "\342\225\224", false},
+    {"boxDl", "\342\225\226", false},
+    {"boxDr", "\342\225\223", false},
+    {"boxH", "\342\225\220", false},
+    {"boxHD", "\342\225\246", false},
+    {"boxHU", "\342\225\251", false},
+    {"boxHd", "\342\225\244", false},
+    {"boxHu", "\342\225\247", false},
+    {"boxUL", "\342\225\235", false},
+    {"boxUR", "\342\225\232", false},
+    {"boxUl", "\342\225\234", false},
+    {"boxUr", "\342\225\231", false},
+    {"boxV", "\342\225\221", false},
+    {"boxVH", "\342\225\254", false},
+    {"boxVL", "\342\225\243", false},
+    {"boxVR", "\342\225\240", false},
+    {"boxVh", "\342\225\253", false},
+    {"boxVl", "\342\225\242", false},
+    {"boxVr", "\342\225\237", false},
+    {"boxbox", "\342\247\211", false},
+    {"boxdL", "\342\225\225", false},
+    {"boxdR", "\342\225\222", false},
+    {"boxdl", "\342\224\220", false},
+    {"boxdr", "\342\224\214", false},
+    {"boxh", "\342\224\200", false},
+    {"boxhD", "\342\225\245", false},
+    {"boxhU", "\342\225\250", false},
+    {"boxhd", "\342\224\254", false},
+    {"boxhu", "\342\224\264", false},
+    {"boxminus", "\342\212\237", false},
+    {"boxplus", "\342\212\236", false},
+    {"boxtimes", "\342\212\240", false},
+    {"boxuL", "\342\225\233", false},
+    {"boxuR", "\342\225\230", false},
+    {"boxul", "\342\224\230", false},
+    {"boxur", "\342\224\224", false},
+    {"boxv", "\342\224\202", false},
+    {"boxvH", "\342\225\252", false},
+    {"boxvL", "\342\225\241", false},
+    {"boxvR", "\342\225\236", false},
+    {"boxvh", "\342\224\274", false},
+    {"boxvl", "\342\224\244", false},
+    {"boxvr", "\342\224\234", false},
+    {"bprime", "\342\200\265", false},
+    {"breve", "\313\230", false},
+    {"brvbar", "\302\246", true},
+    {"bscr", "\360\235\222\267", false},
+    {"bsemi", "\342\201\217", false},
+    {"bsim", "\342\210\275", false},
+    {"bsime", "\342\213\215", false},
+    {"bsol", "\\", false},
+    {"bsolb", "\342\247\205", false},
+    {"bsolhsub", "\342\237\210", false},
+    {"bull", "\342\200\242", false},
+    {"bullet", "\342\200\242", false},
+    {"bump", "\342\211\216", false},
+    {"bumpE", "\342\252\256", false},
+    {"bumpe", "\342\211\217", false},
+    {"bumpeq", "\342\211\217", false},
+    {"cacute", "\304\207", false},
+    {"cap", "\342\210\251", false},
+    {"capand", "\342\251\204", false},
+    {"capbrcup", "\342\251\211", false},
+    {"capcap", "\342\251\213", false},
+    {"capcup", "\342\251\207", false},
+    {"capdot", "\342\251\200", false},
+    {"caps", "\342\210\251\357\270\200", false},
+    {"caret", "\342\201\201", false},
+    {"caron", "\313\207", false},
+    {"ccaps", "\342\251\215", false},
+    {"ccaron", "\304\215", false},
+    {"ccedil", "\303\247", true},
+    {"ccirc", "\304\211", false},
+    {"ccups", "\342\251\214", false},
+    {"ccupssm", "\342\251\220", false},
+    {"cdot", "\304\213", false},
+    {"cedil", "\302\270", true},
+    {"cemptyv", "\342\246\262", false},
+    {"cent", "\302\242", true},
+    {"centerdot", "\302\267", false},
+    {"cfr", "\360\235\224\240", false},
+    {"chcy", "\321\207", false},
+    {"check", "\342\234\223", false},
+    {"checkmark", "\342\234\223", false},
+    {"chi", "\317\207", false},
+    {"cir", "\342\227\213", false},
+    {"cirE", "\342\247\203", false},
+    {"circ", "\313\206", false},
+    {"circeq", "\342\211\227", false},
+    {"circlearrowleft", "\342\206\272", false},
+    {"circlearrowright", "\342\206\273", false},
+    {"circledR", "\302\256", false},
+    {"circledS", "\342\223\210", false},
+    {"circledast", "\342\212\233", false},
+    {"circledcirc", "\342\212\232", false},
+    {"circleddash", "\342\212\235", false},
+    {"cire", "\342\211\227", false},
+    {"cirfnint", "\342\250\220", false},
+    {"cirmid", "\342\253\257", false},
+    {"cirscir", "\342\247\202", false},
+    {"clubs", "\342\231\243", false},
+    {"clubsuit", "\342\231\243", false},
+    {"colon", ":", false},
+    {"colone", "\342\211\224", false},
+    {"coloneq", "\342\211\224", false},
+    {"comma", ",", false},
+    {"commat", "@", false},
+    {"comp", "\342\210\201", false},
+    {"compfn", "\342\210\230", false},
+    {"complement", "\342\210\201", false},
+    {"complexes", "\342\204\202", false},
+    {"cong", "\342\211\205", false},
+    {"congdot", "\342\251\255", false},
+    {"conint", "\342\210\256", false},
+    {"copf", "\360\235\225\224", false},
+    {"coprod", "\342\210\220", false},
+    {"copy", "\302\251", true},
+    {"copysr", "\342\204\227", false},
+    {"crarr", "\342\206\265", false},
+    {"cross", "\342\234\227", false},
+    {"cscr", "\360\235\222\270", false},
+    {"csub", "\342\253\217", false},
+    {"csube", "\342\253\221", false},
+    {"csup", "\342\253\220", false},
+    {"csupe", "\342\253\222", false},
+    {"ctdot", "\342\213\257", false},
+    {"cudarrl", "\342\244\270", false},
+    {"cudarrr", "\342\244\265", false},
+    {"cuepr", "\342\213\236", false},
+    {"cuesc", "\342\213\237", false},
+    {"cularr", "\342\206\266", false},
+    {"cularrp", "\342\244\275", false},
+    {"cup", "\342\210\252", false},
+    {"cupbrcap", "\342\251\210", false},
+    {"cupcap", "\342\251\206", false},
+    {"cupcup", "\342\251\212", false},
+    {"cupdot", "\342\212\215", false},
+    {"cupor", "\342\251\205", false},
+    {"cups", "\342\210\252\357\270\200", false},
+    {"curarr", "\342\206\267", false},
+    {"curarrm", "\342\244\274", false},
+    {"curlyeqprec", "\342\213\236", false},
+    {"curlyeqsucc", "\342\213\237", false},
+    {"curlyvee", "\342\213\216", false},
+    {"curlywedge", "\342\213\217", false},
+    {"curren", "\302\244", true},
+    {"curvearrowleft", "\342\206\266", false},
+    {"curvearrowright", "\342\206\267", false},
+    {"cuvee", "\342\213\216", false},
+    {"cuwed", "\342\213\217", false},
+    {"cwconint", "\342\210\262", false},
+    {"cwint", "\342\210\261", false},
+    {"cylcty", "\342\214\255", false},
+    {"dArr", "\342\207\223", false},
+    {"dHar", "\342\245\245", false},
+    {"dagger", "\342\200\240", false},
+    {"daleth", "\342\204\270", false},
+    {"darr", "\342\206\223", false},
+    {"dash", "\342\200\220", false},
+    {"dashv", "\342\212\243", false},
+    {"dbkarow", "\342\244\217", false},
+    {"dblac", "\313\235", false},
+    {"dcaron", "\304\217", false},
+    {"dcy", "\320\264", false},
+    {"dd", "\342\205\206", false},
+    {"ddagger", "\342\200\241", false},
+    {"ddarr", "\342\207\212", false},
+    {"ddotseq", "\342\251\267", false},
+    {"deg", "\302\260", true},
+    {"delta", "\316\264", false},
+    {"demptyv", "\342\246\261", false},
+    {"dfisht", "\342\245\277", false},
+    {"dfr", "\360\235\224\241", false},
+    {"dharl", "\342\207\203", false},
+    {"dharr", "\342\207\202", false},
+    {"diam", "\342\213\204", false},
+    {"diamond", "\342\213\204", false},
+    {"diamondsuit", "\342\231\246", false},
+    {"diams", "\342\231\246", false},
+    {"die", "\302\250", false},
+    {"digamma", "\317\235", false},
+    {"disin", "\342\213\262", false},
+    {"div", "\303\267", false},
+    {"divide", "\303\267", true},
+    {"divideontimes", "\342\213\207", false},
+    {"divonx", "\342\213\207", false},
+    {"djcy", "\321\222", false},
+    {"dlcorn", "\342\214\236", false},
+    {"dlcrop", "\342\214\215", false},
+    {"dollar", "$", false},
+    {"dopf", "\360\235\225\225", false},
+    {"dot", "\313\231", false},
+    {"doteq", "\342\211\220", false},
+    {"doteqdot", "\342\211\221", false},
+    {"dotminus", "\342\210\270", false},
+    {"dotplus", "\342\210\224", false},
+    {"dotsquare", "\342\212\241", false},
+    {"doublebarwedge", "\342\214\206", false},
+    {"downarrow", "\342\206\223", false},
+    {"downdownarrows", "\342\207\212", false},
+    {"downharpoonleft", "\342\207\203", false},
+    {"downharpoonright", "\342\207\202", false},
+    {"drbkarow", "\342\244\220", false},
+    {"drcorn", "\342\214\237", false},
+    {"drcrop", "\342\214\214", false},
+    {"dscr", "\360\235\222\271", false},
+    {"dscy", "\321\225", false},
+    {"dsol", "\342\247\266", false},
+    {"dstrok", "\304\221", false},
+    {"dtdot", "\342\213\261", false},
+    {"dtri", "\342\226\277", false},
+    {"dtrif", "\342\226\276", false},
+    {"duarr", "\342\207\265", false},
+    {"duhar", "\342\245\257", false},
+    {"dwangle", "\342\246\246", false},
+    {"dzcy", "\321\237", false},
+    {"dzigrarr", "\342\237\277", false},
+    {"eDDot", "\342\251\267", false},
+    {"eDot", "\342\211\221", false},
+    {"eacute", "\303\251", true},
+    {"easter", "\342\251\256", false},
+    {"ecaron", "\304\233", false},
+    {"ecir", "\342\211\226", false},
+    {"ecirc", "\303\252", true},
+    {"ecolon", "\342\211\225", false},
+    {"ecy", "\321\215", false},
+    {"edot", "\304\227", false},
+    {"ee", "\342\205\207", false},
+    {"efDot", "\342\211\222", false},
+    {"efr", "\360\235\224\242", false},
+    {"eg", "\342\252\232", false},
+    {"egrave", "\303\250", true},
+    {"egs", "\342\252\226", false},
+    {"egsdot", "\342\252\230", false},
+    {"el", "\342\252\231", false},
+    {"elinters", "\342\217\247", false},
+    {"ell", "\342\204\223", false},
+    {"els", "\342\252\225", false},
+    {"elsdot", "\342\252\227", false},
+    {"emacr", "\304\223", false},
+    {"empty", "\342\210\205", false},
+    {"emptyset", "\342\210\205", false},
+    {"emptyv", "\342\210\205", false},
+    {"emsp", "\342\200\203", false},
+    {"emsp13", "\342\200\204", false},
+    {"emsp14", "\342\200\205", false},
+    {"eng", "\305\213", false},
+    {"ensp", "\342\200\202", false},
+    {"eogon", "\304\231", false},
+    {"eopf", "\360\235\225\226", false},
+    {"epar", "\342\213\225", false},
+    {"eparsl", "\342\247\243", false},
+    {"eplus", "\342\251\261", false},
+    {"epsi", "\316\265", false},
+    {"epsilon", "\316\265", false},
+    {"epsiv", "\317\265", false},
+    {"eqcirc", "\342\211\226", false},
+    {"eqcolon", "\342\211\225", false},
+    {"eqsim", "\342\211\202", false},
+    {"eqslantgtr", "\342\252\226", false},
+    {"eqslantless", "\342\252\225", false},
+    {"equals", "=", false},
+    {"equest", "\342\211\237", false},
+    {"equiv", "\342\211\241", false},
+    {"equivDD", "\342\251\270", false},
+    {"eqvparsl", "\342\247\245", false},
+    {"erDot", "\342\211\223", false},
+    {"erarr", "\342\245\261", false},
+    {"escr", "\342\204\257", false},
+    {"esdot", "\342\211\220", false},
+    {"esim", "\342\211\202", false},
+    {"eta", "\316\267", false},
+    {"eth", "\303\260", true},
+    {"euml", "\303\253", true},
+    {"euro", "\342\202\254", false},
+    {"excl", "!", false},
+    {"exist", "\342\210\203", false},
+    {"expectation", "\342\204\260", false},
+    {"exponentiale", "\342\205\207", false},
+    {"fallingdotseq", "\342\211\222", false},
+    {"fcy", "\321\204", false},
+    {"female", "\342\231\200", false},
+    {"ffilig", "\357\254\203", false},
+    {"fflig", "\357\254\200", false},
+    {"ffllig", "\357\254\204", false},
+    {"ffr", "\360\235\224\243", false},
+    {"filig", "\357\254\201", false},
+    {"fjlig", "fj", false},
+    {"flat", "\342\231\255", false},
+    {"fllig", "\357\254\202", false},
+    {"fltns", "\342\226\261", false},
+    {"fnof", "\306\222", false},
+    {"fopf", "\360\235\225\227", false},
+    {"forall", "\342\210\200", false},
+    {"fork", "\342\213\224", false},
+    {"forkv", "\342\253\231", false},
+    {"fpartint", "\342\250\215", false},
+    {"frac12", "\302\275", true},
+    {"frac13", "\342\205\223", false},
+    {"frac14", "\302\274", true},
+    {"frac15", "\342\205\225", false},
+    {"frac16", "\342\205\231", false},
+    {"frac18", "\342\205\233", false},
+    {"frac23", "\342\205\224", false},
+    {"frac25", "\342\205\226", false},
+    {"frac34", "\302\276", true},
+    {"frac35", "\342\205\227", false},
+    {"frac38", "\342\205\234", false},
+    {"frac45", "\342\205\230", false},
+    {"frac56", "\342\205\232", false},
+    {"frac58", "\342\205\235", false},
+    {"frac78", "\342\205\236", false},
+    {"frasl", "\342\201\204", false},
+    {"frown", "\342\214\242", false},
+    {"fscr", "\360\235\222\273", false},
+    {"gE", "\342\211\247", false},
+    {"gEl", "\342\252\214", false},
+    {"gacute", "\307\265", false},
+    {"gamma", "\316\263", false},
+    {"gammad", "\317\235", false},
+    {"gap", "\342\252\206", false},
+    {"gbreve", "\304\237", false},
+    {"gcirc", "\304\235", false},
+    {"gcy", "\320\263", false},
+    {"gdot", "\304\241", false},
+    {"ge", "\342\211\245", false},
+    {"gel", "\342\213\233", false},
+    {"geq", "\342\211\245", false},
+    {"geqq", "\342\211\247", false},
+    {"geqslant", "\342\251\276", false},
+    {"ges", "\342\251\276", false},
+    {"gescc", "\342\252\251", false},
+    {"gesdot", "\342\252\200", false},
+    {"gesdoto", "\342\252\202", false},
+    {"gesdotol", "\342\252\204", false},
+    {"gesl", "\342\213\233\357\270\200", false},
+    {"gesles", "\342\252\224", false},
+    {"gfr", "\360\235\224\244", false},
+    {"gg", "\342\211\253", false},
+    {"ggg", "\342\213\231", false},
+    {"gimel", "\342\204\267", false},
+    {"gjcy", "\321\223", false},
+    {"gl", "\342\211\267", false},
+    {"glE", "\342\252\222", false},
+    {"gla", "\342\252\245", false},
+    {"glj", "\342\252\244", false},
+    {"gnE", "\342\211\251", false},
+    {"gnap", "\342\252\212", false},
+    {"gnapprox", "\342\252\212", false},
+    {"gne", "\342\252\210", false},
+    {"gneq", "\342\252\210", false},
+    {"gneqq", "\342\211\251", false},
+    {"gnsim", "\342\213\247", false},
+    {"gopf", "\360\235\225\230", false},
+    {"grave", "`", false},
+    {"gscr", "\342\204\212", false},
+    {"gsim", "\342\211\263", false},
+    {"gsime", "\342\252\216", false},
+    {"gsiml", "\342\252\220", false},
+    {"gt", ">", true},
+    {"gtcc", "\342\252\247", false},
+    {"gtcir", "\342\251\272", false},
+    {"gtdot", "\342\213\227", false},
+    {"gtlPar", "\342\246\225", false},
+    {"gtquest", "\342\251\274", false},
+    {"gtrapprox", "\342\252\206", false},
+    {"gtrarr", "\342\245\270", false},
+    {"gtrdot", "\342\213\227", false},
+    {"gtreqless", "\342\213\233", false},
+    {"gtreqqless", "\342\252\214", false},
+    {"gtrless", "\342\211\267", false},
+    {"gtrsim", "\342\211\263", false},
+    {"gvertneqq", "\342\211\251\357\270\200", false},
+    {"gvnE", "\342\211\251\357\270\200", false},
+    {"hArr", "\342\207\224", false},
+    {"hairsp", "\342\200\212", false},
+    {"half", "\302\275", false},
+    {"hamilt", "\342\204\213", false},
+    {"hardcy", "\321\212", false},
+    {"harr", "\342\206\224", false},
+    {"harrcir", "\342\245\210", false},
+    {"harrw", "\342\206\255", false},
+    {"hbar", "\342\204\217", false},
+    {"hcirc", "\304\245", false},
+    {"hearts", "\342\231\245", false},
+    {"heartsuit", "\342\231\245", false},
+    {"hellip", "\342\200\246", false},
+    {"hercon", "\342\212\271", false},
+    {"hfr", "\360\235\224\245", false},
+    {"hksearow", "\342\244\245", false},
+    {"hkswarow", "\342\244\246", false},
+    {"hoarr", "\342\207\277", false},
+    {"homtht", "\342\210\273", false},
+    {"hookleftarrow", "\342\206\251", false},
+    {"hookrightarrow", "\342\206\252", false},
+    {"hopf", "\360\235\225\231", false},
+    {"horbar", "\342\200\225", false},
+    {"hscr", "\360\235\222\275", false},
+    {"hslash", "\342\204\217", false},
+    {"hstrok", "\304\247", false},
+    {"hybull", "\342\201\203", false},
+    {"hyphen", "\342\200\220", false},
+    {"iacute", "\303\255", true},
+    {"ic", "\342\201\243", false},
+    {"icirc", "\303\256", true},
+    {"icy", "\320\270", false},
+    {"iecy", "\320\265", false},
+    {"iexcl", "\302\241", true},
+    {"iff", "\342\207\224", false},
+    {"ifr", "\360\235\224\246", false},
+    {"igrave", "\303\254", true},
+    {"ii", "\342\205\210", false},
+    {"iiiint", "\342\250\214", false},
+    {"iiint", "\342\210\255", false},
+    {"iinfin", "\342\247\234", false},
+    {"iiota", "\342\204\251", false},
+    {"ijlig", "\304\263", false},
+    {"imacr", "\304\253", false},
+    {"image", "\342\204\221", false},
+    {"imagline", "\342\204\220", false},
+    {"imagpart", "\342\204\221", false},
+    {"imath", "\304\261", false},
+    {"imof", "\342\212\267", false},
+    {"imped", "\306\265", false},
+    {"in", "\342\210\210", false},
+    {"incare", "\342\204\205", false},
+    {"infin", "\342\210\236", false},
+    {"infintie", "\342\247\235", false},
+    {"inodot", "\304\261", false},
+    {"int", "\342\210\253", false},
+    {"intcal", "\342\212\272", false},
+    {"integers", "\342\204\244", false},
+    {"intercal", "\342\212\272", false},
+    {"intlarhk", "\342\250\227", false},
+    {"intprod", "\342\250\274", false},
+    {"iocy", "\321\221", false},
+    {"iogon", "\304\257", false},
+    {"iopf", "\360\235\225\232", false},
+    {"iota", "\316\271", false},
+    {"iprod", "\342\250\274", false},
+    {"iquest", "\302\277", true},
+    {"iscr", "\360\235\222\276", false},
+    {"isin", "\342\210\210", false},
+    {"isinE", "\342\213\271", false},
+    {"isindot", "\342\213\265", false},
+    {"isins", "\342\213\264", false},
+    {"isinsv", "\342\213\263", false},
+    {"isinv", "\342\210\210", false},
+    {"it", "\342\201\242", false},
+    {"itilde", "\304\251", false},
+    {"iukcy", "\321\226", false},
+    {"iuml", "\303\257", true},
+    {"jcirc", "\304\265", false},
+    {"jcy", "\320\271", false},
+    {"jfr", "\360\235\224\247", false},
+    {"jmath", "\310\267", false},
+    {"jopf", "\360\235\225\233", false},
+    {"jscr", "\360\235\222\277", false},
+    {"jsercy", "\321\230", false},
+    {"jukcy", "\321\224", false},
+    {"kappa", "\316\272", false},
+    {"kappav", "\317\260", false},
+    {"kcedil", "\304\267", false},
+    {"kcy", "\320\272", false},
+    {"kfr", "\360\235\224\250", false},
+    {"kgreen", "\304\270", false},
+    {"khcy", "\321\205", false},
+    {"kjcy", "\321\234", false},
+    {"kopf", "\360\235\225\234", false},
+    {"kscr", "\360\235\223\200", false},
+    {"lAarr", "\342\207\232", false},
+    {"lArr", "\342\207\220", false},
+    {"lAtail", "\342\244\233", false},
+    {"lBarr", "\342\244\216", false},
+    {"lE", "\342\211\246", false},
+    {"lEg", "\342\252\213", false},
+    {"lHar", "\342\245\242", false},
+    {"lacute", "\304\272", false},
+    {"laemptyv", "\342\246\264", false},
+    {"lagran", "\342\204\222", false},
+    {"lambda", "\316\273", false},
+    {"lang", "\342\237\250", false},
+    {"langd", "\342\246\221", false},
+    {"langle", "\342\237\250", false},
+    {"lap", "\342\252\205", false},
+    {"laquo", "\302\253", true},
+    {"larr", "\342\206\220", false},
+    {"larrb", "\342\207\244", false},
+    {"larrbfs", "\342\244\237", false},
+    {"larrfs", "\342\244\235", false},
+    {"larrhk", "\342\206\251", false},
+    {"larrlp", "\342\206\253", false},
+    {"larrpl", "\342\244\271", false},
+    {"larrsim", "\342\245\263", false},
+    {"larrtl", "\342\206\242", false},
+    {"lat", "\342\252\253", false},
+    {"latail", "\342\244\231", false},
+    {"late", "\342\252\255", false},
+    {"lates", "\342\252\255\357\270\200", false},
+    {"lbarr", "\342\244\214", false},
+    {"lbbrk", "\342\235\262", false},
+    {"lbrace", "{", false},
+    {"lbrack", "[", false},
+    {"lbrke", "\342\246\213", false},
+    {"lbrksld", "\342\246\217", false},
+    {"lbrkslu", "\342\246\215", false},
+    {"lcaron", "\304\276", false},
+    {"lcedil", "\304\274", false},
+    {"lceil", "\342\214\210", false},
+    {"lcub", "{", false},
+    {"lcy", "\320\273", false},
+    {"ldca", "\342\244\266", false},
+    {"ldquo", "\342\200\234", false},
+    {"ldquor", "\342\200\236", false},
+    {"ldrdhar", "\342\245\247", false},
+    {"ldrushar", "\342\245\213", false},
+    {"ldsh", "\342\206\262", false},
+    {"le", "\342\211\244", false},
+    {"leftarrow", "\342\206\220", false},
+    {"leftarrowtail", "\342\206\242", false},
+    {"leftharpoondown", "\342\206\275", false},
+    {"leftharpoonup", "\342\206\274", false},
+    {"leftleftarrows", "\342\207\207", false},
+    {"leftrightarrow", "\342\206\224", false},
+    {"leftrightarrows", "\342\207\206", false},
+    {"leftrightharpoons", "\342\207\213", false},
+    {"leftrightsquigarrow", "\342\206\255", false},
+    {"leftthreetimes", "\342\213\213", false},
+    {"leg", "\342\213\232", false},
+    {"leq", "\342\211\244", false},
+    {"leqq", "\342\211\246", false},
+    {"leqslant", "\342\251\275", false},
+    {"les", "\342\251\275", false},
+    {"lescc", "\342\252\250", false},
+    {"lesdot", "\342\251\277", false},
+    {"lesdoto", "\342\252\201", false},
+    {"lesdotor", "\342\252\203", false},
+    {"lesg", "\342\213\232\357\270\200", false},
+    {"lesges", "\342\252\223", false},
+    {"lessapprox", "\342\252\205", false},
+    {"lessdot", "\342\213\226", false},
+    {"lesseqgtr", "\342\213\232", false},
+    {"lesseqqgtr", "\342\252\213", false},
+    {"lessgtr", "\342\211\266", false},
+    {"lesssim", "\342\211\262", false},
+    {"lfisht", "\342\245\274", false},
+    {"lfloor", "\342\214\212", false},
+    {"lfr", "\360\235\224\251", false},
+    {"lg", "\342\211\266", false},
+    {"lgE", "\342\252\221", false},
+    {"lhard", "\342\206\275", false},
+    {"lharu", "\342\206\274", false},
+    {"lharul", "\342\245\252", false},
+    {"lhblk", "\342\226\204", false},
+    {"ljcy", "\321\231", false},
+    {"ll", "\342\211\252", false},
+    {"llarr", "\342\207\207", false},
+    {"llcorner", "\342\214\236", false},
+    {"llhard", "\342\245\253", false},
+    {"lltri", "\342\227\272", false},
+    {"lmidot", "\305\200", false},
+    {"lmoust", "\342\216\260", false},
+    {"lmoustache", "\342\216\260", false},
+    {"lnE", "\342\211\250", false},
+    {"lnap", "\342\252\211", false},
+    {"lnapprox", "\342\252\211", false},
+    {"lne", "\342\252\207", false},
+    {"lneq", "\342\252\207", false},
+    {"lneqq", "\342\211\250", false},
+    {"lnsim", "\342\213\246", false},
+    {"loang", "\342\237\254", false},
+    {"loarr", "\342\207\275", false},
+    {"lobrk", "\342\237\246", false},
+    {"longleftarrow", "\342\237\265", false},
+    {"longleftrightarrow", "\342\237\267", false},
+    {"longmapsto", "\342\237\274", false},
+    {"longrightarrow", "\342\237\266", false},
+    {"looparrowleft", "\342\206\253", false},
+    {"looparrowright", "\342\206\254", false},
+    {"lopar", "\342\246\205", false},
+    {"lopf", "\360\235\225\235", false},
+    {"loplus", "\342\250\255", false},
+    {"lotimes", "\342\250\264", false},
+    {"lowast", "\342\210\227", false},
+    {"lowbar", "_", false},
+    {"loz", "\342\227\212", false},
+    {"lozenge", "\342\227\212", false},
+    {"lozf", "\342\247\253", false},
+    {"lpar", "(", false},
+    {"lparlt", "\342\246\223", false},
+    {"lrarr", "\342\207\206", false},
+    {"lrcorner", "\342\214\237", false},
+    {"lrhar", "\342\207\213", false},
+    {"lrhard", "\342\245\255", false},
+    {"lrm", "\342\200\216", false},
+    {"lrtri", "\342\212\277", false},
+    {"lsaquo", "\342\200\271", false},
+    {"lscr", "\360\235\223\201", false},
+    {"lsh", "\342\206\260", false},
+    {"lsim", "\342\211\262", false},
+    {"lsime", "\342\252\215", false},
+    {"lsimg", "\342\252\217", false},
+    {"lsqb", "[", false},
+    {"lsquo", "\342\200\230", false},
+    {"lsquor", "\342\200\232", false},
+    {"lstrok", "\305\202", false},
+    {"lt", "<", true},
+    {"ltcc", "\342\252\246", false},
+    {"ltcir", "\342\251\271", false},
+    {"ltdot", "\342\213\226", false},
+    {"lthree", "\342\213\213", false},
+    {"ltimes", "\342\213\211", false},
+    {"ltlarr", "\342\245\266", false},
+    {"ltquest", "\342\251\273", false},
+    {"ltrPar", "\342\246\226", false},
+    {"ltri", "\342\227\203", false},
+    {"ltrie", "\342\212\264", false},
+    {"ltrif", "\342\227\202", false},
+    {"lurdshar", "\342\245\212", false},
+    {"luruhar", "\342\245\246", false},
+    {"lvertneqq", "\342\211\250\357\270\200", false},
+    {"lvnE", "\342\211\250\357\270\200", false},
+    {"mDDot", "\342\210\272", false},
+    {"macr", "\302\257", true},
+    {"male", "\342\231\202", false},
+    {"malt", "\342\234\240", false},
+    {"maltese", "\342\234\240", false},
+    {"map", "\342\206\246", false},
+    {"mapsto", "\342\206\246", false},
+    {"mapstodown", "\342\206\247", false},
+    {"mapstoleft", "\342\206\244", false},
+    {"mapstoup", "\342\206\245", false},
+    {"marker", "\342\226\256", false},
+    {"mcomma", "\342\250\251", false},
+    {"mcy", "\320\274", false},
+    {"mdash", "\342\200\224", false},
+    {"measuredangle", "\342\210\241", false},
+    {"mfr", "\360\235\224\252", false},
+    {"mho", "\342\204\247", false},
+    {"micro", "\302\265", true},
+    {"mid", "\342\210\243", false},
+    {"midast", "*", false},
+    {"midcir", "\342\253\260", false},
+    {"middot", "\302\267", true},
+    {"minus", "\342\210\222", false},
+    {"minusb", "\342\212\237", false},
+    {"minusd", "\342\210\270", false},
+    {"minusdu", "\342\250\252", false},
+    {"mlcp", "\342\253\233", false},
+    {"mldr", "\342\200\246", false},
+    {"mnplus", "\342\210\223", false},
+    {"models", "\342\212\247", false},
+    {"mopf", "\360\235\225\236", false},
+    {"mp", "\342\210\223", false},
+    {"mscr", "\360\235\223\202", false},
+    {"mstpos", "\342\210\276", false},
+    {"mu", "\316\274", false},
+    {"multimap", "\342\212\270", false},
+    {"mumap", "\342\212\270", false},
+    {"nGg", "\342\213\231\314\270", false},
+    {"nGt", "\342\211\253\342\203\222", false},
+    {"nGtv", "\342\211\253\314\270", false},
+    {"nLeftarrow", "\342\207\215", false},
+    {"nLeftrightarrow", "\342\207\216", false},
+    {"nLl", "\342\213\230\314\270", false},
+    {"nLt", "\342\211\252\342\203\222", false},
+    {"nLtv", "\342\211\252\314\270", false},
+    {"nRightarrow", "\342\207\217", false},
+    {"nVDash", "\342\212\257", false},
+    {"nVdash", "\342\212\256", false},
+    {"nabla", "\342\210\207", false},
+    {"nacute", "\305\204", false},
+    {"nang", "\342\210\240\342\203\222", false},
+    {"nap", "\342\211\211", false},
+    {"napE", "\342\251\260\314\270", false},
+    {"napid", "\342\211\213\314\270", false},
+    {"napos", "\305\211", false},
+    {"napprox", "\342\211\211", false},
+    {"natur", "\342\231\256", false},
+    {"natural", "\342\231\256", false},
+    {"naturals", "\342\204\225", false},
+    {"nbsp", "\302\240", true},
+    {"nbump", "\342\211\216\314\270", false},
+    {"nbumpe", "\342\211\217\314\270", false},
+    {"ncap", "\342\251\203", false},
+    {"ncaron", "\305\210", false},
+    {"ncedil", "\305\206", false},
+    {"ncong", "\342\211\207", false},
+    {"ncongdot", "\342\251\255\314\270", false},
+    {"ncup", "\342\251\202", false},
+    {"ncy", "\320\275", false},
+    {"ndash", "\342\200\223", false},
+    {"ne", "\342\211\240", false},
+    {"neArr", "\342\207\227", false},
+    {"nearhk", "\342\244\244", false},
+    {"nearr", "\342\206\227", false},
+    {"nearrow", "\342\206\227", false},
+    {"nedot", "\342\211\220\314\270", false},
+    {"nequiv", "\342\211\242", false},
+    {"nesear", "\342\244\250", false},
+    {"nesim", "\342\211\202\314\270", false},
+    {"nexist", "\342\210\204", false},
+    {"nexists", "\342\210\204", false},
+    {"nfr", "\360\235\224\253", false},
+    {"ngE", "\342\211\247\314\270", false},
+    {"nge", "\342\211\261", false},
+    {"ngeq", "\342\211\261", false},
+    {"ngeqq", "\342\211\247\314\270", false},
+    {"ngeqslant", "\342\251\276\314\270", false},
+    {"nges", "\342\251\276\314\270", false},
+    {"ngsim", "\342\211\265", false},
+    {"ngt", "\342\211\257", false},
+    {"ngtr", "\342\211\257", false},
+    {"nhArr", "\342\207\216", false},
+    {"nharr", "\342\206\256", false},
+    {"nhpar", "\342\253\262", false},
+    {"ni", "\342\210\213", false},
+    {"nis", "\342\213\274", false},
+    {"nisd", "\342\213\272", false},
+    {"niv", "\342\210\213", false},
+    {"njcy", "\321\232", false},
+    {"nlArr", "\342\207\215", false},
+    {"nlE", "\342\211\246\314\270", false},
+    {"nlarr", "\342\206\232", false},
+    {"nldr", "\342\200\245", false},
+    {"nle", "\342\211\260", false},
+    {"nleftarrow", "\342\206\232", false},
+    {"nleftrightarrow", "\342\206\256", false},
+    {"nleq", "\342\211\260", false},
+    {"nleqq", "\342\211\246\314\270", false},
+    {"nleqslant", "\342\251\275\314\270", false},
+    {"nles", "\342\251\275\314\270", false},
+    {"nless", "\342\211\256", false},
+    {"nlsim", "\342\211\264", false},
+    {"nlt", "\342\211\256", false},
+    {"nltri", "\342\213\252", false},
+    {"nltrie", "\342\213\254", false},
+    {"nmid", "\342\210\244", false},
+    {"nopf", "\360\235\225\237", false},
+    {"not", "\302\254", true},
+    {"notin", "\342\210\211", false},
+    {"notinE", "\342\213\271\314\270", false},
+    {"notindot", "\342\213\265\314\270", false},
+    {"notinva", "\342\210\211", false},
+    {"notinvb", "\342\213\267", false},
+    {"notinvc", "\342\213\266", false},
+    {"notni", "\342\210\214", false},
+    {"notniva", "\342\210\214", false},
+    {"notnivb", "\342\213\276", false},
+    {"notnivc", "\342\213\275", false},
+    {"npar", "\342\210\246", false},
+    {"nparallel", "\342\210\246", false},
+    {"nparsl", "\342\253\275\342\203\245", false},
+    {"npart", "\342\210\202\314\270", false},
+    {"npolint", "\342\250\224", false},
+    {"npr", "\342\212\200", false},
+    {"nprcue", "\342\213\240", false},
+    {"npre", "\342\252\257\314\270", false},
+    {"nprec", "\342\212\200", false},
+    {"npreceq", "\342\252\257\314\270", false},
+    {"nrArr", "\342\207\217", false},
+    {"nrarr", "\342\206\233", false},
+    {"nrarrc", "\342\244\263\314\270", false},
+    {"nrarrw", "\342\206\235\314\270", false},
+    {"nrightarrow", "\342\206\233", false},
+    {"nrtri", "\342\213\253", false},
+    {"nrtrie", "\342\213\255", false},
+    {"nsc", "\342\212\201", false},
+    {"nsccue", "\342\213\241", false},
+    {"nsce", "\342\252\260\314\270", false},
+    {"nscr", "\360\235\223\203", false},
+    {"nshortmid", "\342\210\244", false},
+    {"nshortparallel", "\342\210\246", false},
+    {"nsim", "\342\211\201", false},
+    {"nsime", "\342\211\204", false},
+    {"nsimeq", "\342\211\204", false},
+    {"nsmid", "\342\210\244", false},
+    {"nspar", "\342\210\246", false},
+    {"nsqsube", "\342\213\242", false},
+    {"nsqsupe", "\342\213\243", false},
+    {"nsub", "\342\212\204", false},
+    {"nsubE", "\342\253\205\314\270", false},
+    {"nsube", "\342\212\210", false},
+    {"nsubset", "\342\212\202\342\203\222", false},
+    {"nsubseteq", "\342\212\210", false},
+    {"nsubseteqq", "\342\253\205\314\270", false},
+    {"nsucc", "\342\212\201", false},
+    {"nsucceq", "\342\252\260\314\270", false},
+    {"nsup", "\342\212\205", false},
+    {"nsupE", "\342\253\206\314\270", false},
+    {"nsupe", "\342\212\211", false},
+    {"nsupset", "\342\212\203\342\203\222", false},
+    {"nsupseteq", "\342\212\211", false},
+    {"nsupseteqq", "\342\253\206\314\270", false},
+    {"ntgl", "\342\211\271", false},
+    {"ntilde", "\303\261", true},
+    {"ntlg", "\342\211\270", false},
+    {"ntriangleleft", "\342\213\252", false},
+    {"ntrianglelefteq", "\342\213\254", false},
+    {"ntriangleright", "\342\213\253", false},
+    {"ntrianglerighteq", "\342\213\255", false},
+    {"nu", "\316\275", false},
+    {"num", "#", false},
+    {"numero", "\342\204\226", false},
+    {"numsp", "\342\200\207", false},
+    {"nvDash", "\342\212\255", false},
+    {"nvHarr", "\342\244\204", false},
+    {"nvap", "\342\211\215\342\203\222", false},
+    {"nvdash", "\342\212\254", false},
+    {"nvge", "\342\211\245\342\203\222", false},
+    {"nvgt", ">\342\203\222", false},
+    {"nvinfin", "\342\247\236", false},
+    {"nvlArr", "\342\244\202", false},
+    {"nvle", "\342\211\244\342\203\222", false},
+    {"nvlt", "<\342\203\222", false},
+    {"nvltrie", "\342\212\264\342\203\222", false},
+    {"nvrArr", "\342\244\203", false},
+    {"nvrtrie", "\342\212\265\342\203\222", false},
+    {"nvsim", "\342\210\274\342\203\222", false},
+    {"nwArr", "\342\207\226", false},
+    {"nwarhk", "\342\244\243", false},
+    {"nwarr", "\342\206\226", false},
+    {"nwarrow", "\342\206\226", false},
+    {"nwnear", "\342\244\247", false},
+    {"oS", "\342\223\210", false},
+    {"oacute", "\303\263", true},
+    {"oast", "\342\212\233", false},
+    {"ocir", "\342\212\232", false},
+    {"ocirc", "\303\264", true},
+    {"ocy", "\320\276", false},
+    {"odash", "\342\212\235", false},
+    {"odblac", "\305\221", false},
+    {"odiv", "\342\250\270", false},
+    {"odot", "\342\212\231", false},
+    {"odsold", "\342\246\274", false},
+    {"oelig", "\305\223", false},
+    {"ofcir", "\342\246\277", false},
+    {"ofr", "\360\235\224\254", false},
+    {"ogon", "\313\233", false},
+    {"ograve", "\303\262", true},
+    {"ogt", "\342\247\201", false},
+    {"ohbar", "\342\246\265", false},
+    {"ohm", "\316\251", false},
+    {"oint", "\342\210\256", false},
+    {"olarr", "\342\206\272", false},
+    {"olcir", "\342\246\276", false},
+    {"olcross", "\342\246\273", false},
+    {"oline", "\342\200\276", false},
+    {"olt", "\342\247\200", false},
+    {"omacr", "\305\215", false},
+    {"omega", "\317\211", false},
+    {"omicron", "\316\277", false},
+    {"omid", "\342\246\266", false},
+    {"ominus", "\342\212\226", false},
+    {"oopf", "\360\235\225\240", false},
+    {"opar", "\342\246\267", false},
+    {"operp", "\342\246\271", false},
+    {"oplus", "\342\212\225", false},
+    {"or", "\342\210\250", false},
+    {"orarr", "\342\206\273", false},
+    {"ord", "\342\251\235", false},
+    {"order", "\342\204\264", false},
+    {"orderof", "\342\204\264", false},
+    {"ordf", "\302\252", true},
+    {"ordm", "\302\272", true},
+    {"origof", "\342\212\266", false},
+    {"oror", "\342\251\226", false},
+    {"orslope", "\342\251\227", false},
+    {"orv", "\342\251\233", false},
+    {"oscr", "\342\204\264", false},
+    {"oslash", "\303\270", true},
+    {"osol", "\342\212\230", false},
+    {"otilde", "\303\265", true},
+    {"otimes", "\342\212\227", false},
+    {"otimesas", "\342\250\266", false},
+    {"ouml", "\303\266", true},
+    {"ovbar", "\342\214\275", false},
+    {"par", "\342\210\245", false},
+    {"para", "\302\266", true},
+    {"parallel", "\342\210\245", false},
+    {"parsim", "\342\253\263", false},
+    {"parsl", "\342\253\275", false},
+    {"part", "\342\210\202", false},
+    {"pcy", "\320\277", false},
+    {"percnt", "%", false},
+    {"period", ".", false},
+    {"permil", "\342\200\260", false},
+    {"perp", "\342\212\245", false},
+    {"pertenk", "\342\200\261", false},
+    {"pfr", "\360\235\224\255", false},
+    {"phi", "\317\206", false},
+    {"phiv", "\317\225", false},
+    {"phmmat", "\342\204\263", false},
+    {"phone", "\342\230\216", false},
+    {"pi", "\317\200", false},
+    {"pitchfork", "\342\213\224", false},
+    {"piv", "\317\226", false},
+    {"planck", "\342\204\217", false},
+    {"planckh", "\342\204\216", false},
+    {"plankv", "\342\204\217", false},
+    {"plus", "+", false},
+    {"plusacir", "\342\250\243", false},
+    {"plusb", "\342\212\236", false},
+    {"pluscir", "\342\250\242", false},
+    {"plusdo", "\342\210\224", false},
+    {"plusdu", "\342\250\245", false},
+    {"pluse", "\342\251\262", false},
+    {"plusmn", "\302\261", true},
+    {"plussim", "\342\250\246", false},
+    {"plustwo", "\342\250\247", false},
+    {"pm", "\302\261", false},
+    {"pointint", "\342\250\225", false},
+    {"popf", "\360\235\225\241", false},
+    {"pound", "\302\243", true},
+    {"pr", "\342\211\272", false},
+    {"prE", "\342\252\263", false},
+    {"prap", "\342\252\267", false},
+    {"prcue", "\342\211\274", false},
+    {"pre", "\342\252\257", false},
+    {"prec", "\342\211\272", false},
+    {"precapprox", "\342\252\267", false},
+    {"preccurlyeq", "\342\211\274", false},
+    {"preceq", "\342\252\257", false},
+    {"precnapprox", "\342\252\271", false},
+    {"precneqq", "\342\252\265", false},
+    {"precnsim", "\342\213\250", false},
+    {"precsim", "\342\211\276", false},
+    {"prime", "\342\200\262", false},
+    {"primes", "\342\204\231", false},
+    {"prnE", "\342\252\265", false},
+    {"prnap", "\342\252\271", false},
+    {"prnsim", "\342\213\250", false},
+    {"prod", "\342\210\217", false},
+    {"profalar", "\342\214\256", false},
+    {"profline", "\342\214\222", false},
+    {"profsurf", "\342\214\223", false},
+    {"prop", "\342\210\235", false},
+    {"propto", "\342\210\235", false},
+    {"prsim", "\342\211\276", false},
+    {"prurel", "\342\212\260", false},
+    {"pscr", "\360\235\223\205", false},
+    {"psi", "\317\210", false},
+    {"puncsp", "\342\200\210", false},
+    {"qfr", "\360\235\224\256", false},
+    {"qint", "\342\250\214", false},
+    {"qopf", "\360\235\225\242", false},
+    {"qprime", "\342\201\227", false},
+    {"qscr", "\360\235\223\206", false},
+    {"quaternions", "\342\204\215", false},
+    {"quatint", "\342\250\226", false},
+    {"quest", "?", false},
+    {"questeq", "\342\211\237", false},
+    {"quot", "\"", true},
+    {"rAarr", "\342\207\233", false},
+    {"rArr", "\342\207\222", false},
+    {"rAtail", "\342\244\234", false},
+    {"rBarr", "\342\244\217", false},
+    {"rHar", "\342\245\244", false},
+    {"race", "\342\210\275\314\261", false},
+    {"racute", "\305\225", false},
+    {"radic", "\342\210\232", false},
+    {"raemptyv", "\342\246\263", false},
+    {"rang", "\342\237\251", false},
+    {"rangd", "\342\246\222", false},
+    {"range", "\342\246\245", false},
+    {"rangle", "\342\237\251", false},
+    {"raquo", "\302\273", true},
+    {"rarr", "\342\206\222", false},
+    {"rarrap", "\342\245\265", false},
+    {"rarrb", "\342\207\245", false},
+    {"rarrbfs", "\342\244\240", false},
+    {"rarrc", "\342\244\263", false},
+    {"rarrfs", "\342\244\236", false},
+    {"rarrhk", "\342\206\252", false},
+    {"rarrlp", "\342\206\254", false},
+    {"rarrpl", "\342\245\205", false},
+    {"rarrsim", "\342\245\264", false},
+    {"rarrtl", "\342\206\243", false},
+    {"rarrw", "\342\206\235", false},
+    {"ratail", "\342\244\232", false},
+    {"ratio", "\342\210\266", false},
+    {"rationals", "\342\204\232", false},
+    {"rbarr", "\342\244\215", false},
+    {"rbbrk", "\342\235\263", false},
+    {"rbrace", "}", false},
+    {"rbrack", "]", false},
+    {"rbrke", "\342\246\214", false},
+    {"rbrksld", "\342\246\216", false},
+    {"rbrkslu", "\342\246\220", false},
+    {"rcaron", "\305\231", false},
+    {"rcedil", "\305\227", false},
+    {"rceil", "\342\214\211", false},
+    {"rcub", "}", false},
+    {"rcy", "\321\200", false},
+    {"rdca", "\342\244\267", false},
+    {"rdldhar", "\342\245\251", false},
+    {"rdquo", "\342\200\235", false},
+    {"rdquor", "\342\200\235", false},
+    {"rdsh", "\342\206\263", false},
+    {"real", "\342\204\234", false},
+    {"realine", "\342\204\233", false},
+    {"realpart", "\342\204\234", false},
+    {"reals", "\342\204\235", false},
+    {"rect", "\342\226\255", false},
+    {"reg", "\302\256", true},
+    {"rfisht", "\342\245\275", false},
+    {"rfloor", "\342\214\213", false},
+    {"rfr", "\360\235\224\257", false},
+    {"rhard", "\342\207\201", false},
+    {"rharu", "\342\207\200", false},
+    {"rharul", "\342\245\254", false},
+    {"rho", "\317\201", false},
+    {"rhov", "\317\261", false},
+    {"rightarrow", "\342\206\222", false},
+    {"rightarrowtail", "\342\206\243", false},
+    {"rightharpoondown", "\342\207\201", false},
+    {"rightharpoonup", "\342\207\200", false},
+    {"rightleftarrows", "\342\207\204", false},
+    {"rightleftharpoons", "\342\207\214", false},
+    {"rightrightarrows", "\342\207\211", false},
+    {"rightsquigarrow", "\342\206\235", false},
+    {"rightthreetimes", "\342\213\214", false},
+    {"ring", "\313\232", false},
+    {"risingdotseq", "\342\211\223", false},
+    {"rlarr", "\342\207\204", false},
+    {"rlhar", "\342\207\214", false},
+    {"rlm", "\342\200\217", false},
+    {"rmoust", "\342\216\261", false},
+    {"rmoustache", "\342\216\261", false},
+    {"rnmid", "\342\253\256", false},
+    {"roang", "\342\237\255", false},
+    {"roarr", "\342\207\276", false},
+    {"robrk", "\342\237\247", false},
+    {"ropar", "\342\246\206", false},
+    {"ropf", "\360\235\225\243", false},
+    {"roplus", "\342\250\256", false},
+    {"rotimes", "\342\250\265", false},
+    {"rpar", ")", false},
+    {"rpargt", "\342\246\224", false},
+    {"rppolint", "\342\250\222", false},
+    {"rrarr", "\342\207\211", false},
+    {"rsaquo", "\342\200\272", false},
+    {"rscr", "\360\235\223\207", false},
+    {"rsh", "\342\206\261", false},
+    {"rsqb", "]", false},
+    {"rsquo", "\342\200\231", false},
+    {"rsquor", "\342\200\231", false},
+    {"rthree", "\342\213\214", false},
+    {"rtimes", "\342\213\212", false},
+    {"rtri", "\342\226\271", false},
+    {"rtrie", "\342\212\265", false},
+    {"rtrif", "\342\226\270", false},
+    {"rtriltri", "\342\247\216", false},
+    {"ruluhar", "\342\245\250", false},
+    {"rx", "\342\204\236", false},
+    {"sacute", "\305\233", false},
+    {"sbquo", "\342\200\232", false},
+    {"sc", "\342\211\273", false},
+    {"scE", "\342\252\264", false},
+    {"scap", "\342\252\270", false},
+    {"scaron", "\305\241", false},
+    {"sccue", "\342\211\275", false},
+    {"sce", "\342\252\260", false},
+    {"scedil", "\305\237", false},
+    {"scirc", "\305\235", false},
+    {"scnE", "\342\252\266", false},
+    {"scnap", "\342\252\272", false},
+    {"scnsim", "\342\213\251", false},
+    {"scpolint", "\342\250\223", false},
+    {"scsim", "\342\211\277", false},
+    {"scy", "\321\201", false},
+    {"sdot", "\342\213\205", false},
+    {"sdotb", "\342\212\241", false},
+    {"sdote", "\342\251\246", false},
+    {"seArr", "\342\207\230", false},
+    {"searhk", "\342\244\245", false},
+    {"searr", "\342\206\230", false},
+    {"searrow", "\342\206\230", false},
+    {"sect", "\302\247", true},
+    {"semi", ";", false},
+    {"seswar", "\342\244\251", false},
+    {"setminus", "\342\210\226", false},
+    {"setmn", "\342\210\226", false},
+    {"sext", "\342\234\266", false},
+    {"sfr", "\360\235\224\260", false},
+    {"sfrown", "\342\214\242", false},
+    {"sharp", "\342\231\257", false},
+    {"shchcy", "\321\211", false},
+    {"shcy", "\321\210", false},
+    {"shortmid", "\342\210\243", false},
+    {"shortparallel", "\342\210\245", false},
+    {"shy", "\302\255", true},
+    {"sigma", "\317\203", false},
+    {"sigmaf", "\317\202", false},
+    {"sigmav", "\317\202", false},
+    {"sim", "\342\210\274", false},
+    {"simdot", "\342\251\252", false},
+    {"sime", "\342\211\203", false},
+    {"simeq", "\342\211\203", false},
+    {"simg", "\342\252\236", false},
+    {"simgE", "\342\252\240", false},
+    {"siml", "\342\252\235", false},
+    {"simlE", "\342\252\237", false},
+    {"simne", "\342\211\206", false},
+    {"simplus", "\342\250\244", false},
+    {"simrarr", "\342\245\262", false},
+    {"slarr", "\342\206\220", false},
+    {"smallsetminus", "\342\210\226", false},
+    {"smashp", "\342\250\263", false},
+    {"smeparsl", "\342\247\244", false},
+    {"smid", "\342\210\243", false},
+    {"smile", "\342\214\243", false},
+    {"smt", "\342\252\252", false},
+    {"smte", "\342\252\254", false},
+    {"smtes", "\342\252\254\357\270\200", false},
+    {"softcy", "\321\214", false},
+    {"sol", "/", false},
+    {"solb", "\342\247\204", false},
+    {"solbar", "\342\214\277", false},
+    {"sopf", "\360\235\225\244", false},
+    {"spades", "\342\231\240", false},
+    {"spadesuit", "\342\231\240", false},
+    {"spar", "\342\210\245", false},
+    {"sqcap", "\342\212\223", false},
+    {"sqcaps", "\342\212\223\357\270\200", false},
+    {"sqcup", "\342\212\224", false},
+    {"sqcups", "\342\212\224\357\270\200", false},
+    {"sqsub", "\342\212\217", false},
+    {"sqsube", "\342\212\221", false},
+    {"sqsubset", "\342\212\217", false},
+    {"sqsubseteq", "\342\212\221", false},
+    {"sqsup", "\342\212\220", false},
+    {"sqsupe", "\342\212\222", false},
+    {"sqsupset", "\342\212\220", false},
+    {"sqsupseteq", "\342\212\222", false},
+    {"squ", "\342\226\241", false},
+    {"square", "\342\226\241", false},
+    {"squarf", "\342\226\252", false},
+    {"squf", "\342\226\252", false},
+    {"srarr", "\342\206\222", false},
+    {"sscr", "\360\235\223\210", false},
+    {"ssetmn", "\342\210\226", false},
+    {"ssmile", "\342\214\243", false},
+    {"sstarf", "\342\213\206", false},
+    {"star", "\342\230\206", false},
+    {"starf", "\342\230\205", false},
+    {"straightepsilon", "\317\265", false},
+    {"straightphi", "\317\225", false},
+    {"strns", "\302\257", false},
+    {"sub", "\342\212\202", false},
+    {"subE", "\342\253\205", false},
+    {"subdot", "\342\252\275", false},
+    {"sube", "\342\212\206", false},
+    {"subedot", "\342\253\203", false},
+    {"submult", "\342\253\201", false},
+    {"subnE", "\342\253\213", false},
+    {"subne", "\342\212\212", false},
+    {"subplus", "\342\252\277", false},
+    {"subrarr", "\342\245\271", false},
+    {"subset", "\342\212\202", false},
+    {"subseteq", "\342\212\206", false},
+    {"subseteqq", "\342\253\205", false},
+    {"subsetneq", "\342\212\212", false},
+    {"subsetneqq", "\342\253\213", false},
+    {"subsim", "\342\253\207", false},
+    {"subsub", "\342\253\225", false},
+    {"subsup", "\342\253\223", false},
+    {"succ", "\342\211\273", false},
+    {"succapprox", "\342\252\270", false},
+    {"succcurlyeq", "\342\211\275", false},
+    {"succeq", "\342\252\260", false},
+    {"succnapprox", "\342\252\272", false},
+    {"succneqq", "\342\252\266", false},
+    {"succnsim", "\342\213\251", false},
+    {"succsim", "\342\211\277", false},
+    {"sum", "\342\210\221", false},
+    {"sung", "\342\231\252", false},
+    {"sup", "\342\212\203", false},
+    {"sup1", "\302\271", true},
+    {"sup2", "\302\262", true},
+    {"sup3", "\302\263", true},
+    {"supE", "\342\253\206", false},
+    {"supdot", "\342\252\276", false},
+    {"supdsub", "\342\253\230", false},
+    {"supe", "\342\212\207", false},
+    {"supedot", "\342\253\204", false},
+    {"suphsol", "\342\237\211", false},
+    {"suphsub", "\342\253\227", false},
+    {"suplarr", "\342\245\273", false},
+    {"supmult", "\342\253\202", false},
+    {"supnE", "\342\253\214", false},
+    {"supne", "\342\212\213", false},
+    {"supplus", "\342\253\200", false},
+    {"supset", "\342\212\203", false},
+    {"supseteq", "\342\212\207", false},
+    {"supseteqq", "\342\253\206", false},
+    {"supsetneq", "\342\212\213", false},
+    {"supsetneqq", "\342\253\214", false},
+    {"supsim", "\342\253\210", false},
+    {"supsub", "\342\253\224", false},
+    {"supsup", "\342\253\226", false},
+    {"swArr", "\342\207\231", false},
+    {"swarhk", "\342\244\246", false},
+    {"swarr", "\342\206\231", false},
+    {"swarrow", "\342\206\231", false},
+    {"swnwar", "\342\244\252", false},
+    {"szlig", "\303\237", true},
+    {"target", "\342\214\226", false},
+    {"tau", "\317\204", false},
+    {"tbrk", "\342\216\264", false},
+    {"tcaron", "\305\245", false},
+    {"tcedil", "\305\243", false},
+    {"tcy", "\321\202", false},
+    {"tdot", "\342\203\233", false},
+    {"telrec", "\342\214\225", false},
+    {"tfr", "\360\235\224\261", false},
+    {"there4", "\342\210\264", false},
+    {"therefore", "\342\210\264", false},
+    {"theta", "\316\270", false},
+    {"thetasym", "\317\221", false},
+    {"thetav", "\317\221", false},
+    {"thickapprox", "\342\211\210", false},
+    {"thicksim", "\342\210\274", false},
+    {"thinsp", "\342\200\211", false},
+    {"thkap", "\342\211\210", false},
+    {"thksim", "\342\210\274", false},
+    {"thorn", "\303\276", true},
+    {"tilde", "\313\234", false},
+    {"times", "\303\227", true},
+    {"timesb", "\342\212\240", false},
+    {"timesbar", "\342\250\261", false},
+    {"timesd", "\342\250\260", false},
+    {"tint", "\342\210\255", false},
+    {"toea", "\342\244\250", false},
+    {"top", "\342\212\244", false},
+    {"topbot", "\342\214\266", false},
+    {"topcir", "\342\253\261", false},
+    {"topf", "\360\235\225\245", false},
+    {"topfork", "\342\253\232", false},
+    {"tosa", "\342\244\251", false},
+    {"tprime", "\342\200\264", false},
+    {"trade", "\342\204\242", false},
+    {"triangle", "\342\226\265", false},
+    {"triangledown", "\342\226\277", false},
+    {"triangleleft", "\342\227\203", false},
+    {"trianglelefteq", "\342\212\264", false},
+    {"triangleq", "\342\211\234", false},
+    {"triangleright", "\342\226\271", false},
+    {"trianglerighteq", "\342\212\265", false},
+    {"tridot", "\342\227\254", false},
+    {"trie", "\342\211\234", false},
+    {"triminus", "\342\250\272", false},
+    {"triplus", "\342\250\271", false},
+    {"trisb", "\342\247\215", false},
+    {"tritime", "\342\250\273", false},
+    {"trpezium", "\342\217\242", false},
+    {"tscr", "\360\235\223\211", false},
+    {"tscy", "\321\206", false},
+    {"tshcy", "\321\233", false},
+    {"tstrok", "\305\247", false},
+    {"twixt", "\342\211\254", false},
+    {"twoheadleftarrow", "\342\206\236", false},
+    {"twoheadrightarrow", "\342\206\240", false},
+    {"uArr", "\342\207\221", false},
+    {"uHar", "\342\245\243", false},
+    {"uacute", "\303\272", true},
+    {"uarr", "\342\206\221", false},
+    {"ubrcy", "\321\236", false},
+    {"ubreve", "\305\255", false},
+    {"ucirc", "\303\273", true},
+    {"ucy", "\321\203", false},
+    {"udarr", "\342\207\205", false},
+    {"udblac", "\305\261", false},
+    {"udhar", "\342\245\256", false},
+    {"ufisht", "\342\245\276", false},
+    {"ufr", "\360\235\224\262", false},
+    {"ugrave", "\303\271", true},
+    {"uharl", "\342\206\277", false},
+    {"uharr", "\342\206\276", false},
+    {"uhblk", "\342\226\200", false},
+    {"ulcorn", "\342\214\234", false},
+    {"ulcorner", "\342\214\234", false},
+    {"ulcrop", "\342\214\217", false},
+    {"ultri", "\342\227\270", false},
+    {"umacr", "\305\253", false},
+    {"uml", "\302\250", true},
+    {"uogon", "\305\263", false},
+    {"uopf", "\360\235\225\246", false},
+    {"uparrow", "\342\206\221", false},
+    {"updownarrow", "\342\206\225", false},
+    {"upharpoonleft", "\342\206\277", false},
+    {"upharpoonright", "\342\206\276", false},
+    {"uplus", "\342\212\216", false},
+    {"upsi", "\317\205", false},
+    {"upsih", "\317\222", false},
+    {"upsilon", "\317\205", false},
+    {"upuparrows", "\342\207\210", false},
+    {"urcorn", "\342\214\235", false},
+    {"urcorner", "\342\214\235", false},
+    {"urcrop", "\342\214\216", false},
+    {"uring", "\305\257", false},
+    {"urtri", "\342\227\271", false},
+    {"uscr", "\360\235\223\212", false},
+    {"utdot", "\342\213\260", false},
+    {"utilde", "\305\251", false},
+    {"utri", "\342\226\265", false},
+    {"utrif", "\342\226\264", false},
+    {"uuarr", "\342\207\210", false},
+    {"uuml", "\303\274", true},
+    {"uwangle", "\342\246\247", false},
+    {"vArr", "\342\207\225", false},
+    {"vBar", "\342\253\250", false},
+    {"vBarv", "\342\253\251", false},
+    {"vDash", "\342\212\250", false},
+    {"vangrt", "\342\246\234", false},
+    {"varepsilon", "\317\265", false},
+    {"varkappa", "\317\260", false},
+    {"varnothing", "\342\210\205", false},
+    {"varphi", "\317\225", false},
+    {"varpi", "\317\226", false},
+    {"varpropto", "\342\210\235", false},
+    {"varr", "\342\206\225", false},
+    {"varrho", "\317\261", false},
+    {"varsigma", "\317\202", false},
+    {"varsubsetneq", "\342\212\212\357\270\200", false},
+    {"varsubsetneqq", "\342\253\213\357\270\200", false},
+    {"varsupsetneq", "\342\212\213\357\270\200", false},
+    {"varsupsetneqq", "\342\253\214\357\270\200", false},
+    {"vartheta", "\317\221", false},
+    {"vartriangleleft", "\342\212\262", false},
+    {"vartriangleright", "\342\212\263", false},
+    {"vcy", "\320\262", false},
+    {"vdash", "\342\212\242", false},
+    {"vee", "\342\210\250", false},
+    {"veebar", "\342\212\273", false},
+    {"veeeq", "\342\211\232", false},
+    {"vellip", "\342\213\256", false},
+    {"verbar", "|", false},
+    {"vert", "|", false},
+    {"vfr", "\360\235\224\263", false},
+    {"vltri", "\342\212\262", false},
+    {"vnsub", "\342\212\202\342\203\222", false},
+    {"vnsup", "\342\212\203\342\203\222", false},
+    {"vopf", "\360\235\225\247", false},
+    {"vprop", "\342\210\235", false},
+    {"vrtri", "\342\212\263", false},
+    {"vscr", "\360\235\223\213", false},
+    {"vsubnE", "\342\253\213\357\270\200", false},
+    {"vsubne", "\342\212\212\357\270\200", false},
+    {"vsupnE", "\342\253\214\357\270\200", false},
+    {"vsupne", "\342\212\213\357\270\200", false},
+    {"vzigzag", "\342\246\232", false},
+    {"wcirc", "\305\265", false},
+    {"wedbar", "\342\251\237", false},
+    {"wedge", "\342\210\247", false},
+    {"wedgeq", "\342\211\231", false},
+    {"weierp", "\342\204\230", false},
+    {"wfr", "\360\235\224\264", false},
+    {"wopf", "\360\235\225\250", false},
+    {"wp", "\342\204\230", false},
+    {"wr", "\342\211\200", false},
+    {"wreath", "\342\211\200", false},
+    {"wscr", "\360\235\223\214", false},
+    {"xcap", "\342\213\202", false},
+    {"xcirc", "\342\227\257", false},
+    {"xcup", "\342\213\203", false},
+    {"xdtri", "\342\226\275", false},
+    {"xfr", "\360\235\224\265", false},
+    {"xhArr", "\342\237\272", false},
+    {"xharr", "\342\237\267", false},
+    {"xi", "\316\276", false},
+    {"xlArr", "\342\237\270", false},
+    {"xlarr", "\342\237\265", false},
+    {"xmap", "\342\237\274", false},
+    {"xnis", "\342\213\273", false},
+    {"xodot", "\342\250\200", false},
+    {"xopf", "\360\235\225\251", false},
+    {"xoplus", "\342\250\201", false},
+    {"xotime", "\342\250\202", false},
+    {"xrArr", "\342\237\271", false},
+    {"xrarr", "\342\237\266", false},
+    {"xscr", "\360\235\223\215", false},
+    {"xsqcup", "\342\250\206", false},
+    {"xuplus", "\342\250\204", false},
+    {"xutri", "\342\226\263", false},
+    {"xvee", "\342\213\201", false},
+    {"xwedge", "\342\213\200", false},
+    {"yacute", "\303\275", true},
+    {"yacy", "\321\217", false},
+    {"ycirc", "\305\267", false},
+    {"ycy", "\321\213", false},
+    {"yen", "\302\245", true},
+    {"yfr", "\360\235\224\266", false},
+    {"yicy", "\321\227", false},
+    {"yopf", "\360\235\225\252", false},
+    {"yscr", "\360\235\223\216", false},
+    {"yucy", "\321\216", false},
+    {"yuml", "\303\277", true},
+    {"zacute", "\305\272", false},
+    {"zcaron", "\305\276", false},
+    {"zcy", "\320\267", false},
+    {"zdot", "\305\274", false},
+    {"zeetrf", "\342\204\250", false},
+    {"zeta", "\316\266", false},
+    {"zfr", "\360\235\224\267", false},
+    {"zhcy", "\320\266", false},
+    {"zigrarr", "\342\207\235", false},
+    {"zopf", "\360\235\225\253", false},
+    {"zscr", "\360\235\223\217", false},
+    {"zwj", "\342\200\215", false},
+    {"zwnj", "\342\200\214", false},
+};
+
+} // namespace
+
+// Function to look up a named character reference by binary search
+const HtmlEntity* MailTMAPI::findHtmlEntity(std::string_view name) {
+    auto it = std::lower_bound(std::begin(entities), std::end(entities), name,
+                               [](const HtmlEntity& entity, std::string_view key) { return entity.name < key; });
+    if (it == std::end(entities) || it->name != name) {
+        return nullptr;
+    }
+    return it;
+}
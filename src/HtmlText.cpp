@@ -0,0 +1,383 @@
+#include "HtmlText.h"
+#include "HtmlEntities.h"
+#include <algorithm>
+#include <cctype>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+using namespace MailTMAPI;
+
+namespace {
+
+// Function to find the next '<' or '&' from pos, 16 bytes at a time where SSE2 is available
+size_t findMarkup(std::string_view text, size_t pos) {
+    const char* data = text.data();
+    const size_t size = text.size();
+#if defined(__SSE2__)
+    const __m128i lt = _mm_set1_epi8('<');
+    const __m128i amp = _mm_set1_epi8('&');
+    for (; pos + 16 <= size; pos += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, lt), _mm_cmpeq_epi8(block, amp)));
+        if (mask != 0) {
+            return pos + __builtin_ctz(mask);
+        }
+    }
+#endif
+    for (; pos < size; ++pos) { // The tail, or everything without SSE2
+        if (data[pos] == '<' || data[pos] == '&') {
+            return pos;
+        }
+    }
+    return size;
+}
+
+// Function to append a code point as UTF-8
+void appendUtf8(std::string& out, char32_t codePoint) {
+    if (codePoint < 0x80) {
+        out += static_cast<char>(codePoint);
+    } else if (codePoint < 0x800) {
+        out += static_cast<char>(0xC0 | (codePoint >> 6));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else if (codePoint < 0x10000) {
+        out += static_cast<char>(0xE0 | (codePoint >> 12));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (codePoint >> 18));
+        out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+}
+
+// Function to map a numeric reference to the code point HTML renders, e.g. &#146; is the Windows-1252 quote
+char32_t numericCodePoint(unsigned long value) {
+    static const char32_t windows1252[32] = {
+        0x20AC, 0x81,   0x201A, 0x0192, 0x201E, 0x2026, 0x2020, 0x2021, 0x02C6, 0x2030, 0x0160,
+        0x2039, 0x0152, 0x8D,   0x017D, 0x8F,   0x90,   0x2018, 0x2019, 0x201C, 0x201D, 0x2022,
+        0x2013, 0x2014, 0x02DC, 0x2122, 0x0161, 0x203A, 0x0153, 0x9D,   0x017E, 0x0178};
+    if (value == 0 || value > 0x10FFFF || (value >= 0xD800 && value <= 0xDFFF)) {
+        return 0xFFFD; // Replacement character
+    }
+    if (value >= 0x80 && value <= 0x9F) {
+        return windows1252[value - 0x80];
+    }
+    return static_cast<char32_t>(value);
+}
+
+// Function to decode one character reference at text[pos] == '&'; returns the bytes consumed, 0 if it is not one
+size_t decodeEntity(std::string_view text, size_t pos, std::string& out, bool inAttribute) {
+    size_t start = pos + 1;
+    if (start < text.size() && text[start] == '#') { // Numeric: &#38; or &#x26;
+        size_t digits = start + 1;
+        bool hex = digits < text.size() && (text[digits] == 'x' || text[digits] == 'X');
+        if (hex) {
+            digits++;
+        }
+        size_t end = digits;
+        unsigned long value = 0;
+        while (end < text.size() && (hex ? std::isxdigit(static_cast<unsigned char>(text[end]))
+                                         : std::isdigit(static_cast<unsigned char>(text[end])))) {
+            char c = static_cast<char>(std::tolower(static_cast<unsigned char>(text[end])));
+            if (value <= 0x10FFFF) { // Stop accumulating once out of range so it cannot overflow
+                value = value * (hex ? 16 : 10) + (c <= '9' ? c - '0' : c - 'a' + 10);
+            }
+            end++;
+        }
+        if (end == digits) {
+            return 0;
+        }
+        appendUtf8(out, numericCodePoint(value));
+        return (end < text.size() && text[end] == ';' ? end + 1 : end) - pos;
+    }
+
+    size_t end = start;
+    while (end < text.size() && end - start < 32 && std::isalnum(static_cast<unsigned char>(text[end]))) {
+        end++;
+    }
+    if (end == start) {
+        return 0;
+    }
+    if (end < text.size() && text[end] == ';') { // Exact name with ';'
+        if (const HtmlEntity* entity = findHtmlEntity(text.substr(start, end - start))) {
+            out += entity->value;
+            return end + 1 - pos;
+        }
+    }
+
+    // Legacy names may appear without ';' and as a prefix, as in "&copy2024"; the longest one is at most 6 letters
+    for (size_t length = std::min<size_t>(end - start, 6); length >= 2; --length) {
+        const HtmlEntity* entity = findHtmlEntity(text.substr(start, length));
+        if (entity && entity->legacy) {
+            size_t next = start + length;
+            if (inAttribute && next < text.size() &&
+                (std::isalnum(static_cast<unsigned char>(text[next])) || text[next] == '=')) {
+                return 0; // Part of a query string such as "?a=1&copy=2"
+            }
+            out += entity->value;
+            return next - pos;
+        }
+    }
+    return 0;
+}
+
+// Function to compare two names case-insensitively
+bool tagIs(std::string_view name, std::string_view expected) {
+    if (name.size() != expected.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < name.size(); ++i) {
+        if (std::tolower(static_cast<unsigned char>(name[i])) != std::tolower(static_cast<unsigned char>(expected[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Function to find the end tag of a raw text element such as "</style>" case-insensitively
+size_t findClosingTag(std::string_view html, size_t pos, std::string_view name) {
+    while ((pos = html.find("</", pos)) != std::string_view::npos) {
+        size_t after = pos + 2 + name.size();
+        if (tagIs(html.substr(pos + 2, name.size()), name) &&
+            (after >= html.size() || !std::isalnum(static_cast<unsigned char>(html[after])))) {
+            return pos;
+        }
+        pos += 2;
+    }
+    return html.size();
+}
+
+// Function to check whether a tag ends a line of text
+bool isBlockTag(std::string_view name) {
+    static const char* const blocks[] = {"br", "p", "div", "tr", "li", "h1", "h2", "h3", "h4", "h5", "h6",
+                                         "table", "ul", "ol", "hr", "blockquote", "section", "header", "footer"};
+    for (const char* block : blocks) {
+        if (tagIs(name, block)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Function to collapse whitespace and trim, for anchor text
+std::string collapseWhitespace(std::string_view text) {
+    std::string result;
+    bool pendingSpace = false;
+    for (char c : text) {
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            pendingSpace = !result.empty();
+        } else {
+            if (pendingSpace) {
+                result += ' ';
+                pendingSpace = false;
+            }
+            result += c;
+        }
+    }
+    return result;
+}
+
+// A parsed start or end tag
+struct Tag {
+    std::string_view name;
+    std::string_view href; // Raw value of the href attribute, still encoded
+    bool closing = false;
+    bool selfClosing = false;
+    size_t end = 0; // Offset just past the '>'
+};
+
+// Function to parse the tag at html[pos] == '<'; returns false if it is not a tag and '<' is literal text
+bool parseTag(std::string_view html, size_t pos, Tag& tag) {
+    size_t i = pos + 1;
+    if (i < html.size() && html[i] == '/') {
+        tag.closing = true;
+        i++;
+    }
+    size_t nameStart = i;
+    if (i >= html.size() || !std::isalpha(static_cast<unsigned char>(html[i]))) {
+        return false;
+    }
+    while (i < html.size() && !std::isspace(static_cast<unsigned char>(html[i])) && html[i] != '>' && html[i] != '/') {
+        i++;
+    }
+    tag.name = html.substr(nameStart, i - nameStart);
+
+    // Attributes; quoted values may contain '>'
+    while (i < html.size() && html[i] != '>') {
+        if (std::isspace(static_cast<unsigned char>(html[i])) || html[i] == '/') {
+            tag.selfClosing = html[i] == '/';
+            i++;
+            continue;
+        }
+        size_t attrStart = i;
+        while (i < html.size() && !std::isspace(static_cast<unsigned char>(html[i])) && html[i] != '=' &&
+               html[i] != '>' && html[i] != '/') {
+            i++;
+        }
+        std::string_view attrName = html.substr(attrStart, i - attrStart);
+        while (i < html.size() && std::isspace(static_cast<unsigned char>(html[i]))) {
+            i++;
+        }
+        if (i >= html.size() || html[i] != '=') {
+            continue; // Attribute without a value
+        }
+        i++;
+        while (i < html.size() && std::isspace(static_cast<unsigned char>(html[i]))) {
+            i++;
+        }
+
+        std::string_view value;
+        if (i < html.size() && (html[i] == '"' || html[i] == '\'')) {
+            size_t close = html.find(html[i], i + 1);
+            if (close == std::string_view::npos) {
+                close = html.size();
+            }
+            value = html.substr(i + 1, close - i - 1);
+            i = std::min(close + 1, html.size());
+        } else {
+            size_t valueStart = i;
+            while (i < html.size() && !std::isspace(static_cast<unsigned char>(html[i])) && html[i] != '>') {
+                i++;
+            }
+            value = html.substr(valueStart, i - valueStart);
+        }
+        tag.selfClosing = false;
+        if (tagIs(attrName, "href")) {
+            tag.href = value;
+        }
+    }
+    tag.end = std::min(i + 1, html.size());
+    return true;
+}
+
+// State of one conversion
+class Converter {
+private:
+    std::string_view html;
+    bool inlineLinks;
+    HtmlTextResult result;
+    bool inLink = false;
+    std::string linkUrl;
+    size_t linkStart = 0; // Offset in result.text where the anchor text begins
+
+    // Method to finish the open link, if any
+    void closeLink() {
+        if (!inLink) {
+            return;
+        }
+        inLink = false;
+        HtmlLink link{std::move(linkUrl), collapseWhitespace(std::string_view(result.text).substr(linkStart))};
+        bool isWebUrl = link.url.compare(0, 7, "http://") == 0 || link.url.compare(0, 8, "https://") == 0;
+        if (inlineLinks && isWebUrl && link.text != link.url) { // Keep the URL next to the words that link to it
+            result.text += ' ';
+            result.text += link.url;
+            result.text += ' ';
+        }
+        result.links.push_back(std::move(link));
+        linkUrl.clear();
+    }
+
+    // Method to handle a parsed tag; returns where scanning continues
+    size_t handleTag(const Tag& tag) {
+        if (!tag.closing && !tag.selfClosing &&
+            (tagIs(tag.name, "style") || tagIs(tag.name, "script") || tagIs(tag.name, "title"))) {
+            // Content that is never shown; like a browser, everything up to the matching end tag belongs to it
+            size_t close = findClosingTag(html, tag.end, tag.name);
+            size_t closeEnd = html.find('>', close);
+            return closeEnd == std::string_view::npos ? html.size() : closeEnd + 1;
+        }
+
+        if (tagIs(tag.name, "a")) {
+            closeLink(); // Links do not nest
+            if (!tag.closing && !tag.href.empty()) {
+                inLink = true;
+                HtmlText::decodeEntities(tag.href, linkUrl, true);
+                linkStart = result.text.size();
+            }
+        } else if (isBlockTag(tag.name)) {
+            if (!result.text.empty() && result.text.back() != '\n') {
+                result.text += '\n';
+            }
+        } else if (tagIs(tag.name, "td") || tagIs(tag.name, "th") || tagIs(tag.name, "img")) {
+            result.text += ' '; // Keep cells and images from gluing words together
+        }
+        return tag.end;
+    }
+
+public:
+    Converter(std::string_view html, bool inlineLinks) : html(html), inlineLinks(inlineLinks) {
+        result.text.reserve(html.size() / 2);
+    }
+
+    // Method to run the conversion in one pass over the input
+    HtmlTextResult run() {
+        size_t pos = 0;
+        while (pos < html.size()) {
+            size_t special = findMarkup(html, pos);
+            result.text.append(html.data() + pos, special - pos); // Copy the plain run in one go
+            if (special == html.size()) {
+                break;
+            }
+            pos = special;
+
+            if (html[pos] == '&') {
+                size_t consumed = decodeEntity(html, pos, result.text, false);
+                if (consumed == 0) {
+                    result.text += '&';
+                    consumed = 1;
+                }
+                pos += consumed;
+                continue;
+            }
+
+            // '<': comment, declaration, tag or a literal '<'
+            if (html.compare(pos, 4, "<!--") == 0) {
+                size_t end = html.find("-->", pos + 4);
+                pos = end == std::string_view::npos ? html.size() : end + 3;
+            } else if (pos + 1 < html.size() && (html[pos + 1] == '!' || html[pos + 1] == '?')) {
+                size_t end = html.find('>', pos);
+                pos = end == std::string_view::npos ? html.size() : end + 1;
+            } else {
+                Tag tag;
+                if (parseTag(html, pos, tag)) {
+                    pos = handleTag(tag);
+                } else {
+                    result.text += '<';
+                    pos++;
+                }
+            }
+        }
+        closeLink();
+        return std::move(result);
+    }
+};
+
+} // namespace
+
+// Function to convert HTML to text and links
+HtmlTextResult HtmlText::convert(std::string_view html, bool inlineLinks) {
+    return Converter(html, inlineLinks).run();
+}
+
+// Function to decode character references, copying the plain runs between them
+void HtmlText::decodeEntities(std::string_view text, std::string& out, bool inAttribute) {
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t amp = text.find('&', pos);
+        if (amp == std::string_view::npos) {
+            amp = text.size();
+        }
+        out.append(text.data() + pos, amp - pos);
+        if (amp == text.size()) {
+            break;
+        }
+        size_t consumed = decodeEntity(text, amp, out, inAttribute);
+        if (consumed == 0) {
+            out += '&';
+            consumed = 1;
+        }
+        pos = amp + consumed;
+    }
+}
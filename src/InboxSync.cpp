@@ -0,0 +1,124 @@
+#include "InboxSync.h"
+#include "JsonParser.h"
+#include <algorithm>
+
+using namespace MailTMAPI;
+
+// Constructor that starts collecting above the given watermark
+InboxSync::InboxSync(InboxCursor cursor)
+    : cursor(std::move(cursor)), reachedWatermark(false), failed(false) {}
+
+// Method to check whether a message is at or below the watermark
+bool InboxSync::isKnown(const std::string& createdAt, const std::string& id) const {
+    if (cursor.empty()) {
+        return false;
+    }
+    if (createdAt != cursor.createdAt) {
+        return createdAt < cursor.createdAt; // ISO 8601 timestamps in one zone sort lexicographically
+    }
+    return std::binary_search(cursor.ids.begin(), cursor.ids.end(), id);
+}
+
+// Method to collect the new messages of one page and find the page to request next
+std::string InboxSync::addPage(const std::string& response) {
+    Json::Value page;
+    if (!JsonParser::local().parse(response, page) || !page.isObject() || !page["hydra:member"].isArray()) {
+        failed = true;
+        return "";
+    }
+
+    for (const auto& member : page["hydra:member"]) {
+        MessageSummary message = MessageSummary::fromJson(member);
+        const std::string& createdAt = message.createdAt;
+        const std::string& id = message.id;
+        if (isKnown(createdAt, id)) {
+            reachedWatermark = true;
+            if (createdAt < cursor.createdAt) {
+                break; // Everything after this is older still
+            }
+            continue; // Unseen messages may share the watermark's timestamp
+        }
+        if (std::binary_search(cursor.returnedIds.begin(), cursor.returnedIds.end(), id)) {
+            continue; // Returned by an earlier sync that stopped before the watermark
+        }
+        if (!collectedIds.insert(id).second) {
+            continue; // Shifted onto this page by mail that arrived mid-sync
+        }
+        if (createdAt > newestCreatedAt) { // New high-water mark
+            newestCreatedAt = createdAt;
+            newestIds.clear();
+        }
+        if (createdAt == newestCreatedAt) {
+            newestIds.push_back(id);
+        }
+        messages.push_back(std::move(message));
+    }
+
+    // Keep paging only while every message so far was new
+    if (reachedWatermark || cursor.empty()) {
+        return "";
+    }
+    return page["hydra:view"]["hydra:next"].asString();
+}
+
+// Method to give up on a sync whose page request failed
+void InboxSync::abort() {
+    failed = true;
+}
+
+// Method to end the sync at the caller's page limit
+void InboxSync::stop(const std::string& next) {
+    stoppedAt = next;
+}
+
+// Method to report whether the sync failed
+bool InboxSync::hasFailed() const {
+    return failed;
+}
+
+// Method to hand the collected messages to the caller
+std::vector<MessageSummary> InboxSync::takeMessages() {
+    return std::move(messages);
+}
+
+// Method to compute the watermark for the next sync
+InboxCursor InboxSync::getCursor() const {
+    if (failed) {
+        return cursor;
+    }
+
+    // Newest message returned by this sync and the stopped syncs before it
+    std::string newest = cursor.pendingCreatedAt;
+    std::vector<std::string> newestAt = cursor.pendingIds;
+    if (newestCreatedAt > newest) {
+        newest = newestCreatedAt;
+        newestAt = newestIds;
+    } else if (!newestCreatedAt.empty() && newestCreatedAt == newest) {
+        newestAt.insert(newestAt.end(), newestIds.begin(), newestIds.end());
+    }
+    std::sort(newestAt.begin(), newestAt.end());
+
+    if (!stoppedAt.empty() && !cursor.empty()) { // Older unseen mail remains, keep the watermark until it is read
+        InboxCursor next = cursor;
+        next.resumeLink = stoppedAt;
+        next.returnedIds.insert(next.returnedIds.end(), collectedIds.begin(), collectedIds.end());
+        std::sort(next.returnedIds.begin(), next.returnedIds.end());
+        next.pendingCreatedAt = newest;
+        next.pendingIds = newestAt;
+        return next;
+    }
+
+    InboxCursor next;
+    if (newest.empty() || newest < cursor.createdAt) {
+        next.createdAt = cursor.createdAt;
+        next.ids = cursor.ids;
+        return next;
+    }
+    next.createdAt = newest;
+    next.ids = newestAt;
+    if (newest == cursor.createdAt) { // Still the same timestamp, keep the IDs seen before
+        next.ids.insert(next.ids.end(), cursor.ids.begin(), cursor.ids.end());
+    }
+    std::sort(next.ids.begin(), next.ids.end());
+    return next;
+}
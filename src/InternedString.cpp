@@ -0,0 +1,61 @@
+#include "InternedString.h"
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+
+using namespace MailTMAPI;
+
+namespace {
+
+// Process-wide pool; entries only hold weak references so unused values are freed
+struct StringPool {
+    std::mutex mutex;
+    std::unordered_map<std::string, std::weak_ptr<const std::string>> entries;
+    size_t nextPurge = 1024; // Size at which expired entries are swept
+
+    std::shared_ptr<const std::string> intern(std::string_view text) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto& entry = entries[std::string(text)];
+        if (auto existing = entry.lock()) {
+            return existing;
+        }
+        auto value = std::make_shared<const std::string>(text);
+        entry = value;
+
+        // Sweep values nobody refers to any more, amortised over the inserts that grew the pool
+        if (entries.size() >= nextPurge) {
+            for (auto it = entries.begin(); it != entries.end();) {
+                it = it->second.expired() ? entries.erase(it) : std::next(it);
+            }
+            nextPurge = std::max<size_t>(1024, entries.size() * 2);
+        }
+        return value;
+    }
+};
+
+// Function to get the pool; leaked on purpose so strings outliving static destruction stay valid
+StringPool& pool() {
+    static StringPool* instance = new StringPool();
+    return *instance;
+}
+
+} // namespace
+
+// Constructor that shares storage with equal values already in the pool
+InternedString::InternedString(std::string_view text) {
+    if (!text.empty()) {
+        value = pool().intern(text);
+    }
+}
+
+// Method to get the value
+const std::string& InternedString::str() const {
+    static const std::string emptyString;
+    return value ? *value : emptyString;
+}
+
+// Function to report how many distinct values are pooled
+size_t InternedString::poolSize() {
+    std::lock_guard<std::mutex> lock(pool().mutex);
+    return pool().entries.size();
+}
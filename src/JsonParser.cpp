@@ -0,0 +1,240 @@
+#include "JsonParser.h"
+
+using namespace MailTMAPI;
+
+namespace {
+
+// Function to skip whitespace, returning the new position
+size_t skipSpace(std::string_view text, size_t pos) {
+    while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t' || text[pos] == '\n' || text[pos] == '\r')) {
+        ++pos;
+    }
+    return pos;
+}
+
+// Function to find the closing quote of a string starting at pos (just after the opening quote)
+size_t skipString(std::string_view text, size_t pos) {
+    while (pos < text.size()) {
+        if (text[pos] == '\\') {
+            pos += 2; // Skip the escaped character
+        } else if (text[pos] == '"') {
+            return pos;
+        } else {
+            ++pos;
+        }
+    }
+    return std::string_view::npos;
+}
+
+// Function to parse four hex digits of a \u escape
+bool readHex(std::string_view text, size_t pos, unsigned& value) {
+    if (pos + 4 > text.size()) {
+        return false;
+    }
+    value = 0;
+    for (size_t i = pos; i < pos + 4; ++i) {
+        char c = text[i];
+        value <<= 4;
+        if (c >= '0' && c <= '9') {
+            value |= c - '0';
+        } else if (c >= 'a' && c <= 'f') {
+            value |= c - 'a' + 10;
+        } else if (c >= 'A' && c <= 'F') {
+            value |= c - 'A' + 10;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Function to append a code point as UTF-8
+void appendUtf8(std::string& out, unsigned codePoint) {
+    if (codePoint < 0x80) {
+        out += static_cast<char>(codePoint);
+    } else if (codePoint < 0x800) {
+        out += static_cast<char>(0xC0 | (codePoint >> 6));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else if (codePoint < 0x10000) {
+        out += static_cast<char>(0xE0 | (codePoint >> 12));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (codePoint >> 18));
+        out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+}
+
+// Function to decode the body of a JSON string (without quotes)
+std::optional<std::string> decodeString(std::string_view raw) {
+    std::string out;
+    out.reserve(raw.size());
+    for (size_t i = 0; i < raw.size(); ++i) {
+        size_t escape = raw.find('\\', i);
+        out.append(raw.data() + i, (escape == std::string_view::npos ? raw.size() : escape) - i); // Copy plain runs in one go
+        if (escape == std::string_view::npos) {
+            break;
+        }
+        i = escape;
+        if (++i >= raw.size()) {
+            return std::nullopt;
+        }
+        switch (raw[i]) {
+            case '"': out += '"'; break;
+            case '\\': out += '\\'; break;
+            case '/': out += '/'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u': {
+                unsigned codePoint;
+                if (!readHex(raw, i + 1, codePoint)) {
+                    return std::nullopt;
+                }
+                i += 4;
+                // Combine a surrogate pair into one code point
+                unsigned low;
+                if (codePoint >= 0xD800 && codePoint < 0xDC00 && i + 2 < raw.size() && raw[i + 1] == '\\' &&
+                    raw[i + 2] == 'u' && readHex(raw, i + 3, low) && low >= 0xDC00 && low < 0xE000) {
+                    codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                    i += 6;
+                }
+                appendUtf8(out, codePoint);
+                break;
+            }
+            default:
+                return std::nullopt;
+        }
+    }
+    return out;
+}
+
+// Function to skip any JSON value starting at pos, returning the position after it
+size_t skipValue(std::string_view text, size_t pos) {
+    if (pos >= text.size()) {
+        return std::string_view::npos;
+    }
+    if (text[pos] == '"') {
+        size_t end = skipString(text, pos + 1);
+        return end == std::string_view::npos ? end : end + 1;
+    }
+    if (text[pos] == '{' || text[pos] == '[') {
+        int depth = 0;
+        while (pos < text.size()) {
+            char c = text[pos];
+            if (c == '"') {
+                pos = skipString(text, pos + 1);
+                if (pos == std::string_view::npos) {
+                    return pos;
+                }
+            } else if (c == '{' || c == '[') {
+                ++depth;
+            } else if (c == '}' || c == ']') {
+                if (--depth == 0) {
+                    return pos + 1;
+                }
+            }
+            ++pos;
+        }
+        return std::string_view::npos;
+    }
+    // Number or literal, runs until the next separator
+    while (pos < text.size() && text[pos] != ',' && text[pos] != '}' && text[pos] != ']' && text[pos] != ' ' &&
+           text[pos] != '\t' && text[pos] != '\n' && text[pos] != '\r') {
+        ++pos;
+    }
+    return pos;
+}
+
+} // namespace
+
+// Constructor that creates the reader once
+JsonParser::JsonParser() {
+    Json::CharReaderBuilder builder;
+    reader.reset(builder.newCharReader());
+}
+
+// Method to parse a document in place, without copying it into a stream
+bool JsonParser::parse(std::string_view text, Json::Value& root, std::string* errors) {
+    std::string ignored;
+    return reader->parse(text.data(), text.data() + text.size(), &root, errors ? errors : &ignored);
+}
+
+// Function to get the calling thread's parser; CharReader keeps state so threads must not share one
+JsonParser& JsonParser::local() {
+    thread_local JsonParser parser;
+    return parser;
+}
+
+// Function to extract one top-level string field by scanning the object
+std::optional<std::string> JsonParser::findString(std::string_view text, std::string_view key, bool* malformed) {
+    if (malformed) {
+        *malformed = false;
+    }
+    auto fail = [&]() -> std::optional<std::string> {
+        if (malformed) {
+            *malformed = true;
+        }
+        return std::nullopt;
+    };
+
+    size_t pos = skipSpace(text, 0);
+    if (pos >= text.size() || text[pos] != '{') {
+        return fail();
+    }
+    pos = skipSpace(text, pos + 1);
+    if (pos < text.size() && text[pos] == '}') {
+        return std::nullopt; // Empty object
+    }
+
+    while (pos < text.size()) {
+        // Read the field name
+        if (text[pos] != '"') {
+            return fail();
+        }
+        size_t keyEnd = skipString(text, pos + 1);
+        if (keyEnd == std::string_view::npos) {
+            return fail();
+        }
+        std::string_view name = text.substr(pos + 1, keyEnd - pos - 1);
+        pos = skipSpace(text, keyEnd + 1);
+        if (pos >= text.size() || text[pos] != ':') {
+            return fail();
+        }
+        pos = skipSpace(text, pos + 1);
+
+        // Decode the value only for the requested field
+        bool matches = name == key || (name.find('\\') != std::string_view::npos && decodeString(name) == std::string(key));
+        if (matches) {
+            if (pos >= text.size() || text[pos] != '"') {
+                return std::nullopt; // Present but not a string
+            }
+            size_t end = skipString(text, pos + 1);
+            if (end == std::string_view::npos) {
+                return fail();
+            }
+            return decodeString(text.substr(pos + 1, end - pos - 1));
+        }
+
+        pos = skipValue(text, pos);
+        if (pos == std::string_view::npos) {
+            return fail();
+        }
+        pos = skipSpace(text, pos);
+        if (pos >= text.size()) {
+            return fail();
+        }
+        if (text[pos] == '}') {
+            return std::nullopt; // Field not present
+        }
+        if (text[pos] != ',') {
+            return fail();
+        }
+        pos = skipSpace(text, pos + 1);
+    }
+    return fail();
+}
@@ -0,0 +1,48 @@
+#include "LayoutCache.h"
+
+// Constructor for LayoutCache
+LayoutCache::LayoutCache(const sf::Font& font) : font(font) {}
+
+// Method to get the advance table of a font size, building it on first use
+const MailTMAPI::GlyphAdvances& LayoutCache::getAdvances(unsigned int fontSize) {
+    auto& table = advances[fontSize];
+    if (!table) {
+        table = std::make_unique<MailTMAPI::GlyphAdvances>([this, fontSize](char32_t codePoint) {
+            return font.getGlyph(codePoint, fontSize, false).advance;
+        });
+    }
+    return *table;
+}
+
+// Method to look up a block, laying it out and building its glyph quads on a miss
+LayoutCache::Block& LayoutCache::get(const std::string& key, const Style& style, const std::vector<MailTMAPI::LayoutWord>& words) {
+    std::string fullKey = key + '|' + std::to_string(style.fontSize) + '|' + std::to_string(style.options.maxWidth) +
+                          '|' + std::to_string(style.options.maxLines);
+    auto it = blocks.find(fullKey);
+    if (it != blocks.end()) {
+        return it->second;
+    }
+
+    if (blocks.size() >= maxBlocks) { // Bound memory; visible blocks are rebuilt on the next frame
+        blocks.clear();
+    }
+
+    Block block;
+    block.layout = MailTMAPI::TextLayout::layout(words, getAdvances(style.fontSize), style.options);
+    block.fontSize = style.fontSize;
+    for (const auto& run : block.layout.runs) {
+        BatchRenderer::buildText(font, run.text, style.fontSize, run.isLink ? style.linkColor : style.color, run.isLink,
+                                 run.x, run.y, block.vertices);
+    }
+    return blocks.emplace(std::move(fullKey), std::move(block)).first->second;
+}
+
+// Function to add a cached block to the batch; only its position changes, the glyph quads are reused
+void LayoutCache::draw(BatchRenderer& batch, const Block& block, float x, float y) {
+    batch.addVertices(block.vertices, block.fontSize, x, y);
+}
+
+// Method to empty the cache
+void LayoutCache::clear() {
+    blocks.clear();
+}
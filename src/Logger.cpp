@@ -0,0 +1,189 @@
+#include "Logger.h"
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+using namespace MailTMAPI;
+
+namespace {
+
+// Function to get the fixed-width name printed before each line
+const char* levelName(LogLevel level) {
+    switch (level) {
+    case LogLevel::Debug: return "DEBUG";
+    case LogLevel::Info: return "INFO ";
+    case LogLevel::Warn: return "WARN ";
+    default: return "ERROR";
+    }
+}
+
+// Function to write a line to the terminal, keeping the stream each level used before
+void writeToTerminal(LogLevel level, std::string_view line) {
+    std::FILE* stream = level <= LogLevel::Info ? stdout : stderr;
+    std::fwrite(line.data(), 1, line.size(), stream);
+    std::fputc('\n', stream);
+}
+
+// Function to write the time and level in front of a line; returns the bytes written
+size_t formatPrefix(char* buffer, size_t size, std::chrono::system_clock::time_point time, LogLevel level) {
+    std::time_t seconds = std::chrono::system_clock::to_time_t(time);
+    auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count() % 1000;
+    std::tm parts{};
+    localtime_r(&seconds, &parts);
+    int length = std::snprintf(buffer, size, "%02d:%02d:%02d.%03d %s ", parts.tm_hour, parts.tm_min, parts.tm_sec,
+                               static_cast<int>(millis), levelName(level));
+    return length > 0 ? static_cast<size_t>(length) : 0;
+}
+
+} // namespace
+
+// Method to append text, keeping whatever fits
+void Logger::LineWriter::append(std::string_view text) {
+    size_t room = lineCapacity - slot.length;
+    size_t count = text.size() < room ? text.size() : room;
+    text.copy(slot.text + slot.length, count);
+    slot.length += count;
+}
+
+// Method to append a floating-point value the way std::cout would
+void Logger::LineWriter::append(double value) {
+    char buffer[32];
+    int length = std::snprintf(buffer, sizeof(buffer), "%g", value);
+    append(std::string_view(buffer, length > 0 ? static_cast<size_t>(length) : 0));
+}
+
+// Constructor writing to stdout and stderr
+Logger::Logger(size_t capacity) : Logger(writeToTerminal, capacity) {}
+
+// Constructor with a custom sink; starts the writer thread
+Logger::Logger(Sink sink, size_t requested) : capacity(1), sink(std::move(sink)) {
+    while (capacity < requested) {
+        capacity <<= 1;
+    }
+    slots.reset(new Slot[capacity]);
+    for (size_t i = 0; i < capacity; ++i) {
+        slots[i].sequence.store(i, std::memory_order_relaxed); // Free for the producer that claims position i
+    }
+    writer = std::thread(&Logger::run, this);
+}
+
+// Destructor draining the ring before the writer stops
+Logger::~Logger() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        running.store(false);
+    }
+    wake.notify_one();
+    writer.join();
+}
+
+// Function to get the process-wide logger
+Logger& Logger::instance() {
+    static Logger* logger = [] {
+        Logger* created = new Logger(); // Leaked on purpose so late log calls never see a destroyed logger
+        std::atexit([] { Logger::instance().flush(); });
+        return created;
+    }();
+    return *logger;
+}
+
+// Method to claim the next free slot; returns nullptr when the ring is full
+Logger::Slot* Logger::claim() {
+    size_t position = enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = slots[position & (capacity - 1)];
+        size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+        if (difference == 0) {
+            if (enqueuePos.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                return &slot;
+            }
+        } else if (difference < 0) {
+            return nullptr; // The writer has not freed this slot yet
+        } else {
+            position = enqueuePos.load(std::memory_order_relaxed); // Another producer got there first
+        }
+    }
+}
+
+// Method to hand a filled slot to the writer, waking it if it went to sleep
+void Logger::publish(Slot& slot) {
+    size_t position = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(position + 1); // Sequentially consistent with the writer's check before it sleeps
+    if (sleeping.load()) { // Only the first lines after a quiet spell get here
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex); // The writer is either waiting or has not checked yet
+        }
+        wake.notify_one();
+    }
+}
+
+// Method to check whether a line or a drop report is waiting for the writer
+bool Logger::hasPending() const {
+    return slots[dequeuePos & (capacity - 1)].sequence.load() == dequeuePos + 1 ||
+           dropped.load(std::memory_order_relaxed) > 0;
+}
+
+// Method to write every published line; returns whether there was any
+bool Logger::drain() {
+    bool wroteAny = false;
+    char line[lineCapacity + 64];
+    for (;;) {
+        uint64_t lost = dropped.exchange(0, std::memory_order_relaxed);
+        if (lost > 0) {
+            size_t prefix = formatPrefix(line, sizeof(line), std::chrono::system_clock::now(), LogLevel::Warn);
+            int length = std::snprintf(line + prefix, sizeof(line) - prefix, "Logger dropped %llu lines, the ring was full",
+                                       static_cast<unsigned long long>(lost));
+            sink(LogLevel::Warn, std::string_view(line, prefix + static_cast<size_t>(length)));
+        }
+
+        Slot& slot = slots[dequeuePos & (capacity - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != dequeuePos + 1) {
+            return wroteAny; // Empty, or the next producer is still formatting
+        }
+        size_t prefix = formatPrefix(line, sizeof(line), slot.time, slot.level);
+        std::memcpy(line + prefix, slot.text, slot.length);
+        LogLevel level = slot.level;
+        size_t length = prefix + slot.length;
+
+        slot.sequence.store(dequeuePos + capacity, std::memory_order_release); // Free the slot for the next lap
+        ++dequeuePos;
+        sink(level, std::string_view(line, length));
+        written.fetch_add(1, std::memory_order_release);
+        wroteAny = true;
+    }
+}
+
+// Method run by the writer thread: drain, then sleep until a producer, flush() or shutdown wakes it
+void Logger::run() {
+    for (;;) {
+        bool stopping = !running.load(); // Read first so the last drain sees everything logged before the stop
+        if (drain()) { // One flush per batch rather than per line
+            std::fflush(stdout);
+            std::fflush(stderr);
+        }
+        if (stopping) {
+            return;
+        }
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        sleeping.store(true);
+        if (!hasPending() && running.load()) { // A line published after this check sees sleeping and wakes us
+            wake.wait(lock);
+        }
+        sleeping.store(false);
+    }
+}
+
+// Method to wait until every line logged so far has been written
+void Logger::flush() {
+    size_t target = enqueuePos.load(std::memory_order_acquire);
+    while (written.load(std::memory_order_acquire) < target && running.load()) {
+        wake.notify_one();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+// Method to get the number of dropped lines not reported yet
+uint64_t Logger::getDropped() const {
+    return dropped.load(std::memory_order_relaxed);
+}
@@ -1,65 +1,165 @@
 #include "MailTM.h"
 #include "CurlWrapper.h"
-#include <sstream>
-#include <iostream>
-#include "CurlWrapper.h"
+#include "CurlPool.h"
+#include "CurlMulti.h"
+#include "SseParser.h"
+#include "TokenCache.h"
+#include "JsonParser.h"
+#include "Logger.h"
+#include "SearchIndex.h"
+#include "RequestMetrics.h"
+#include <algorithm>
+#include <cctype>
+#include <condition_variable>
+#include <stdexcept>
+#include <thread>
+#include <chrono>
 
 using namespace MailTMAPI;
 
+namespace {
+
+// State shared with the CURL callbacks of a push stream
+struct StreamContext {
+    SseParser* parser;
+    const std::atomic<bool>* running;
+};
+
+// Callback function that feeds streamed bytes to the SSE parser
+size_t StreamWriteCallback(void* contents, size_t size, size_t nmemb, void* userp) {
+    static_cast<StreamContext*>(userp)->parser->feed(static_cast<const char*>(contents), size * nmemb);
+    return size * nmemb;
+}
+
+// Progress callback that aborts the stream once the caller stops it
+int StreamProgressCallback(void* userp, curl_off_t, curl_off_t, curl_off_t, curl_off_t) {
+    return *static_cast<StreamContext*>(userp)->running ? 0 : 1;
+}
+
+} // namespace
+
+// Constructor that sets up the pool of reusable CURL handles
+MailTM::MailTM(const std::string& baseUrl)
+    : baseUrl(baseUrl)
+    , metrics(std::make_shared<RequestMetrics>())
+    , curlPool(std::make_unique<CurlPool>())
+    , tokenCache(std::make_unique<TokenCache>([this](const std::string& email, const std::string& password) {
+          return requestToken(email, password);
+      })) {}
+
+// Destructor stopping the event loop first, since its callbacks use the token cache and the extractor
+MailTM::~MailTM() {
+    curlMulti.reset(); // Joins the loop and completes unfinished transfers while every member is still alive
+}
+
 // Callback function to write CURL response data into a string
 size_t MailTM::WriteCallback(void* contents, size_t size, size_t nmemb, void* userp) {
     ((std::string*)userp)->append((char*)contents, size * nmemb);
     return size * nmemb;
 }
 
+// Function to configure a CURL handle for a request to the Mail.tm API
+void MailTM::prepareRequest(CurlWrapper& curl, const std::string& url, const std::string& method,
+                            const std::string& payload, const std::string& authToken, std::string* response) {
+    // Set CURL options
+    curl.setOption(CURLOPT_URL, url.c_str());
+    curl.setOption(CURLOPT_WRITEFUNCTION, WriteCallback); // Set the write callback function
+    curl.setOption(CURLOPT_WRITEDATA, response);
+
+    // Add headers if an authentication token is provided
+    if (!authToken.empty()) {
+        curl.addHeader("Authorization: Bearer " + authToken);
+    }
+    curl.addHeader("Content-Type: application/json");
+
+    // Set method-specific options
+    if (method == "POST") {
+        curl.setOption(CURLOPT_COPYPOSTFIELDS, payload.c_str()); // Copied so async requests may outlive the payload
+    } else if (method == "DELETE") {
+        curl.setOption(CURLOPT_CUSTOMREQUEST, "DELETE");
+    }
+}
+
 // Function to send a network request using the specified URL, method, payload, and optional authentication token
 std::string MailTM::sendRequest(const std::string& url, const std::string& method,
-                                const std::string& payload, const std::string& authToken) {
+                                const std::string& payload, const std::string& authToken, long* statusCode) {
+    requestsStarted.store(true, std::memory_order_relaxed); // From here on setMetrics would race with the recording
+    if (statusCode) {
+        *statusCode = 0;
+    }
     try {
-        CurlWrapper curl; // Initialize CURL wrapper
+        std::unique_ptr<CurlWrapper> handle = curlPool->acquire(); // Reuse a keep-alive handle
         std::string response;
-
-        // Set CURL options
-        curl.setOption(CURLOPT_URL, url.c_str());
-        curl.setOption(CURLOPT_WRITEFUNCTION, WriteCallback); // Set the write callback function
-        curl.setOption(CURLOPT_WRITEDATA, &response);
-
-        // Add headers if an authentication token is provided
-        if (!authToken.empty()) {
-            curl.addHeader("Authorization: Bearer " + authToken);
-        }
-        curl.addHeader("Content-Type: application/json");
-
-        // Set method-specific options
-        if (method == "POST") {
-            curl.setOption(CURLOPT_POSTFIELDS, payload.c_str());
-        } else if (method == "DELETE") {
-            curl.setOption(CURLOPT_CUSTOMREQUEST, "DELETE");
-        }
+        prepareRequest(*handle, url, method, payload, authToken, &response);
 
         // Perform the CURL request
-        CURLcode res = curl.perform();
+        CURLcode res = handle->perform();
+        metrics->record(RequestMetrics::classify(method, url), handle->getTiming(), res == CURLE_OK);
         if (res != CURLE_OK) {
-            std::cerr << "CURL error: " << curl_easy_strerror(res) << std::endl;
+            LOG_ERROR("CURL error: ", curl_easy_strerror(res));
+            response.clear(); // A transfer cut off midway leaves a partial body that callers would try to parse
+        } else if (statusCode) {
+            *statusCode = handle->getResponseCode();
         }
 
+        curlPool->release(std::move(handle)); // Hand the connection back for the next request
         return response; // Return the response as a string
     } catch (const std::exception& e) {
-        std::cerr << "Error in sendRequest: " << e.what() << std::endl;
+        LOG_ERROR("Error in sendRequest: ", e.what());
         return ""; // Return an empty string on error
     }
 }
 
+// Function to lazily start the event loop used by the async API
+CurlMulti& MailTM::getMulti() {
+    std::lock_guard<std::mutex> lock(multiMutex);
+    if (!curlMulti) { // Only clients that use the async API pay for the loop thread
+        curlMulti = std::make_unique<CurlMulti>(maxAsyncConnections);
+    }
+    return *curlMulti;
+}
+
+// Function to send a network request without blocking; onDone receives the response body
+void MailTM::sendRequestAsync(const std::string& url, const std::string& method, const std::string& payload,
+                              const std::string& authToken, std::function<void(std::string, long)> onDone) {
+    requestsStarted.store(true, std::memory_order_relaxed);
+    auto response = std::make_shared<std::string>();
+    std::unique_ptr<CurlWrapper> handle;
+    try {
+        handle = curlPool->acquire(); // Reuse a keep-alive handle
+        prepareRequest(*handle, url, method, payload, authToken, response.get());
+    } catch (const std::exception& e) {
+        LOG_ERROR("Error in sendRequestAsync: ", e.what());
+        onDone("", 0); // Report failure the same way sendRequest does
+        return;
+    }
+
+    Endpoint endpoint = RequestMetrics::classify(method, url);
+    getMulti().submit(std::move(handle), [this, response, onDone, endpoint](std::unique_ptr<CurlWrapper> curl, CURLcode res) {
+        metrics->record(endpoint, curl->getTiming(), res == CURLE_OK);
+        long status = 0;
+        if (res != CURLE_OK) {
+            LOG_ERROR("CURL error: ", curl_easy_strerror(res));
+            response->clear(); // Drop any partial body, as sendRequest does
+        } else {
+            status = curl->getResponseCode();
+        }
+        try {
+            curlPool->release(std::move(curl)); // Hand the connection back for the next request
+        } catch (const std::exception& e) {
+            LOG_ERROR("Error releasing CURL handle: ", e.what());
+        }
+        onDone(std::move(*response), status);
+    });
+}
+
 // Function to fetch an available domain for email creation
 std::string MailTM::getAvailableDomain() {
     std::string response = sendRequest(baseUrl + "/domains", "GET");
     Json::Value jsonData;
-    Json::CharReaderBuilder reader;
-    std::istringstream stream(response);
-    std::string errors;
 
     // Parse the response JSON
-    if (Json::parseFromStream(reader, stream, &jsonData, &errors)) {
+    if (JsonParser::local().parse(response, jsonData)) {
         if (!jsonData["hydra:member"].empty()) { // Check if domains are available
             return jsonData["hydra:member"][0]["domain"].asString(); // Return the first domain
         }
@@ -79,69 +179,152 @@ std::optional<std::string> MailTM::registerEmail(const std::string& email, const
     // Send a POST request to create the account
     std::string response = sendRequest(baseUrl + "/accounts", "POST", jsonStr);
 
-    Json::CharReaderBuilder reader;
-    Json::Value jsonResponse;
-    std::string errors;
-
-    std::istringstream stream(response);
-    if (!Json::parseFromStream(reader, stream, &jsonResponse, &errors)) { // Parse the response JSON
-        std::cerr << "Failed to parse registerEmail response: " << errors << std::endl;
-        return std::nullopt;
+    // Only the account ID is needed, so skip building a DOM
+    bool malformed = false;
+    auto accountId = JsonParser::findString(response, "id", &malformed);
+    if (malformed) {
+        LOG_ERROR("Failed to parse registerEmail response");
     }
+    return accountId; // nullopt if registration fails
+}
 
-    if (jsonResponse.isMember("id")) { // Check if the response contains an account ID
-        return jsonResponse["id"].asString(); // Return the account ID
+// Function to authenticate a user and retrieve a token, reusing a cached one when possible
+std::optional<std::string> MailTM::authenticate(const std::string& email, const std::string& password) {
+    if (auto cached = tokenCache->get(email, password)) { // Skip the round trip while the token is valid
+        return cached;
     }
-
-    return std::nullopt; // Return nullopt if registration fails
+    auto token = requestToken(email, password);
+    if (token) {
+        tokenCache->put(email, password, *token);
+    }
+    return token;
 }
 
-// Function to authenticate a user and retrieve a token
-std::optional<std::string> MailTM::authenticate(const std::string& email, const std::string& password) {
+// Function to build the JSON payload for /token
+std::string MailTM::tokenPayload(const std::string& email, const std::string& password) {
     Json::Value payload;
     payload["address"] = email; // Set email address in JSON payload
     payload["password"] = password; // Set password in JSON payload
 
     Json::StreamWriterBuilder writer;
-    std::string payloadStr = Json::writeString(writer, payload);
+    return Json::writeString(writer, payload);
+}
 
-    try {
-        // Send a POST request to authenticate
-        std::string response = sendRequest(baseUrl + "/token", "POST", payloadStr);
-        Json::CharReaderBuilder reader;
-        Json::Value jsonResponse;
-        std::string errors;
+// Function to request a new token from the server
+std::optional<std::string> MailTM::requestToken(const std::string& email, const std::string& password) {
+    // Send a POST request to authenticate
+    return parseToken(sendRequest(baseUrl + "/token", "POST", tokenPayload(email, password)));
+}
 
-        std::istringstream ss(response);
-        if (!Json::parseFromStream(reader, ss, &jsonResponse, &errors)) { // Parse the response JSON
-            throw std::runtime_error("Failed to parse authentication response: " + errors);
-        }
+// Function to drop a token the server rejected
+void MailTM::invalidateToken(const std::string& email) {
+    tokenCache->invalidate(email);
+}
 
-        if (jsonResponse.isMember("token")) { // Check if the response contains a token
-            return jsonResponse["token"].asString(); // Return the token
-        }
-        return std::nullopt; // Return nullopt if authentication fails
-    } catch (const std::exception& e) {
-        std::cerr << "Authentication error: " << e.what() << std::endl;
-        return std::nullopt;
+// Function to enable the on-disk token store
+void MailTM::setTokenStorePath(const std::string& path) {
+    tokenCache->setStorePath(path);
+}
+
+// Function to index every message fetched from now on
+void MailTM::setSearchIndex(SearchIndex* index) {
+    searchIndex = index;
+}
+
+// Function to record request statistics into a shared collector
+void MailTM::setMetrics(std::shared_ptr<RequestMetrics> shared) {
+    if (requestsStarted.load(std::memory_order_relaxed)) {
+        throw std::logic_error("setMetrics called after the first request");
     }
+    metrics = std::move(shared);
+}
+
+// Function to get the collector of request statistics
+std::shared_ptr<RequestMetrics> MailTM::getMetrics() const {
+    return metrics;
+}
+
+// Function to count the async requests that have not finished
+size_t MailTM::getRequestsInFlight() const {
+    std::lock_guard<std::mutex> lock(multiMutex);
+    return curlMulti ? curlMulti->getInFlight() : 0;
+}
+
+// Function to extract the token from an authentication response
+std::optional<std::string> MailTM::parseToken(const std::string& response) {
+    // Only the token is needed, so skip building a DOM
+    bool malformed = false;
+    auto token = JsonParser::findString(response, "token", &malformed);
+    if (malformed) {
+        LOG_ERROR("Authentication error: Failed to parse authentication response");
+    }
+    return token; // nullopt if authentication fails
 }
 
 // Function to fetch messages from the inbox
-std::vector<Json::Value> MailTM::checkInbox(const std::string& token) {
-    std::string response = sendRequest(baseUrl + "/messages", "GET", "", token);
-    Json::Value jsonData;
-    Json::CharReaderBuilder reader;
-    std::istringstream stream(response);
-    std::string errors;
-    std::vector<Json::Value> messages;
+std::vector<MessageSummary> MailTM::checkInbox(const std::string& token) {
+    return parseInbox(sendRequest(baseUrl + "/messages", "GET", "", token));
+}
 
-    // Parse the response JSON and extract messages
-    if (Json::parseFromStream(reader, stream, &jsonData, &errors)) {
-        for (const auto& message : jsonData["hydra:member"]) {
-            messages.push_back(message);
+// Function to fetch messages from the inbox and report the HTTP status
+std::vector<MessageSummary> MailTM::checkInbox(const std::string& token, long& statusCode) {
+    return parseInbox(sendRequest(baseUrl + "/messages", "GET", "", token, &statusCode));
+}
+
+// Function to fetch the messages newer than the cursor, paging until its watermark
+std::vector<MessageSummary> MailTM::syncInbox(const std::string& token, InboxCursor& cursor, long& statusCode) {
+    InboxSync sync(cursor);
+    std::string url = syncStartUrl(cursor);
+    std::string next;
+    for (int page = 0; page < maxSyncPages && !url.empty(); ++page) {
+        std::string response = sendRequest(url, "GET", "", token, &statusCode);
+        if (statusCode < 200 || statusCode >= 300) {
+            return {}; // Keep the cursor so the next sync picks up from the same place
         }
+        next = sync.addPage(response);
+        url = next.empty() ? "" : resolveLink(next);
+    }
+    if (!next.empty()) {
+        sync.stop(next); // Page limit hit before the watermark, the next sync continues here
     }
+    if (sync.hasFailed()) {
+        return {};
+    }
+
+    cursor = sync.getCursor();
+    return sync.takeMessages();
+}
+
+// Function to find the first page of a sync: the top of the inbox, or where a stopped sync left off
+std::string MailTM::syncStartUrl(const InboxCursor& cursor) const {
+    return cursor.resumeLink.empty() ? baseUrl + "/messages" : resolveLink(cursor.resumeLink);
+}
+
+// Function to resolve a hydra:next link, which the API returns as a path
+std::string MailTM::resolveLink(const std::string& next) const {
+    if (next.compare(0, 4, "http") == 0) {
+        return next;
+    }
+    return baseUrl + next;
+}
+
+// Function to extract the message list from a /messages response
+std::vector<MessageSummary> MailTM::parseInbox(const std::string& response) {
+    auto start = std::chrono::steady_clock::now();
+    Json::Value jsonData;
+    std::vector<MessageSummary> messages;
+
+    // Parse the response JSON and keep only the typed summaries
+    if (!JsonParser::local().parse(response, jsonData) || !jsonData["hydra:member"].isArray()) {
+        return messages; // Error responses such as 401 carry no message list and are not timed
+    }
+    const Json::Value& members = jsonData["hydra:member"];
+    messages.reserve(members.size());
+    for (const auto& message : members) {
+        messages.push_back(MessageSummary::fromJson(message));
+    }
+    metrics->recordProcessing(Endpoint::Inbox, std::chrono::duration_cast<std::chrono::microseconds>(
+                                                   std::chrono::steady_clock::now() - start).count());
     return messages; // Return the list of messages
 }
 
@@ -159,37 +342,343 @@ std::optional<std::string> MailTM::deleteAccount(const std::string& token, const
 
 // Function to fetch the account ID
 std::optional<std::string> MailTM::getAccountId(const std::string& token) {
-    std::string response = sendRequest(baseUrl + "/me", "GET", "", token);
+    return parseAccountId(sendRequest(baseUrl + "/me", "GET", "", token));
+}
 
-    Json::CharReaderBuilder reader;
-    Json::Value root;
-    std::string errors;
+// Function to extract the account ID from a /me response
+std::optional<std::string> MailTM::parseAccountId(const std::string& response) {
+    // Only the account ID is needed, so skip building a DOM
+    bool malformed = false;
+    auto accountId = JsonParser::findString(response, "id", &malformed);
+    if (malformed) {
+        LOG_ERROR("Failed to parse getAccountId response");
+    }
+    return accountId; // nullopt if the account ID is not found
+}
 
-    std::istringstream stream(response);
-    if (!Json::parseFromStream(reader, stream, &root, &errors)) { // Parse the response JSON
-        std::cerr << "Failed to parse getAccountId response: " << errors << std::endl;
+// Function to fetch a specific message by ID
+std::optional<Message> MailTM::getMessage(const std::string& token, const std::string& messageId) {
+    return parseMessage(sendRequest(baseUrl + "/messages/" + messageId, "GET", "", token));
+}
+
+// Function to parse a full message response
+std::optional<Message> MailTM::parseMessage(const std::string& response) {
+    auto start = std::chrono::steady_clock::now();
+    Json::Value jsonResponse;
+    if (!JsonParser::local().parse(response, jsonResponse) || !jsonResponse.isObject() ||
+        !jsonResponse.isMember("id")) { // Error responses such as 404 carry no message ID
         return std::nullopt;
     }
 
-    if (root.isMember("id")) { // Check if the response contains an account ID
-        return root["id"].asString(); // Return the account ID
+    Message message = Message::fromJson(jsonResponse); // Keep only the typed fields, the DOM is dropped here
+    if (SearchIndex* index = searchIndex.load()) {
+        index->add(message); // Every fetch path ends here, so nothing reaches the caller unindexed
+    }
+    extractMatches(message);
+    metrics->recordProcessing(Endpoint::Message, std::chrono::duration_cast<std::chrono::microseconds>(
+                                                     std::chrono::steady_clock::now() - start).count());
+    return message;
+}
+
+// Function to run the extractor on a fetched message and wake the waiters
+void MailTM::extractMatches(const Message& message) {
+    std::shared_ptr<const Extractor> current;
+    {
+        std::lock_guard<std::mutex> lock(matchMutex);
+        current = extractor;
+    }
+    if (!current) {
+        return;
+    }
+    std::vector<Extraction> matches = current->extract(message); // Outside the lock, waiters are not held up
+    if (matches.empty()) {
+        return;
     }
 
-    return std::nullopt; // Return nullopt if account ID is not found
+    std::vector<std::string> recipients;
+    for (const auto& recipient : message.to) {
+        std::string address = recipient.address.str();
+        std::transform(address.begin(), address.end(), address.begin(), [](unsigned char c) { return std::tolower(c); });
+        recipients.push_back(std::move(address));
+    }
+    {
+        std::lock_guard<std::mutex> lock(matchMutex);
+        for (auto& match : matches) {
+            pendingMatches.push_back(PendingMatch{std::move(match), recipients});
+        }
+        while (pendingMatches.size() > maxPendingMatches) {
+            pendingMatches.pop_front();
+        }
+    }
+    matchArrived.notify_all();
 }
 
-// Function to fetch a specific message by ID
-Json::Value MailTM::getMessage(const std::string& token, const std::string& messageId) {
-    std::string response = sendRequest(baseUrl + "/messages/" + messageId, "GET", "", token);
+// Function to start extracting codes and links from fetched messages
+void MailTM::enableExtraction(std::vector<ExtractionPattern> patterns) {
+    auto compiled = std::make_shared<const Extractor>(std::move(patterns)); // Compile outside the lock
+    std::lock_guard<std::mutex> lock(matchMutex);
+    extractor = std::move(compiled);
+}
 
-    Json::Value jsonResponse;
-    Json::CharReaderBuilder reader;
-    std::string errors;
+// Function to wait for a code or link to arrive for an account
+std::optional<Extraction> MailTM::waitForMatch(const std::string& account, const std::string& pattern,
+                                               std::chrono::milliseconds timeout) {
+    std::string recipient = account;
+    std::transform(recipient.begin(), recipient.end(), recipient.begin(), [](unsigned char c) { return std::tolower(c); });
+
+    std::unique_lock<std::mutex> lock(matchMutex);
+    if (!extractor) {
+        LOG_ERROR("waitForMatch called without enableExtraction");
+        return std::nullopt;
+    }
+    std::optional<Extraction> result;
+    matchArrived.wait_for(lock, timeout, [&]() {
+        for (auto it = pendingMatches.begin(); it != pendingMatches.end(); ++it) {
+            bool forAccount = recipient.empty() ||
+                              std::find(it->recipients.begin(), it->recipients.end(), recipient) != it->recipients.end();
+            if (forAccount && it->extraction.pattern == pattern) {
+                result = std::move(it->extraction);
+                pendingMatches.erase(it);
+                return true;
+            }
+        }
+        return false;
+    });
+    return result;
+}
 
-    std::istringstream stream(response);
-    if (!Json::parseFromStream(reader, stream, &jsonResponse, &errors)) { // Parse the response JSON
-        return Json::Value(); // Return an empty JSON value on error
+// Function to authenticate without blocking
+std::future<std::optional<std::string>> MailTM::authenticateAsync(const std::string& email, const std::string& password) {
+    auto promise = std::make_shared<std::promise<std::optional<std::string>>>();
+    auto future = promise->get_future();
+    authenticateAsync(email, password, [promise](std::optional<std::string> token) {
+        promise->set_value(std::move(token));
+    });
+    return future;
+}
+
+// Function to authenticate without blocking, delivering the token to a callback
+void MailTM::authenticateAsync(const std::string& email, const std::string& password,
+                               std::function<void(std::optional<std::string>)> onDone) {
+    if (auto cached = tokenCache->get(email, password)) { // Answer from the cache right away
+        onDone(cached);
+        return;
     }
 
-    return jsonResponse; // Return the full message as a JSON value
+    sendRequestAsync(baseUrl + "/token", "POST", tokenPayload(email, password), "",
+                     [this, email, password, onDone](std::string response, long) {
+        auto token = parseToken(response);
+        if (token) {
+            tokenCache->put(email, password, *token);
+        }
+        onDone(token);
+    });
+}
+
+// Function to fetch the inbox without blocking
+std::future<std::vector<MessageSummary>> MailTM::checkInboxAsync(const std::string& token) {
+    auto promise = std::make_shared<std::promise<std::vector<MessageSummary>>>();
+    auto future = promise->get_future();
+    sendRequestAsync(baseUrl + "/messages", "GET", "", token, [this, promise](std::string response, long) {
+        promise->set_value(parseInbox(response));
+    });
+    return future;
+}
+
+// Function to fetch the inbox without blocking, reporting the HTTP status to a callback
+void MailTM::checkInboxAsync(const std::string& token, std::function<void(std::vector<MessageSummary>, long)> onDone) {
+    sendRequestAsync(baseUrl + "/messages", "GET", "", token, [this, onDone](std::string response, long status) {
+        onDone(parseInbox(response), status);
+    });
+}
+
+// Function to fetch the messages newer than the cursor without blocking
+void MailTM::syncInboxAsync(const std::string& token, const InboxCursor& cursor,
+                            std::function<void(std::vector<MessageSummary>, InboxCursor, long)> onDone) {
+    syncPageAsync(token, syncStartUrl(cursor), std::make_shared<InboxSync>(cursor), maxSyncPages - 1, std::move(onDone));
+}
+
+// Function to fetch one page of an incremental sync and chain the next one
+void MailTM::syncPageAsync(const std::string& token, const std::string& url, std::shared_ptr<InboxSync> sync,
+                           int pagesLeft, std::function<void(std::vector<MessageSummary>, InboxCursor, long)> onDone) {
+    sendRequestAsync(url, "GET", "", token, [this, token, sync, pagesLeft, onDone](std::string response, long status) {
+        if (status < 200 || status >= 300) {
+            sync->abort(); // Keep the cursor so the next sync picks up from the same place
+            onDone({}, sync->getCursor(), status);
+            return;
+        }
+        std::string next = sync->addPage(response);
+        if (!next.empty() && pagesLeft > 0) {
+            syncPageAsync(token, resolveLink(next), sync, pagesLeft - 1, onDone);
+            return;
+        }
+        if (!next.empty()) {
+            sync->stop(next); // Page limit hit before the watermark, the next sync continues here
+        }
+        InboxCursor cursor = sync->getCursor();
+        onDone(sync->hasFailed() ? std::vector<MessageSummary>() : sync->takeMessages(), std::move(cursor), status);
+    });
+}
+
+// Function to fetch the account ID without blocking
+std::future<std::optional<std::string>> MailTM::getAccountIdAsync(const std::string& token) {
+    auto promise = std::make_shared<std::promise<std::optional<std::string>>>();
+    auto future = promise->get_future();
+    sendRequestAsync(baseUrl + "/me", "GET", "", token, [promise](std::string response, long) {
+        promise->set_value(parseAccountId(response));
+    });
+    return future;
+}
+
+// Function to fetch a specific message without blocking
+std::future<std::optional<Message>> MailTM::getMessageAsync(const std::string& token, const std::string& messageId) {
+    auto promise = std::make_shared<std::promise<std::optional<Message>>>();
+    auto future = promise->get_future();
+    sendRequestAsync(baseUrl + "/messages/" + messageId, "GET", "", token, [this, promise](std::string response, long) {
+        promise->set_value(parseMessage(response));
+    });
+    return future;
+}
+
+// Function to fetch a specific message without blocking, delivering it to a callback
+void MailTM::getMessageAsync(const std::string& token, const std::string& messageId,
+                             std::function<void(std::optional<Message>)> onDone) {
+    sendRequestAsync(baseUrl + "/messages/" + messageId, "GET", "", token, [this, onDone](std::string response, long) {
+        onDone(parseMessage(response));
+    });
+}
+
+// Function to fetch a batch of messages with a bounded number of requests in flight
+std::vector<std::optional<Message>> MailTM::getMessages(const std::string& token,
+                                                        const std::vector<std::string>& messageIds,
+                                                        size_t maxConcurrency) {
+    if (getMulti().isLoopThread()) { // The results arrive on this very thread, so waiting for them never ends
+        throw std::logic_error("getMessages called from an async callback; use getMessageAsync there");
+    }
+    std::vector<std::optional<Message>> results(messageIds.size());
+    if (maxConcurrency == 0) {
+        maxConcurrency = 1;
+    }
+
+    std::mutex batchMutex;
+    std::condition_variable slotFreed;
+    size_t inFlight = 0;
+
+    for (size_t i = 0; i < messageIds.size(); ++i) {
+        {
+            // Wait for a free slot before starting the next request
+            std::unique_lock<std::mutex> lock(batchMutex);
+            slotFreed.wait(lock, [&]() { return inFlight < maxConcurrency; });
+            inFlight++;
+        }
+
+        sendRequestAsync(baseUrl + "/messages/" + messageIds[i], "GET", "", token,
+                         [&, i](std::string response, long) {
+            std::optional<Message> message = parseMessage(response); // Parse outside the lock
+            std::lock_guard<std::mutex> lock(batchMutex);
+            results[i] = std::move(message); // Store by index so the order matches messageIds
+            inFlight--;
+            slotFreed.notify_all();
+        });
+    }
+
+    // Wait for the last requests to finish before returning the batch
+    std::unique_lock<std::mutex> lock(batchMutex);
+    slotFreed.wait(lock, [&]() { return inFlight == 0; });
+    return results;
+}
+
+// Function to point push streaming at a different Mercure hub
+void MailTM::setMercureUrl(const std::string& url) {
+    mercureUrl = url;
+}
+
+// Function to receive push updates for an account until stopped
+bool MailTM::streamInbox(const std::string& token, const std::string& accountId,
+                         const std::function<void(const Json::Value&)>& onUpdate, const std::atomic<bool>& running) {
+    return streamUpdates([&token](bool rejected) -> std::optional<std::string> {
+        if (rejected) {
+            return std::nullopt; // A fixed token will not be accepted on the next try either
+        }
+        return token;
+    }, accountId, onUpdate, running);
+}
+
+// Function to subscribe to push updates with the cached token of an account, logging in again when it is rejected
+bool MailTM::streamInbox(const std::string& email, const std::string& password, const std::string& accountId,
+                         const std::function<void(const Json::Value&)>& onUpdate, const std::atomic<bool>& running) {
+    return streamUpdates([&](bool rejected) {
+        if (rejected) {
+            invalidateToken(email);
+        }
+        return authenticate(email, password); // A cache hit unless the token was just dropped
+    }, accountId, onUpdate, running);
+}
+
+// Function to stream push updates, reconnecting with a fresh token from tokenFor each time
+bool MailTM::streamUpdates(const std::function<std::optional<std::string>(bool)>& tokenFor, const std::string& accountId,
+                           const std::function<void(const Json::Value&)>& onUpdate, const std::atomic<bool>& running) {
+    SseParser parser([&](const SseEvent& event) {
+        Json::Value update;
+        if (JsonParser::local().parse(event.data, update)) { // Parse the pushed JSON
+            onUpdate(update);
+        }
+    });
+    StreamContext context{&parser, &running};
+    std::string url = mercureUrl + "?topic=/accounts/" + accountId;
+
+    bool rejected = false; // Whether the hub turned down the last token
+    while (running) {
+        std::optional<std::string> token = tokenFor(rejected);
+        if (!token) {
+            return false;
+        }
+        CURLcode res;
+        parser.reset(); // A dropped connection may have left half an event behind
+        try {
+            CurlWrapper curl; // Dedicated handle, the connection stays open for the whole stream
+            curl.setOption(CURLOPT_URL, url.c_str());
+            curl.setOption(CURLOPT_WRITEFUNCTION, StreamWriteCallback);
+            curl.setOption(CURLOPT_WRITEDATA, &context);
+            curl.setOption(CURLOPT_XFERINFOFUNCTION, StreamProgressCallback);
+            curl.setOption(CURLOPT_XFERINFODATA, &context);
+            curl.setOption(CURLOPT_NOPROGRESS, 0L);
+            curl.setOption(CURLOPT_FAILONERROR, 1L); // Treat 4xx/5xx from the hub as errors
+            curl.addHeader("Accept: text/event-stream");
+            curl.addHeader("Authorization: Bearer " + *token);
+            if (!parser.getLastEventId().empty()) { // Resume where the dropped stream stopped
+                curl.addHeader("Last-Event-ID: " + parser.getLastEventId());
+            }
+
+            res = curl.perform();
+            long status = curl.getResponseCode();
+            if (res == CURLE_HTTP_RETURNED_ERROR && status >= 400 && status < 500) {
+                LOG_WARN("Mercure subscription rejected with HTTP ", status);
+                if (rejected || status != 401) {
+                    return false; // A new token was turned down too, or the topic is wrong; reconnecting will not help
+                }
+                rejected = true; // Most likely expired, retry right away with a new one
+                continue;
+            }
+            rejected = false;
+        } catch (const std::exception& e) {
+            LOG_ERROR("Error in streamInbox: ", e.what());
+            res = CURLE_FAILED_INIT;
+        }
+
+        if (!running) {
+            break;
+        }
+        if (res != CURLE_OK) {
+            LOG_WARN("Mercure stream dropped: ", curl_easy_strerror(res));
+        }
+
+        // Wait before reconnecting, as long as the server asked for (default 3 seconds)
+        long retryMs = parser.getRetryMs() >= 0 ? parser.getRetryMs() : 3000;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(retryMs);
+        while (running && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+    }
+    return true;
 }
@@ -0,0 +1,148 @@
+#include "Message.h"
+
+using namespace MailTMAPI;
+
+namespace {
+
+// Function to read a string field without creating a temporary Json::Value for missing keys
+std::string stringField(const Json::Value& json, const char* key) {
+    const Json::Value* value = json.find(key, key + std::char_traits<char>::length(key));
+    return value && value->isString() ? value->asString() : std::string();
+}
+
+// Function to read a non-negative integer field
+size_t sizeField(const Json::Value& json, const char* key) {
+    const Json::Value* value = json.find(key, key + std::char_traits<char>::length(key));
+    return value && value->isNumeric() && value->asLargestInt() > 0 ? static_cast<size_t>(value->asLargestUInt()) : 0;
+}
+
+// Function to read a boolean field
+bool boolField(const Json::Value& json, const char* key) {
+    const Json::Value* value = json.find(key, key + std::char_traits<char>::length(key));
+    return value && value->isBool() && value->asBool();
+}
+
+} // namespace
+
+// Function to read an address object
+Address Address::fromJson(const Json::Value& json) {
+    Address result;
+    if (json.isObject()) {
+        result.address = InternedString(stringField(json, "address"));
+        result.name = InternedString(stringField(json, "name"));
+    }
+    return result;
+}
+
+// Method to write an address object
+Json::Value Address::toJson() const {
+    Json::Value json(Json::objectValue);
+    json["address"] = address.str();
+    json["name"] = name.str();
+    return json;
+}
+
+// Function to read attachment metadata
+Attachment Attachment::fromJson(const Json::Value& json) {
+    Attachment result;
+    if (json.isObject()) {
+        result.id = stringField(json, "id");
+        result.filename = stringField(json, "filename");
+        result.contentType = stringField(json, "contentType");
+        result.size = sizeField(json, "size");
+        result.downloadUrl = stringField(json, "downloadUrl");
+    }
+    return result;
+}
+
+// Method to write attachment metadata
+Json::Value Attachment::toJson() const {
+    Json::Value json(Json::objectValue);
+    json["id"] = id;
+    json["filename"] = filename;
+    json["contentType"] = contentType;
+    json["size"] = static_cast<Json::UInt64>(size);
+    json["downloadUrl"] = downloadUrl;
+    return json;
+}
+
+// Function to read the fields shared by listed and full messages
+MessageSummary MessageSummary::fromJson(const Json::Value& json) {
+    MessageSummary result;
+    if (!json.isObject()) {
+        return result;
+    }
+    result.id = stringField(json, "id");
+    result.from = Address::fromJson(json["from"]);
+    result.subject = stringField(json, "subject");
+    result.intro = stringField(json, "intro");
+    result.createdAt = stringField(json, "createdAt");
+    result.seen = boolField(json, "seen");
+    result.hasAttachments = boolField(json, "hasAttachments");
+    result.size = sizeField(json, "size");
+    return result;
+}
+
+// Method to write the fields shared by listed and full messages
+Json::Value MessageSummary::toJson() const {
+    Json::Value json(Json::objectValue);
+    json["id"] = id;
+    json["from"] = from.toJson();
+    json["subject"] = subject;
+    json["intro"] = intro;
+    json["createdAt"] = createdAt;
+    json["seen"] = seen;
+    json["hasAttachments"] = hasAttachments;
+    json["size"] = static_cast<Json::UInt64>(size);
+    return json;
+}
+
+// Function to read a full message
+Message Message::fromJson(const Json::Value& json) {
+    Message result;
+    static_cast<MessageSummary&>(result) = MessageSummary::fromJson(json);
+    if (!json.isObject()) {
+        return result;
+    }
+
+    for (const auto& recipient : json["to"]) {
+        result.to.push_back(Address::fromJson(recipient));
+    }
+    result.text = stringField(json, "text");
+
+    // mail.tm returns HTML as an array of parts
+    const Json::Value& html = json["html"];
+    if (html.isArray()) {
+        for (const auto& part : html) {
+            if (part.isString()) {
+                result.html += part.asString();
+            }
+        }
+    } else if (html.isString()) {
+        result.html = html.asString();
+    }
+
+    for (const auto& attachment : json["attachments"]) {
+        result.attachments.push_back(Attachment::fromJson(attachment));
+    }
+    return result;
+}
+
+// Method to write a full message
+Json::Value Message::toJson() const {
+    Json::Value json = MessageSummary::toJson();
+    json["to"] = Json::Value(Json::arrayValue);
+    for (const auto& recipient : to) {
+        json["to"].append(recipient.toJson());
+    }
+    json["text"] = text;
+    json["html"] = Json::Value(Json::arrayValue);
+    if (!html.empty()) {
+        json["html"].append(html);
+    }
+    json["attachments"] = Json::Value(Json::arrayValue);
+    for (const auto& attachment : attachments) {
+        json["attachments"].append(attachment.toJson());
+    }
+    return json;
+}
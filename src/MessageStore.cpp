@@ -0,0 +1,441 @@
+#include "MessageStore.h"
+#include "JsonParser.h"
+#include "Logger.h"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <string_view>
+#include <unordered_set>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace MailTMAPI;
+
+namespace {
+
+const uint32_t recordMagic = 0x314D544D; // "MTM1"
+const size_t recordHeaderSize = 12; // Magic, length and CRC, each 32 bits
+const uint32_t maxRecordLength = 64 * 1024 * 1024; // Anything longer is a damaged header
+
+// Function to compute the CRC-32 (IEEE) of a buffer
+uint32_t crc32(const char* data, size_t size) {
+    static const std::array<uint32_t, 256> table = []() {
+        std::array<uint32_t, 256> result{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            result[i] = c;
+        }
+        return result;
+    }();
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ static_cast<unsigned char>(data[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+// Function to read exactly size bytes at offset
+bool readAt(int fd, void* buffer, size_t size, uint64_t offset) {
+    char* out = static_cast<char*>(buffer);
+    while (size > 0) {
+        ssize_t n = ::pread(fd, out, size, static_cast<off_t>(offset));
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        out += n;
+        size -= n;
+        offset += n;
+    }
+    return true;
+}
+
+// Function to write exactly size bytes at offset
+bool writeAt(int fd, const void* buffer, size_t size, uint64_t offset) {
+    const char* in = static_cast<const char*>(buffer);
+    while (size > 0) {
+        ssize_t n = ::pwrite(fd, in, size, static_cast<off_t>(offset));
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        in += n;
+        size -= n;
+        offset += n;
+    }
+    return true;
+}
+
+// Function to copy a string into a fixed NUL-padded field; fails if it does not fit, or is empty unless allowed
+bool setField(char (&field)[40], const std::string& value, bool allowEmpty = false) {
+    if ((value.empty() && !allowEmpty) || value.size() >= sizeof(field)) {
+        return false;
+    }
+    std::memset(field, 0, sizeof(field));
+    std::memcpy(field, value.data(), value.size());
+    return true;
+}
+
+// Function to read a fixed NUL-padded field
+std::string_view getField(const char (&field)[40]) {
+    return std::string_view(field, strnlen(field, sizeof(field)));
+}
+
+// Function to hash an ID for the position table
+uint64_t hashId(std::string_view id) {
+    return std::hash<std::string_view>()(id);
+}
+
+// Function to turn an address into a directory name
+std::string accountDirectoryName(const std::string& address) {
+    std::string name = address;
+    for (char& c : name) {
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '@' && c != '.' && c != '_' && c != '-') {
+            c = '_';
+        }
+    }
+    return name.empty() || name[0] == '.' ? "_" + name : name;
+}
+
+// Function to open a store file and sync its directory if the file is new
+int openFile(const std::filesystem::path& path) {
+    bool existed = std::filesystem::exists(path);
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (fd >= 0 && !existed) { // Make the new directory entry itself durable
+        int dirFd = ::open(path.parent_path().c_str(), O_RDONLY | O_CLOEXEC);
+        if (dirFd >= 0) {
+            ::fsync(dirFd);
+            ::close(dirFd);
+        }
+    }
+    return fd;
+}
+
+} // namespace
+
+static_assert(sizeof(MessageStore::IndexEntry) == 96, "index entries are written to disk as is");
+
+// Constructor for MessageStore
+MessageStore::MessageStore() : logFd(-1), indexFd(-1), entries(nullptr), count(0), logSize(0) {}
+
+// Destructor for MessageStore
+MessageStore::~MessageStore() {
+    close();
+}
+
+// Method to release the mapping and the files
+void MessageStore::close() {
+    if (entries) {
+        ::munmap(const_cast<IndexEntry*>(entries), count * sizeof(IndexEntry));
+        entries = nullptr;
+    }
+    if (logFd >= 0) {
+        ::close(logFd); // Also releases the lock
+        logFd = -1;
+    }
+    if (indexFd >= 0) {
+        ::close(indexFd);
+        indexFd = -1;
+    }
+    count = 0;
+    logSize = 0;
+    positions.clear();
+}
+
+// Method to open the store of an account
+bool MessageStore::open(const std::string& root, const std::string& address) {
+    std::lock_guard<std::mutex> lock(mutex);
+    close();
+
+    std::filesystem::path path = std::filesystem::path(root) / accountDirectoryName(address);
+    std::error_code error;
+    std::filesystem::create_directories(path, error);
+    if (error) {
+        LOG_ERROR("Failed to create message store ", path.string(), ": ", error.message());
+        return false;
+    }
+    directory = path.string();
+
+    logFd = openFile(path / "messages.log");
+    indexFd = openFile(path / "messages.idx");
+    if (logFd < 0 || indexFd < 0) {
+        LOG_ERROR("Failed to open message store ", directory, ": ", std::strerror(errno));
+        close();
+        return false;
+    }
+    if (::flock(logFd, LOCK_EX | LOCK_NB) != 0) {
+        LOG_ERROR("Message store ", directory, " is in use by another process");
+        close();
+        return false;
+    }
+
+    if (!recover()) {
+        close();
+        return false;
+    }
+    positions.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        positions.emplace(hashId(getField(entries[i].id)), i);
+    }
+    return true;
+}
+
+// Method to map the index file as it is on disk
+bool MessageStore::remap() {
+    if (entries) {
+        ::munmap(const_cast<IndexEntry*>(entries), count * sizeof(IndexEntry));
+        entries = nullptr;
+    }
+    struct stat info;
+    if (::fstat(indexFd, &info) != 0) {
+        return false;
+    }
+    count = static_cast<size_t>(info.st_size) / sizeof(IndexEntry);
+    if (count == 0) {
+        return true;
+    }
+    void* mapped = ::mmap(nullptr, count * sizeof(IndexEntry), PROT_READ, MAP_SHARED, indexFd, 0);
+    if (mapped == MAP_FAILED) {
+        LOG_ERROR("Failed to map message index: ", std::strerror(errno));
+        count = 0;
+        return false;
+    }
+    entries = static_cast<const IndexEntry*>(mapped);
+    return true;
+}
+
+// Method to bring the log and the index back in line after an interrupted append
+bool MessageStore::recover() {
+    struct stat indexInfo, logInfo;
+    if (::fstat(indexFd, &indexInfo) != 0 || ::fstat(logFd, &logInfo) != 0) {
+        return false;
+    }
+    uint64_t rawLogSize = static_cast<uint64_t>(logInfo.st_size);
+
+    // A torn index entry at the end is dropped; the record it belonged to is re-indexed below
+    if (indexInfo.st_size % sizeof(IndexEntry) != 0) {
+        ::ftruncate(indexFd, indexInfo.st_size - indexInfo.st_size % sizeof(IndexEntry));
+    }
+    if (!remap()) {
+        return false;
+    }
+
+    // Entries whose record did not reach the log are dropped too
+    size_t valid = count;
+    while (valid > 0 && entries[valid - 1].offset + recordHeaderSize + entries[valid - 1].length > rawLogSize) {
+        valid--;
+    }
+    if (valid < count) {
+        LOG_WARN("Message store: dropping ", count - valid, " index entries past the end of the log");
+        ::ftruncate(indexFd, valid * sizeof(IndexEntry));
+        ::fsync(indexFd);
+        if (!remap()) {
+            return false;
+        }
+    }
+
+    // Re-index complete records written after the last index entry
+    logSize = count > 0 ? entries[count - 1].offset + recordHeaderSize + entries[count - 1].length : 0;
+    std::vector<IndexEntry> recovered;
+    std::string payload;
+    while (logSize + recordHeaderSize <= rawLogSize) {
+        uint32_t header[3];
+        if (!readAt(logFd, header, sizeof(header), logSize) || header[0] != recordMagic ||
+            header[1] > maxRecordLength || logSize + recordHeaderSize + header[1] > rawLogSize) {
+            break;
+        }
+        payload.resize(header[1]);
+        if (!readAt(logFd, payload.data(), payload.size(), logSize + recordHeaderSize) ||
+            crc32(payload.data(), payload.size()) != header[2]) {
+            break;
+        }
+        Json::Value json;
+        IndexEntry entry{};
+        if (!JsonParser::local().parse(payload, json) || !json.isObject() ||
+            !setField(entry.id, json["id"].asString()) || !setField(entry.createdAt, json["createdAt"].asString(), true)) {
+            break;
+        }
+        entry.offset = logSize;
+        entry.length = header[1];
+        entry.crc = header[2];
+        recovered.push_back(entry);
+        logSize += recordHeaderSize + header[1];
+    }
+
+    // Whatever follows is a torn record from an append that never completed
+    if (logSize < rawLogSize) {
+        LOG_WARN("Message store: discarding ", rawLogSize - logSize, " bytes of incomplete records");
+        ::ftruncate(logFd, static_cast<off_t>(logSize));
+        ::fsync(logFd);
+    }
+    if (!recovered.empty()) {
+        LOG_WARN("Message store: re-indexed ", recovered.size(), " messages");
+        if (!writeAt(indexFd, recovered.data(), recovered.size() * sizeof(IndexEntry), count * sizeof(IndexEntry)) ||
+            ::fsync(indexFd) != 0) {
+            LOG_ERROR("Failed to write message index: ", std::strerror(errno));
+            return false;
+        }
+        return remap();
+    }
+    return true;
+}
+
+// Method to find the index entry of an ID
+std::optional<size_t> MessageStore::find(const std::string& id) const {
+    auto range = positions.equal_range(hashId(id));
+    for (auto it = range.first; it != range.second; ++it) {
+        if (getField(entries[it->second].id) == id) {
+            return it->second;
+        }
+    }
+    return std::nullopt;
+}
+
+// Method to read and verify the record of an entry
+std::optional<Message> MessageStore::read(const IndexEntry& entry) const {
+    std::string record(recordHeaderSize + entry.length, '\0');
+    if (!readAt(logFd, record.data(), record.size(), entry.offset)) {
+        return std::nullopt;
+    }
+    uint32_t header[3];
+    std::memcpy(header, record.data(), sizeof(header));
+    std::string_view payload(record.data() + recordHeaderSize, entry.length);
+    if (header[0] != recordMagic || header[1] != entry.length || header[2] != entry.crc ||
+        crc32(payload.data(), payload.size()) != entry.crc) {
+        LOG_WARN("Message store: damaged record for ", getField(entry.id));
+        return std::nullopt;
+    }
+    Json::Value json;
+    if (!JsonParser::local().parse(payload, json)) {
+        return std::nullopt;
+    }
+    return Message::fromJson(json);
+}
+
+// Method to get the number of stored messages
+size_t MessageStore::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return count;
+}
+
+// Method to check whether a message is stored
+bool MessageStore::contains(const std::string& id) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return find(id).has_value();
+}
+
+// Method to read one stored message
+std::optional<Message> MessageStore::get(const std::string& id) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto position = find(id);
+    if (!position) {
+        return std::nullopt;
+    }
+    return read(entries[*position]);
+}
+
+// Method to read the newest messages in the order they were stored
+std::vector<Message> MessageStore::latest(size_t limit) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<Message> result;
+    for (size_t i = count; i > 0 && result.size() < limit; --i) {
+        if (auto message = read(entries[i - 1])) {
+            result.push_back(std::move(*message));
+        }
+    }
+    return result;
+}
+
+// Method to append messages: records first, then the index entries that make them visible
+size_t MessageStore::append(const std::vector<Message>& messages) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (logFd < 0) {
+        return 0;
+    }
+
+    Json::StreamWriterBuilder writer;
+    writer["indentation"] = "";
+    std::string buffer;
+    std::vector<IndexEntry> added;
+    std::unordered_set<std::string> batchIds; // Duplicates within the batch are stored once
+    for (const auto& message : messages) {
+        IndexEntry entry{};
+        if (find(message.id) || !batchIds.insert(message.id).second) {
+            continue;
+        }
+        if (!setField(entry.id, message.id) || !setField(entry.createdAt, message.createdAt, true)) {
+            LOG_WARN("Not storing message '", message.id, "': ID or createdAt does not fit the index");
+            continue;
+        }
+        std::string payload = Json::writeString(writer, message.toJson());
+        entry.offset = logSize + buffer.size();
+        entry.length = static_cast<uint32_t>(payload.size());
+        entry.crc = crc32(payload.data(), payload.size());
+
+        uint32_t header[3] = {recordMagic, entry.length, entry.crc};
+        buffer.append(reinterpret_cast<const char*>(header), sizeof(header));
+        buffer += payload;
+        added.push_back(entry);
+    }
+    if (added.empty()) {
+        return 0;
+    }
+
+    // The index never points at a record that is not on disk yet
+    if (!writeAt(logFd, buffer.data(), buffer.size(), logSize) || ::fsync(logFd) != 0 ||
+        !writeAt(indexFd, added.data(), added.size() * sizeof(IndexEntry), count * sizeof(IndexEntry)) ||
+        ::fsync(indexFd) != 0) {
+        LOG_ERROR("Failed to append to message store: ", std::strerror(errno));
+        ::ftruncate(indexFd, count * sizeof(IndexEntry)); // Roll back what was written
+        ::ftruncate(logFd, static_cast<off_t>(logSize));
+        return 0;
+    }
+    logSize += buffer.size();
+
+    size_t first = count;
+    if (!remap()) { // The batch is durable and the next open() indexes it, but this handle cannot read the index
+        LOG_ERROR("Closing message store, its index could not be mapped after storing ", added.size(), " messages");
+        close();
+        return added.size();
+    }
+    for (size_t i = first; i < count; ++i) {
+        positions.emplace(hashId(getField(entries[i].id)), i);
+    }
+    return added.size();
+}
+
+// Method to build the sync watermark from the newest stored createdAt
+InboxCursor MessageStore::cursor() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    InboxCursor result;
+    std::string_view newest;
+    for (size_t i = 0; i < count; ++i) {
+        std::string_view createdAt = getField(entries[i].createdAt);
+        if (createdAt.empty()) { // Stored without a timestamp, so it cannot mark a position in the inbox
+            continue;
+        }
+        if (createdAt > newest) { // ISO 8601 times in the same zone sort as strings
+            newest = createdAt;
+            result.ids.clear();
+        }
+        if (createdAt == newest) {
+            result.ids.emplace_back(getField(entries[i].id));
+        }
+    }
+    result.createdAt = std::string(newest);
+    std::sort(result.ids.begin(), result.ids.end());
+    return result;
+}
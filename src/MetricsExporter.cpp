@@ -0,0 +1,327 @@
+#include "MetricsExporter.h"
+#include "Logger.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <optional>
+
+using namespace MailTMAPI;
+
+namespace {
+
+// Bucket bounds reported for every histogram, in seconds; they span fast requests to slow mail delivery
+const double bucketBounds[] = {0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10, 30, 60, 300};
+
+// Function to escape a label value as the text format requires
+std::string escapeLabel(const std::string& value) {
+    std::string escaped;
+    for (char c : value) {
+        if (c == '\\' || c == '"') {
+            escaped += '\\';
+            escaped += c;
+        } else if (c == '\n') {
+            escaped += "\\n";
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+// Function to format labels as {name="value",...}, with an optional extra label at the end
+std::string formatLabels(const MetricLabels& labels, const std::string& extraName = "", const std::string& extraValue = "") {
+    if (labels.empty() && extraName.empty()) {
+        return "";
+    }
+    std::string text = "{";
+    for (const auto& [name, value] : labels) {
+        text += name + "=\"" + escapeLabel(value) + "\",";
+    }
+    if (!extraName.empty()) {
+        text += extraName + "=\"" + extraValue + "\",";
+    }
+    text.back() = '}';
+    return text;
+}
+
+// Function to format a sample value; counts are written without a fraction or exponent
+std::string formatValue(double value) {
+    char buffer[32];
+    if (value == std::floor(value) && std::fabs(value) < 1e15) {
+        std::snprintf(buffer, sizeof(buffer), "%.0f", value);
+    } else {
+        std::snprintf(buffer, sizeof(buffer), "%.9g", value);
+    }
+    return buffer;
+}
+
+// Function to parse an API timestamp such as "2024-05-01T12:00:00+00:00" or "...Z"
+std::optional<std::chrono::system_clock::time_point> parseTimestamp(const std::string& text) {
+    std::tm parts{};
+    int offsetHours = 0, offsetMinutes = 0;
+    char sign = 'Z';
+    if (std::sscanf(text.c_str(), "%4d-%2d-%2dT%2d:%2d:%2d", &parts.tm_year, &parts.tm_mon, &parts.tm_mday,
+                    &parts.tm_hour, &parts.tm_min, &parts.tm_sec) != 6) {
+        return std::nullopt;
+    }
+    size_t zone = text.find_first_of("Z+-", 19); // After the seconds and any fraction
+    if (zone != std::string::npos && text[zone] != 'Z') {
+        sign = text[zone];
+        std::sscanf(text.c_str() + zone + 1, "%2d:%2d", &offsetHours, &offsetMinutes);
+    }
+    parts.tm_year -= 1900;
+    parts.tm_mon -= 1;
+    std::time_t seconds = timegm(&parts);
+    if (sign != 'Z') { // Convert the local time of the offset to UTC
+        seconds += (sign == '+' ? -1 : 1) * (offsetHours * 3600 + offsetMinutes * 60);
+    }
+    return std::chrono::system_clock::from_time_t(seconds);
+}
+
+} // namespace
+
+// Method to start a metric family
+void MetricsWriter::family(const std::string& name, const std::string& type, const std::string& help) {
+    text += "# HELP " + name + " " + help + "\n# TYPE " + name + " " + type + "\n";
+}
+
+// Method to write one counter or gauge sample
+void MetricsWriter::sample(const std::string& name, double value, const MetricLabels& labels) {
+    text += name + formatLabels(labels) + " " + formatValue(value) + "\n";
+}
+
+// Method to write a microsecond histogram in seconds with cumulative buckets
+void MetricsWriter::histogram(const std::string& name, const HistogramSnapshot& snapshot, const MetricLabels& labels) {
+    size_t bucket = 0;
+    uint64_t cumulative = 0;
+    for (double bound : bucketBounds) {
+        uint64_t boundMicros = static_cast<uint64_t>(std::llround(bound * 1e6));
+        while (bucket < snapshot.buckets.size() && LatencyHistogram::upperBound(bucket) <= boundMicros) {
+            cumulative += snapshot.buckets[bucket++];
+        }
+        text += name + "_bucket" + formatLabels(labels, "le", formatValue(bound)) + " " + std::to_string(cumulative) + "\n";
+    }
+    text += name + "_bucket" + formatLabels(labels, "le", "+Inf") + " " + std::to_string(snapshot.count) + "\n";
+    text += name + "_sum" + formatLabels(labels) + " " + formatValue(snapshot.sumMicros / 1e6) + "\n";
+    text += name + "_count" + formatLabels(labels) + " " + std::to_string(snapshot.count) + "\n";
+}
+
+// Method to write the request counters and histograms of every endpoint
+void MetricsWriter::requestMetrics(const RequestMetrics& metrics) {
+    auto endpoints = metrics.snapshot();
+    family("mailtm_requests_total", "counter", "API requests by endpoint and HTTP status class.");
+    for (const auto& endpoint : endpoints) {
+        for (size_t statusClass = 1; statusClass < endpoint.statusClasses.size(); ++statusClass) {
+            if (endpoint.statusClasses[statusClass] > 0) {
+                sample("mailtm_requests_total", endpoint.statusClasses[statusClass],
+                       {{"endpoint", endpoint.endpoint}, {"status", std::to_string(statusClass) + "xx"}});
+            }
+        }
+    }
+    family("mailtm_transport_errors_total", "counter", "API requests that got no HTTP response.");
+    for (const auto& endpoint : endpoints) {
+        sample("mailtm_transport_errors_total", endpoint.transportErrors, {{"endpoint", endpoint.endpoint}});
+    }
+    family("mailtm_request_bytes_sent_total", "counter", "Bytes sent to the API, headers included.");
+    for (const auto& endpoint : endpoints) {
+        sample("mailtm_request_bytes_sent_total", endpoint.bytesSent, {{"endpoint", endpoint.endpoint}});
+    }
+    family("mailtm_request_bytes_received_total", "counter", "Bytes received from the API, headers included.");
+    for (const auto& endpoint : endpoints) {
+        sample("mailtm_request_bytes_received_total", endpoint.bytesReceived, {{"endpoint", endpoint.endpoint}});
+    }
+    family("mailtm_request_duration_seconds", "histogram", "Time for the whole API request.");
+    for (const auto& endpoint : endpoints) {
+        histogram("mailtm_request_duration_seconds", endpoint.total, {{"endpoint", endpoint.endpoint}});
+    }
+    family("mailtm_request_first_byte_seconds", "histogram", "Time until the first response byte of an API request.");
+    for (const auto& endpoint : endpoints) {
+        histogram("mailtm_request_first_byte_seconds", endpoint.firstByte, {{"endpoint", endpoint.endpoint}});
+    }
+    family("mailtm_response_processing_seconds", "histogram", "Time spent parsing and indexing API responses.");
+    for (const auto& endpoint : endpoints) {
+        if (endpoint.processing.count > 0) {
+            histogram("mailtm_response_processing_seconds", endpoint.processing, {{"endpoint", endpoint.endpoint}});
+        }
+    }
+}
+
+// Method to write the number of watched inboxes and the depth of the poll queue
+void MetricsWriter::pollScheduler(const PollScheduler& scheduler) {
+    PollQueueDepth depth = scheduler.getQueueDepth();
+    family("mailtm_active_accounts", "gauge", "Inboxes being watched.");
+    sample("mailtm_active_accounts", scheduler.size());
+    family("mailtm_poll_queue_depth", "gauge", "Inboxes being polled, and inboxes due but not polled yet.");
+    sample("mailtm_poll_queue_depth", depth.polling, {{"state", "polling"}});
+    sample("mailtm_poll_queue_depth", depth.overdue, {{"state", "overdue"}});
+}
+
+// Method to get the response built so far
+const std::string& MetricsWriter::str() const {
+    return text;
+}
+
+// Method to count a poll by its outcome
+void WatcherMetrics::recordPoll(PollStatus status) {
+    switch (status) {
+    case PollStatus::Ok: pollsOk.fetch_add(1, std::memory_order_relaxed); break;
+    case PollStatus::Error: pollsFailed.fetch_add(1, std::memory_order_relaxed); break;
+    case PollStatus::RateLimited: pollsRateLimited.fetch_add(1, std::memory_order_relaxed); break;
+    }
+}
+
+// Method to count a delivered message and record its lag since arrival
+void WatcherMetrics::recordMessage(const MessageSummary& message) {
+    messages.fetch_add(1, std::memory_order_relaxed);
+    if (auto created = parseTimestamp(message.createdAt)) {
+        auto lag = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now() - *created);
+        arrivalLag.record(lag.count() > 0 ? static_cast<uint64_t>(lag.count()) : 0); // Clock skew can make it negative
+    }
+}
+
+// Method to get the number of polls so far
+uint64_t WatcherMetrics::getPolls() const {
+    return pollsOk.load(std::memory_order_relaxed) + getErrors();
+}
+
+// Method to get the number of polls that failed or were rate limited
+uint64_t WatcherMetrics::getErrors() const {
+    return pollsFailed.load(std::memory_order_relaxed) + pollsRateLimited.load(std::memory_order_relaxed);
+}
+
+// Method to get the number of messages shown or written
+uint64_t WatcherMetrics::getMessages() const {
+    return messages.load(std::memory_order_relaxed);
+}
+
+// Method to write the poll, message and lag families
+void WatcherMetrics::write(MetricsWriter& writer) const {
+    writer.family("mailtm_polls_total", "counter", "Inbox polls by result.");
+    writer.sample("mailtm_polls_total", pollsOk.load(std::memory_order_relaxed), {{"result", "ok"}});
+    writer.sample("mailtm_polls_total", pollsFailed.load(std::memory_order_relaxed), {{"result", "error"}});
+    writer.sample("mailtm_polls_total", pollsRateLimited.load(std::memory_order_relaxed), {{"result", "rate_limited"}});
+    writer.family("mailtm_messages_total", "counter", "Messages shown or written.");
+    writer.sample("mailtm_messages_total", getMessages());
+    writer.family("mailtm_message_lag_seconds", "histogram", "Time from a message's arrival on the server until it was shown or written.");
+    writer.histogram("mailtm_message_lag_seconds", arrivalLag.snapshot());
+}
+
+// Constructor that leaves the exporter idle until start()
+MetricsExporter::MetricsExporter() : listenFd(-1), port(0), running(false) {}
+
+// Destructor that stops the listener thread
+MetricsExporter::~MetricsExporter() {
+    running = false;
+    if (listenFd >= 0) {
+        shutdown(listenFd, SHUT_RDWR); // Wakes the blocked accept
+        close(listenFd);
+    }
+    if (listener.joinable()) {
+        listener.join();
+    }
+}
+
+// Method to add a collector called on every scrape
+void MetricsExporter::addCollector(Collector collector) {
+    std::lock_guard<std::mutex> lock(collectorMutex);
+    collectors.push_back(std::move(collector));
+}
+
+// Method to bind 127.0.0.1 and start serving scrapes
+bool MetricsExporter::start(uint16_t requestedPort) {
+    if (running) {
+        return true;
+    }
+    listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        LOG_ERROR("Metrics exporter: failed to create socket: ", std::strerror(errno));
+        return false;
+    }
+    int reuse = 1; // Restarts should not wait for TIME_WAIT to clear
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK); // Local scrapers only
+    addr.sin_port = htons(requestedPort);
+    socklen_t len = sizeof(addr);
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(listenFd, 16) != 0 ||
+        getsockname(listenFd, reinterpret_cast<sockaddr*>(&addr), &len) != 0) {
+        LOG_ERROR("Metrics exporter: failed to listen on port ", requestedPort, ": ", std::strerror(errno));
+        close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+    port = ntohs(addr.sin_port);
+    running = true;
+    listener = std::thread(&MetricsExporter::serve, this);
+    return true;
+}
+
+// Method to get the port the exporter listens on
+uint16_t MetricsExporter::getPort() const {
+    return port;
+}
+
+// Method to build a scrape response from every collector
+std::string MetricsExporter::render() {
+    MetricsWriter writer;
+    std::lock_guard<std::mutex> lock(collectorMutex);
+    for (const auto& collector : collectors) {
+        collector(writer);
+    }
+    return writer.str();
+}
+
+// Listener loop answering one connection at a time
+void MetricsExporter::serve() {
+    while (running) {
+        int client = accept(listenFd, nullptr, nullptr);
+        if (client < 0) {
+            if (!running) {
+                return;
+            }
+            continue;
+        }
+        timeval timeout{2, 0}; // A stalled client must not block the next scrape for long
+        setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+        // Only the request line matters; read until the end of the headers
+        std::string request;
+        char buffer[1024];
+        while (request.find("\r\n\r\n") == std::string::npos && request.size() < 8192) {
+            ssize_t received = recv(client, buffer, sizeof(buffer), 0);
+            if (received <= 0) {
+                break;
+            }
+            request.append(buffer, received);
+        }
+
+        std::string status = "200 OK";
+        std::string body;
+        if (request.compare(0, 13, "GET /metrics ") == 0 || request.compare(0, 13, "GET /metrics?") == 0) {
+            body = render();
+        } else {
+            status = "404 Not Found";
+            body = "Not found; metrics are served at /metrics\n";
+        }
+        std::string response = "HTTP/1.1 " + status + "\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8\r\n" +
+                               "Content-Length: " + std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+        for (size_t sent = 0; sent < response.size();) {
+            ssize_t written = send(client, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+            if (written <= 0) {
+                break;
+            }
+            sent += written;
+        }
+        close(client);
+    }
+}
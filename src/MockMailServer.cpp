@@ -0,0 +1,496 @@
+#include "MockMailServer.h"
+#include "JsonParser.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <strings.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+using namespace MailTMAPI;
+
+namespace {
+
+const size_t maxBodyLength = 1 << 20; // Larger request bodies are refused; the API never needs more than a login
+
+// Function to build a JSON error body the way mail.tm does
+Json::Value errorBody(int status, const std::string& message) {
+    Json::Value body;
+    body["code"] = status;
+    body["message"] = message;
+    return body;
+}
+
+// Function to get the reason phrase of the status codes the server sends
+const char* reasonPhrase(int status) {
+    switch (status) {
+    case 200: return "OK";
+    case 201: return "Created";
+    case 204: return "No Content";
+    case 400: return "Bad Request";
+    case 401: return "Unauthorized";
+    case 404: return "Not Found";
+    case 422: return "Unprocessable Entity";
+    case 429: return "Too Many Requests";
+    default: return "Internal Server Error";
+    }
+}
+
+// Function to build a complete HTTP response
+std::string httpResponse(int status, const std::string& body, bool keepAlive) {
+    return "HTTP/1.1 " + std::to_string(status) + " " + reasonPhrase(status) +
+           "\r\nContent-Type: application/ld+json; charset=utf-8\r\nContent-Length: " + std::to_string(body.size()) +
+           (keepAlive ? "\r\n\r\n" : "\r\nConnection: close\r\n\r\n") + body;
+}
+
+// Function to send all of a response; fails if the client went away
+bool sendAll(int fd, const std::string& data) {
+    for (size_t sent = 0; sent < data.size();) {
+        ssize_t written = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (written <= 0) {
+            return false;
+        }
+        sent += written;
+    }
+    return true;
+}
+
+// Function to parse a Content-Length value; fails on anything but a plain decimal up to maxBodyLength
+bool parseContentLength(const std::string& value, size_t& length) {
+    if (value.empty() || value[0] < '0' || value[0] > '9') { // strtoul would accept a sign or spaces
+        return false;
+    }
+    char* end = nullptr;
+    errno = 0;
+    unsigned long parsed = std::strtoul(value.c_str(), &end, 10);
+    if (errno == ERANGE || *end != '\0' || parsed > maxBodyLength) {
+        return false;
+    }
+    length = parsed;
+    return true;
+}
+
+// Function to compare a header name case-insensitively
+bool isHeader(const std::string& line, const char* name) {
+    size_t length = std::strlen(name);
+    return line.size() > length && line[length] == ':' && strncasecmp(line.c_str(), name, length) == 0;
+}
+
+// Function to get a header value without the leading spaces
+std::string headerValue(const std::string& line) {
+    size_t start = line.find(':') + 1;
+    while (start < line.size() && line[start] == ' ') {
+        start++;
+    }
+    return line.substr(start);
+}
+
+// Function to format a creation time like the API, e.g. "2024-05-01T12:00:00+00:00"
+std::string formatTime(std::time_t time) {
+    std::tm utc{};
+    gmtime_r(&time, &utc);
+    char buffer[32];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S+00:00", &utc);
+    return buffer;
+}
+
+} // namespace
+
+// Constructor that binds a free loopback port and starts accepting
+MockMailServer::MockMailServer(MockServerOptions options)
+    : options(std::move(options)), listenFd(socket(AF_INET, SOCK_STREAM, 0)), port(0), running(true), requests(0),
+      nextId(1), startTime(std::time(nullptr)), rng(this->options.seed) {
+    if (listenFd < 0) {
+        throw std::runtime_error("Failed to create the mock server socket");
+    }
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(this->options.port); // 0 lets the OS pick a free port
+    int reuse = 1; // A fixed port can be bound again right after a previous run
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    socklen_t len = sizeof(addr);
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(listenFd, 1024) != 0 ||
+        getsockname(listenFd, reinterpret_cast<sockaddr*>(&addr), &len) != 0) {
+        close(listenFd);
+        throw std::runtime_error("Failed to listen on a loopback port: " + std::string(std::strerror(errno)));
+    }
+    port = ntohs(addr.sin_port);
+    acceptor = std::thread(&MockMailServer::acceptLoop, this);
+}
+
+// Destructor that hangs up on every client and joins the server threads
+MockMailServer::~MockMailServer() {
+    running = false;
+    shutdown(listenFd, SHUT_RDWR); // Wakes the accept loop
+    close(listenFd);
+    if (acceptor.joinable()) {
+        acceptor.join();
+    }
+
+    std::list<Connection> remaining;
+    {
+        std::lock_guard<std::mutex> lock(connectionMutex);
+        for (auto& connection : connections) {
+            if (connection.fd >= 0) {
+                shutdown(connection.fd, SHUT_RDWR); // Wakes the blocked recv
+            }
+        }
+        remaining.splice(remaining.end(), connections); // Nodes stay put, so the serving threads keep their reference
+    }
+    for (auto& connection : remaining) {
+        connection.thread.join();
+    }
+}
+
+// Method to get the base URL to hand to MailTM
+std::string MockMailServer::url() const {
+    return "http://127.0.0.1:" + std::to_string(port);
+}
+
+// Method to list the registered accounts
+std::vector<std::string> MockMailServer::addresses() const {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    std::vector<std::string> result;
+    result.reserve(accounts.size());
+    for (const auto& account : accounts) {
+        result.push_back(account.first);
+    }
+    return result;
+}
+
+// Method to get the number of requests answered so far
+uint64_t MockMailServer::requestCount() const {
+    return requests.load();
+}
+
+// Method to accept connections until the server stops, giving each its own thread
+void MockMailServer::acceptLoop() {
+    while (running) {
+        int client = accept(listenFd, nullptr, nullptr);
+        if (client < 0) {
+            if (!running) {
+                return;
+            }
+            continue;
+        }
+        int noDelay = 1; // Responses are small; do not wait for more to send
+        setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+        std::lock_guard<std::mutex> lock(connectionMutex);
+        // Join the threads of connections the clients already closed
+        for (auto it = connections.begin(); it != connections.end();) {
+            if (it->fd < 0) {
+                it->thread.join();
+                it = connections.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        connections.push_back(Connection{client, std::thread()});
+        Connection& connection = connections.back();
+        connection.thread = std::thread(&MockMailServer::serve, this, std::ref(connection));
+    }
+}
+
+// Method to answer the requests of one keep-alive connection
+void MockMailServer::serve(Connection& connection) {
+    int fd;
+    {
+        std::lock_guard<std::mutex> lock(connectionMutex); // The acceptor is still filling in the thread
+        fd = connection.fd;
+    }
+    std::string buffer;
+    char chunk[16384];
+    bool open = true;
+    while (open) {
+        // Read until the headers are complete
+        size_t headerEnd;
+        while ((headerEnd = buffer.find("\r\n\r\n")) == std::string::npos) {
+            ssize_t received = recv(fd, chunk, sizeof(chunk), 0);
+            if (received <= 0) {
+                open = false;
+                break;
+            }
+            buffer.append(chunk, received);
+        }
+        if (!open) {
+            break;
+        }
+
+        Request request;
+        size_t contentLength = 0;
+        bool badLength = false;
+        size_t lineStart = 0;
+        for (bool first = true; lineStart < headerEnd; first = false) {
+            size_t lineEnd = buffer.find("\r\n", lineStart);
+            std::string line = buffer.substr(lineStart, lineEnd - lineStart);
+            lineStart = lineEnd + 2;
+            if (first) { // e.g. "GET /messages?page=2 HTTP/1.1"
+                size_t space = line.find(' ');
+                request.method = line.substr(0, space);
+                request.path = line.substr(space + 1, line.rfind(' ') - space - 1);
+            } else if (isHeader(line, "Content-Length")) {
+                badLength = !parseContentLength(headerValue(line), contentLength);
+            } else if (isHeader(line, "Authorization")) {
+                request.authorization = headerValue(line);
+            } else if (isHeader(line, "Connection")) {
+                request.keepAlive = strcasecmp(headerValue(line).c_str(), "close") != 0;
+            }
+        }
+
+        if (badLength) { // Where the body ends is unknown, so answer and hang up
+            Json::StreamWriterBuilder writer;
+            writer["indentation"] = "";
+            sendAll(fd, httpResponse(400, Json::writeString(writer, errorBody(400, "Invalid Content-Length")), false));
+            requests++;
+            break;
+        }
+
+        // Read the body
+        size_t bodyStart = headerEnd + 4;
+        while (buffer.size() < bodyStart + contentLength) {
+            ssize_t received = recv(fd, chunk, sizeof(chunk), 0);
+            if (received <= 0) {
+                open = false;
+                break;
+            }
+            buffer.append(chunk, received);
+        }
+        if (!open) {
+            break;
+        }
+        request.body = buffer.substr(bodyStart, contentLength);
+        buffer.erase(0, bodyStart + contentLength); // Keep a pipelined request
+
+        open = sendAll(fd, respond(request)) && request.keepAlive;
+    }
+
+    std::lock_guard<std::mutex> lock(connectionMutex);
+    close(fd);
+    connection.fd = -1; // Lets the acceptor reap this thread
+}
+
+// Method to apply the latency and error injection, then build the HTTP response
+std::string MockMailServer::respond(const Request& request) {
+    std::chrono::microseconds delay = options.latency;
+    double draw;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        if (options.latencyJitter.count() > 0) {
+            delay += std::chrono::microseconds(rng() % (options.latencyJitter.count() + 1));
+        }
+        draw = std::uniform_real_distribution<double>(0, 1)(rng);
+    }
+    if (delay.count() > 0) {
+        std::this_thread::sleep_for(delay);
+    }
+
+    int status;
+    std::string body;
+    Json::StreamWriterBuilder writer;
+    writer["indentation"] = "";
+    if (draw < options.errorRate) {
+        status = 500;
+        body = Json::writeString(writer, errorBody(status, "Internal Server Error"));
+    } else if (draw < options.errorRate + options.rateLimitRate) {
+        status = 429;
+        body = Json::writeString(writer, errorBody(status, "Too Many Requests"));
+    } else {
+        body = handle(request, status);
+    }
+    requests++;
+
+    return httpResponse(status, body, request.keepAlive);
+}
+
+// Method to find the account a request's bearer token belongs to; the caller holds stateMutex
+const MockMailServer::Account* MockMailServer::authorize(const Request& request) const {
+    const std::string prefix = "Bearer ";
+    if (request.authorization.compare(0, prefix.size(), prefix) != 0) {
+        return nullptr;
+    }
+    auto owner = addressByToken.find(request.authorization.substr(prefix.size()));
+    if (owner == addressByToken.end()) {
+        return nullptr;
+    }
+    auto account = accounts.find(owner->second);
+    return account == accounts.end() ? nullptr : &account->second;
+}
+
+// Method to build a message for an account; the caller holds stateMutex
+Message MockMailServer::makeMessage(const Account& account, const std::string& subject, const std::string& text) {
+    uint64_t number = nextId++;
+    char id[25];
+    std::snprintf(id, sizeof(id), "%024llx", static_cast<unsigned long long>(number)); // 24 hex digits like mail.tm
+
+    Message message;
+    message.id = id;
+    message.from.address = InternedString("sender@" + options.domain);
+    message.from.name = InternedString("Sender");
+    message.subject = subject;
+    message.intro = text.substr(0, 120);
+    message.createdAt = formatTime(startTime + static_cast<std::time_t>(number)); // Later messages sort after earlier ones
+    message.size = text.size();
+    Address recipient;
+    recipient.address = InternedString(account.address);
+    message.to.push_back(recipient);
+    message.text = text;
+    message.html = "<p>" + text + "</p>";
+    return message;
+}
+
+// Method to create an account with its starting inbox; the caller holds stateMutex
+MockMailServer::Account& MockMailServer::addAccount(const std::string& address, const std::string& password) {
+    Account& account = accounts[address];
+    account.id = "account-" + std::to_string(nextId++);
+    account.address = address;
+    account.password = password;
+    for (size_t i = 0; i < options.inboxSize; ++i) {
+        account.messages.push_back(makeMessage(account, "Message " + std::to_string(i + 1),
+                                               "Your verification code is " + std::to_string(100000 + i) + "."));
+    }
+    return account;
+}
+
+// Method to deliver a new message to a registered account
+std::string MockMailServer::deliver(const std::string& address, const std::string& subject, const std::string& text) {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    auto account = accounts.find(address);
+    if (account == accounts.end()) {
+        return "";
+    }
+    account->second.messages.push_back(makeMessage(account->second, subject, text));
+    return account->second.messages.back().id;
+}
+
+// Method to route a request to its endpoint and produce the response body
+std::string MockMailServer::handle(const Request& request, int& status) {
+    Json::StreamWriterBuilder writer;
+    writer["indentation"] = "";
+    std::string path = request.path.substr(0, request.path.find('?'));
+    std::string query = request.path.find('?') == std::string::npos ? "" : request.path.substr(request.path.find('?') + 1);
+
+    std::lock_guard<std::mutex> lock(stateMutex);
+    if (request.method == "GET" && path == "/domains") {
+        Json::Value domain;
+        domain["id"] = "domain-1";
+        domain["domain"] = options.domain;
+        domain["isActive"] = true;
+        Json::Value body;
+        body["hydra:member"].append(domain);
+        body["hydra:totalItems"] = 1;
+        status = 200;
+        return Json::writeString(writer, body);
+    }
+
+    if (request.method == "POST" && (path == "/accounts" || path == "/token")) {
+        auto address = JsonParser::findString(request.body, "address");
+        auto password = JsonParser::findString(request.body, "password");
+        if (!address || !password) {
+            status = 400;
+            return Json::writeString(writer, errorBody(status, "address and password are required"));
+        }
+
+        size_t at = address->find('@');
+        bool ownDomain = at != std::string::npos && address->substr(at + 1) == options.domain;
+        if (path == "/token") {
+            auto account = accounts.find(*address);
+            if (account == accounts.end() && options.openLogin && ownDomain) {
+                account = accounts.find(addAccount(*address, *password).address);
+            }
+            if (account == accounts.end() || (!options.openLogin && account->second.password != *password)) {
+                status = 401;
+                return Json::writeString(writer, errorBody(status, "Invalid credentials."));
+            }
+            std::string token = "mock-token-" + std::to_string(nextId++);
+            addressByToken[token] = *address;
+            Json::Value body;
+            body["id"] = account->second.id;
+            body["token"] = token;
+            status = 200;
+            return Json::writeString(writer, body);
+        }
+
+        if (!ownDomain || accounts.count(*address)) {
+            status = 422;
+            return Json::writeString(writer, errorBody(status, "address: This value is already used or invalid."));
+        }
+        Account& account = addAccount(*address, *password);
+        Json::Value body;
+        body["id"] = account.id;
+        body["address"] = account.address;
+        status = 201;
+        return Json::writeString(writer, body);
+    }
+
+    const Account* account = authorize(request);
+    if (!account) {
+        status = 401;
+        return Json::writeString(writer, errorBody(status, "JWT Token not found"));
+    }
+
+    if (request.method == "GET" && path == "/me") {
+        Json::Value body;
+        body["id"] = account->id;
+        body["address"] = account->address;
+        status = 200;
+        return Json::writeString(writer, body);
+    }
+
+    if (request.method == "GET" && path == "/messages") {
+        size_t page = 1;
+        if (query.compare(0, 5, "page=") == 0) {
+            page = std::max<size_t>(1, std::strtoul(query.c_str() + 5, nullptr, 10));
+        }
+        const auto& messages = account->messages;
+        Json::Value body;
+        body["hydra:member"] = Json::Value(Json::arrayValue);
+        // Newest first, like the API
+        size_t skip = (page - 1) * options.pageSize;
+        for (size_t i = skip; i < messages.size() && i < skip + options.pageSize; ++i) {
+            body["hydra:member"].append(messages[messages.size() - 1 - i].MessageSummary::toJson());
+        }
+        body["hydra:totalItems"] = static_cast<Json::UInt64>(messages.size());
+        body["hydra:view"]["@id"] = "/messages?page=" + std::to_string(page);
+        if (skip + options.pageSize < messages.size()) {
+            body["hydra:view"]["hydra:next"] = "/messages?page=" + std::to_string(page + 1);
+        }
+        status = 200;
+        return Json::writeString(writer, body);
+    }
+
+    if (request.method == "GET" && path.compare(0, 10, "/messages/") == 0) {
+        std::string id = path.substr(10);
+        for (const auto& message : account->messages) {
+            if (message.id == id) {
+                status = 200;
+                return Json::writeString(writer, message.toJson());
+            }
+        }
+        status = 404;
+        return Json::writeString(writer, errorBody(status, "Not Found"));
+    }
+
+    if (request.method == "DELETE" && path.compare(0, 10, "/accounts/") == 0) {
+        if (path.substr(10) != account->id) {
+            status = 404;
+            return Json::writeString(writer, errorBody(status, "Not Found"));
+        }
+        std::string address = account->address;
+        for (auto it = addressByToken.begin(); it != addressByToken.end();) {
+            it = it->second == address ? addressByToken.erase(it) : std::next(it);
+        }
+        accounts.erase(address);
+        status = 204;
+        return "";
+    }
+
+    status = 404;
+    return Json::writeString(writer, errorBody(status, "Not Found"));
+}
@@ -0,0 +1,213 @@
+#include "PollScheduler.h"
+#include <algorithm>
+
+using namespace MailTMAPI;
+
+// Function to classify an HTTP status code as a poll outcome
+PollResult PollResult::fromHttpStatus(long httpStatus, size_t newMessages) {
+    PollResult result;
+    result.newMessages = newMessages;
+    if (httpStatus == 429) {
+        result.status = PollStatus::RateLimited;
+    } else if (httpStatus < 200 || httpStatus >= 300) { // Includes 0 for transport errors
+        result.status = PollStatus::Error;
+    }
+    return result;
+}
+
+// Constructor for PollScheduler
+PollScheduler::PollScheduler(PollPolicy policy)
+    : policy(policy), rng(std::random_device{}()), running(false) {}
+
+// Destructor for PollScheduler that stops the dispatcher thread
+PollScheduler::~PollScheduler() {
+    stop();
+}
+
+// Method to start the dispatcher thread
+void PollScheduler::start() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (running) {
+        return;
+    }
+    running = true;
+    dispatcher = std::thread(&PollScheduler::run, this);
+}
+
+// Method to stop the dispatcher thread
+void PollScheduler::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = false;
+    }
+    changed.notify_all();
+    if (dispatcher.joinable()) {
+        dispatcher.join();
+    }
+}
+
+// Method to add an inbox with a randomly spread first poll
+void PollScheduler::addAccount(const std::string& key, PollTask task) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Entry& entry = entries[key];
+    unsigned generation = entry.generation; // Keep counting so polls of a removed inbox stay stale
+    entry = Entry();
+    entry.generation = generation;
+    entry.task = std::move(task);
+    entry.interval = policy.initialInterval;
+
+    // Spread first polls over the whole initial interval
+    std::uniform_int_distribution<long long> spread(0, std::max<long long>(0, policy.initialInterval.count() - 1));
+    schedule(key, entry, Clock::now() + std::chrono::milliseconds(spread(rng)));
+    changed.notify_all();
+}
+
+// Method to stop watching an inbox
+void PollScheduler::removeAccount(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.erase(key); // Its heap items become stale and are skipped
+}
+
+// Method to move an inbox to the front of the queue
+void PollScheduler::pollNow(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(key);
+    if (it == entries.end()) {
+        return;
+    }
+    if (it->second.polling) { // Poll again right after the running poll reports back
+        it->second.pollRequested = true;
+        return;
+    }
+    schedule(key, it->second, Clock::now());
+    changed.notify_all();
+}
+
+// Method to read the current interval of an inbox
+std::chrono::milliseconds PollScheduler::getInterval(const std::string& key) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(key);
+    return it == entries.end() ? std::chrono::milliseconds(0) : it->second.interval;
+}
+
+// Method to count the watched inboxes
+size_t PollScheduler::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+// Method to count the inboxes being polled and those waiting past their due time
+PollQueueDepth PollScheduler::getQueueDepth() const {
+    PollQueueDepth depth;
+    auto now = Clock::now();
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& [key, entry] : entries) {
+        if (entry.polling) {
+            depth.polling++;
+        } else if (entry.due <= now) {
+            depth.overdue++;
+        }
+    }
+    return depth;
+}
+
+// Method to queue the next poll of an inbox, invalidating any earlier queued poll
+void PollScheduler::schedule(const std::string& key, Entry& entry, Clock::time_point due) {
+    entry.generation++;
+    entry.due = due;
+    heap.push(HeapItem{due, key, entry.generation});
+}
+
+// Function to adapt the interval to recent arrivals
+std::chrono::milliseconds PollScheduler::adaptInterval(const PollPolicy& policy, std::chrono::milliseconds current,
+                                                       size_t newMessages) {
+    std::chrono::milliseconds next;
+    if (newMessages > 0) { // Busy inbox: poll twice as often
+        next = current / 2;
+    } else { // Idle inbox: back off gradually
+        next = std::chrono::milliseconds(static_cast<long long>(current.count() * policy.idleGrowth));
+    }
+    return std::clamp(next, policy.minInterval, policy.maxInterval);
+}
+
+// Method to apply +/- jitter so inboxes do not drift into lockstep
+std::chrono::milliseconds PollScheduler::jittered(std::chrono::milliseconds interval) {
+    std::uniform_real_distribution<double> factor(1.0 - policy.jitter, 1.0 + policy.jitter);
+    return std::chrono::milliseconds(static_cast<long long>(interval.count() * factor(rng)));
+}
+
+// Method to compute an exponential backoff delay with full jitter
+std::chrono::milliseconds PollScheduler::backoff(const Entry& entry, PollStatus status) {
+    // Rate limiting starts from a longer base than ordinary errors
+    long long base = status == PollStatus::RateLimited ? entry.interval.count() * 2 : policy.minInterval.count();
+    unsigned shift = std::min(entry.errorStreak, 16u);
+    long long ceiling = std::min<long long>(policy.maxBackoff.count(), base << shift);
+    std::uniform_int_distribution<long long> delay(policy.minInterval.count(),
+                                                   std::max<long long>(policy.minInterval.count(), ceiling));
+    return std::chrono::milliseconds(delay(rng));
+}
+
+// Method called when a poll reports back; reschedules the inbox
+void PollScheduler::finish(const std::string& key, unsigned generation, PollResult result) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(key);
+    if (it == entries.end() || it->second.generation != generation) {
+        return; // The inbox was removed (or re-added) while the poll was running
+    }
+    Entry& entry = it->second;
+    entry.polling = false;
+
+    std::chrono::milliseconds delay;
+    if (result.status == PollStatus::Ok) {
+        entry.errorStreak = 0;
+        entry.interval = adaptInterval(policy, entry.interval, result.newMessages);
+        delay = jittered(entry.interval);
+    } else {
+        delay = backoff(entry, result.status);
+        entry.errorStreak++;
+    }
+
+    if (entry.pollRequested && result.status == PollStatus::Ok) { // A push arrived during the poll
+        delay = std::chrono::milliseconds(0);
+    }
+    entry.pollRequested = false;
+
+    schedule(key, entry, Clock::now() + delay);
+    changed.notify_all();
+}
+
+// Dispatcher loop that runs each inbox's task when it becomes due
+void PollScheduler::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (running) {
+        if (heap.empty()) {
+            changed.wait(lock);
+            continue;
+        }
+
+        HeapItem top = heap.top();
+        if (Clock::now() < top.due) { // Sleep until the earliest inbox is due or the queue changes
+            changed.wait_until(lock, top.due);
+            continue;
+        }
+        heap.pop();
+
+        auto it = entries.find(top.key);
+        if (it == entries.end() || it->second.generation != top.generation || it->second.polling) {
+            continue; // Stale item left behind by a reschedule or removal
+        }
+        Entry& entry = it->second;
+        entry.polling = true;
+        PollTask task = entry.task;
+        unsigned generation = entry.generation;
+        std::string key = top.key;
+
+        lock.unlock(); // Tasks may call pollNow or finish synchronously
+        try {
+            task([this, key, generation](PollResult result) { finish(key, generation, result); });
+        } catch (const std::exception&) {
+            finish(key, generation, PollResult{PollStatus::Error, 0}); // Back off instead of stopping the scheduler
+        }
+        lock.lock();
+    }
+}
@@ -0,0 +1,38 @@
+#include "RenderModel.h"
+#include <algorithm>
+
+using namespace MailTMAPI;
+
+// Function to prepare everything the GUI shows of a message
+RenderModel RenderModel::build(const Message& message) {
+    RenderModel model;
+    model.id = message.id;
+    if (!message.from.address.empty()) {
+        model.from = TextLayout::prepare("From: " + message.from.address.str());
+    }
+    if (!message.subject.empty()) {
+        model.subject = TextLayout::prepare("Subject: " + message.subject);
+    }
+
+    if (!message.text.empty()) {
+        model.text = TextLayout::prepare(message.text);
+    }
+    if (!message.html.empty()) { // Converted once here instead of on every layout
+        HtmlTextResult converted = HtmlText::convert(message.html);
+        model.html = TextLayout::prepare(converted.text);
+        model.links = std::move(converted.links);
+        for (const auto& link : model.links) {
+            model.linkLabels.push_back(TextLayout::prepare(link.text.empty() ? link.url : link.text));
+        }
+    }
+
+    // The preview shows the text part, else the HTML part, else the intro from the listing
+    const std::vector<LayoutWord>& body = !model.text.empty() ? model.text : model.html;
+    if (!body.empty()) {
+        size_t count = std::min(body.size(), previewWordLimit);
+        model.preview.assign(body.begin(), body.begin() + count);
+    } else {
+        model.preview = TextLayout::prepare(message.intro, previewWordLimit);
+    }
+    return model;
+}
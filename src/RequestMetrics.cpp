@@ -0,0 +1,164 @@
+#include "RequestMetrics.h"
+
+using namespace MailTMAPI;
+
+// Method to estimate a percentile from the bucket counts
+uint64_t HistogramSnapshot::percentile(double fraction) const {
+    if (count == 0) {
+        return 0;
+    }
+    uint64_t rank = static_cast<uint64_t>(fraction * count);
+    rank = rank < count ? rank + 1 : count; // 1-based rank of the value we want
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < buckets.size(); ++bucket) {
+        seen += buckets[bucket];
+        if (seen >= rank) {
+            return LatencyHistogram::upperBound(bucket);
+        }
+    }
+    return LatencyHistogram::upperBound(buckets.size() - 1); // Records raced with the copy
+}
+
+// Method to compute the mean value
+double HistogramSnapshot::mean() const {
+    return count == 0 ? 0 : static_cast<double>(sumMicros) / count;
+}
+
+// Function to find the bucket of a value: exact below subBuckets, then subBuckets per power of two
+size_t LatencyHistogram::bucketFor(uint64_t micros) {
+    if (micros < subBuckets) {
+        return static_cast<size_t>(micros);
+    }
+    int highestBit = 63 - __builtin_clzll(micros);
+    int shift = highestBit - 3; // Keep the three bits below the highest one
+    size_t bucket = static_cast<size_t>(shift + 1) * subBuckets + ((micros >> shift) & (subBuckets - 1));
+    return bucket < bucketCount ? bucket : bucketCount - 1;
+}
+
+// Function to get the largest value a bucket holds
+uint64_t LatencyHistogram::upperBound(size_t bucket) {
+    if (bucket < subBuckets) {
+        return bucket;
+    }
+    size_t shift = bucket / subBuckets - 1;
+    return ((subBuckets + bucket % subBuckets + 1) << shift) - 1;
+}
+
+// Method to record a value; relaxed ordering is enough since readers only need eventually consistent counts
+void LatencyHistogram::record(uint64_t micros) {
+    buckets[bucketFor(micros)].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    sumMicros.fetch_add(micros, std::memory_order_relaxed);
+}
+
+// Method to copy the current counts
+HistogramSnapshot LatencyHistogram::snapshot() const {
+    HistogramSnapshot result;
+    result.buckets.resize(bucketCount);
+    for (size_t bucket = 0; bucket < bucketCount; ++bucket) {
+        result.buckets[bucket] = buckets[bucket].load(std::memory_order_relaxed);
+        result.count += result.buckets[bucket]; // Consistent with the buckets even while others record
+    }
+    result.sumMicros = sumMicros.load(std::memory_order_relaxed);
+    return result;
+}
+
+// Method to record a finished request
+void RequestMetrics::record(Endpoint endpoint, const RequestTiming& timing, bool transportOk) {
+    EndpointStats& stats = endpoints[static_cast<size_t>(endpoint)];
+    stats.requests.fetch_add(1, std::memory_order_relaxed);
+    stats.bytesSent.fetch_add(timing.bytesSent, std::memory_order_relaxed);
+    stats.bytesReceived.fetch_add(timing.bytesReceived, std::memory_order_relaxed);
+    if (!transportOk || timing.status <= 0) {
+        stats.transportErrors.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        size_t statusClass = static_cast<size_t>(timing.status / 100);
+        stats.statusClasses[statusClass < stats.statusClasses.size() ? statusClass : 0].fetch_add(1, std::memory_order_relaxed);
+    }
+    stats.dns.record(timing.dnsMicros);
+    stats.connect.record(timing.connectMicros);
+    stats.tls.record(timing.tlsMicros);
+    stats.firstByte.record(timing.firstByteMicros);
+    stats.total.record(timing.totalMicros);
+}
+
+// Method to record the time spent turning a response into a result
+void RequestMetrics::recordProcessing(Endpoint endpoint, uint64_t micros) {
+    endpoints[static_cast<size_t>(endpoint)].processing.record(micros);
+}
+
+// Method to copy the statistics of every endpoint that saw traffic
+std::vector<EndpointSnapshot> RequestMetrics::snapshot() const {
+    std::vector<EndpointSnapshot> result;
+    for (size_t i = 0; i < endpoints.size(); ++i) {
+        const EndpointStats& stats = endpoints[i];
+        if (stats.requests.load(std::memory_order_relaxed) == 0) {
+            continue;
+        }
+        EndpointSnapshot snapshot;
+        snapshot.endpoint = name(static_cast<Endpoint>(i));
+        snapshot.requests = stats.requests.load(std::memory_order_relaxed);
+        snapshot.transportErrors = stats.transportErrors.load(std::memory_order_relaxed);
+        for (size_t c = 0; c < stats.statusClasses.size(); ++c) {
+            snapshot.statusClasses[c] = stats.statusClasses[c].load(std::memory_order_relaxed);
+        }
+        snapshot.bytesSent = stats.bytesSent.load(std::memory_order_relaxed);
+        snapshot.bytesReceived = stats.bytesReceived.load(std::memory_order_relaxed);
+        snapshot.dns = stats.dns.snapshot();
+        snapshot.connect = stats.connect.snapshot();
+        snapshot.tls = stats.tls.snapshot();
+        snapshot.firstByte = stats.firstByte.snapshot();
+        snapshot.total = stats.total.snapshot();
+        snapshot.processing = stats.processing.snapshot();
+        result.push_back(std::move(snapshot));
+    }
+    return result;
+}
+
+// Function to find the endpoint a request goes to from its method and path
+Endpoint RequestMetrics::classify(const std::string& method, std::string_view url) {
+    size_t scheme = url.find("://");
+    if (scheme != std::string_view::npos) { // Drop the scheme and host
+        size_t pathStart = url.find('/', scheme + 3);
+        url = pathStart == std::string_view::npos ? std::string_view() : url.substr(pathStart);
+    }
+    url = url.substr(0, url.find('?'));
+
+    auto startsWith = [&](std::string_view prefix) { return url.compare(0, prefix.size(), prefix) == 0; };
+    if (url == "/domains") {
+        return Endpoint::Domains;
+    }
+    if (url == "/accounts" && method == "POST") {
+        return Endpoint::Register;
+    }
+    if (url == "/token") {
+        return Endpoint::Token;
+    }
+    if (url == "/me") {
+        return Endpoint::Me;
+    }
+    if (url == "/messages") {
+        return Endpoint::Inbox;
+    }
+    if (startsWith("/messages/") && method == "GET") {
+        return Endpoint::Message;
+    }
+    if (startsWith("/accounts/") && method == "DELETE") {
+        return Endpoint::DeleteAccount;
+    }
+    return Endpoint::Other;
+}
+
+// Function to get the name of an endpoint
+const char* RequestMetrics::name(Endpoint endpoint) {
+    switch (endpoint) {
+    case Endpoint::Domains: return "domains";
+    case Endpoint::Register: return "register";
+    case Endpoint::Token: return "token";
+    case Endpoint::Me: return "me";
+    case Endpoint::Inbox: return "inbox";
+    case Endpoint::Message: return "message";
+    case Endpoint::DeleteAccount: return "delete_account";
+    default: return "other";
+    }
+}
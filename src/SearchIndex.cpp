@@ -0,0 +1,257 @@
+#include "SearchIndex.h"
+#include "HtmlText.h"
+#include <algorithm>
+#include <mutex>
+
+using namespace MailTMAPI;
+
+namespace {
+
+thread_local SearchIndex::LockWaitSink lockWaitSink = nullptr; // Where this thread's lock waits are reported
+
+// Function to lowercase ASCII letters in place
+void toLower(std::string& text) {
+    for (char& c : text) {
+        if (c >= 'A' && c <= 'Z') {
+            c = static_cast<char>(c - 'A' + 'a');
+        }
+    }
+}
+
+// Function to get the length of the UTF-8 sequence a lead byte starts
+size_t sequenceLength(unsigned char lead) {
+    return lead >= 0xF0 ? 4 : lead >= 0xE0 ? 3 : lead >= 0xC0 ? 2 : 1;
+}
+
+} // namespace
+
+// Method to split text into lowercased words
+void SearchIndex::tokenize(std::string_view text, const std::function<void(std::string_view)>& onWord) {
+    std::string word;
+    bool full = false; // Set once the word reached maxWordLength; the rest of it is skipped
+    for (size_t i = 0; i <= text.size(); ++i) {
+        unsigned char c = i < text.size() ? static_cast<unsigned char>(text[i]) : ' ';
+        bool isWordChar = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c >= 0x80;
+        if (!isWordChar) {
+            if (!word.empty()) {
+                onWord(word);
+                word.clear();
+            }
+            full = false;
+            continue;
+        }
+        if (full) {
+            continue;
+        }
+        if (c >= 0xC0 && word.size() + sequenceLength(c) > maxWordLength) { // Never cut a character in half
+            full = true;
+            continue;
+        }
+        word += (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : static_cast<char>(c);
+        full = word.size() >= maxWordLength;
+    }
+}
+
+// Method to parse a search box string
+SearchQuery SearchQuery::parse(std::string_view text) {
+    SearchQuery query;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        // Split on whitespace first so "from:" and '*' apply to one word of the query
+        size_t start = text.find_first_not_of(" \t\r\n", pos);
+        if (start == std::string_view::npos) {
+            break;
+        }
+        size_t end = std::min(text.find_first_of(" \t\r\n", start), text.size());
+        std::string_view part = text.substr(start, end - start);
+        pos = end;
+
+        std::string lowered(part);
+        toLower(lowered);
+        if (lowered.size() > 5 && lowered.compare(0, 5, "from:") == 0) {
+            query.sender = lowered.substr(5);
+            continue;
+        }
+
+        bool isPrefix = part.back() == '*';
+        std::vector<std::string> words;
+        SearchIndex::tokenize(isPrefix ? part.substr(0, part.size() - 1) : part, [&](std::string_view word) {
+            words.emplace_back(word);
+        });
+        for (size_t i = 0; i < words.size(); ++i) {
+            if (isPrefix && i + 1 == words.size()) { // Only the last word is open-ended, as in "example.co*"
+                query.prefixes.push_back(std::move(words[i]));
+            } else {
+                query.terms.push_back(std::move(words[i]));
+            }
+        }
+    }
+    return query;
+}
+
+// Method to check whether a query has nothing to match
+bool SearchQuery::empty() const {
+    return terms.empty() && prefixes.empty() && sender.empty();
+}
+
+// Method to add a message to the index
+void SearchIndex::add(const Message& message) {
+    // Collect the words before taking the lock, so searches only wait for the insertions
+    std::vector<std::string> messageWords;
+    auto collect = [&](std::string_view word) {
+        messageWords.emplace_back(word);
+    };
+    tokenize(message.subject, collect);
+    tokenize(message.from.address.str(), collect);
+    tokenize(message.from.name.str(), collect);
+    tokenize(message.text, collect);
+    if (!message.html.empty()) {
+        HtmlTextResult html = HtmlText::convert(message.html, false);
+        tokenize(html.text, collect);
+        for (const auto& link : html.links) {
+            tokenize(link.url, collect);
+        }
+    }
+    std::sort(messageWords.begin(), messageWords.end());
+    messageWords.erase(std::unique(messageWords.begin(), messageWords.end()), messageWords.end());
+
+    std::string sender = message.from.address.str();
+    toLower(sender);
+    size_t at = sender.rfind('@');
+
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    if (message.id.empty() || !numbers.emplace(message.id, static_cast<uint32_t>(messageIds.size())).second) {
+        return;
+    }
+    uint32_t number = static_cast<uint32_t>(messageIds.size());
+    messageIds.push_back(message.id);
+
+    // Numbers only grow, so appending keeps every list sorted
+    for (auto& word : messageWords) {
+        auto inserted = wordNumbers.try_emplace(std::move(word), static_cast<uint32_t>(postings.size()));
+        if (inserted.second) { // A new word; the view stays valid because map nodes never move
+            postings.emplace_back();
+            sortedWords.emplace(inserted.first->first, inserted.first->second);
+        }
+        postings[inserted.first->second].push_back(number);
+    }
+    if (!sender.empty()) {
+        senders[sender].push_back(number);
+        if (at != std::string::npos) {
+            senders[sender.substr(at)].push_back(number);
+        }
+    }
+}
+
+// Function to set where the calling thread's lock waits are reported
+void SearchIndex::setLockWaitSink(LockWaitSink sink) {
+    lockWaitSink = sink;
+}
+
+// Method to find the messages matching a query
+std::vector<std::string> SearchIndex::search(const SearchQuery& query, size_t limit) const {
+    std::shared_lock<std::shared_mutex> lock(mutex, std::try_to_lock);
+    if (!lock.owns_lock()) { // A fetch thread is adding
+        Clock::time_point start = lockWaitSink ? Clock::now() : Clock::time_point();
+        lock.lock();
+        if (lockWaitSink) {
+            lockWaitSink(start, Clock::now());
+        }
+    }
+    std::vector<const Postings*> lists;
+    std::vector<Postings> unions; // Postings of all words starting with a prefix
+    unions.reserve(query.prefixes.size()); // Keeps the pointers in lists valid
+
+    for (const auto& term : query.terms) {
+        auto it = wordNumbers.find(term);
+        if (it == wordNumbers.end()) {
+            return {};
+        }
+        lists.push_back(&postings[it->second]);
+    }
+    for (const auto& prefix : query.prefixes) {
+        std::vector<const Postings*> matching;
+        for (auto it = sortedWords.lower_bound(prefix); it != sortedWords.end() && it->first.substr(0, prefix.size()) == prefix; ++it) {
+            matching.push_back(&postings[it->second]);
+        }
+        if (matching.empty()) {
+            return {};
+        }
+        if (matching.size() == 1) { // Often the prefix is a whole word already
+            lists.push_back(matching[0]);
+            continue;
+        }
+        Postings merged;
+        for (const Postings* list : matching) {
+            size_t middle = merged.size();
+            merged.insert(merged.end(), list->begin(), list->end());
+            std::inplace_merge(merged.begin(), merged.begin() + middle, merged.end());
+        }
+        merged.erase(std::unique(merged.begin(), merged.end()), merged.end());
+        unions.push_back(std::move(merged));
+        lists.push_back(&unions.back());
+    }
+    if (!query.sender.empty()) {
+        auto it = senders.find(query.sender);
+        if (it == senders.end()) {
+            return {};
+        }
+        lists.push_back(&it->second);
+    }
+    if (lists.empty()) {
+        return {};
+    }
+
+    // Walk the shortest list from the newest message and look each one up in the others. Candidates only
+    // get older, so every other list is searched below where the previous lookup ended, galloping down
+    // from there: long lists of similar length are merged in near-linear time.
+    std::sort(lists.begin(), lists.end(), [](const Postings* a, const Postings* b) { return a->size() < b->size(); });
+    std::vector<size_t> ends;
+    for (const Postings* list : lists) {
+        ends.push_back(list->size());
+    }
+    std::vector<std::string> results;
+    for (auto it = lists[0]->rbegin(); it != lists[0]->rend() && results.size() < limit; ++it) {
+        uint32_t number = *it;
+        bool matches = true;
+        for (size_t i = 1; i < lists.size() && matches; ++i) {
+            const Postings& list = *lists[i];
+            size_t high = ends[i]; // Everything from high on is newer than number
+            size_t low = high;
+            for (size_t step = 1; low > 0; step *= 2) {
+                size_t probe = low > step ? low - step : 0;
+                if (list[probe] <= number) {
+                    low = probe;
+                    break;
+                }
+                high = low = probe;
+            }
+            ends[i] = std::upper_bound(list.begin() + low, list.begin() + high, number) - list.begin();
+            matches = ends[i] > 0 && list[ends[i] - 1] == number;
+            if (ends[i] == 0) { // Nothing older is left in this list, so nothing else can match
+                return results;
+            }
+        }
+        if (matches) {
+            results.push_back(messageIds[number]);
+        }
+    }
+    return results;
+}
+
+// Method to get the number of indexed messages
+size_t SearchIndex::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return messageIds.size();
+}
+
+// Method to remove every message
+void SearchIndex::clear() {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    sortedWords.clear();
+    wordNumbers.clear();
+    postings.clear();
+    senders.clear();
+    numbers.clear();
+    messageIds.clear();
+}
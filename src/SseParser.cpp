@@ -0,0 +1,120 @@
+#include "SseParser.h"
+#include <cctype>
+
+using namespace MailTMAPI;
+
+// Constructor for SseParser
+SseParser::SseParser(EventCallback onEvent)
+    : onEvent(std::move(onEvent)), hasData(false), skipLineFeed(false), retryMs(-1) {}
+
+// Method to consume a chunk, splitting it into lines terminated by \n, \r\n or \r
+void SseParser::feed(const char* chunk, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        char c = chunk[i];
+        if (skipLineFeed) { // Second half of a \r\n split across two chunks
+            skipLineFeed = false;
+            if (c == '\n') {
+                continue;
+            }
+        }
+
+        if (c == '\r' || c == '\n') {
+            processLine();
+            line.clear();
+            if (c == '\r') {
+                if (i + 1 < size) {
+                    if (chunk[i + 1] == '\n') {
+                        ++i;
+                    }
+                } else {
+                    skipLineFeed = true;
+                }
+            }
+        } else {
+            line += c;
+        }
+    }
+}
+
+// Method to interpret one complete line of the stream
+void SseParser::processLine() {
+    if (line.empty()) { // A blank line ends the current event
+        dispatch();
+        return;
+    }
+    if (line[0] == ':') { // Comment lines are used as keep-alive heartbeats
+        return;
+    }
+
+    std::string field;
+    std::string value;
+    size_t colon = line.find(':');
+    if (colon == std::string::npos) {
+        field = line;
+    } else {
+        field = line.substr(0, colon);
+        size_t start = colon + 1;
+        if (start < line.size() && line[start] == ' ') { // A single leading space is not part of the value
+            start++;
+        }
+        value = line.substr(start);
+    }
+
+    if (field == "event") {
+        eventType = value;
+    } else if (field == "data") {
+        if (hasData) {
+            data += '\n';
+        }
+        data += value;
+        hasData = true;
+    } else if (field == "id") {
+        if (value.find('\0') == std::string::npos) {
+            lastEventId = value;
+        }
+    } else if (field == "retry") {
+        bool digits = !value.empty();
+        for (char c : value) {
+            if (!std::isdigit(static_cast<unsigned char>(c))) {
+                digits = false;
+                break;
+            }
+        }
+        if (digits && value.size() < 10) { // Ignore values that would overflow
+            retryMs = std::stol(value);
+        }
+    }
+}
+
+// Method to deliver the event built so far and start a new one
+void SseParser::dispatch() {
+    if (hasData) { // Events without data are discarded
+        SseEvent event;
+        event.type = eventType.empty() ? "message" : eventType;
+        event.data = std::move(data);
+        event.id = lastEventId;
+        onEvent(event);
+    }
+    eventType.clear();
+    data.clear();
+    hasData = false;
+}
+
+// Method to drop any partial state left by a connection that went away mid-event
+void SseParser::reset() {
+    line.clear();
+    eventType.clear();
+    data.clear();
+    hasData = false;
+    skipLineFeed = false;
+}
+
+// Method to get the ID to resume from after a reconnect
+const std::string& SseParser::getLastEventId() const {
+    return lastEventId;
+}
+
+// Method to get the reconnection delay requested by the server
+long SseParser::getRetryMs() const {
+    return retryMs;
+}
@@ -0,0 +1,169 @@
+#include "TextLayout.h"
+#include <cctype>
+
+using namespace MailTMAPI;
+
+namespace {
+
+// Function to decode the next UTF-8 code point, advancing pos; invalid bytes are taken as Latin-1
+char32_t nextCodePoint(std::string_view text, size_t& pos) {
+    unsigned char lead = text[pos++];
+    if (lead < 0x80) {
+        return lead;
+    }
+    int extra = (lead & 0xE0) == 0xC0 ? 1 : (lead & 0xF0) == 0xE0 ? 2 : (lead & 0xF8) == 0xF0 ? 3 : 0;
+    if (extra == 0 || pos + extra > text.size()) {
+        return lead;
+    }
+    char32_t codePoint = lead & (0x3F >> extra);
+    for (int i = 0; i < extra; ++i) {
+        unsigned char next = text[pos + i];
+        if ((next & 0xC0) != 0x80) {
+            return lead;
+        }
+        codePoint = (codePoint << 6) | (next & 0x3F);
+    }
+    pos += extra;
+    return codePoint;
+}
+
+// Function to check whether a word continues a URL that was split at a space; plain words never do
+bool continuesUrl(const std::string& next) {
+    char firstChar = next[0];
+    return firstChar == '?' || firstChar == '&' || firstChar == '=' || firstChar == '/' || firstChar == '|' ||
+           firstChar == '-' || firstChar == '_' || firstChar == '.';
+}
+
+} // namespace
+
+// Constructor that reads the ASCII advances up front
+GlyphAdvances::GlyphAdvances(AdvanceFunction source) : source(std::move(source)) {
+    for (char32_t c = 0; c < ascii.size(); ++c) {
+        ascii[c] = this->source(c);
+    }
+}
+
+// Method to look up the advance of a code point
+float GlyphAdvances::advance(char32_t codePoint) const {
+    if (codePoint < ascii.size()) {
+        return ascii[codePoint];
+    }
+    auto it = others.find(codePoint);
+    if (it == others.end()) { // First time this glyph is seen, ask the font once
+        it = others.emplace(codePoint, source(codePoint)).first;
+    }
+    return it->second;
+}
+
+// Method to measure a UTF-8 string by summing its advances
+float GlyphAdvances::measure(std::string_view text) const {
+    float width = 0;
+    for (size_t pos = 0; pos < text.size();) {
+        width += advance(nextCodePoint(text, pos));
+    }
+    return width;
+}
+
+// Function to check whether a word is a URL
+bool TextLayout::isLink(const std::string& word) {
+    return word.compare(0, 7, "http://") == 0 || word.compare(0, 8, "https://") == 0;
+}
+
+// Function to split text into words, rejoining URLs that were broken at a space
+std::vector<std::string> TextLayout::splitWords(const std::string& text) {
+    std::vector<std::string> words;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) {
+            ++pos;
+        }
+        size_t start = pos;
+        while (pos < text.size() && !std::isspace(static_cast<unsigned char>(text[pos]))) {
+            ++pos;
+        }
+        if (pos == start) {
+            break;
+        }
+
+        std::string word = text.substr(start, pos - start);
+        if (!words.empty() && isLink(words.back()) && continuesUrl(word)) {
+            words.back() += word;
+        } else {
+            words.push_back(std::move(word));
+        }
+    }
+    return words;
+}
+
+// Function to split text into words and mark the links
+std::vector<LayoutWord> TextLayout::prepare(const std::string& text, size_t maxWords) {
+    std::vector<std::string> split = splitWords(text);
+    if (maxWords > 0 && split.size() > maxWords) {
+        split.resize(maxWords);
+    }
+    std::vector<LayoutWord> words;
+    words.reserve(split.size());
+    for (auto& word : split) {
+        bool link = isLink(word);
+        words.push_back(LayoutWord{std::move(word), link});
+    }
+    return words;
+}
+
+// Function to wrap text into runs
+LayoutResult TextLayout::layout(const std::string& text, const GlyphAdvances& advances, const LayoutOptions& options) {
+    return layout(prepare(text), advances, options);
+}
+
+// Function to wrap prepared words into runs, measuring every word exactly once
+LayoutResult TextLayout::layout(const std::vector<LayoutWord>& words, const GlyphAdvances& advances,
+                                const LayoutOptions& options) {
+    LayoutResult result;
+    const float spaceWidth = advances.advance(' ');
+    size_t lines = 1;
+    float lineY = 0;
+    float lineWidth = 0;
+    bool lineHasWords = false;
+
+    for (const auto& [word, link] : words) {
+        float width = advances.measure(word);
+
+        // Wrap before a word that does not fit; a word wider than a line gets a line of its own
+        if (lineHasWords && lineWidth + spaceWidth + width > options.maxWidth) {
+            if (options.maxLines > 0 && lines == options.maxLines) {
+                result.truncated = true;
+                break;
+            }
+            lines++;
+            lineY += options.lineHeight;
+            lineWidth = 0;
+            lineHasWords = false;
+        }
+
+        float x = lineHasWords ? lineWidth + spaceWidth : 0;
+        bool extendsRun = lineHasWords && !link && !result.runs.empty() && !result.runs.back().isLink;
+        if (extendsRun) { // Consecutive plain words share a run so they are drawn together
+            LayoutRun& run = result.runs.back();
+            run.text += ' ';
+            run.text += word;
+            run.width = x + width - run.x;
+        } else {
+            result.runs.push_back(LayoutRun{word, x, lineY, width, link});
+        }
+        lineWidth = x + width;
+        lineHasWords = true;
+    }
+
+    if (result.truncated) { // Mark the cut at the end of the last line
+        if (!result.runs.empty() && !result.runs.back().isLink) {
+            result.runs.back().text += " ...";
+            result.runs.back().width += spaceWidth + advances.measure("...");
+        } else {
+            result.runs.push_back(LayoutRun{"...", lineWidth + spaceWidth, lineY, advances.measure("..."), false});
+        }
+    }
+
+    result.lineCount = lines;
+    result.height = lines * options.lineHeight;
+    return result;
+}
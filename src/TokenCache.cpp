@@ -0,0 +1,254 @@
+#include "TokenCache.h"
+#include "JsonParser.h"
+#include <fcntl.h>
+#include <algorithm>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+using namespace MailTMAPI;
+
+namespace {
+
+// Tokens without an exp claim are trusted for this long
+const std::chrono::minutes untimedTokenLifetime(10);
+
+// Changes are written to the store at most this often, so logging in many accounts rewrites it once
+const std::chrono::seconds saveDelay(1);
+
+// Function to decode base64url (the JWT alphabet, padding optional)
+std::optional<std::string> decodeBase64Url(const std::string& input) {
+    std::string output;
+    uint32_t buffer = 0;
+    int bits = 0;
+    for (char c : input) {
+        int value;
+        if (c >= 'A' && c <= 'Z') value = c - 'A';
+        else if (c >= 'a' && c <= 'z') value = c - 'a' + 26;
+        else if (c >= '0' && c <= '9') value = c - '0' + 52;
+        else if (c == '-' || c == '+') value = 62;
+        else if (c == '_' || c == '/') value = 63;
+        else if (c == '=') break;
+        else return std::nullopt;
+
+        buffer = (buffer << 6) | static_cast<uint32_t>(value);
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            output += static_cast<char>((buffer >> bits) & 0xFF);
+        }
+        buffer &= (1u << bits) - 1; // Keep only the bits not written yet
+    }
+    return output;
+}
+
+} // namespace
+
+// Constructor for TokenCache
+TokenCache::TokenCache(FetchFunction fetch, std::chrono::seconds refreshMargin)
+    : fetch(std::move(fetch)), refreshMargin(refreshMargin), dirty(false), running(false) {}
+
+// Destructor for TokenCache that stops the refresh thread and writes pending changes
+TokenCache::~TokenCache() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = false;
+    }
+    changed.notify_all();
+    if (refresher.joinable()) {
+        refresher.join();
+    }
+    if (dirty) {
+        writeStore(serialize());
+    }
+}
+
+// Function to read the expiry claim from the payload segment of a JWT
+std::optional<TokenCache::Clock::time_point> TokenCache::decodeExpiry(const std::string& token) {
+    size_t first = token.find('.');
+    size_t second = token.find('.', first + 1);
+    if (first == std::string::npos || second == std::string::npos) {
+        return std::nullopt;
+    }
+    auto payload = decodeBase64Url(token.substr(first + 1, second - first - 1));
+    if (!payload) {
+        return std::nullopt;
+    }
+
+    Json::Value claims;
+    if (!JsonParser::local().parse(*payload, claims) || !claims["exp"].isNumeric()) {
+        return std::nullopt;
+    }
+    return Clock::time_point(std::chrono::seconds(claims["exp"].asInt64()));
+}
+
+// Method to return a cached token that is still comfortably valid for this password
+std::optional<std::string> TokenCache::get(const std::string& address, const std::string& password) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(address);
+    if (it == entries.end() || Clock::now() + refreshMargin >= it->second.expiresAt) {
+        return std::nullopt;
+    }
+    // A token only stands in for the password that obtained it. Tokens loaded from disk have no
+    // password yet; they are served as they were stored, and learn one from the next successful put()
+    if (!it->second.password.empty() && it->second.password != password) {
+        return std::nullopt;
+    }
+    return it->second.token;
+}
+
+// Method to store a token and wake the refresher so it reschedules
+void TokenCache::put(const std::string& address, const std::string& password, const std::string& token) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        Entry& entry = entries[address];
+        entry.token = token;
+        entry.password = password;
+        entry.expiresAt = decodeExpiry(token).value_or(Clock::now() + untimedTokenLifetime);
+        markDirty();
+        startRefresher();
+    }
+    changed.notify_all();
+}
+
+// Method to forget a token the server no longer accepts
+void TokenCache::invalidate(const std::string& address) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        entries.erase(address);
+        markDirty();
+    }
+    changed.notify_all();
+}
+
+// Method to load persisted tokens and persist future updates
+void TokenCache::setStorePath(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex);
+    storePath = path;
+
+    std::ifstream in(path);
+    std::string address;
+    std::string token;
+    while (in >> address >> token) {
+        auto expiresAt = decodeExpiry(token);
+        if (expiresAt && *expiresAt > Clock::now() + refreshMargin && entries.find(address) == entries.end()) {
+            entries[address] = Entry{token, "", *expiresAt};
+        }
+    }
+    startRefresher();
+}
+
+// Method to schedule a write of the store; the refresher does it later, off the lock (caller holds the lock)
+void TokenCache::markDirty() {
+    if (storePath.empty() || dirty) {
+        return;
+    }
+    dirty = true;
+    saveAt = Clock::now() + saveDelay;
+    startRefresher();
+}
+
+// Method to render the store contents (caller holds the lock)
+std::string TokenCache::serialize() const {
+    std::string contents;
+    for (const auto& entry : entries) {
+        contents += entry.first + ' ' + entry.second.token + '\n';
+    }
+    return contents;
+}
+
+// Method to replace the store file atomically; the temporary file is private from the moment it exists
+void TokenCache::writeStore(const std::string& contents) {
+    std::string tempPath = storePath + ".tmp";
+    ::unlink(tempPath.c_str()); // Left over from a crash
+    int fd = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0600); // Tokens are credentials
+    if (fd < 0) {
+        return;
+    }
+    size_t done = 0;
+    while (done < contents.size()) {
+        ssize_t written = ::write(fd, contents.data() + done, contents.size() - done);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            ::close(fd);
+            ::unlink(tempPath.c_str());
+            return;
+        }
+        done += static_cast<size_t>(written);
+    }
+    ::close(fd);
+    std::rename(tempPath.c_str(), storePath.c_str());
+}
+
+// Method to start the refresh thread on first use (caller holds the lock)
+void TokenCache::startRefresher() {
+    if (!running) {
+        running = true;
+        refresher = std::thread(&TokenCache::refreshLoop, this);
+    }
+}
+
+// Background loop that refreshes each token refreshMargin before it expires and writes the store
+void TokenCache::refreshLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (running) {
+        if (dirty && Clock::now() >= saveAt) {
+            // Write without holding the lock; changes made meanwhile mark the cache dirty again
+            std::string contents = serialize();
+            dirty = false;
+            lock.unlock();
+            writeStore(contents);
+            lock.lock();
+            continue;
+        }
+
+        // Find the refreshable token that expires first
+        std::string dueAddress;
+        Clock::time_point dueAt = Clock::time_point::max();
+        for (const auto& entry : entries) {
+            Clock::time_point refreshAt = entry.second.expiresAt - refreshMargin;
+            if (!entry.second.password.empty() && refreshAt < dueAt) {
+                dueAt = refreshAt;
+                dueAddress = entry.first;
+            }
+        }
+
+        Clock::time_point wakeAt = dirty ? std::min(dueAt, saveAt) : dueAt;
+        if (wakeAt == Clock::time_point::max()) {
+            changed.wait(lock);
+            continue;
+        }
+        if (Clock::now() < wakeAt) {
+            changed.wait_until(lock, wakeAt);
+            continue;
+        }
+        if (dueAddress.empty() || Clock::now() < dueAt) {
+            continue; // Woken for the store write
+        }
+
+        // Fetch without holding the lock so lookups are never blocked by the network
+        std::string password = entries[dueAddress].password;
+        lock.unlock();
+        std::optional<std::string> token = fetch(dueAddress, password);
+        lock.lock();
+
+        auto it = entries.find(dueAddress);
+        if (it == entries.end()) {
+            continue; // Invalidated while refreshing
+        }
+        if (token) {
+            it->second.token = *token;
+            it->second.expiresAt = decodeExpiry(*token).value_or(Clock::now() + untimedTokenLifetime);
+            markDirty();
+        }
+        if (!token || it->second.expiresAt - refreshMargin <= Clock::now()) {
+            // Refresh failed or the token lives shorter than the margin; let it lapse so the
+            // next authenticate() fetches one directly instead of retrying in a tight loop
+            it->second.password.clear();
+        }
+    }
+}
@@ -0,0 +1,55 @@
+#include "VirtualList.h"
+#include <algorithm>
+
+using namespace MailTMAPI;
+
+// Constructor for VirtualList
+VirtualList::VirtualList(float spacing) : tops{0}, spacing(spacing) {}
+
+// Method to add a row, extending the prefix sums by one entry
+void VirtualList::append(float height) {
+    heights.push_back(height);
+    tops.push_back(tops.back() + height + spacing);
+}
+
+// Method to remove every row
+void VirtualList::clear() {
+    heights.clear();
+    tops.assign(1, 0);
+}
+
+// Method to get the number of rows
+size_t VirtualList::size() const {
+    return heights.size();
+}
+
+// Method to get the height of the whole list
+float VirtualList::totalHeight() const {
+    return tops.back();
+}
+
+// Method to get the top of a row
+float VirtualList::rowTop(size_t index) const {
+    return tops[index];
+}
+
+// Method to find the rows starting in a range with two binary searches
+std::pair<size_t, size_t> VirtualList::rowsStartingIn(float top, float bottom) const {
+    auto rowsEnd = tops.begin() + heights.size(); // The last entry is the total height, not a row
+    size_t first = std::lower_bound(tops.begin(), rowsEnd, top) - tops.begin();
+    size_t last = std::upper_bound(tops.begin(), rowsEnd, bottom) - tops.begin();
+    return {first, std::max(first, last)};
+}
+
+// Method to find the row containing an offset
+std::optional<size_t> VirtualList::rowAt(float y) const {
+    if (heights.empty() || y < 0) {
+        return std::nullopt;
+    }
+    auto rowsEnd = tops.begin() + heights.size();
+    size_t index = std::upper_bound(tops.begin(), rowsEnd, y) - tops.begin() - 1; // Last row starting at or above y
+    if (y >= tops[index] + heights[index]) { // Below the row, in its spacing or past the end
+        return std::nullopt;
+    }
+    return index;
+}
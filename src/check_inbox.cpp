@@ -1,14 +1,38 @@
 #include "MailTM.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
 #include <iostream>
 #include <thread>
 #include <atomic>
-#include <unordered_set>
-#include <chrono>
+#include <map>
+#include <vector>
 #include "CurlWrapper.h"
+#include "Extractor.h"
+#include "MessageStore.h"
+#include "MetricsExporter.h"
+#include "PollScheduler.h"
 
-using namespace std::chrono_literals; // Enable chrono literals like 10s
 using namespace MailTMAPI;   
 
+const int maxFetchAttempts = 5; // Polls a failing message fetch is retried on before its summary is printed alone
+const long maxWaitSeconds = 7 * 24 * 3600; // Longest --timeout, a week
+
+// Function to parse a numeric option; fails on anything but a plain decimal between min and max
+bool parseNumber(const std::string& value, long min, long max, long& number) {
+    if (value.empty() || value[0] < '0' || value[0] > '9') { // strtol would accept a sign or spaces
+        return false;
+    }
+    char* end = nullptr;
+    errno = 0;
+    long parsed = std::strtol(value.c_str(), &end, 10);
+    if (errno == ERANGE || *end != '\0' || parsed < min || parsed > max) {
+        return false;
+    }
+    number = parsed;
+    return true;
+}
+
 // Function to monitor user input and handle commands to stop or delete the account
 void monitorInput(std::atomic<bool>& running, std::atomic<bool>& deleteAccount) {
     std::string input;
@@ -25,9 +49,63 @@ void monitorInput(std::atomic<bool>& running, std::atomic<bool>& deleteAccount)
     }
 }
 
-int main() {
+int main(int argc, char* argv[]) {
     MailTM mailTm; // Create an instance of the MailTM class
     std::string email, password; // Variables to store user credentials
+    std::string storeRoot; // Directory of the local message stores, empty to keep nothing
+    std::string waitPattern; // Pattern to wait for, e.g. "code"; empty to watch the inbox interactively
+    long waitSeconds = 300; // How long --wait-for waits
+    std::vector<std::string> extraKeywords; // --keyword words that also point at a code or link
+    int metricsPort = -1; // Port of the Prometheus endpoint, -1 to not serve one
+
+    // Optionally keep tokens on disk so the next run can skip authentication,
+    // and fetched messages so the next run starts from where this one stopped
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string option = argv[i];
+        if (option == "--token-store") {
+            mailTm.setTokenStorePath(argv[i + 1]);
+        } else if (option == "--store") {
+            storeRoot = argv[i + 1];
+        } else if (option == "--wait-for") {
+            waitPattern = argv[i + 1];
+        } else if (option == "--keyword") {
+            extraKeywords.push_back(argv[i + 1]);
+        } else if (option == "--timeout") {
+            if (!parseNumber(argv[i + 1], 1, maxWaitSeconds, waitSeconds)) {
+                std::cerr << "Invalid --timeout: " << argv[i + 1] << " (expected 1 to " << maxWaitSeconds << " seconds)"
+                          << std::endl;
+                return 1;
+            }
+        } else if (option == "--metrics-port") {
+            long port = 0;
+            if (!parseNumber(argv[i + 1], 0, 65535, port)) {
+                std::cerr << "Invalid --metrics-port: " << argv[i + 1] << " (expected 0 to 65535)" << std::endl;
+                return 1;
+            }
+            metricsPort = static_cast<int>(port);
+        } else {
+            std::cerr << "Unknown option: " << option << std::endl;
+            return 1;
+        }
+    }
+
+    // Extra keywords go to the awaited pattern, or to every pattern when just watching
+    std::vector<ExtractionPattern> patterns = Extractor::defaultPatterns();
+    bool knownPattern = waitPattern.empty();
+    for (auto& pattern : patterns) {
+        if (waitPattern.empty() || pattern.name == waitPattern) {
+            pattern.keywords.insert(pattern.keywords.end(), extraKeywords.begin(), extraKeywords.end());
+            knownPattern = true;
+        }
+    }
+    if (!knownPattern) { // Fail now rather than after logging in and waiting out the timeout
+        std::cerr << "Unknown pattern: " << waitPattern << " (expected";
+        for (const auto& pattern : patterns) {
+            std::cerr << " " << pattern.name;
+        }
+        std::cerr << ")" << std::endl;
+        return 1;
+    }
 
     std::cout << "Enter your email: "; // Prompt the user for email
     std::cin >> email; // Read email input
@@ -50,53 +128,188 @@ int main() {
     }
     std::string accountId = *accountIdOpt; // Retrieve the account ID
 
-    std::cout << "Checking inbox (Type 'x' to stop, 'delete' to delete account)..." << std::endl;
+    if (waitPattern.empty()) {
+        std::cout << "Checking inbox (Type 'x' to stop, 'delete' to delete account)..." << std::endl;
+    } else {
+        std::cerr << "Waiting for a " << waitPattern << "..." << std::endl;
+    }
 
     std::atomic<bool> running(true); // Flag to indicate if the program is running
     std::atomic<bool> deleteAccount(false); // Flag to indicate if the account should be deleted
-    std::unordered_set<std::string> printedMessages; // Set to track printed messages
+    InboxCursor cursor; // Watermark of the messages already printed
+    std::vector<MessageSummary> retries; // Messages whose fetch failed, printed once a later fetch works
+    std::map<std::string, int> attempts; // Failed fetches so far for each of them
+
+    // Show what earlier runs kept and resume syncing after it
+    MessageStore store;
+    bool storeOpen = !storeRoot.empty() && store.open(storeRoot, email);
+    if (storeOpen) {
+        std::cout << store.size() << " stored messages." << std::endl;
+        auto stored = store.latest(5);
+        for (auto it = stored.rbegin(); it != stored.rend(); ++it) {
+            std::cout << "[stored] From: " << it->from.address.str() << " Subject: " << it->subject << std::endl;
+        }
+        cursor = store.cursor();
+    }
+
+    // Codes and links are pulled out of every fetched message; --wait-for only prints the first match
+    Extractor extractor(patterns);
+    bool waiting = !waitPattern.empty();
+    if (waiting) {
+        mailTm.enableExtraction(patterns);
+    }
 
     // Start a thread to monitor user input
-    std::thread inputThread(monitorInput, std::ref(running), std::ref(deleteAccount));
-
-    // Main loop to check the inbox
-    while (running) {
-        auto messages = mailTm.checkInbox(token); // Fetch messages from the inbox
-        for (const auto& message : messages) { // Iterate over the messages
-            std::string messageId = message["id"].asString(); // Get the message ID
-            if (printedMessages.find(messageId) == printedMessages.end()) { // Check if the message is new
-                Json::Value fullMessage = mailTm.getMessage(token, messageId); // Fetch the full message
-
-                // Print message details
-                std::cout << "From: " << message["from"]["address"].asString() << std::endl;
-                std::cout << "Subject: " << message["subject"].asString() << std::endl;
-
-                // Print message preview if available
-                if (message.isMember("intro")) {
-                    std::cout << "Preview: " << message["intro"].asString() << std::endl;
-                }
+    std::thread inputThread;
+    if (!waiting) {
+        inputThread = std::thread(monitorInput, std::ref(running), std::ref(deleteAccount));
+    }
+
+    // The scheduler owns the polling cadence: faster while mail arrives, slower when idle,
+    // and backing off on errors or rate limiting
+    PollScheduler scheduler;
+    WatcherMetrics watcher; // Poll outcomes and message lag for the metrics endpoint
+    scheduler.addAccount(email, [&](PollScheduler::DoneCallback done) {
+        // A cache hit that picks up the token the cache refreshed before the old one expired
+        auto currentToken = mailTm.authenticate(email, password);
+        if (!currentToken) {
+            watcher.recordPoll(PollStatus::Error);
+            done(PollResult::fromHttpStatus(0, 0));
+            return;
+        }
+        long status = 0;
+        auto newMessages = mailTm.syncInbox(*currentToken, cursor, status); // Fetch only what arrived since the last poll
+        if (status == 401) { // Token expired or revoked, the next poll logs in again
+            mailTm.invalidateToken(email);
+            watcher.recordPoll(PollStatus::Error);
+            done(PollResult::fromHttpStatus(status, 0));
+            return;
+        }
 
-                // Print the full message body or HTML content
-                if (fullMessage.isMember("text")) {
-                    std::cout << "Body: " << fullMessage["text"].asString() << std::endl;
-                } else if (fullMessage.isMember("html")) {
-                    std::cout << "Body (HTML): " << fullMessage["html"].asString() << std::endl;
+        if (storeOpen) { // A message already stored was printed by an earlier run
+            newMessages.erase(std::remove_if(newMessages.begin(), newMessages.end(), [&](const MessageSummary& message) {
+                return store.contains(message.id);
+            }), newMessages.end());
+        }
+
+        for (auto& retry : retries) { // The cursor is past these already, fetch them again
+            if (std::none_of(newMessages.begin(), newMessages.end(), [&](const MessageSummary& message) {
+                    return message.id == retry.id;
+                })) {
+                newMessages.push_back(std::move(retry));
+            }
+        }
+        retries.clear();
+
+        std::vector<std::string> newIds;
+        for (const auto& message : newMessages) {
+            newIds.push_back(message.id);
+        }
+
+        // Fetch all new full messages concurrently
+        std::vector<std::optional<Message>> fullMessages = mailTm.getMessages(*currentToken, newIds);
+
+        for (size_t i = 0; i < newMessages.size(); ++i) {
+            const MessageSummary& message = newMessages[i];
+            if (!fullMessages[i] && ++attempts[message.id] < maxFetchAttempts) {
+                retries.push_back(message); // Try again next poll; after that, print what the summary has
+                continue;
+            }
+            attempts.erase(message.id);
+            if (waiting) {
+                continue;
+            }
+
+            // Print message details
+            std::cout << "From: " << message.from.address.str() << std::endl;
+            std::cout << "Subject: " << message.subject << std::endl;
+
+            // Print message preview if available
+            if (!message.intro.empty()) {
+                std::cout << "Preview: " << message.intro << std::endl;
+            }
+
+            // Print the full message body or HTML content
+            if (fullMessages[i] && !fullMessages[i]->text.empty()) {
+                std::cout << "Body: " << fullMessages[i]->text << std::endl;
+            } else if (fullMessages[i] && !fullMessages[i]->html.empty()) {
+                std::cout << "Body (HTML): " << fullMessages[i]->html << std::endl;
+            }
+
+            // Print the codes and links found in the message
+            if (fullMessages[i]) {
+                for (const auto& match : extractor.extract(*fullMessages[i])) {
+                    std::cout << "Match (" << match.pattern << "): " << match.value << std::endl;
                 }
+            }
 
-                std::cout << "-------------------" << std::endl;
-                printedMessages.insert(messageId); // Mark the message as printed
+            std::cout << "-------------------" << std::endl;
+            watcher.recordMessage(message);
+        }
+
+        // Keep the fetched messages so the next run does not fetch or print them again
+        if (storeOpen) {
+            std::vector<Message> fetched;
+            for (auto& message : fullMessages) {
+                if (message) {
+                    fetched.push_back(std::move(*message));
+                }
             }
+            store.append(fetched);
+        }
+
+        PollResult result = PollResult::fromHttpStatus(status, newMessages.size());
+        watcher.recordPoll(result.status);
+        done(result);
+    });
+    scheduler.start();
+
+    // Serve the counters to a local scraper instead of making monitoring parse the output
+    MetricsExporter exporter;
+    if (metricsPort >= 0) {
+        exporter.addCollector([&](MetricsWriter& writer) {
+            watcher.write(writer);
+            writer.pollScheduler(scheduler);
+            writer.requestMetrics(*mailTm.getMetrics());
+            writer.family("mailtm_requests_in_flight", "gauge", "Async API requests not finished yet.");
+            writer.sample("mailtm_requests_in_flight", mailTm.getRequestsInFlight());
+        });
+        if (exporter.start(static_cast<uint16_t>(metricsPort))) {
+            std::cerr << "Serving metrics on http://127.0.0.1:" << exporter.getPort() << "/metrics" << std::endl;
         }
-        std::this_thread::sleep_for(10s); // Wait for 10 seconds before checking the inbox again
     }
+    scheduler.pollNow(email); // Check right away instead of waiting for the spread-out first poll
+
+    // Start a thread that polls immediately whenever the server pushes an update;
+    // every reconnection uses the current token
+    std::thread pushThread([&]() {
+        bool streamed = mailTm.streamInbox(email, password, accountId, [&](const Json::Value&) {
+            scheduler.pollNow(email);
+        }, running);
+        if (!streamed) {
+            std::cerr << "Push updates unavailable, relying on polling." << std::endl;
+        }
+    });
 
-    // Join the input thread before exiting
+    // Wait for the first match, or for the user to stop the program
+    std::optional<Extraction> match;
+    if (waiting) {
+        match = mailTm.waitForMatch(email, waitPattern, std::chrono::seconds(waitSeconds));
+        running = false;
+    }
     if (inputThread.joinable()) {
         inputThread.join();
     }
 
+    // Join the push thread, it stops once running is false
+    if (pushThread.joinable()) {
+        pushThread.join();
+    }
+    scheduler.stop();
+
     // Handle account deletion if requested by the user
     if (deleteAccount) {
+        token = mailTm.authenticate(email, password).value_or(token); // The login token may have expired by now
         auto deleteResult = mailTm.deleteAccount(token, accountId); // Attempt to delete the account
         if (deleteResult) { // Check if deletion was successful
             std::cout << "Account deleted successfully." << std::endl;
@@ -105,6 +318,15 @@ int main() {
         }
     }
 
+    if (waiting) {
+        if (!match) {
+            std::cerr << "No " << waitPattern << " arrived within " << waitSeconds << " seconds." << std::endl;
+            return 1;
+        }
+        std::cout << match->value << std::endl; // Only the value, so scripts can capture it
+        return 0;
+    }
+
     std::cout << "Exiting inbox check..." << std::endl; // Indicate program termination
     return 0; // Exit the program successfully
 }
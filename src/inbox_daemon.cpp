@@ -0,0 +1,357 @@
+#include "Extractor.h"
+#include "Logger.h"
+#include "MailTM.h"
+#include "MetricsExporter.h"
+#include "PollScheduler.h"
+#include "RequestMetrics.h"
+#include <sys/resource.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace MailTMAPI;
+
+namespace {
+
+std::atomic<bool> stopRequested(false); // Set by SIGINT/SIGTERM
+const int maxFetchAttempts = 5; // Polls a failing message fetch is retried on before it is dropped
+
+// Signal handler that asks the main loop to exit
+void handleSignal(int) {
+    stopRequested = true;
+}
+
+// Watched account and the state its poll chain keeps between polls
+struct Account {
+    std::string address;
+    std::string password;
+    std::string token;
+    size_t worker = 0; // Index of the MailTM client (event loop) serving this account
+    InboxCursor cursor; // Watermark of the messages already emitted
+    bool primed = false; // False until the first poll when existing mail is skipped
+    std::map<std::string, int> retries; // Messages whose fetch failed, with the attempts so far
+};
+
+// Thread-safe writer for newline-delimited JSON records
+class NdjsonWriter {
+private:
+    std::mutex mutex;
+    std::ofstream file;
+    std::ostream* out;
+    Json::StreamWriterBuilder builder;
+
+public:
+    explicit NdjsonWriter(const std::string& path) : out(&std::cout) {
+        builder["indentation"] = ""; // One record per line
+        if (!path.empty() && path != "-") {
+            file.open(path, std::ios::app);
+            if (!file) {
+                throw std::runtime_error("Failed to open output file: " + path);
+            }
+            out = &file;
+        }
+    }
+
+    void write(const Json::Value& record) {
+        std::string line = Json::writeString(builder, record); // Serialize outside the lock
+        std::lock_guard<std::mutex> lock(mutex);
+        *out << line << '\n';
+        out->flush(); // Consumers tail the stream, deliver each message immediately
+    }
+};
+
+// Function to read "address password" pairs, one per line
+std::vector<std::shared_ptr<Account>> loadCredentials(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("Failed to open credentials file: " + path);
+    }
+    std::vector<std::shared_ptr<Account>> accounts;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') { // Skip blank lines and comments
+            continue;
+        }
+        std::replace(line.begin(), line.end(), ':', ' '); // Accept address:password as well
+        std::istringstream fields(line);
+        auto account = std::make_shared<Account>();
+        if (fields >> account->address >> account->password) {
+            accounts.push_back(account);
+        }
+    }
+    return accounts;
+}
+
+// Function to get the peak resident set size in kilobytes
+long peakRssKb() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024; // Reported in bytes on macOS
+#else
+    return usage.ru_maxrss; // Reported in kilobytes on Linux
+#endif
+}
+
+// Function to build the output record for a fetched message
+Json::Value toRecord(const std::string& address, const Message& message, const Extractor* extractor) {
+    Json::Value record;
+    record["account"] = address;
+    record["id"] = message.id;
+    record["from"] = message.from.address.str();
+    record["subject"] = message.subject;
+    record["createdAt"] = message.createdAt;
+    record["intro"] = message.intro;
+    record["text"] = message.text;
+    record["html"] = message.html; // HTML parts are already joined
+    if (extractor) { // Codes and links, so consumers do not have to scrape the body
+        Json::Value matches(Json::arrayValue);
+        for (const auto& match : extractor->extract(message)) {
+            Json::Value entry;
+            entry["pattern"] = match.pattern;
+            entry["value"] = match.value;
+            matches.append(entry);
+        }
+        record["matches"] = matches;
+    }
+    return record;
+}
+
+// Function to poll one account; every step is asynchronous so no thread blocks on I/O
+void pollAccount(MailTM& client, const std::shared_ptr<Account>& account, NdjsonWriter& output, WatcherMetrics& stats,
+                 const Extractor* extractor, PollScheduler::DoneCallback done) {
+    client.syncInboxAsync(account->token, account->cursor, [&client, account, &output, &stats, extractor, done](std::vector<MessageSummary> inbox, InboxCursor cursor, long status) {
+        if (status == 401) { // Token expired or revoked, fetch a new one before the next poll
+            stats.recordPoll(PollStatus::Error);
+            client.invalidateToken(account->address);
+            client.authenticateAsync(account->address, account->password, [account, done](std::optional<std::string> token) {
+                if (token) {
+                    account->token = *token;
+                }
+                done(PollResult{PollStatus::Error, 0});
+            });
+            return;
+        }
+        if (status < 200 || status >= 300) {
+            PollResult result = PollResult::fromHttpStatus(status, 0);
+            stats.recordPoll(result.status);
+            done(result);
+            return;
+        }
+        stats.recordPoll(PollStatus::Ok);
+
+        // Only the delta since the last poll comes back, so the cost does not grow with the inbox
+        account->cursor = std::move(cursor);
+        std::vector<std::string> newIds;
+        for (const auto& message : inbox) {
+            newIds.push_back(message.id);
+        }
+
+        if (!account->primed) { // First poll with --skip-existing only records what is already there
+            account->primed = true;
+            newIds.clear();
+        }
+        for (const auto& retry : account->retries) { // The cursor is past these already, fetch them again
+            if (std::find(newIds.begin(), newIds.end(), retry.first) == newIds.end()) {
+                newIds.push_back(retry.first);
+            }
+        }
+        if (newIds.empty()) {
+            done(PollResult::fromHttpStatus(status, 0));
+            return;
+        }
+
+        // Fetch the new messages concurrently and emit each one as soon as it arrives
+        auto remaining = std::make_shared<std::atomic<size_t>>(newIds.size());
+        size_t newCount = newIds.size();
+        for (const auto& id : newIds) {
+            client.getMessageAsync(account->token, id, [account, id, &output, &stats, extractor, remaining, newCount, done](std::optional<Message> message) {
+                if (message) {
+                    output.write(toRecord(account->address, *message, extractor));
+                    stats.recordMessage(*message); // Arrival-to-output lag
+                    account->retries.erase(id);
+                } else if (++account->retries[id] >= maxFetchAttempts) { // Most likely deleted, stop asking
+                    LOG_WARN("Giving up on message ", id, " for ", account->address);
+                    account->retries.erase(id);
+                }
+                if (--*remaining == 0) { // Last fetch of this poll reports back to the scheduler
+                    done(PollResult{PollStatus::Ok, newCount});
+                }
+            });
+        }
+    });
+}
+
+// Function to print usage information
+void printUsage() {
+    std::cerr << "Usage: inbox_daemon <credentials-file> [--output FILE] [--workers N] [--duration SECONDS]\n"
+              << "                    [--base-url URL] [--skip-existing] [--token-store FILE] [--extract]\n"
+              << "                    [--metrics-port PORT]\n"
+              << "The credentials file holds one 'address password' pair per line.\n"
+              << "New messages are written as newline-delimited JSON to stdout or FILE.\n"
+              << "--extract adds the verification codes and links found in each message as \"matches\".\n"
+              << "--metrics-port serves Prometheus metrics at http://127.0.0.1:PORT/metrics." << std::endl;
+}
+
+} // namespace
+
+// Daemon that watches many accounts at once and emits new messages as NDJSON
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        printUsage();
+        return 1;
+    }
+
+    std::string credentialsPath = argv[1];
+    std::string outputPath;
+    std::string baseUrl = "https://api.mail.tm";
+    size_t workers = 4;
+    long durationSeconds = 0;
+    bool skipExisting = false;
+    std::string tokenStorePath;
+    bool extract = false;
+    int metricsPort = -1;
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--output" && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else if (arg == "--workers" && i + 1 < argc) {
+            workers = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--duration" && i + 1 < argc) {
+            durationSeconds = std::stol(argv[++i]);
+        } else if (arg == "--base-url" && i + 1 < argc) {
+            baseUrl = argv[++i];
+        } else if (arg == "--skip-existing") {
+            skipExisting = true;
+        } else if (arg == "--token-store" && i + 1 < argc) {
+            tokenStorePath = argv[++i];
+        } else if (arg == "--extract") {
+            extract = true;
+        } else if (arg == "--metrics-port" && i + 1 < argc) {
+            metricsPort = std::stoi(argv[++i]);
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+
+    try {
+        auto accounts = loadCredentials(credentialsPath);
+        NdjsonWriter output(outputPath);
+        WatcherMetrics stats;
+        auto requestMetrics = std::make_shared<RequestMetrics>(); // One collector for every worker's requests
+        std::unique_ptr<Extractor> extractor = extract ? std::make_unique<Extractor>() : nullptr; // Shared by all workers
+
+        // Fixed-size worker pool: each client drives its accounts from one event loop thread
+        std::vector<std::unique_ptr<MailTM>> clients;
+        for (size_t i = 0; i < workers; ++i) {
+            clients.push_back(std::make_unique<MailTM>(baseUrl));
+            clients.back()->setMetrics(requestMetrics);
+            if (!tokenStorePath.empty()) { // Restarts reuse valid tokens instead of logging in again
+                clients.back()->setTokenStorePath(tokenStorePath + "." + std::to_string(i));
+            }
+        }
+
+        // Authenticate every account with a bounded number of requests in flight
+        std::cerr << "Authenticating " << accounts.size() << " accounts..." << std::endl;
+        const size_t maxPendingLogins = 64;
+        std::deque<std::pair<std::shared_ptr<Account>, std::future<std::optional<std::string>>>> logins;
+        std::vector<std::shared_ptr<Account>> watched;
+        auto finishLogin = [&]() {
+            auto& login = logins.front();
+            auto token = login.second.get();
+            if (token) {
+                login.first->token = *token;
+                watched.push_back(login.first);
+            } else {
+                std::cerr << "Authentication failed for " << login.first->address << std::endl;
+            }
+            logins.pop_front();
+        };
+        for (size_t i = 0; i < accounts.size() && !stopRequested; ++i) {
+            accounts[i]->worker = i % workers;
+            accounts[i]->primed = !skipExisting;
+            if (logins.size() >= maxPendingLogins) {
+                finishLogin();
+            }
+            auto& client = *clients[accounts[i]->worker];
+            logins.emplace_back(accounts[i], client.authenticateAsync(accounts[i]->address, accounts[i]->password));
+        }
+        while (!logins.empty()) {
+            finishLogin();
+        }
+
+        // One scheduler spreads and adapts the polling of every account
+        PollScheduler scheduler;
+        for (const auto& account : watched) {
+            MailTM& client = *clients[account->worker];
+            scheduler.addAccount(account->address, [&client, account, &output, &stats, &extractor](PollScheduler::DoneCallback done) {
+                pollAccount(client, account, output, stats, extractor.get(), done);
+            });
+        }
+        scheduler.start();
+        std::cerr << "Watching " << watched.size() << " accounts with " << workers << " workers" << std::endl;
+
+        // Let monitoring scrape the counters instead of parsing the progress lines
+        std::unique_ptr<MetricsExporter> exporter;
+        if (metricsPort >= 0) {
+            exporter = std::make_unique<MetricsExporter>();
+            exporter->addCollector([&](MetricsWriter& writer) {
+                stats.write(writer);
+                writer.pollScheduler(scheduler);
+                writer.requestMetrics(*requestMetrics);
+                size_t inFlight = 0;
+                for (const auto& client : clients) {
+                    inFlight += client->getRequestsInFlight();
+                }
+                writer.family("mailtm_requests_in_flight", "gauge", "Async API requests not finished yet, across all workers.");
+                writer.sample("mailtm_requests_in_flight", inFlight);
+            });
+            if (exporter->start(static_cast<uint16_t>(metricsPort))) {
+                std::cerr << "Serving metrics on http://127.0.0.1:" << exporter->getPort() << "/metrics" << std::endl;
+            }
+        }
+
+        // Report progress until stopped or the requested duration has passed
+        auto start = std::chrono::steady_clock::now();
+        auto nextReport = start + std::chrono::seconds(10);
+        while (!stopRequested) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            auto now = std::chrono::steady_clock::now();
+            if (durationSeconds > 0 && now - start >= std::chrono::seconds(durationSeconds)) {
+                break;
+            }
+            if (now >= nextReport) {
+                std::cerr << "polls=" << stats.getPolls() << " messages=" << stats.getMessages() << " errors=" << stats.getErrors()
+                          << " peak_rss_kb=" << peakRssKb() << std::endl;
+                nextReport = now + std::chrono::seconds(10);
+            }
+        }
+        scheduler.stop();
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::cerr << "accounts=" << watched.size() << " seconds=" << elapsed.count() << " polls=" << stats.getPolls()
+                  << " polls_per_sec=" << stats.getPolls() / elapsed.count() << " messages=" << stats.getMessages()
+                  << " errors=" << stats.getErrors() << " peak_rss_kb=" << peakRssKb() << std::endl;
+        exporter.reset(); // Stop scrapes before the clients they read go away
+        clients.clear(); // Abort in-flight requests before the accounts they reference go away
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include "Extractor.h"
+#include "MailTM.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <chrono>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace MailTMAPI;
+
+// Helper function to build a message to extract from
+Message extractable(const std::string& subject, const std::string& text, const std::string& html = "") {
+    Message message;
+    message.id = "m1";
+    message.subject = subject;
+    message.text = text;
+    message.html = html;
+    return message;
+}
+
+// Helper function to list the values a pattern produced
+std::vector<std::string> valuesOf(const std::vector<Extraction>& matches, const std::string& pattern) {
+    std::vector<std::string> values;
+    for (const auto& match : matches) {
+        if (match.pattern == pattern) {
+            values.push_back(match.value);
+        }
+    }
+    return values;
+}
+
+// Local stand-in for the API: answers every request with the same message JSON
+class MessageStandIn {
+private:
+    int listenFd;
+    int port;
+    std::thread server;
+
+public:
+    explicit MessageStandIn(const std::string& body) : listenFd(socket(AF_INET, SOCK_STREAM, 0)), port(0) {
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0; // Let the OS pick a free port
+        bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        listen(listenFd, 8);
+        socklen_t len = sizeof(addr);
+        getsockname(listenFd, reinterpret_cast<sockaddr*>(&addr), &len);
+        port = ntohs(addr.sin_port);
+
+        std::string response = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nConnection: close\r\n"
+                               "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+        server = std::thread([this, response]() {
+            while (true) {
+                int client = accept(listenFd, nullptr, nullptr);
+                if (client < 0) {
+                    return;
+                }
+                char buffer[4096];
+                recv(client, buffer, sizeof(buffer), 0);
+                send(client, response.data(), response.size(), MSG_NOSIGNAL);
+                close(client);
+            }
+        });
+    }
+
+    ~MessageStandIn() {
+        shutdown(listenFd, SHUT_RDWR);
+        close(listenFd);
+        if (server.joinable()) {
+            server.join();
+        }
+    }
+
+    std::string url() const {
+        return "http://127.0.0.1:" + std::to_string(port);
+    }
+};
+
+// Test finding codes after and before their keyword
+TEST(ExtractorTests, FindsCodes) {
+    Extractor extractor;
+    EXPECT_EQ(valuesOf(extractor.extract(extractable("Welcome", "Your verification code is: 482913.")), "code"),
+              (std::vector<std::string>{"482913"}));
+    EXPECT_EQ(valuesOf(extractor.extract(extractable("482913 is your Example code", "")), "code"),
+              (std::vector<std::string>{"482913"}));
+    EXPECT_EQ(valuesOf(extractor.extract(extractable("Sign in", "Use code 482 913 or 551-204 to continue")), "code"),
+              (std::vector<std::string>{"482913"})) << "Digit groups are joined and the first code wins";
+    EXPECT_EQ(valuesOf(extractor.extract(extractable("Your OTP", "Enter 7731 within 10 minutes")), "code"),
+              (std::vector<std::string>{"7731"}));
+}
+
+// Test that numbers away from keywords, inside words or in URLs are not codes
+TEST(ExtractorTests, IgnoresOtherNumbers) {
+    Extractor extractor;
+    EXPECT_TRUE(extractor.extract(extractable("Order 12345 shipped", "Tracking number 99887766")).empty());
+    EXPECT_TRUE(valuesOf(extractor.extract(extractable("Scan the barcode", "Item 123456")), "code").empty());
+    EXPECT_TRUE(valuesOf(extractor.extract(extractable("Your code", "See https://example.com/orders/123456")), "code").empty());
+    EXPECT_TRUE(valuesOf(extractor.extract(extractable("Your code", "is 12")), "code").empty()) << "Too short";
+    EXPECT_TRUE(valuesOf(extractor.extract(extractable("Pinterest order 48291", "")), "code").empty());
+    EXPECT_TRUE(valuesOf(extractor.extract(extractable("Pinned: ticket 55120", "Promo codes inside, ref 773311")), "code").empty());
+}
+
+// Test extracting links from text and from HTML anchors
+TEST(ExtractorTests, FindsLinks) {
+    Extractor extractor;
+    auto fromText = extractor.extract(extractable("Confirm your email",
+        "Open https://app.example.com/confirm?token=abc123. Questions? https://example.com/help"));
+    EXPECT_EQ(valuesOf(fromText, "link"), (std::vector<std::string>{"https://app.example.com/confirm?token=abc123"}));
+    EXPECT_TRUE(valuesOf(fromText, "code").empty()) << "The token in the URL is not a code";
+
+    auto fromHtml = extractor.extract(extractable("Welcome", "",
+        "<p>Click <a href=\"https://example.com/Verify/XYZ?x=1&amp;y=2\">here</a> or "
+        "<a href=\"https://example.com/unsubscribe\">unsubscribe</a></p>"));
+    EXPECT_EQ(valuesOf(fromHtml, "link"), (std::vector<std::string>{"https://example.com/Verify/XYZ?x=1&y=2"}));
+}
+
+// Test user-supplied patterns, including letters in codes and links without keywords
+TEST(ExtractorTests, CustomPatterns) {
+    ExtractionPattern ticket;
+    ticket.name = "ticket";
+    ticket.keywords = {"Ticket"};
+    ticket.minLength = 6;
+    ticket.maxLength = 10;
+    ticket.digitsOnly = false;
+    ExtractionPattern anyLink;
+    anyLink.name = "url";
+    anyLink.kind = ExtractionPattern::Kind::Link;
+    Extractor extractor({ticket, anyLink});
+    ASSERT_EQ(extractor.getPatterns().size(), 2u);
+
+    auto matches = extractor.extract(extractable("Support", "Your TICKET id: AB12CD34, track it at http://help.example.com/t"));
+    EXPECT_EQ(valuesOf(matches, "ticket"), (std::vector<std::string>{"AB12CD34"}));
+    EXPECT_EQ(valuesOf(matches, "url"), (std::vector<std::string>{"http://help.example.com/t"}));
+    EXPECT_TRUE(valuesOf(extractor.extract(extractable("Ticket", "opened by support")), "ticket").empty())
+        << "Letters alone are not a code";
+}
+
+// Test that waitForMatch returns matches from messages fetched by any caller, once each
+TEST(ExtractorTests, WaitForMatch) {
+    MessageStandIn api(R"({"id": "m1", "subject": "Your code", "text": "Use 482913 to sign in",
+                          "to": [{"address": "Me@Example.com", "name": ""}]})");
+    MailTM client(api.url());
+    EXPECT_FALSE(client.waitForMatch("", "code", std::chrono::milliseconds(1)).has_value()) << "Extraction is off";
+    client.enableExtraction();
+
+    // Waiting first: the fetch on another thread wakes the waiter
+    auto waiter = std::async(std::launch::async, [&client]() {
+        return client.waitForMatch("me@example.com", "code", std::chrono::seconds(10));
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_TRUE(client.getMessage("token", "m1").has_value());
+    auto match = waiter.get();
+    ASSERT_TRUE(match.has_value());
+    EXPECT_EQ(match->value, "482913");
+    EXPECT_EQ(match->messageId, "m1");
+
+    // Fetching first: the match waits for the caller
+    ASSERT_TRUE(client.getMessage("token", "m1").has_value());
+    EXPECT_FALSE(client.waitForMatch("other@example.com", "code", std::chrono::milliseconds(10)).has_value());
+    EXPECT_TRUE(client.waitForMatch("", "code", std::chrono::milliseconds(10)).has_value());
+    EXPECT_FALSE(client.waitForMatch("", "code", std::chrono::milliseconds(10)).has_value()) << "Handed out once";
+}
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include "FrameProfiler.h"
+#include <json/json.h>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <unistd.h>
+
+using namespace MailTMAPI;
+
+// Helper function to keep the thread busy, since sleeps may overshoot by more than the time being checked
+void spinFor(std::chrono::microseconds duration) {
+    auto end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end) {
+    }
+}
+
+// Helper function to find a phase in the stats
+const PhaseTiming* phaseNamed(const FrameStats& stats, const std::string& name) {
+    for (const auto& phase : stats.phases) {
+        if (phase.name == name) {
+            return &phase;
+        }
+    }
+    return nullptr;
+}
+
+// Test that phases are timed per frame and summarized over the recent frames
+TEST(FrameProfilerTests, TimesPhases) {
+    FrameProfiler profiler;
+    EXPECT_EQ(profiler.getStats().frames, 0u);
+
+    for (int frame = 0; frame < 2; ++frame) {
+        profiler.beginFrame();
+        {
+            PROFILE_SCOPE(profiler, "layout");
+            spinFor(std::chrono::microseconds(frame == 0 ? 1000 : 3000));
+        }
+        {
+            PROFILE_SCOPE(profiler, "display");
+        }
+        profiler.endFrame(frame + 4);
+    }
+
+    FrameStats stats = profiler.getStats();
+    EXPECT_EQ(stats.frames, 2u);
+    EXPECT_EQ(stats.drawCalls, 5u);
+    ASSERT_EQ(stats.phases.size(), 2u);
+    EXPECT_EQ(stats.phases[0].name, "layout"); // In the order first seen
+    const PhaseTiming* layout = phaseNamed(stats, "layout");
+    EXPECT_GE(layout->lastMs, 3.0);
+    EXPECT_GE(layout->maxMs, layout->lastMs);
+    EXPECT_GE(layout->averageMs, 2.0);
+    EXPECT_LT(layout->averageMs, layout->maxMs);
+    EXPECT_GE(stats.frame.lastMs, layout->lastMs);
+    EXPECT_EQ(stats.lockWait.maxMs, 0);
+}
+
+// Test that a cancelled frame leaves the stats alone
+TEST(FrameProfilerTests, CancelledFrameIsNotCounted) {
+    FrameProfiler profiler;
+    profiler.beginFrame();
+    {
+        PROFILE_SCOPE(profiler, "events");
+        spinFor(std::chrono::microseconds(2000));
+    }
+    profiler.cancelFrame();
+    profiler.endFrame(1);
+
+    FrameStats stats = profiler.getStats();
+    EXPECT_EQ(stats.frames, 0u);
+    EXPECT_EQ(stats.drawCalls, 0u);
+}
+
+// Test that lock waits count towards the frame on the profiler's thread only
+TEST(FrameProfilerTests, ChargesLockWaitsToItsThread) {
+    FrameProfiler profiler;
+    profiler.beginFrame();
+    std::thread other([]() {
+        FrameProfiler::LockWait wait; // Not a profiled thread
+        spinFor(std::chrono::microseconds(5000));
+    });
+    other.join();
+    {
+        FrameProfiler::LockWait wait;
+        spinFor(std::chrono::microseconds(1000));
+    }
+    profiler.endFrame(0);
+
+    FrameStats stats = profiler.getStats();
+    EXPECT_GE(stats.lockWait.lastMs, 1.0);
+    EXPECT_LT(stats.lockWait.lastMs, 5.0);
+}
+
+// Test that waits reported after the fact, e.g. by the search index, count like a LockWait
+TEST(FrameProfilerTests, RecordsReportedLockWaits) {
+    FrameProfiler profiler;
+    FrameProfiler::Clock::time_point start = FrameProfiler::Clock::now();
+    FrameProfiler::recordLockWait(start, start + std::chrono::milliseconds(50)); // No frame running yet
+    profiler.beginFrame();
+    FrameProfiler::recordLockWait(start, start + std::chrono::milliseconds(2));
+    profiler.endFrame(0);
+
+    EXPECT_DOUBLE_EQ(profiler.getStats().lockWait.lastMs, 2.0);
+}
+
+// Test that the trace is valid Chrome trace event JSON with the frames, phases and counters
+TEST(FrameProfilerTests, WritesChromeTrace) {
+    std::string path = (std::filesystem::temp_directory_path() /
+                        ("frame_profiler_test_" + std::to_string(::getpid()) + ".json")).string();
+    FrameProfiler profiler;
+    EXPECT_FALSE(profiler.stopTrace());
+    ASSERT_TRUE(profiler.startTrace(path));
+    EXPECT_FALSE(profiler.startTrace(path));
+    for (int frame = 0; frame < 3; ++frame) {
+        profiler.beginFrame();
+        {
+            PROFILE_SCOPE(profiler, "drawMessages");
+        }
+        profiler.endFrame(7);
+    }
+    ASSERT_TRUE(profiler.stopTrace());
+    EXPECT_FALSE(profiler.isTracing());
+
+    std::ifstream in(path);
+    Json::Value root;
+    Json::CharReaderBuilder builder;
+    std::string errors;
+    ASSERT_TRUE(Json::parseFromStream(builder, in, &root, &errors)) << errors;
+    std::remove(path.c_str());
+
+    int frames = 0, phases = 0, counters = 0;
+    for (const auto& event : root["traceEvents"]) {
+        std::string name = event["name"].asString();
+        if (name == "frame") {
+            ++frames;
+            EXPECT_EQ(event["ph"].asString(), "X");
+            EXPECT_GE(event["dur"].asInt64(), 0);
+        } else if (name == "drawMessages") {
+            ++phases;
+        } else if (name == "drawCalls") {
+            ++counters;
+            EXPECT_EQ(event["ph"].asString(), "C");
+            EXPECT_EQ(event["args"]["drawCalls"].asInt(), 7);
+        }
+    }
+    EXPECT_EQ(frames, 3);
+    EXPECT_EQ(phases, 3);
+    EXPECT_EQ(counters, 3);
+}
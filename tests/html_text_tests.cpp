@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include "HtmlText.h"
+#include <string>
+
+using namespace MailTMAPI;
+
+// Helper function returning only the text, without inline links
+std::string textOf(const std::string& html) {
+    return HtmlText::convert(html, false).text;
+}
+
+// Test decoding named and numeric character references
+TEST(HtmlTextTests, DecodesEntities) {
+    EXPECT_EQ(textOf("a &amp; b &lt;c&gt; &quot;d&quot;"), "a & b <c> \"d\"");
+    EXPECT_EQ(textOf("&nbsp;&copy;&rarr;&hellip;"), " ©→…") << "Named references beyond the basic four";
+    EXPECT_EQ(textOf("&#8212;&#x2022;&#X41;&#146;"), "—•A’") << "Decimal, hex and Windows-1252 references";
+    EXPECT_EQ(textOf("&copy2024 &amp"), "©2024 &") << "Legacy names without ';'";
+    EXPECT_EQ(textOf("&bogus; & &#; &#0;"), "&bogus; & &#; �") << "Unknown references stay as text";
+}
+
+// Test dropping markup that is never shown
+TEST(HtmlTextTests, DropsHiddenContent) {
+    std::string html = "<html><head><title>Sale</title><STYLE>.a { color: red; } p > a {}</STYLE></head>"
+                       "<body><!-- tracking <b>pixel</b> --><script>if (a < b) {}</script>Hello"
+                       "<![if mso]> <span class=\"x\">world</span></body></html>";
+    EXPECT_EQ(textOf(html), "Hello world");
+    EXPECT_EQ(textOf("1 < 2 and <3"), "1 < 2 and <3") << "A '<' that starts no tag is text";
+    EXPECT_EQ(textOf("<img alt=\"a > b\">x"), " x") << "Quoted attribute values may contain '>'";
+}
+
+// Test that block elements start new lines
+TEST(HtmlTextTests, BreaksLinesAtBlocks) {
+    EXPECT_EQ(textOf("<p>One</p><p>Two<br/>Three</p><div>Four</div>"), "One\nTwo\nThree\nFour\n");
+    EXPECT_EQ(textOf("<table><tr><td>a</td><td>b</td></tr></table>"), " a  b \n");
+}
+
+// Test extracting links with their anchor text
+TEST(HtmlTextTests, ExtractsLinks) {
+    std::string html = "Click <a class=\"btn\" href=\"https://example.com/x?a=1&amp;b=2&copy=3\">\n  Shop&nbsp;now </a>"
+                       " or <A HREF='https://example.com/y'>https://example.com/y</A> <a name=\"top\">top</a>";
+    HtmlTextResult result = HtmlText::convert(html, false);
+    ASSERT_EQ(result.links.size(), 2u);
+    EXPECT_EQ(result.links[0].url, "https://example.com/x?a=1&b=2&copy=3") << "'&copy=' in a URL is not a reference";
+    EXPECT_EQ(result.links[0].text, "Shop now");
+    EXPECT_EQ(result.links[1].url, "https://example.com/y");
+
+    // Inline links put the URL after the anchor text so the layout can make it clickable
+    std::string text = HtmlText::convert(html).text;
+    EXPECT_NE(text.find("Shop now  https://example.com/x?a=1&b=2&copy=3 "), std::string::npos);
+    EXPECT_EQ(text.find("https://example.com/y"), text.rfind("https://example.com/y")) << "Not repeated when it is the anchor text";
+}
+
+// Test that long runs, which use the vectorized scan, find every '<' and '&'
+TEST(HtmlTextTests, ScansLongRuns) {
+    std::string plain(100, 'x');
+    for (size_t offset = 0; offset < 40; ++offset) {
+        std::string html = plain.substr(0, offset) + "&amp;" + plain + "<b>" + plain.substr(0, offset) + "</b>";
+        EXPECT_EQ(textOf(html), plain.substr(0, offset) + "&" + plain + plain.substr(0, offset));
+    }
+}
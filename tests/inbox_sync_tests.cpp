@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "InboxSync.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace MailTMAPI;
+
+// Helper function to build a /messages page from (id, createdAt) pairs, newest first
+std::string makePage(const std::vector<std::pair<std::string, std::string>>& messages, const std::string& next = "") {
+    Json::Value page;
+    page["hydra:member"] = Json::Value(Json::arrayValue);
+    for (const auto& message : messages) {
+        Json::Value summary;
+        summary["id"] = message.first;
+        summary["createdAt"] = message.second;
+        page["hydra:member"].append(summary);
+    }
+    if (!next.empty()) {
+        page["hydra:view"]["hydra:next"] = next;
+    }
+    Json::StreamWriterBuilder writer;
+    return Json::writeString(writer, page);
+}
+
+// Helper function to collect the IDs of synced messages
+std::vector<std::string> idsOf(const std::vector<MessageSummary>& messages) {
+    std::vector<std::string> ids;
+    for (const auto& message : messages) {
+        ids.push_back(message.id);
+    }
+    return ids;
+}
+
+// Test that the first sync reads one page and sets the watermark
+TEST(InboxSyncTests, FirstSyncReadsFirstPage) {
+    InboxSync sync{InboxCursor()};
+    std::string next = sync.addPage(makePage({{"c", "2024-01-01T10:00:02+00:00"},
+                                              {"b", "2024-01-01T10:00:01+00:00"},
+                                              {"a", "2024-01-01T10:00:01+00:00"}}, "/messages?page=2"));
+    EXPECT_TRUE(next.empty()) << "An empty cursor must not walk the whole inbox";
+    EXPECT_EQ(idsOf(sync.takeMessages()), (std::vector<std::string>{"c", "b", "a"}));
+
+    InboxCursor cursor = sync.getCursor();
+    EXPECT_EQ(cursor.createdAt, "2024-01-01T10:00:02+00:00");
+    EXPECT_EQ(cursor.ids, std::vector<std::string>{"c"});
+}
+
+// Test that a sync stops at the watermark and returns only the delta
+TEST(InboxSyncTests, ReturnsOnlyNewMessages) {
+    InboxCursor cursor{"2024-01-01T10:00:02+00:00", {"c"}};
+    InboxSync sync(cursor);
+    std::string next = sync.addPage(makePage({{"e", "2024-01-01T10:00:03+00:00"},
+                                              {"d", "2024-01-01T10:00:02+00:00"},
+                                              {"c", "2024-01-01T10:00:02+00:00"},
+                                              {"b", "2024-01-01T10:00:01+00:00"}}, "/messages?page=2"));
+    EXPECT_TRUE(next.empty()) << "The watermark was reached on the first page";
+    EXPECT_EQ(idsOf(sync.takeMessages()), (std::vector<std::string>{"e", "d"}))
+        << "Unseen messages sharing the watermark's timestamp are new too";
+    EXPECT_EQ(sync.getCursor().ids, std::vector<std::string>{"e"});
+}
+
+// Test that a sync follows hydra:next until it finds known mail
+TEST(InboxSyncTests, PagesUntilWatermark) {
+    InboxSync sync(InboxCursor{"2024-01-01T10:00:01+00:00", {"a"}});
+    std::string next = sync.addPage(makePage({{"d", "2024-01-01T10:00:05+00:00"},
+                                              {"c", "2024-01-01T10:00:04+00:00"}}, "/messages?page=2"));
+    EXPECT_EQ(next, "/messages?page=2");
+    next = sync.addPage(makePage({{"c", "2024-01-01T10:00:04+00:00"}, // Shifted by mail arriving mid-sync
+                                  {"b", "2024-01-01T10:00:03+00:00"},
+                                  {"a", "2024-01-01T10:00:01+00:00"}}, "/messages?page=3"));
+    EXPECT_TRUE(next.empty());
+    EXPECT_EQ(idsOf(sync.takeMessages()), (std::vector<std::string>{"d", "c", "b"}));
+    EXPECT_EQ(sync.getCursor().createdAt, "2024-01-01T10:00:05+00:00");
+}
+
+// Test that IDs at an unchanged watermark timestamp accumulate
+TEST(InboxSyncTests, SameSecondKeepsEarlierIds) {
+    InboxSync sync(InboxCursor{"2024-01-01T10:00:01+00:00", {"a"}});
+    sync.addPage(makePage({{"b", "2024-01-01T10:00:01+00:00"}, {"a", "2024-01-01T10:00:01+00:00"}}));
+    EXPECT_EQ(sync.getCursor().ids, (std::vector<std::string>{"a", "b"}));
+}
+
+// Test that a sync stopped at the page limit keeps the watermark and resumes where it stopped
+TEST(InboxSyncTests, StoppedSyncResumes) {
+    InboxCursor cursor{"2024-01-01T10:00:01+00:00", {"a"}};
+    InboxSync first(cursor);
+    std::string next = first.addPage(makePage({{"d", "2024-01-01T10:00:05+00:00"},
+                                               {"c", "2024-01-01T10:00:04+00:00"}}, "/messages?page=2"));
+    first.stop(next);
+    EXPECT_EQ(idsOf(first.takeMessages()), (std::vector<std::string>{"d", "c"}));
+    cursor = first.getCursor();
+    EXPECT_EQ(cursor.createdAt, "2024-01-01T10:00:01+00:00") << "Older unseen mail must not be skipped";
+    EXPECT_EQ(cursor.resumeLink, "/messages?page=2");
+
+    InboxSync second(cursor);
+    next = second.addPage(makePage({{"c", "2024-01-01T10:00:04+00:00"}, // Shifted by mail arriving in between
+                                    {"b", "2024-01-01T10:00:03+00:00"},
+                                    {"a", "2024-01-01T10:00:01+00:00"}}, "/messages?page=3"));
+    EXPECT_TRUE(next.empty());
+    EXPECT_EQ(idsOf(second.takeMessages()), std::vector<std::string>{"b"}) << "Each message is returned once";
+    cursor = second.getCursor();
+    EXPECT_EQ(cursor.createdAt, "2024-01-01T10:00:05+00:00");
+    EXPECT_EQ(cursor.ids, std::vector<std::string>{"d"});
+    EXPECT_TRUE(cursor.resumeLink.empty());
+    EXPECT_TRUE(cursor.returnedIds.empty());
+}
+
+// Test that failed syncs leave the cursor untouched
+TEST(InboxSyncTests, FailureKeepsCursor) {
+    InboxCursor cursor{"2024-01-01T10:00:01+00:00", {"a"}};
+    InboxSync sync(cursor);
+    sync.addPage(makePage({{"c", "2024-01-01T10:00:04+00:00"}}, "/messages?page=2"));
+    sync.abort(); // The second page request failed
+    EXPECT_TRUE(sync.hasFailed());
+    EXPECT_EQ(sync.getCursor().createdAt, cursor.createdAt);
+
+    InboxSync garbage(cursor);
+    EXPECT_TRUE(garbage.addPage("not json").empty());
+    EXPECT_TRUE(garbage.hasFailed());
+}
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include "JsonParser.h"
+#include <string>
+
+using namespace MailTMAPI;
+
+// Test that the reused reader parses documents like parseFromStream did
+TEST(JsonParserTests, ParsesInPlace) {
+    Json::Value root;
+    ASSERT_TRUE(JsonParser::local().parse(R"({"hydra:member":[{"id":"a"},{"id":"b"}]})", root));
+    EXPECT_EQ(root["hydra:member"][1]["id"].asString(), "b");
+
+    std::string errors;
+    EXPECT_FALSE(JsonParser::local().parse("{\"id\":", root, &errors));
+    EXPECT_FALSE(errors.empty());
+    ASSERT_TRUE(JsonParser::local().parse(R"({"id":"c"})", root)) << "The reader is reusable after an error";
+    EXPECT_EQ(root["id"].asString(), "c");
+}
+
+// Test extracting top-level string fields without a DOM
+TEST(JsonParserTests, FindsTopLevelStrings) {
+    std::string response = R"({"@id":"/accounts/1", "nested":{"token":"inner","list":[1,"]",{"x":"}"}]},
+                               "quota":40000000,"isDisabled":false, "token" : "abc.def"})";
+    EXPECT_EQ(JsonParser::findString(response, "token"), "abc.def") << "Nested fields with the same name are skipped";
+    EXPECT_EQ(JsonParser::findString(response, "@id"), "/accounts/1");
+    EXPECT_FALSE(JsonParser::findString(response, "quota").has_value()) << "Not a string";
+    EXPECT_FALSE(JsonParser::findString(response, "missing").has_value());
+}
+
+// Test that escapes in values and keys are decoded
+TEST(JsonParserTests, DecodesEscapes) {
+    EXPECT_EQ(JsonParser::findString(R"({"s":"a\"b\\c\/d\né😀"})", "s"), "a\"b\\c/d\n\xC3\xA9\xF0\x9F\x98\x80");
+    EXPECT_EQ(JsonParser::findString(R"({"token":"x"})", "token"), "x");
+    EXPECT_EQ(JsonParser::findString(R"({"s":"caf\u00e9 \u00E9"})", "s"), "caf\xC3\xA9 \xC3\xA9");
+    EXPECT_EQ(JsonParser::findString(R"({"s":"\ud83d\ude00!"})", "s"), "\xF0\x9F\x98\x80!") << "Surrogate pair";
+    EXPECT_EQ(JsonParser::findString(R"({"to\u006ben":"y","a\"b":"z"})", "token"), "y") << "Escaped key";
+    EXPECT_EQ(JsonParser::findString(R"({"to\u006ben":"y","a\"b":"z"})", "a\"b"), "z");
+}
+
+// Test that malformed input is reported
+TEST(JsonParserTests, ReportsMalformedInput) {
+    bool malformed = false;
+    EXPECT_FALSE(JsonParser::findString("", "id", &malformed).has_value());
+    EXPECT_TRUE(malformed) << "Empty bodies are what transport errors produce";
+
+    EXPECT_FALSE(JsonParser::findString(R"({"a":"unterminated)", "id", &malformed).has_value());
+    EXPECT_TRUE(malformed);
+
+    EXPECT_FALSE(JsonParser::findString(R"({"message":"Invalid credentials."})", "token", &malformed).has_value());
+    EXPECT_FALSE(malformed) << "A well-formed error response is not malformed";
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include "Logger.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace MailTMAPI;
+
+// Lines captured from a logger's writer thread
+struct CapturedLines {
+    std::mutex mutex;
+    std::vector<std::pair<LogLevel, std::string>> lines;
+
+    Logger::Sink sink() {
+        return [this](LogLevel level, std::string_view line) {
+            std::lock_guard<std::mutex> lock(mutex);
+            lines.emplace_back(level, std::string(line));
+        };
+    }
+};
+
+// Helper function to drop the time in front of a captured line
+std::string withoutTime(const std::string& line) {
+    return line.substr(line.find(' ') + 1);
+}
+
+// Test that a line logged while the writer sleeps wakes it without a flush
+TEST(LoggerTests, WakesIdleWriter) {
+    CapturedLines captured;
+    Logger logger(captured.sink(), 16);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50)); // Let the writer go to sleep
+    logger.write(LogLevel::Info, "after a quiet spell");
+    for (int i = 0; i < 500; ++i) {
+        {
+            std::lock_guard<std::mutex> lock(captured.mutex);
+            if (!captured.lines.empty()) {
+                break;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    std::lock_guard<std::mutex> lock(captured.mutex);
+    ASSERT_EQ(captured.lines.size(), 1u) << "The writer never woke up";
+    EXPECT_EQ(withoutTime(captured.lines[0].second), "INFO  after a quiet spell");
+}
+
+// Test that arguments are formatted in order behind the time and level
+TEST(LoggerTests, FormatsLines) {
+    CapturedLines captured;
+    {
+        Logger logger(captured.sink(), 16);
+        std::string name = "inbox";
+        logger.write(LogLevel::Info, "New messages: ", 3, " in ", name, ' ', 2.5, ' ', true);
+        logger.write(LogLevel::Error, "CURL error: ", static_cast<const char*>(nullptr));
+        logger.flush();
+        ASSERT_EQ(captured.lines.size(), 2u);
+    }
+    EXPECT_EQ(captured.lines[0].first, LogLevel::Info);
+    EXPECT_EQ(withoutTime(captured.lines[0].second), "INFO  New messages: 3 in inbox 2.5 true");
+    EXPECT_EQ(captured.lines[1].first, LogLevel::Error);
+    EXPECT_EQ(withoutTime(captured.lines[1].second), "ERROR CURL error: (null)");
+    EXPECT_EQ(captured.lines[0].second[2], ':'); // HH:MM:SS.mmm
+}
+
+// Test that long lines are cut at lineCapacity
+TEST(LoggerTests, TruncatesLongLines) {
+    CapturedLines captured;
+    {
+        Logger logger(captured.sink(), 4);
+        logger.write(LogLevel::Warn, std::string(Logger::lineCapacity + 100, 'x'));
+    } // The destructor writes what is pending
+    ASSERT_EQ(captured.lines.size(), 1u);
+    EXPECT_EQ(withoutTime(captured.lines[0].second), "WARN  " + std::string(Logger::lineCapacity, 'x'));
+}
+
+// Test that a full ring drops lines instead of blocking, and reports how many
+TEST(LoggerTests, DropsWhenFull) {
+    std::mutex gate;
+    std::atomic<bool> writerBlocked{false};
+    std::vector<std::string> lines;
+    std::unique_lock<std::mutex> hold(gate);
+    {
+        Logger logger([&](LogLevel, std::string_view line) {
+            writerBlocked = true;
+            std::lock_guard<std::mutex> lock(gate); // Stalls the writer like a slow terminal
+            lines.emplace_back(withoutTime(std::string(line)));
+        }, 4);
+        logger.write(LogLevel::Info, "first");
+        while (!writerBlocked) {
+            std::this_thread::yield();
+        }
+        for (int i = 0; i < 10; ++i) { // 4 fit while the writer is stuck on "first"
+            logger.write(LogLevel::Info, "line ", i);
+        }
+        EXPECT_EQ(logger.getDropped(), 6u);
+        hold.unlock();
+    }
+    ASSERT_EQ(lines.size(), 6u);
+    EXPECT_EQ(lines[0], "INFO  first");
+    EXPECT_EQ(lines[1], "WARN  Logger dropped 6 lines, the ring was full");
+    EXPECT_EQ(lines[2], "INFO  line 0");
+    EXPECT_EQ(lines[5], "INFO  line 3");
+}
+
+// Test that lines from many threads all arrive, each thread's in order
+TEST(LoggerTests, HandlesConcurrentProducers) {
+    const int producers = 4;
+    const int perProducer = 2000;
+    CapturedLines captured;
+    {
+        Logger logger(captured.sink(), producers * perProducer);
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p) {
+            threads.emplace_back([&logger, p]() {
+                for (int i = 0; i < perProducer; ++i) {
+                    logger.write(LogLevel::Debug, p, ' ', i);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+    ASSERT_EQ(captured.lines.size(), static_cast<size_t>(producers * perProducer));
+    std::vector<int> next(producers, 0);
+    for (const auto& [level, line] : captured.lines) {
+        std::string text = withoutTime(line).substr(6);
+        int producer = std::stoi(text);
+        int index = std::stoi(text.substr(text.find(' ') + 1));
+        EXPECT_EQ(index, next[producer]++);
+    }
+}
+
+// Test that levels below LAMBDAMAIL_LOG_LEVEL never evaluate their arguments
+TEST(LoggerTests, CompilesOutDisabledLevels) {
+    int evaluated = 0;
+    auto count = [&evaluated]() { return ++evaluated; };
+    LOG_DEBUG("debug ", count());
+    LOG_ERROR("error ", count());
+    Logger::instance().flush();
+    EXPECT_EQ(evaluated, LAMBDAMAIL_LOG_LEVEL <= 0 ? 2 : 1);
+}
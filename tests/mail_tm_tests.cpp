@@ -100,8 +100,10 @@ TEST(MailTMTests, CheckInboxTest) {
     auto token = retry([&]() { return mailTm.authenticate(email, password); });
     ASSERT_TRUE(token.has_value()) << "Authentication failed";
 
-    auto messages = retry([&]() { return mailTm.checkInbox(token.value()); });
-    EXPECT_GE(messages.size(), 0) << "Inbox size should be valid";
+    long status = 0;
+    auto messages = mailTm.checkInbox(token.value(), status);
+    EXPECT_EQ(status, 200) << "Inbox request should succeed";
+    EXPECT_TRUE(messages.empty()) << "A new inbox has no mail";
 }
 
 // Test getAccountId
@@ -154,3 +156,62 @@ TEST(MailTMTests, DeleteAccountTest) {
     ASSERT_TRUE(deleteResult.has_value()) << "Account deletion failed";
     EXPECT_EQ(deleteResult.value(), "Account deleted successfully");
 }
+
+// Test checkInboxAsync and authenticateAsync
+TEST(MailTMTests, CheckInboxAsyncTest) {
+    MailTM mailTm;
+    std::string username = generateUniqueUsername();
+    std::string password = "testpassword";
+
+    auto domain = mailTm.getAvailableDomain();
+    ASSERT_FALSE(domain.empty()) << "Domain should not be empty";
+
+    std::string email = username + "@" + domain;
+
+    auto accountId = retry([&]() { return mailTm.registerEmail(email, password); });
+    ASSERT_TRUE(accountId.has_value()) << "Account ID should be returned";
+
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+
+    auto token = retry([&]() { return mailTm.authenticateAsync(email, password).get(); });
+    ASSERT_TRUE(token.has_value()) << "Authentication failed";
+
+    // Several inbox requests in flight at once should all complete
+    std::vector<std::future<std::vector<MessageSummary>>> inboxes;
+    for (int i = 0; i < 5; ++i) {
+        inboxes.push_back(mailTm.checkInboxAsync(token.value()));
+    }
+    for (auto& inbox : inboxes) {
+        EXPECT_TRUE(inbox.get().empty()) << "A new inbox has no mail";
+    }
+}
+
+// Test getMessages keeps one result per ID in request order
+TEST(MailTMTests, GetMessagesTest) {
+    MailTM mailTm;
+    std::string username = generateUniqueUsername();
+    std::string password = "testpassword";
+
+    auto domain = mailTm.getAvailableDomain();
+    ASSERT_FALSE(domain.empty()) << "Domain should not be empty";
+
+    std::string email = username + "@" + domain;
+
+    auto accountId = retry([&]() { return mailTm.registerEmail(email, password); });
+    ASSERT_TRUE(accountId.has_value()) << "Account ID should be returned";
+
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+
+    auto token = retry([&]() { return mailTm.authenticate(email, password); });
+    ASSERT_TRUE(token.has_value()) << "Authentication failed";
+
+    EXPECT_TRUE(mailTm.getMessages(token.value(), {}).empty()) << "Empty batch should return no messages";
+
+    // Unknown IDs still produce one (empty) entry each, in order
+    std::vector<std::string> ids = {"missing-1", "missing-2", "missing-3"};
+    auto fetched = mailTm.getMessages(token.value(), ids, 2);
+    ASSERT_EQ(fetched.size(), ids.size()) << "One result per requested ID";
+    for (const auto& message : fetched) {
+        EXPECT_FALSE(message.has_value()) << "Unknown IDs should not return messages";
+    }
+}
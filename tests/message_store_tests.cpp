@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+#include "MessageStore.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+using namespace MailTMAPI;
+
+namespace fs = std::filesystem;
+
+// Helper function to build a message with a body
+Message makeMessage(const std::string& id, const std::string& createdAt) {
+    Message message;
+    message.id = id;
+    message.createdAt = createdAt;
+    message.subject = "Subject " + id;
+    message.from.address = InternedString("sender@example.com");
+    message.text = "Body of " + id;
+    message.html = "<p>Body of " + id + "</p>";
+    return message;
+}
+
+// Fixture that gives every test an empty store directory
+class MessageStoreTests : public ::testing::Test {
+protected:
+    fs::path root;
+    const std::string address = "me@example.com";
+
+    void SetUp() override {
+        root = fs::temp_directory_path() / ("message_store_test_" + std::to_string(::getpid()) + "_" +
+                                            ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        fs::remove_all(root);
+    }
+
+    void TearDown() override {
+        fs::remove_all(root);
+    }
+
+    fs::path file(const std::string& name) const {
+        return root / address / name;
+    }
+};
+
+// Test that stored messages read back with every field
+TEST_F(MessageStoreTests, RoundTrip) {
+    MessageStore store;
+    ASSERT_TRUE(store.open(root.string(), address));
+    EXPECT_EQ(store.size(), 0u);
+
+    Message message = makeMessage("a1", "2024-05-20T10:00:00+00:00");
+    message.to.push_back(Address{InternedString("me@example.com"), InternedString("Me")});
+    message.attachments.push_back(Attachment{"ATT1", "a.pdf", "application/pdf", 12, "/messages/a1/attachment/ATT1"});
+    EXPECT_EQ(store.append({message}), 1u);
+
+    ASSERT_TRUE(store.contains("a1"));
+    auto stored = store.get("a1");
+    ASSERT_TRUE(stored.has_value());
+    EXPECT_EQ(stored->subject, "Subject a1");
+    EXPECT_EQ(stored->from.address.str(), "sender@example.com");
+    EXPECT_EQ(stored->text, "Body of a1");
+    EXPECT_EQ(stored->html, "<p>Body of a1</p>");
+    ASSERT_EQ(stored->to.size(), 1u);
+    EXPECT_EQ(stored->to[0].name.str(), "Me");
+    ASSERT_EQ(stored->attachments.size(), 1u);
+    EXPECT_EQ(stored->attachments[0].downloadUrl, "/messages/a1/attachment/ATT1");
+    EXPECT_FALSE(store.get("missing").has_value());
+}
+
+// Test that duplicates and unusable IDs are skipped
+TEST_F(MessageStoreTests, SkipsDuplicates) {
+    MessageStore store;
+    ASSERT_TRUE(store.open(root.string(), address));
+    EXPECT_EQ(store.append({makeMessage("a1", "t1"), makeMessage("a1", "t1"), makeMessage("", "t1")}), 1u);
+    EXPECT_EQ(store.append({makeMessage("a1", "t1"), makeMessage("a2", "t2")}), 1u);
+    EXPECT_EQ(store.append({makeMessage(std::string(40, 'x'), "t3")}), 0u) << "IDs must fit the index entry";
+    EXPECT_EQ(store.size(), 2u);
+}
+
+// Test that a message without a timestamp is stored but does not move the watermark
+TEST_F(MessageStoreTests, StoresMessagesWithoutCreatedAt) {
+    {
+        MessageStore store;
+        ASSERT_TRUE(store.open(root.string(), address));
+        EXPECT_EQ(store.append({makeMessage("a1", "2024-05-20T10:00:00+00:00"), makeMessage("a2", "")}), 2u);
+    }
+    MessageStore store;
+    ASSERT_TRUE(store.open(root.string(), address));
+    EXPECT_EQ(store.size(), 2u) << "Recovery keeps it too";
+    ASSERT_TRUE(store.get("a2").has_value());
+    EXPECT_EQ(store.get("a2")->createdAt, "");
+    EXPECT_EQ(store.cursor().ids, std::vector<std::string>{"a1"});
+}
+
+// Test that a reopened store has the messages, newest first, and the sync watermark
+TEST_F(MessageStoreTests, ReopenKeepsMessages) {
+    {
+        MessageStore store;
+        ASSERT_TRUE(store.open(root.string(), address));
+        store.append({makeMessage("a1", "2024-05-20T10:00:00+00:00"), makeMessage("a2", "2024-05-20T11:00:00+00:00")});
+        store.append({makeMessage("a4", "2024-05-20T12:00:00+00:00"), makeMessage("a3", "2024-05-20T12:00:00+00:00")});
+    }
+    MessageStore store;
+    ASSERT_TRUE(store.open(root.string(), address));
+    EXPECT_EQ(store.size(), 4u);
+
+    auto latest = store.latest(3);
+    ASSERT_EQ(latest.size(), 3u);
+    EXPECT_EQ(latest[0].id, "a3");
+    EXPECT_EQ(latest[1].id, "a4");
+    EXPECT_EQ(latest[2].id, "a2");
+
+    InboxCursor cursor = store.cursor();
+    EXPECT_EQ(cursor.createdAt, "2024-05-20T12:00:00+00:00");
+    EXPECT_EQ(cursor.ids, (std::vector<std::string>{"a3", "a4"}));
+}
+
+// Test that a second open of the same account is refused while the first is open
+TEST_F(MessageStoreTests, SingleOwner) {
+    MessageStore first;
+    ASSERT_TRUE(first.open(root.string(), address));
+    MessageStore second;
+    EXPECT_FALSE(second.open(root.string(), address));
+}
+
+// Test recovery from a record torn halfway through writing
+TEST_F(MessageStoreTests, RecoversTornRecord) {
+    {
+        MessageStore store;
+        ASSERT_TRUE(store.open(root.string(), address));
+        store.append({makeMessage("a1", "t1"), makeMessage("a2", "t2")});
+    }
+    auto intactSize = fs::file_size(file("messages.log"));
+    {
+        std::ofstream log(file("messages.log"), std::ios::binary | std::ios::app);
+        log.write("MTM1\x40\x00\x00\x00garbage", 15);
+    }
+
+    MessageStore store;
+    ASSERT_TRUE(store.open(root.string(), address));
+    EXPECT_EQ(store.size(), 2u);
+    EXPECT_EQ(fs::file_size(file("messages.log")), intactSize) << "The torn tail is truncated";
+    EXPECT_EQ(store.append({makeMessage("a3", "t3")}), 1u);
+    ASSERT_TRUE(store.get("a3").has_value());
+    ASSERT_TRUE(store.get("a2").has_value());
+}
+
+// Test that records the index never learned about are re-indexed
+TEST_F(MessageStoreTests, ReindexesMissingEntries) {
+    {
+        MessageStore store;
+        ASSERT_TRUE(store.open(root.string(), address));
+        store.append({makeMessage("a1", "t1")});
+        store.append({makeMessage("a2", "t2"), makeMessage("a3", "t3")});
+    }
+    // A crash between syncing the log and writing the index, plus a torn index entry
+    fs::resize_file(file("messages.idx"), sizeof(MessageStore::IndexEntry) + 20);
+
+    MessageStore store;
+    ASSERT_TRUE(store.open(root.string(), address));
+    EXPECT_EQ(store.size(), 3u);
+    EXPECT_EQ(fs::file_size(file("messages.idx")), 3 * sizeof(MessageStore::IndexEntry));
+    auto message = store.get("a3");
+    ASSERT_TRUE(message.has_value());
+    EXPECT_EQ(message->text, "Body of a3");
+    EXPECT_EQ(store.cursor().createdAt, "t3");
+}
+
+// Test that index entries pointing past a shortened log are dropped
+TEST_F(MessageStoreTests, DropsEntriesPastLog) {
+    uintmax_t firstRecordEnd;
+    {
+        MessageStore store;
+        ASSERT_TRUE(store.open(root.string(), address));
+        store.append({makeMessage("a1", "t1")});
+        firstRecordEnd = fs::file_size(file("messages.log"));
+        store.append({makeMessage("a2", "t2")});
+    }
+    fs::resize_file(file("messages.log"), firstRecordEnd + 5);
+
+    MessageStore store;
+    ASSERT_TRUE(store.open(root.string(), address));
+    EXPECT_EQ(store.size(), 1u);
+    EXPECT_FALSE(store.contains("a2"));
+    EXPECT_EQ(fs::file_size(file("messages.log")), firstRecordEnd);
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include "Message.h"
+#include "JsonParser.h"
+#include <string>
+
+using namespace MailTMAPI;
+
+// Helper function to parse a JSON literal
+Json::Value parseJson(const std::string& text) {
+    Json::Value root;
+    EXPECT_TRUE(JsonParser::local().parse(text, root));
+    return root;
+}
+
+// Test reading a full /messages/{id} response
+TEST(MessageTests, ReadsFullMessage) {
+    Message message = Message::fromJson(parseJson(R"({
+        "id": "6650f1", "subject": "Your code", "intro": "Use 482913", "seen": true, "hasAttachments": true,
+        "size": 4200, "createdAt": "2024-05-20T23:00:13+00:00",
+        "from": {"address": "noreply@example.com", "name": "Service"},
+        "to": [{"address": "me@example.com", "name": ""}],
+        "text": "Use 482913 to sign in", "html": ["<p>Use ", "<b>482913</b></p>"],
+        "attachments": [{"id": "ATTACH1", "filename": "a.pdf", "contentType": "application/pdf", "size": 12,
+                         "downloadUrl": "/messages/6650f1/attachment/ATTACH1"}]
+    })"));
+
+    EXPECT_EQ(message.id, "6650f1");
+    EXPECT_EQ(message.from.address.str(), "noreply@example.com");
+    EXPECT_EQ(message.from.name.str(), "Service");
+    EXPECT_EQ(message.subject, "Your code");
+    EXPECT_TRUE(message.seen);
+    EXPECT_EQ(message.size, 4200u);
+    ASSERT_EQ(message.to.size(), 1u);
+    EXPECT_EQ(message.to[0].address.str(), "me@example.com");
+    EXPECT_EQ(message.html, "<p>Use <b>482913</b></p>") << "HTML parts are joined";
+    ASSERT_EQ(message.attachments.size(), 1u);
+    EXPECT_EQ(message.attachments[0].filename, "a.pdf");
+    EXPECT_EQ(message.attachments[0].size, 12u);
+}
+
+// Test that missing or mistyped fields fall back to empty values
+TEST(MessageTests, ToleratesMissingFields) {
+    Message message = Message::fromJson(parseJson(R"({"id": "x", "subject": null, "from": "not an object", "html": 5})"));
+    EXPECT_EQ(message.id, "x");
+    EXPECT_TRUE(message.subject.empty());
+    EXPECT_TRUE(message.from.address.empty());
+    EXPECT_TRUE(message.html.empty());
+
+    EXPECT_TRUE(MessageSummary::fromJson(Json::Value()).id.empty()) << "A null value gives an empty summary";
+}
+
+// Test that equal sender strings share one copy and are released when unused
+TEST(MessageTests, InternsSenders) {
+    std::string sender = "interned-" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) + "@example.com";
+    {
+        InternedString first(sender);
+        std::string copy = sender; // Separate buffer, same text
+        InternedString second(copy);
+        EXPECT_EQ(&first.str(), &second.str()) << "Equal values share storage";
+        EXPECT_EQ(first, second);
+        EXPECT_NE(first, InternedString("other@example.com"));
+    }
+    InternedString again(sender);
+    EXPECT_EQ(again.str(), sender) << "Released values can be interned again";
+    EXPECT_TRUE(InternedString().str().empty());
+}
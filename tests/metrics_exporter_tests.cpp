@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include "CurlWrapper.h"
+#include "MetricsExporter.h"
+#include <chrono>
+#include <ctime>
+#include <string>
+
+using namespace MailTMAPI;
+
+// Helper function to fetch a page from the exporter
+std::string scrapeExporter(uint16_t port, const std::string& path, long& status) {
+    std::string body;
+    std::string url = "http://127.0.0.1:" + std::to_string(port) + path;
+    CurlWrapper curl;
+    curl.setOption(CURLOPT_URL, url.c_str());
+    curl.setOption(CURLOPT_WRITEFUNCTION, +[](void* data, size_t size, size_t count, void* out) {
+        static_cast<std::string*>(out)->append(static_cast<char*>(data), size * count);
+        return size * count;
+    });
+    curl.setOption(CURLOPT_WRITEDATA, &body);
+    status = curl.perform() == CURLE_OK ? curl.getResponseCode() : 0;
+    return body;
+}
+
+// Helper function to format a time as the API does
+std::string isoTimeAgo(std::chrono::seconds age) {
+    std::time_t when = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now() - age);
+    char buffer[32];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S+00:00", std::gmtime(&when));
+    return buffer;
+}
+
+// Test the text format of families and samples, including label escaping
+TEST(MetricsExporterTests, WritesTextFormat) {
+    MetricsWriter writer;
+    writer.family("mailtm_polls_total", "counter", "Inbox polls.");
+    writer.sample("mailtm_polls_total", 3, {{"result", "ok"}});
+    writer.sample("mailtm_odd", 0.25, {{"path", "a\"b\\c\nd"}, {"x", "y"}});
+    writer.sample("mailtm_plain", 12);
+    EXPECT_EQ(writer.str(), "# HELP mailtm_polls_total Inbox polls.\n"
+                            "# TYPE mailtm_polls_total counter\n"
+                            "mailtm_polls_total{result=\"ok\"} 3\n"
+                            "mailtm_odd{path=\"a\\\"b\\\\c\\nd\",x=\"y\"} 0.25\n"
+                            "mailtm_plain 12\n");
+}
+
+// Test that histogram buckets are cumulative and in seconds
+TEST(MetricsExporterTests, WritesCumulativeHistogram) {
+    LatencyHistogram histogram;
+    histogram.record(500); // 0.5 ms
+    histogram.record(3000); // 3 ms
+    histogram.record(3000);
+    histogram.record(400000000); // 400 s, past the last bound
+    MetricsWriter writer;
+    writer.histogram("lag_seconds", histogram.snapshot(), {{"endpoint", "inbox"}});
+    const std::string& text = writer.str();
+    EXPECT_NE(text.find("lag_seconds_bucket{endpoint=\"inbox\",le=\"0.001\"} 1\n"), std::string::npos) << text;
+    EXPECT_NE(text.find("lag_seconds_bucket{endpoint=\"inbox\",le=\"0.0025\"} 1\n"), std::string::npos) << text;
+    EXPECT_NE(text.find("lag_seconds_bucket{endpoint=\"inbox\",le=\"0.005\"} 3\n"), std::string::npos) << text;
+    EXPECT_NE(text.find("lag_seconds_bucket{endpoint=\"inbox\",le=\"300\"} 3\n"), std::string::npos) << text;
+    EXPECT_NE(text.find("lag_seconds_bucket{endpoint=\"inbox\",le=\"+Inf\"} 4\n"), std::string::npos) << text;
+    EXPECT_NE(text.find("lag_seconds_sum{endpoint=\"inbox\"} 400.0065\n"), std::string::npos) << text;
+    EXPECT_NE(text.find("lag_seconds_count{endpoint=\"inbox\"} 4\n"), std::string::npos) << text;
+}
+
+// Test the watcher counters and the arrival lag taken from createdAt
+TEST(MetricsExporterTests, WatcherCountsPollsAndLag) {
+    WatcherMetrics watcher;
+    watcher.recordPoll(PollStatus::Ok);
+    watcher.recordPoll(PollStatus::Ok);
+    watcher.recordPoll(PollStatus::Error);
+    watcher.recordPoll(PollStatus::RateLimited);
+    MessageSummary message;
+    message.createdAt = isoTimeAgo(std::chrono::seconds(90));
+    watcher.recordMessage(message);
+    EXPECT_EQ(watcher.getPolls(), 4u);
+    EXPECT_EQ(watcher.getErrors(), 2u);
+    EXPECT_EQ(watcher.getMessages(), 1u);
+
+    MetricsWriter writer;
+    watcher.write(writer);
+    const std::string& text = writer.str();
+    EXPECT_NE(text.find("mailtm_polls_total{result=\"ok\"} 2\n"), std::string::npos) << text;
+    EXPECT_NE(text.find("mailtm_polls_total{result=\"rate_limited\"} 1\n"), std::string::npos) << text;
+    EXPECT_NE(text.find("mailtm_messages_total 1\n"), std::string::npos) << text;
+    EXPECT_NE(text.find("mailtm_message_lag_seconds_bucket{le=\"60\"} 0\n"), std::string::npos) << text;
+    EXPECT_NE(text.find("mailtm_message_lag_seconds_bucket{le=\"300\"} 1\n"), std::string::npos) << text;
+}
+
+// Test that the exporter serves the collectors' output on /metrics and nothing else
+TEST(MetricsExporterTests, ServesMetrics) {
+    MetricsExporter exporter;
+    int scrapes = 0;
+    exporter.addCollector([&scrapes](MetricsWriter& writer) {
+        writer.family("mailtm_scrapes", "counter", "Scrapes so far.");
+        writer.sample("mailtm_scrapes", ++scrapes);
+    });
+    ASSERT_TRUE(exporter.start(0));
+    ASSERT_NE(exporter.getPort(), 0);
+
+    long status = 0;
+    std::string body = scrapeExporter(exporter.getPort(), "/metrics", status);
+    EXPECT_EQ(status, 200);
+    EXPECT_NE(body.find("mailtm_scrapes 1\n"), std::string::npos) << body;
+    body = scrapeExporter(exporter.getPort(), "/metrics", status);
+    EXPECT_NE(body.find("mailtm_scrapes 2\n"), std::string::npos) << body; // Rendered fresh on every scrape
+
+    scrapeExporter(exporter.getPort(), "/other", status);
+    EXPECT_EQ(status, 404);
+
+    MetricsExporter taken; // The port is already bound
+    EXPECT_FALSE(taken.start(exporter.getPort()));
+}
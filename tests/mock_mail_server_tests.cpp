@@ -0,0 +1,288 @@
+#include <gtest/gtest.h>
+#include "MailTM.h"
+#include "MockMailServer.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace MailTMAPI;
+
+// Helper function to register and log into an account on the mock server
+std::string registerOnMock(MailTM& client, const std::string& address) {
+    EXPECT_TRUE(client.registerEmail(address, "secret").has_value());
+    auto token = client.authenticate(address, "secret");
+    EXPECT_TRUE(token.has_value());
+    return token.value_or("");
+}
+
+// Test the account endpoints: domains, registration, login, /me and deletion
+TEST(MockMailServerTests, AccountLifecycle) {
+    MockMailServer server;
+    MailTM client(server.url());
+    EXPECT_EQ(client.getAvailableDomain(), "example.com");
+
+    auto accountId = client.registerEmail("alice@example.com", "secret");
+    ASSERT_TRUE(accountId.has_value());
+    EXPECT_FALSE(client.registerEmail("alice@example.com", "other").has_value()) << "Addresses are unique";
+    EXPECT_FALSE(client.registerEmail("bob@elsewhere.com", "secret").has_value()) << "Only the listed domain works";
+    EXPECT_FALSE(client.authenticate("alice@example.com", "wrong").has_value());
+
+    auto token = client.authenticate("alice@example.com", "secret");
+    ASSERT_TRUE(token.has_value());
+    EXPECT_EQ(client.getAccountId(*token), accountId);
+    EXPECT_TRUE(client.deleteAccount(*token, *accountId).has_value());
+    EXPECT_FALSE(client.getAccountId(*token).has_value()) << "Tokens die with the account";
+}
+
+// Test that a cached token is not handed out for the wrong password
+TEST(MockMailServerTests, CachedTokenNeedsThePassword) {
+    MockMailServer server;
+    MailTM client(server.url());
+    std::string token = registerOnMock(client, "dave@example.com");
+    size_t requests = server.requestCount();
+
+    EXPECT_EQ(client.authenticate("dave@example.com", "secret"), token) << "Served from the cache";
+    EXPECT_EQ(server.requestCount(), requests);
+    EXPECT_FALSE(client.authenticate("dave@example.com", "wrong").has_value()) << "A miss that the server rejects";
+    EXPECT_EQ(server.requestCount(), requests + 1);
+    EXPECT_EQ(client.authenticate("dave@example.com", "secret"), token) << "The good login stays cached";
+}
+
+// Test paging through a prefilled inbox and fetching new and existing messages
+TEST(MockMailServerTests, InboxAndMessages) {
+    MockServerOptions options;
+    options.inboxSize = 45;
+    MockMailServer server(options);
+    MailTM client(server.url());
+    std::string token = registerOnMock(client, "carol@example.com");
+
+    long status = 0;
+    auto firstPage = client.checkInbox(token, status);
+    EXPECT_EQ(status, 200);
+    ASSERT_EQ(firstPage.size(), 30u);
+    EXPECT_EQ(firstPage.front().subject, "Message 45") << "Newest first";
+
+    InboxCursor cursor;
+    EXPECT_EQ(client.syncInbox(token, cursor, status).size(), 30u) << "A first sync reads one page";
+    std::string id = server.deliver("carol@example.com", "Your code", "Use 482913 to sign in");
+    ASSERT_FALSE(id.empty());
+    auto fresh = client.syncInbox(token, cursor, status);
+    ASSERT_EQ(fresh.size(), 1u);
+    EXPECT_EQ(fresh[0].id, id);
+
+    auto message = client.getMessage(token, id);
+    ASSERT_TRUE(message.has_value());
+    EXPECT_EQ(message->text, "Use 482913 to sign in");
+    ASSERT_EQ(message->to.size(), 1u);
+    EXPECT_EQ(message->to[0].address.str(), "carol@example.com");
+    EXPECT_FALSE(client.getMessage(token, "missing").has_value());
+    EXPECT_TRUE(server.deliver("nobody@example.com", "Lost", "").empty());
+}
+
+// Test that requests without a valid token are refused
+TEST(MockMailServerTests, RequiresToken) {
+    MockMailServer server;
+    MailTM client(server.url());
+    long status = 0;
+    EXPECT_TRUE(client.checkInbox("forged", status).empty());
+    EXPECT_EQ(status, 401);
+}
+
+// Test the injected errors and latency
+TEST(MockMailServerTests, InjectsErrorsAndLatency) {
+    MockServerOptions failing;
+    failing.errorRate = 1;
+    MockMailServer broken(failing);
+    MailTM brokenClient(broken.url());
+    long status = 0;
+    brokenClient.checkInbox("token", status);
+    EXPECT_EQ(status, 500);
+
+    MockServerOptions limited;
+    limited.rateLimitRate = 1;
+    MockMailServer busy(limited);
+    MailTM busyClient(busy.url());
+    busyClient.checkInbox("token", status);
+    EXPECT_EQ(status, 429);
+
+    MockServerOptions slow;
+    slow.latency = std::chrono::milliseconds(50);
+    MockMailServer distant(slow);
+    MailTM distantClient(distant.url());
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(distantClient.getAvailableDomain(), "example.com");
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(50));
+    EXPECT_EQ(broken.requestCount() + busy.requestCount() + distant.requestCount(), 3u);
+}
+
+// Test that async requests share the event loop and finish together rather than one after another
+TEST(MockMailServerTests, AsyncRequestsRunConcurrently) {
+    MockServerOptions slow;
+    slow.inboxSize = 3;
+    slow.latency = std::chrono::milliseconds(100);
+    MockMailServer server(slow);
+    MailTM client(server.url());
+    std::string token = registerOnMock(client, "erin@example.com");
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::future<std::vector<MessageSummary>>> inboxes;
+    for (int i = 0; i < 8; ++i) {
+        inboxes.push_back(client.checkInboxAsync(token));
+    }
+    for (auto& inbox : inboxes) {
+        EXPECT_EQ(inbox.get().size(), 3u);
+    }
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(400))
+        << "Eight requests in sequence would take 800 ms";
+}
+
+// Test that a transport error reaches the callback as status 0 with no body, like the blocking path
+TEST(MockMailServerTests, AsyncTransportError) {
+    std::string url;
+    {
+        MockMailServer server;
+        url = server.url();
+    } // Nothing listens on the port any more
+
+    MailTM client(url);
+    std::promise<long> statusPromise;
+    client.checkInboxAsync("token", [&](std::vector<MessageSummary> inbox, long status) {
+        EXPECT_TRUE(inbox.empty());
+        statusPromise.set_value(status);
+    });
+    auto status = statusPromise.get_future();
+    ASSERT_EQ(status.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+    EXPECT_EQ(status.get(), 0);
+    EXPECT_FALSE(client.getMessageAsync("token", "id").get().has_value());
+
+    long blockingStatus = -1;
+    EXPECT_TRUE(client.checkInbox("token", blockingStatus).empty());
+    EXPECT_EQ(blockingStatus, 0);
+}
+
+// Test that destroying a client with requests in flight finishes them before the token cache and extractor go
+TEST(MockMailServerTests, DestroyWithRequestsInFlight) {
+    MockServerOptions options;
+    options.inboxSize = 2;
+    options.latency = std::chrono::milliseconds(5);
+    options.latencyJitter = std::chrono::milliseconds(40);
+    MockMailServer server(options);
+
+    std::vector<std::future<std::optional<std::string>>> logins;
+    std::vector<std::future<std::optional<Message>>> messages;
+    {
+        MailTM client(server.url());
+        client.enableExtraction();
+        std::string token = registerOnMock(client, "dora@example.com");
+        auto inbox = client.checkInbox(token);
+        ASSERT_EQ(inbox.size(), 2u);
+        client.invalidateToken("dora@example.com");
+        for (int i = 0; i < 16; ++i) {
+            logins.push_back(client.authenticateAsync("dora@example.com", "secret"));
+            messages.push_back(client.getMessageAsync(token, inbox[i % 2].id));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20)); // Some requests have completed, most have not
+    }
+    for (auto& login : logins) {
+        EXPECT_EQ(login.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    }
+    for (auto& message : messages) {
+        EXPECT_EQ(message.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    }
+}
+
+// Test that a batch fetch keeps one result per ID in order, with nothing for a missing message
+TEST(MockMailServerTests, GetMessagesWithMissingId) {
+    MockServerOptions options;
+    options.inboxSize = 4;
+    MockMailServer server(options);
+    MailTM client(server.url());
+    std::string token = registerOnMock(client, "frank@example.com");
+
+    auto inbox = client.checkInboxAsync(token).get();
+    ASSERT_EQ(inbox.size(), 4u);
+    std::vector<std::string> ids = {inbox[0].id, "missing", inbox[2].id, inbox[1].id, inbox[3].id};
+    auto fetched = client.getMessages(token, ids, 2);
+    ASSERT_EQ(fetched.size(), ids.size());
+    EXPECT_FALSE(fetched[1].has_value());
+    for (size_t i : {0u, 2u, 3u, 4u}) {
+        ASSERT_TRUE(fetched[i].has_value()) << "Message " << i;
+        EXPECT_EQ(fetched[i]->id, ids[i]);
+    }
+}
+
+// Test that getMessages refuses to block the event loop its own results arrive on
+TEST(MockMailServerTests, GetMessagesRejectsLoopThread) {
+    MockMailServer server;
+    MailTM client(server.url());
+    std::string token = registerOnMock(client, "grace@example.com");
+
+    std::promise<bool> refused;
+    client.checkInboxAsync(token, [&](std::vector<MessageSummary>, long) {
+        try {
+            client.getMessages(token, {"missing"});
+            refused.set_value(false);
+        } catch (const std::logic_error&) {
+            refused.set_value(true);
+        }
+    });
+    auto result = refused.get_future();
+    ASSERT_EQ(result.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+    EXPECT_TRUE(result.get());
+}
+
+// Helper function to send raw bytes to the mock server and read until it hangs up
+std::string sendRawToMock(const MockMailServer& server, const std::string& request) {
+    std::string url = server.url();
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(static_cast<uint16_t>(std::stoi(url.substr(url.rfind(':') + 1))));
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        return "";
+    }
+    send(fd, request.data(), request.size(), MSG_NOSIGNAL);
+    std::string response;
+    char chunk[4096];
+    ssize_t received;
+    while ((received = recv(fd, chunk, sizeof(chunk), 0)) > 0) {
+        response.append(chunk, received);
+    }
+    close(fd);
+    return response;
+}
+
+// Test that a malformed Content-Length is answered with 400 instead of killing the serving thread
+TEST(MockMailServerTests, RejectsBadContentLength) {
+    MockMailServer server;
+    for (const char* length : {"abc", "-1", "99999999999999999999999", "12x"}) {
+        std::string response = sendRawToMock(server, std::string("POST /token HTTP/1.1\r\nContent-Length: ") + length +
+                                                         "\r\n\r\n{}");
+        EXPECT_EQ(response.compare(0, 12, "HTTP/1.1 400"), 0) << length << ": " << response;
+    }
+    MailTM client(server.url());
+    EXPECT_EQ(client.getAvailableDomain(), "example.com") << "The server keeps serving";
+}
+
+// Test the open login used by load tests against separate processes
+TEST(MockMailServerTests, OpenLogin) {
+    MockServerOptions options;
+    options.openLogin = true;
+    MockMailServer server(options);
+    MailTM client(server.url());
+    EXPECT_TRUE(client.authenticate("load1@example.com", "anything").has_value());
+    EXPECT_FALSE(client.authenticate("load1@elsewhere.com", "anything").has_value()) << "Only the listed domain";
+    EXPECT_EQ(server.addresses(), std::vector<std::string>{"load1@example.com"});
+    EXPECT_FALSE(server.deliver("load1@example.com", "Hi", "Code 123456").empty());
+}
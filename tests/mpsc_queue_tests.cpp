@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include "MpscQueue.h"
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace MailTMAPI;
+
+// Test that values come out in the order they were pushed
+TEST(MpscQueueTests, PopsInOrder) {
+    MpscQueue<std::string> queue;
+    EXPECT_EQ(queue.pop(), std::nullopt);
+
+    queue.push("first");
+    queue.push("second");
+    EXPECT_EQ(queue.pop(), "first");
+    EXPECT_EQ(queue.pop(), "second");
+    EXPECT_EQ(queue.pop(), std::nullopt);
+}
+
+// Test that move-only values are handed over and unpopped ones are freed
+TEST(MpscQueueTests, MovesValues) {
+    auto tracked = std::make_shared<int>(7);
+    {
+        MpscQueue<std::unique_ptr<std::shared_ptr<int>>> queue;
+        queue.push(std::make_unique<std::shared_ptr<int>>(tracked));
+        queue.push(std::make_unique<std::shared_ptr<int>>(tracked));
+        auto value = queue.pop();
+        ASSERT_TRUE(value);
+        EXPECT_EQ(***value, 7);
+        EXPECT_EQ(tracked.use_count(), 3);
+    }
+    EXPECT_EQ(tracked.use_count(), 1) << "The queue frees what was never popped";
+}
+
+// Test that concurrent producers lose nothing and keep their own order
+TEST(MpscQueueTests, HandlesConcurrentProducers) {
+    const int producers = 4;
+    const int perProducer = 50000;
+    MpscQueue<std::pair<int, int>> queue;
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&queue, p]() {
+            for (int i = 0; i < perProducer; ++i) {
+                queue.push({p, i});
+            }
+        });
+    }
+
+    std::vector<int> next(producers, 0);
+    int received = 0;
+    while (received < producers * perProducer) {
+        auto value = queue.pop();
+        if (!value) {
+            std::this_thread::yield();
+            continue;
+        }
+        ASSERT_EQ(value->second, next[value->first]) << "Values of one producer stay in order";
+        next[value->first]++;
+        received++;
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(queue.pop(), std::nullopt);
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include "PollScheduler.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace MailTMAPI;
+using namespace std::chrono_literals;
+
+// Test that busy inboxes speed up and idle inboxes slow down within bounds
+TEST(PollSchedulerTests, AdaptIntervalFollowsArrivals) {
+    PollPolicy policy;
+    policy.minInterval = 2000ms;
+    policy.maxInterval = 60000ms;
+    policy.idleGrowth = 1.5;
+
+    EXPECT_EQ(PollScheduler::adaptInterval(policy, 10000ms, 3), 5000ms) << "New mail halves the interval";
+    EXPECT_EQ(PollScheduler::adaptInterval(policy, 10000ms, 0), 15000ms) << "Idle polls grow the interval";
+    EXPECT_EQ(PollScheduler::adaptInterval(policy, 3000ms, 1), 2000ms) << "Never faster than minInterval";
+    EXPECT_EQ(PollScheduler::adaptInterval(policy, 50000ms, 0), 60000ms) << "Never slower than maxInterval";
+}
+
+// Test HTTP status classification
+TEST(PollSchedulerTests, ResultFromHttpStatus) {
+    EXPECT_EQ(PollResult::fromHttpStatus(200, 0).status, PollStatus::Ok);
+    EXPECT_EQ(PollResult::fromHttpStatus(429, 0).status, PollStatus::RateLimited);
+    EXPECT_EQ(PollResult::fromHttpStatus(500, 0).status, PollStatus::Error);
+    EXPECT_EQ(PollResult::fromHttpStatus(0, 0).status, PollStatus::Error) << "Transport errors report 0";
+}
+
+// Test that first polls of many inboxes are spread over the initial interval
+TEST(PollSchedulerTests, FirstPollsAreSpread) {
+    PollPolicy policy;
+    policy.initialInterval = 1000ms;
+    policy.minInterval = 1000ms;
+    PollScheduler scheduler(policy);
+
+    std::mutex timesMutex;
+    std::vector<std::chrono::steady_clock::time_point> firstPolls;
+    const int accounts = 500;
+    for (int i = 0; i < accounts; ++i) {
+        scheduler.addAccount("inbox" + std::to_string(i), [&](PollScheduler::DoneCallback done) {
+            {
+                std::lock_guard<std::mutex> lock(timesMutex);
+                firstPolls.push_back(std::chrono::steady_clock::now());
+            }
+            done(PollResult{PollStatus::Ok, 0});
+        });
+    }
+    auto start = std::chrono::steady_clock::now();
+    scheduler.start();
+    std::this_thread::sleep_for(1100ms);
+    scheduler.stop();
+
+    std::lock_guard<std::mutex> lock(timesMutex);
+    ASSERT_GE(firstPolls.size(), static_cast<size_t>(accounts));
+
+    // Count polls per 100 ms bucket; a uniform spread puts about 50 in each
+    std::vector<int> buckets(11, 0);
+    for (size_t i = 0; i < static_cast<size_t>(accounts); ++i) {
+        auto offset = std::chrono::duration_cast<std::chrono::milliseconds>(firstPolls[i] - start).count();
+        buckets[std::min<long long>(offset / 100, 10)]++;
+    }
+    for (int count : buckets) {
+        EXPECT_LT(count, accounts / 4) << "No 100 ms window should get a burst of first polls";
+    }
+}
+
+// Test that errors back off and pollNow bypasses the regular interval
+TEST(PollSchedulerTests, BackoffAndPollNow) {
+    PollPolicy policy;
+    policy.initialInterval = 20ms;
+    policy.minInterval = 20ms;
+    policy.maxInterval = 10000ms;
+    policy.maxBackoff = 10000ms;
+    PollScheduler scheduler(policy);
+
+    std::atomic<int> polls(0);
+    std::atomic<bool> failing(true);
+    scheduler.addAccount("inbox", [&](PollScheduler::DoneCallback done) {
+        polls++;
+        done(failing ? PollResult{PollStatus::RateLimited, 0} : PollResult{PollStatus::Ok, 1});
+    });
+    scheduler.start();
+
+    // While rate limited, the backoff grows so only a handful of polls happen
+    std::this_thread::sleep_for(500ms);
+    EXPECT_LT(polls.load(), 10) << "Rate limiting should back off exponentially";
+
+    // A push notification polls immediately even during backoff
+    failing = false;
+    int before = polls.load();
+    scheduler.pollNow("inbox");
+    std::this_thread::sleep_for(50ms);
+    EXPECT_GT(polls.load(), before) << "pollNow should poll right away";
+
+    scheduler.removeAccount("inbox");
+    EXPECT_EQ(scheduler.size(), 0u);
+    scheduler.stop();
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include "RenderModel.h"
+#include "JsonParser.h"
+#include <string>
+
+using namespace MailTMAPI;
+
+// Helper function to build a message from a JSON literal
+Message parseMessage(const std::string& text) {
+    Json::Value root;
+    EXPECT_TRUE(JsonParser::local().parse(text, root));
+    return Message::fromJson(root);
+}
+
+// Helper function to join prepared words back into text
+std::string joined(const std::vector<LayoutWord>& words) {
+    std::string text;
+    for (const auto& word : words) {
+        text += (text.empty() ? "" : " ") + word.text;
+    }
+    return text;
+}
+
+// Test preparing the header lines and both body parts
+TEST(RenderModelTests, PreparesAllParts) {
+    RenderModel model = RenderModel::build(parseMessage(R"({
+        "id": "m1", "subject": "Confirm  your account", "intro": "Confirm",
+        "from": {"address": "noreply@example.com", "name": ""},
+        "text": "Open https://example.com/c?t=1 to confirm",
+        "html": ["<p>Please <a href=\"https://example.com/c?t=1&amp;s=2\">confirm</a></p><style>p{}</style>"]
+    })"));
+
+    EXPECT_EQ(model.id, "m1");
+    EXPECT_EQ(joined(model.from), "From: noreply@example.com");
+    EXPECT_EQ(joined(model.subject), "Subject: Confirm your account");
+    EXPECT_EQ(joined(model.text), "Open https://example.com/c?t=1 to confirm");
+    ASSERT_EQ(model.text.size(), 4u);
+    EXPECT_TRUE(model.text[1].isLink);
+    EXPECT_FALSE(model.text[0].isLink);
+
+    EXPECT_EQ(joined(model.html), "Please confirm https://example.com/c?t=1&s=2") << "HTML is converted on arrival";
+    ASSERT_EQ(model.links.size(), 1u);
+    EXPECT_EQ(model.links[0].text, "confirm");
+    ASSERT_EQ(model.linkLabels.size(), 1u);
+    ASSERT_EQ(model.linkLabels[0].size(), 1u);
+    EXPECT_EQ(model.linkLabels[0][0].text, "confirm");
+    EXPECT_EQ(joined(model.preview), joined(model.text)) << "The preview prefers the text part";
+}
+
+// Test the preview fallbacks and its word limit
+TEST(RenderModelTests, ChoosesPreviewSource) {
+    RenderModel htmlOnly = RenderModel::build(parseMessage(R"({"id": "m2", "html": ["<b>Hi</b> there"], "intro": "x"})"));
+    EXPECT_EQ(joined(htmlOnly.preview), "Hi there");
+    EXPECT_TRUE(htmlOnly.from.empty());
+    EXPECT_TRUE(htmlOnly.subject.empty());
+    EXPECT_TRUE(htmlOnly.text.empty());
+
+    RenderModel introOnly = RenderModel::build(parseMessage(R"({"id": "m3", "intro": "Just the intro"})"));
+    EXPECT_EQ(joined(introOnly.preview), "Just the intro");
+    EXPECT_TRUE(introOnly.html.empty());
+
+    std::string longText;
+    for (int i = 0; i < 1000; ++i) {
+        longText += "word ";
+    }
+    RenderModel longMessage = RenderModel::build(parseMessage(R"({"id": "m4", "text": ")" + longText + R"("})"));
+    EXPECT_EQ(longMessage.text.size(), 1000u);
+    EXPECT_EQ(longMessage.preview.size(), RenderModel::previewWordLimit);
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include "MailTM.h"
+#include "MockMailServer.h"
+#include "RequestMetrics.h"
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace MailTMAPI;
+
+// Helper function to find an endpoint in a snapshot
+const EndpointSnapshot* endpointIn(const std::vector<EndpointSnapshot>& snapshot, const std::string& name) {
+    for (const auto& endpoint : snapshot) {
+        if (endpoint.endpoint == name) {
+            return &endpoint;
+        }
+    }
+    return nullptr;
+}
+
+// Test that every value lands in a bucket whose bound is at most 12.5% above it
+TEST(RequestMetricsTests, BucketBounds) {
+    for (uint64_t value : {0ull, 1ull, 7ull, 8ull, 9ull, 15ull, 16ull, 17ull, 1000ull, 123456ull, 60000000ull}) {
+        size_t bucket = LatencyHistogram::bucketFor(value);
+        EXPECT_GE(LatencyHistogram::upperBound(bucket), value);
+        EXPECT_LE(LatencyHistogram::upperBound(bucket), value + value / 8) << value;
+        if (bucket > 0) {
+            EXPECT_LT(LatencyHistogram::upperBound(bucket - 1), value) << value;
+        }
+    }
+    EXPECT_EQ(LatencyHistogram::bucketFor(UINT64_MAX), LatencyHistogram::bucketCount - 1);
+}
+
+// Test percentiles, including values recorded from several threads at once
+TEST(RequestMetricsTests, Percentiles) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.snapshot().percentile(0.5), 0u);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&histogram]() {
+            for (uint64_t value = 1; value <= 1000; ++value) {
+                histogram.record(value);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    HistogramSnapshot snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count, 4000u);
+    EXPECT_DOUBLE_EQ(snapshot.mean(), 500.5);
+    EXPECT_GE(snapshot.percentile(0.5), 500u);
+    EXPECT_LE(snapshot.percentile(0.5), 563u);
+    EXPECT_GE(snapshot.percentile(0.99), 990u);
+    EXPECT_LE(snapshot.percentile(0.99), 1114u);
+    EXPECT_EQ(snapshot.percentile(1.0), LatencyHistogram::upperBound(LatencyHistogram::bucketFor(1000)));
+}
+
+// Test grouping request URLs into endpoints
+TEST(RequestMetricsTests, Classify) {
+    EXPECT_EQ(RequestMetrics::classify("GET", "https://api.mail.tm/domains"), Endpoint::Domains);
+    EXPECT_EQ(RequestMetrics::classify("POST", "https://api.mail.tm/accounts"), Endpoint::Register);
+    EXPECT_EQ(RequestMetrics::classify("POST", "http://127.0.0.1:8080/token"), Endpoint::Token);
+    EXPECT_EQ(RequestMetrics::classify("GET", "/messages?page=2"), Endpoint::Inbox);
+    EXPECT_EQ(RequestMetrics::classify("GET", "https://api.mail.tm/messages/664f1a"), Endpoint::Message);
+    EXPECT_EQ(RequestMetrics::classify("DELETE", "https://api.mail.tm/accounts/abc"), Endpoint::DeleteAccount);
+    EXPECT_EQ(RequestMetrics::classify("GET", "https://api.mail.tm/sources/1"), Endpoint::Other);
+    EXPECT_STREQ(RequestMetrics::name(Endpoint::Message), "message");
+}
+
+// Test that sync and async requests from two clients land in one shared collector
+TEST(RequestMetricsTests, RecordsMailTMRequests) {
+    MockServerOptions options;
+    options.inboxSize = 3;
+    MockMailServer server(options);
+    auto metrics = std::make_shared<RequestMetrics>();
+    MailTM first(server.url());
+    MailTM second(server.url());
+    first.setMetrics(metrics);
+    second.setMetrics(metrics);
+
+    ASSERT_TRUE(first.registerEmail("dave@example.com", "secret").has_value());
+    auto token = second.authenticate("dave@example.com", "secret");
+    ASSERT_TRUE(token.has_value());
+    auto inbox = first.checkInboxAsync(*token).get();
+    ASSERT_EQ(inbox.size(), 3u);
+    ASSERT_TRUE(second.getMessage(*token, inbox[0].id).has_value());
+    EXPECT_FALSE(second.getMessage(*token, "missing").has_value());
+
+    auto snapshot = metrics->snapshot();
+    EXPECT_EQ(snapshot.size(), 4u) << "Only endpoints with traffic are listed";
+    const EndpointSnapshot* message = endpointIn(snapshot, "message");
+    ASSERT_NE(message, nullptr);
+    EXPECT_EQ(message->requests, 2u);
+    EXPECT_EQ(message->statusClasses[2], 1u);
+    EXPECT_EQ(message->statusClasses[4], 1u);
+    EXPECT_EQ(message->total.count, 2u);
+    EXPECT_EQ(message->processing.count, 1u) << "The 404 body is not processed";
+    EXPECT_GT(message->bytesReceived, message->bytesSent);
+    const EndpointSnapshot* inboxStats = endpointIn(snapshot, "inbox");
+    ASSERT_NE(inboxStats, nullptr);
+    EXPECT_EQ(inboxStats->requests, 1u) << "Async requests are recorded too";
+    EXPECT_LE(inboxStats->firstByte.percentile(0.5), inboxStats->total.percentile(0.5));
+    EXPECT_EQ(first.getMetrics(), metrics);
+    EXPECT_THROW(first.setMetrics(std::make_shared<RequestMetrics>()), std::logic_error)
+        << "Swapping the collector under running requests would race";
+
+    long status = 0;
+    EXPECT_TRUE(first.checkInbox("forged", status).empty());
+    EXPECT_EQ(status, 401);
+    EXPECT_EQ(endpointIn(metrics->snapshot(), "inbox")->processing.count, 1u) << "The 401 body is not processed";
+}
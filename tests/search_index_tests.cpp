@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "SearchIndex.h"
+#include <string>
+#include <vector>
+
+using namespace MailTMAPI;
+
+// Helper function to build a message for the index
+Message indexedMessage(const std::string& id, const std::string& from, const std::string& subject,
+                       const std::string& text, const std::string& html = "") {
+    Message message;
+    message.id = id;
+    message.from.address = InternedString(from);
+    message.subject = subject;
+    message.text = text;
+    message.html = html;
+    return message;
+}
+
+// Helper function to run a search box string
+std::vector<std::string> searchFor(const SearchIndex& index, const std::string& text, size_t limit = 100) {
+    return index.search(SearchQuery::parse(text), limit);
+}
+
+// Test splitting text into words
+TEST(SearchIndexTests, Tokenize) {
+    std::vector<std::string> words;
+    SearchIndex::tokenize("Your CODE: 482913, see https://Example.com/verify?t=abc — Grüße", [&](std::string_view word) {
+        words.emplace_back(word);
+    });
+    EXPECT_EQ(words, (std::vector<std::string>{"your", "code", "482913", "see", "https", "example", "com", "verify",
+                                               "t", "abc", "\xE2\x80\x94", "grüße"}));
+
+    words.clear();
+    SearchIndex::tokenize(std::string(100, 'A'), [&](std::string_view word) { words.emplace_back(word); });
+    ASSERT_EQ(words.size(), 1u);
+    EXPECT_EQ(words[0], std::string(SearchIndex::maxWordLength, 'a')) << "Long words are indexed by their start";
+}
+
+// Test parsing queries
+TEST(SearchIndexTests, ParseQuery) {
+    SearchQuery query = SearchQuery::parse("  Verif* code FROM:NoReply@Example.com example.co*");
+    EXPECT_EQ(query.terms, (std::vector<std::string>{"code", "example"}));
+    EXPECT_EQ(query.prefixes, (std::vector<std::string>{"verif", "co"}));
+    EXPECT_EQ(query.sender, "noreply@example.com");
+    EXPECT_TRUE(SearchQuery::parse("  ").empty());
+    EXPECT_TRUE(SearchQuery::parse("*").empty());
+}
+
+// Test that every term must match and results come newest first
+TEST(SearchIndexTests, TermsMatchAll) {
+    SearchIndex index;
+    index.add(indexedMessage("m1", "a@one.com", "Welcome", "Your code is 111111"));
+    index.add(indexedMessage("m2", "b@two.com", "Your CODE", "Use 222222 to sign in"));
+    index.add(indexedMessage("m3", "a@one.com", "Newsletter", "Nothing to see"));
+    EXPECT_EQ(index.size(), 3u);
+
+    EXPECT_EQ(searchFor(index, "code"), (std::vector<std::string>{"m2", "m1"}));
+    EXPECT_EQ(searchFor(index, "your code 222222"), (std::vector<std::string>{"m2"}));
+    EXPECT_TRUE(searchFor(index, "code missing").empty());
+    EXPECT_EQ(searchFor(index, "code", 1), (std::vector<std::string>{"m2"})) << "The limit keeps the newest";
+    EXPECT_TRUE(searchFor(index, "").empty());
+}
+
+// Test prefix queries
+TEST(SearchIndexTests, Prefix) {
+    SearchIndex index;
+    index.add(indexedMessage("m1", "a@one.com", "Verify your account", ""));
+    index.add(indexedMessage("m2", "a@one.com", "Verification code", ""));
+    index.add(indexedMessage("m3", "a@one.com", "Very important", ""));
+
+    EXPECT_EQ(searchFor(index, "verif*"), (std::vector<std::string>{"m2", "m1"}));
+    EXPECT_EQ(searchFor(index, "ver*"), (std::vector<std::string>{"m3", "m2", "m1"}));
+    EXPECT_EQ(searchFor(index, "verif* code"), (std::vector<std::string>{"m2"}));
+    EXPECT_TRUE(searchFor(index, "verz*").empty());
+}
+
+// Test the sender filter by address and by domain
+TEST(SearchIndexTests, SenderFilter) {
+    SearchIndex index;
+    index.add(indexedMessage("m1", "NoReply@Shop.com", "Your code", ""));
+    index.add(indexedMessage("m2", "team@other.org", "Your code", ""));
+    index.add(indexedMessage("m3", "news@shop.com", "Sale", ""));
+
+    EXPECT_EQ(searchFor(index, "code from:noreply@shop.com"), (std::vector<std::string>{"m1"}));
+    EXPECT_EQ(searchFor(index, "from:@shop.com"), (std::vector<std::string>{"m3", "m1"}));
+    EXPECT_TRUE(searchFor(index, "from:@nowhere.net").empty());
+    EXPECT_EQ(searchFor(index, "shop"), (std::vector<std::string>{"m3", "m1"})) << "The sender is searchable as text too";
+}
+
+// Test that HTML is indexed as text plus link URLs, without tags or attributes
+TEST(SearchIndexTests, HtmlText) {
+    SearchIndex index;
+    index.add(indexedMessage("m1", "a@one.com", "Confirm", "",
+                             "<div class=\"wrapper\"><style>.x{color:red}</style>"
+                             "<p>Please <a href=\"https://app.example.com/confirm?token=XYZ123\">confirm</a> &amp; go</p></div>"));
+
+    EXPECT_EQ(searchFor(index, "please confirm"), (std::vector<std::string>{"m1"}));
+    EXPECT_EQ(searchFor(index, "xyz123"), (std::vector<std::string>{"m1"}));
+    EXPECT_EQ(searchFor(index, "app.example.com"), (std::vector<std::string>{"m1"}));
+    EXPECT_TRUE(searchFor(index, "div").empty());
+    EXPECT_TRUE(searchFor(index, "wrapper").empty());
+    EXPECT_TRUE(searchFor(index, "red").empty());
+    EXPECT_TRUE(searchFor(index, "amp").empty());
+}
+
+// Test that a message fetched twice is indexed once and clear() empties the index
+TEST(SearchIndexTests, DuplicatesAndClear) {
+    SearchIndex index;
+    index.add(indexedMessage("m1", "a@one.com", "Hello", ""));
+    index.add(indexedMessage("m1", "a@one.com", "Hello", ""));
+    index.add(indexedMessage("", "a@one.com", "Hello", ""));
+    EXPECT_EQ(index.size(), 1u);
+    EXPECT_EQ(searchFor(index, "hello"), (std::vector<std::string>{"m1"}));
+
+    index.clear();
+    EXPECT_EQ(index.size(), 0u);
+    EXPECT_TRUE(searchFor(index, "hello").empty());
+    index.add(indexedMessage("m1", "a@one.com", "Hello", ""));
+    EXPECT_EQ(searchFor(index, "hello"), (std::vector<std::string>{"m1"}));
+}
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include "MailTM.h"
+#include "SseParser.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace MailTMAPI;
+
+// Local stand-in for the Mercure hub: answers one subscription with a fixed response
+class SseStandIn {
+private:
+    int listenFd;
+    int port;
+    std::thread server;
+    mutable std::mutex requestMutex; // Guards lastRequest, which the server thread fills
+    std::string lastRequest;
+
+public:
+    explicit SseStandIn(const std::string& response) : listenFd(socket(AF_INET, SOCK_STREAM, 0)), port(0) {
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0; // Let the OS pick a free port
+        bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        listen(listenFd, 1);
+        socklen_t len = sizeof(addr);
+        getsockname(listenFd, reinterpret_cast<sockaddr*>(&addr), &len);
+        port = ntohs(addr.sin_port);
+
+        server = std::thread([this, response]() {
+            int client = accept(listenFd, nullptr, nullptr);
+            if (client < 0) {
+                return;
+            }
+            char buffer[4096];
+            ssize_t received = recv(client, buffer, sizeof(buffer), 0);
+            if (received > 0) {
+                std::lock_guard<std::mutex> lock(requestMutex);
+                lastRequest.assign(buffer, received);
+            }
+            send(client, response.data(), response.size(), MSG_NOSIGNAL);
+            // Keep the stream open until the client hangs up
+            while (recv(client, buffer, sizeof(buffer), 0) > 0) {
+            }
+            close(client);
+        });
+    }
+
+    ~SseStandIn() {
+        shutdown(listenFd, SHUT_RDWR);
+        close(listenFd);
+        if (server.joinable()) {
+            server.join();
+        }
+    }
+
+    std::string url() const {
+        return "http://127.0.0.1:" + std::to_string(port) + "/.well-known/mercure";
+    }
+
+    std::string request() const {
+        std::lock_guard<std::mutex> lock(requestMutex);
+        return lastRequest;
+    }
+};
+
+// Test that events split across arbitrary chunks are reassembled
+TEST(SseParserTests, ParsesEventsAcrossChunks) {
+    std::vector<SseEvent> events;
+    SseParser parser([&](const SseEvent& event) { events.push_back(event); });
+
+    std::string stream = ": heartbeat\r\nid: 1\r\nevent: update\r\ndata: {\"a\":\r\ndata: 1}\r\n\r\ndata: second\n\n";
+    for (char c : stream) { // Feed one byte at a time
+        parser.feed(&c, 1);
+    }
+
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events[0].type, "update");
+    EXPECT_EQ(events[0].data, "{\"a\":\n1}");
+    EXPECT_EQ(events[0].id, "1");
+    EXPECT_EQ(events[1].type, "message");
+    EXPECT_EQ(events[1].data, "second");
+    EXPECT_EQ(events[1].id, "1") << "The last event ID carries over";
+}
+
+// Test retry handling and that events without data are dropped
+TEST(SseParserTests, HandlesRetryAndEmptyEvents) {
+    int count = 0;
+    SseParser parser([&](const SseEvent&) { count++; });
+
+    std::string stream = "retry: 1500\n\nevent: ping\n\nid: 7\ndata\n\n";
+    parser.feed(stream.data(), stream.size());
+
+    EXPECT_EQ(parser.getRetryMs(), 1500);
+    EXPECT_EQ(parser.getLastEventId(), "7");
+    EXPECT_EQ(count, 1) << "Only the event with a data field is dispatched";
+}
+
+// Test that streamInbox delivers pushed updates from a local hub
+TEST(SseStreamTests, StreamInboxReceivesUpdates) {
+    SseStandIn hub("HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\n\r\n"
+                   "id: 1\ndata: {\"@type\":\"Message\",\"id\":\"m1\"}\n\n"
+                   "id: 2\ndata: {\"@type\":\"Message\",\"id\":\"m2\"}\n\n");
+    MailTM mailTm;
+    mailTm.setMercureUrl(hub.url());
+
+    std::atomic<bool> running(true);
+    std::vector<std::string> ids;
+    bool streamed = mailTm.streamInbox("test-token", "account-1", [&](const Json::Value& update) {
+        ids.push_back(update["id"].asString());
+        if (ids.size() == 2) {
+            running = false; // Stop once both pushed updates arrived
+        }
+    }, running);
+
+    EXPECT_TRUE(streamed);
+    ASSERT_EQ(ids.size(), 2u);
+    EXPECT_EQ(ids[0], "m1");
+    EXPECT_EQ(ids[1], "m2");
+    EXPECT_NE(hub.request().find("topic=/accounts/account-1"), std::string::npos);
+    EXPECT_NE(hub.request().find("Authorization: Bearer test-token"), std::string::npos);
+}
+
+// Test that a rejected subscription returns so the caller can fall back to polling
+TEST(SseStreamTests, StreamInboxReturnsFalseWhenRejected) {
+    SseStandIn hub("HTTP/1.1 401 Unauthorized\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+    MailTM mailTm;
+    mailTm.setMercureUrl(hub.url());
+
+    std::atomic<bool> running(true);
+    auto start = std::chrono::steady_clock::now();
+    bool streamed = mailTm.streamInbox("bad-token", "account-1", [](const Json::Value&) {}, running);
+
+    EXPECT_FALSE(streamed);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include "TextLayout.h"
+#include <string>
+
+using namespace MailTMAPI;
+
+// Helper function giving every glyph the same 10 px advance
+GlyphAdvances fixedAdvances() {
+    return GlyphAdvances([](char32_t) { return 10.0f; });
+}
+
+// Test measuring ASCII and multi-byte UTF-8 text
+TEST(TextLayoutTests, MeasuresCodePoints) {
+    int lookups = 0;
+    GlyphAdvances advances([&lookups](char32_t codePoint) {
+        lookups++;
+        return codePoint == U'é' ? 7.0f : 10.0f;
+    });
+    int asciiLookups = lookups;
+    EXPECT_FLOAT_EQ(advances.measure("abc"), 30.0f);
+    EXPECT_FLOAT_EQ(advances.measure("é"), 7.0f);
+    EXPECT_FLOAT_EQ(advances.measure("éé"), 14.0f);
+    EXPECT_EQ(lookups, asciiLookups + 1) << "Each non-ASCII glyph is looked up once";
+}
+
+// Test wrapping at the width and merging plain words into runs
+TEST(TextLayoutTests, WrapsAtMaxWidth) {
+    LayoutOptions options;
+    options.maxWidth = 100; // Ten glyphs per line
+    options.lineHeight = 20;
+    LayoutResult result = TextLayout::layout("aaa bbb  ccc\n dddd", fixedAdvances(), options);
+
+    ASSERT_EQ(result.runs.size(), 2u);
+    EXPECT_EQ(result.runs[0].text, "aaa bbb");
+    EXPECT_FLOAT_EQ(result.runs[0].width, 70.0f);
+    EXPECT_EQ(result.runs[1].text, "ccc dddd");
+    EXPECT_FLOAT_EQ(result.runs[1].y, 20.0f);
+    EXPECT_EQ(result.lineCount, 2u);
+    EXPECT_FLOAT_EQ(result.height, 40.0f);
+    EXPECT_FALSE(result.truncated);
+}
+
+// Test that links become their own runs at their position in the line
+TEST(TextLayoutTests, PlacesLinks) {
+    LayoutOptions options;
+    options.maxWidth = 1000;
+    LayoutResult result = TextLayout::layout("Visit https://example.com/a ?x=1 now!", fixedAdvances(), options);
+
+    ASSERT_EQ(result.runs.size(), 3u);
+    EXPECT_EQ(result.runs[1].text, "https://example.com/a?x=1") << "URL pieces split by spaces are rejoined";
+    EXPECT_TRUE(result.runs[1].isLink);
+    EXPECT_FLOAT_EQ(result.runs[1].x, 60.0f);
+    EXPECT_FLOAT_EQ(result.runs[2].x, 60.0f + 250.0f + 10.0f);
+    EXPECT_FALSE(result.runs[2].isLink);
+}
+
+// Test cutting text at the line limit
+TEST(TextLayoutTests, TruncatesAtMaxLines) {
+    LayoutOptions options;
+    options.maxWidth = 50;
+    options.maxLines = 2;
+    LayoutResult result = TextLayout::layout("one two three four five", fixedAdvances(), options);
+
+    EXPECT_TRUE(result.truncated);
+    EXPECT_EQ(result.lineCount, 2u);
+    EXPECT_EQ(result.runs.back().text, "two ...");
+
+    LayoutResult empty = TextLayout::layout("   ", fixedAdvances(), options);
+    EXPECT_TRUE(empty.runs.empty());
+    EXPECT_FLOAT_EQ(empty.height, options.lineHeight) << "Empty text still takes one line";
+}
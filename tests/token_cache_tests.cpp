@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include "TokenCache.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <sys/stat.h>
+
+using namespace MailTMAPI;
+
+// Helper function to encode a string as unpadded base64url
+std::string base64Url(const std::string& input) {
+    static const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+    std::string output;
+    uint32_t buffer = 0;
+    int bits = 0;
+    for (unsigned char c : input) {
+        buffer = ((buffer << 8) | c) & 0xFFFF; // At most 13 bits are pending
+        bits += 8;
+        while (bits >= 6) {
+            bits -= 6;
+            output += alphabet[(buffer >> bits) & 0x3F];
+        }
+    }
+    if (bits > 0) {
+        output += alphabet[(buffer << (6 - bits)) & 0x3F];
+    }
+    return output;
+}
+
+// Helper function to build an unsigned JWT that expires after the given number of seconds
+std::string makeToken(long long secondsFromNow, const std::string& subject = "user") {
+    long long exp = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count() + secondsFromNow;
+    return base64Url("{\"alg\":\"none\"}") + "." +
+           base64Url("{\"sub\":\"" + subject + "\",\"exp\":" + std::to_string(exp) + "}") + ".sig";
+}
+
+// Test reading the exp claim
+TEST(TokenCacheTests, DecodeExpiry) {
+    auto expiry = TokenCache::decodeExpiry(makeToken(3600));
+    ASSERT_TRUE(expiry.has_value());
+    auto remaining = std::chrono::duration_cast<std::chrono::seconds>(*expiry - std::chrono::system_clock::now());
+    EXPECT_NEAR(remaining.count(), 3600, 5);
+
+    EXPECT_FALSE(TokenCache::decodeExpiry("not-a-jwt").has_value());
+    EXPECT_FALSE(TokenCache::decodeExpiry(base64Url("{}") + "." + base64Url("{\"sub\":1}") + ".x").has_value());
+}
+
+// Test that cached tokens are reused until they get close to expiry
+TEST(TokenCacheTests, ServesValidTokensOnly) {
+    TokenCache cache([](const std::string&, const std::string&) { return std::optional<std::string>(); },
+                     std::chrono::seconds(60));
+
+    EXPECT_FALSE(cache.get("a@example.com", "pw").has_value()) << "Nothing cached yet";
+
+    std::string token = makeToken(3600);
+    cache.put("a@example.com", "pw", token);
+    EXPECT_EQ(cache.get("a@example.com", "pw"), token);
+
+    cache.put("b@example.com", "pw", makeToken(30)); // Expires inside the 60 s margin
+    EXPECT_FALSE(cache.get("b@example.com", "pw").has_value());
+
+    EXPECT_FALSE(cache.get("a@example.com", "wrong").has_value()) << "Tokens only stand in for their password";
+
+    cache.invalidate("a@example.com");
+    EXPECT_FALSE(cache.get("a@example.com", "pw").has_value());
+}
+
+// Test that payloads longer than a few bytes decode, e.g. a realistic mail.tm token
+TEST(TokenCacheTests, DecodesLongPayloads) {
+    std::string subject(200, 'x');
+    auto expiry = TokenCache::decodeExpiry(makeToken(3600, subject));
+    ASSERT_TRUE(expiry.has_value());
+}
+
+// Test that the background thread refreshes a token before it expires
+TEST(TokenCacheTests, RefreshesBeforeExpiry) {
+    std::atomic<int> fetches(0);
+    std::string refreshed = makeToken(3600, "refreshed");
+    TokenCache cache([&](const std::string& address, const std::string& password) {
+        fetches++;
+        EXPECT_EQ(address, "a@example.com");
+        EXPECT_EQ(password, "pw");
+        return std::optional<std::string>(refreshed);
+    }, std::chrono::seconds(60));
+
+    cache.put("a@example.com", "pw", makeToken(61)); // Due for refresh in about one second
+
+    for (int i = 0; i < 50 && fetches == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    EXPECT_EQ(fetches.load(), 1);
+    EXPECT_EQ(cache.get("a@example.com", "pw"), refreshed);
+}
+
+// Test that tokens survive a restart through the on-disk store
+TEST(TokenCacheTests, PersistsToDisk) {
+    std::string path = ::testing::TempDir() + "lambdamail_tokens_test";
+    std::remove(path.c_str());
+    auto noFetch = [](const std::string&, const std::string&) { return std::optional<std::string>(); };
+    std::string token = makeToken(3600);
+
+    {
+        TokenCache cache(noFetch);
+        cache.setStorePath(path);
+        cache.put("a@example.com", "pw", token);
+        cache.put("b@example.com", "pw", makeToken(10)); // Too close to expiry to be reloaded
+    }
+
+    struct stat info {};
+    ASSERT_EQ(::stat(path.c_str(), &info), 0);
+    EXPECT_EQ(info.st_mode & 0777, 0600u) << "Tokens are credentials";
+
+    TokenCache restarted(noFetch);
+    restarted.setStorePath(path);
+    EXPECT_EQ(restarted.get("a@example.com", "pw"), token);
+    EXPECT_FALSE(restarted.get("b@example.com", "pw").has_value());
+    restarted.put("a@example.com", "pw", token); // Confirmed by a login, so now tied to the password
+    EXPECT_FALSE(restarted.get("a@example.com", "other").has_value());
+    std::remove(path.c_str());
+}
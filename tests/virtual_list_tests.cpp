@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include "VirtualList.h"
+
+using namespace MailTMAPI;
+
+// Test that row tops are the running sum of heights and spacing
+TEST(VirtualListTests, StacksRows) {
+    VirtualList list(10);
+    EXPECT_EQ(list.size(), 0u);
+    EXPECT_FLOAT_EQ(list.totalHeight(), 0.0f);
+
+    list.append(120);
+    list.append(50);
+    list.append(120);
+    EXPECT_EQ(list.size(), 3u);
+    EXPECT_FLOAT_EQ(list.rowTop(1), 130.0f);
+    EXPECT_FLOAT_EQ(list.rowTop(2), 190.0f);
+    EXPECT_FLOAT_EQ(list.totalHeight(), 320.0f);
+
+    list.clear();
+    EXPECT_EQ(list.size(), 0u);
+    EXPECT_FLOAT_EQ(list.totalHeight(), 0.0f);
+}
+
+// Test finding the rows that start inside the viewport
+TEST(VirtualListTests, FindsVisibleRows) {
+    VirtualList list(10);
+    for (int i = 0; i < 10000; ++i) {
+        list.append(120);
+    }
+
+    auto rows = list.rowsStartingIn(0, 430);
+    EXPECT_EQ(rows.first, 0u);
+    EXPECT_EQ(rows.second, 4u) << "Rows at 0, 130, 260 and 390";
+
+    rows = list.rowsStartingIn(130 * 5000 + 1, 130 * 5000 + 431);
+    EXPECT_EQ(rows.first, 5001u) << "A row scrolled partly out of view is skipped";
+    EXPECT_EQ(rows.second, 5004u);
+
+    rows = list.rowsStartingIn(list.totalHeight(), list.totalHeight() + 430);
+    EXPECT_EQ(rows.first, rows.second);
+
+    VirtualList empty;
+    rows = empty.rowsStartingIn(0, 430);
+    EXPECT_EQ(rows.first, rows.second);
+}
+
+// Test mapping click offsets to rows
+TEST(VirtualListTests, HitTestsRows) {
+    VirtualList list(10);
+    list.append(120);
+    list.append(120);
+    list.append(120);
+
+    EXPECT_EQ(list.rowAt(0), 0u);
+    EXPECT_EQ(list.rowAt(119), 0u);
+    EXPECT_EQ(list.rowAt(125), std::nullopt) << "Spacing belongs to no row";
+    EXPECT_EQ(list.rowAt(130), 1u);
+    EXPECT_EQ(list.rowAt(300), 2u);
+    EXPECT_EQ(list.rowAt(385), std::nullopt) << "Below the last row";
+    EXPECT_EQ(list.rowAt(-1), std::nullopt);
+    EXPECT_EQ(VirtualList().rowAt(0), std::nullopt);
+}